@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <tnt/core/core.hpp>
+#include <tnt/linear/linear.hpp>
+#include <tnt/benchmark/opencv_utils.hpp>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+template <typename DataType>
+static void convolution_TNT(benchmark::State& state, int size, int kernel_size, int channels, int kernels)
+{
+    while (state.KeepRunning()) {
+        state.PauseTiming(); // We don't count tensor creation
+
+        tnt::Tensor<DataType> tensor(tnt::Shape{size, size, channels}, 3.f);
+        tnt::Tensor<DataType> kernel(tnt::Shape{kernels, kernel_size, kernel_size, channels}, 1.f);
+
+        state.ResumeTiming();
+        tnt::conv3D(tensor, kernel, kernel_size / 2);
+    }
+}
+
+/// OpenCV filters each channel independently, so a bank of multi-channel
+/// kernels is one filter2D per kernel and channel, summed per kernel
+template <typename DataType>
+static void convolution_OCV(benchmark::State& state, int size, int kernel_size, int channels, int kernels)
+{
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+
+        std::vector<cv::Mat> planes(channels, tnt::create_cv_mat<DataType>(size, size, cv::Scalar(3)));
+        cv::Mat kernel = tnt::create_cv_mat<DataType>(kernel_size, kernel_size, cv::Scalar(1));
+
+        std::vector<cv::Mat> outputs(kernels);
+        cv::Mat filtered;
+
+        state.ResumeTiming();
+        for (int k = 0; k < kernels; ++k) {
+            cv::filter2D(planes[0], outputs[k], -1, kernel, cv::Point(-1, -1), 0, cv::BORDER_CONSTANT);
+            for (int c = 1; c < channels; ++c) {
+                cv::filter2D(planes[c], filtered, -1, kernel, cv::Point(-1, -1), 0, cv::BORDER_CONSTANT);
+                outputs[k] += filtered;
+            }
+        }
+    }
+}
+
+template <typename T>
+class RegisterConvolutionBenchmark
+{
+public:
+    RegisterConvolutionBenchmark(const std::string& type)
+    {
+        // {size, kernel size, channels, kernels}
+        std::vector<std::vector<int>> configs{{64, 3, 1, 1}, {512, 3, 1, 1}, {512, 5, 1, 1},
+                                              {2048, 3, 1, 1}, {128, 3, 16, 32}, {56, 1, 64, 64}};
+        for (const std::vector<int>& config : configs) {
+            std::string suffix = type + ">[" + std::to_string(config[0]) + "x" + std::to_string(config[0])
+                                      + "x" + std::to_string(config[2]) + " * " + std::to_string(config[3])
+                                      + "x" + std::to_string(config[1]) + "x" + std::to_string(config[1]) + "]";
+            benchmark::RegisterBenchmark(("Convolution:TNT <" + suffix).c_str(), convolution_TNT<T>,
+                                         config[0], config[1], config[2], config[3]);
+            benchmark::RegisterBenchmark(("Convolution:OCV <" + suffix).c_str(), convolution_OCV<T>,
+                                         config[0], config[1], config[2], config[3]);
+        }
+    }
+};
+
+static RegisterConvolutionBenchmark<float>  convolution_benchmark_float("float");
+static RegisterConvolutionBenchmark<double> convolution_benchmark_double("double");
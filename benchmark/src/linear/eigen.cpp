@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <tnt/core/core.hpp>
+#include <tnt/linear/linear.hpp>
+
+#include <Eigen/Dense>
+
+#include <random>
+
+/// A random symmetric matrix, stored row major
+template <typename DataType>
+static std::vector<DataType> symmetric_matrix(int size)
+{
+    std::mt19937 generator(size);
+    std::uniform_real_distribution<DataType> distribution(-1, 1);
+
+    std::vector<DataType> values(size * size);
+    for (int r = 0; r < size; ++r)
+        for (int c = 0; c <= r; ++c)
+            values[r * size + c] = values[c * size + r] = distribution(generator);
+
+    return values;
+}
+
+template <typename DataType>
+static void eigenvalues_TNT(benchmark::State& state, int size)
+{
+    const std::vector<DataType> values = symmetric_matrix<DataType>(size);
+
+    tnt::Tensor<DataType> tensor(tnt::Shape{size, size});
+    std::copy(values.begin(), values.end(), tensor.data.data);
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(tnt::eigenvalues(tensor, 100, 1e-6f));
+}
+
+template <typename DataType>
+static void eigenvalues_EIG(benchmark::State& state, int size)
+{
+    using MatType = Eigen::Matrix<DataType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    const std::vector<DataType> values = symmetric_matrix<DataType>(size);
+    const MatType matrix = Eigen::Map<const MatType>(values.data(), size, size);
+
+    while (state.KeepRunning()) {
+        Eigen::SelfAdjointEigenSolver<MatType> solver(matrix, Eigen::EigenvaluesOnly);
+        benchmark::DoNotOptimize(solver.eigenvalues());
+    }
+}
+
+template <typename DataType>
+static void symmetric_eigen_TNT(benchmark::State& state, int size)
+{
+    const std::vector<DataType> values = symmetric_matrix<DataType>(size);
+
+    tnt::Tensor<DataType> tensor(tnt::Shape{size, size});
+    std::copy(values.begin(), values.end(), tensor.data.data);
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(tnt::symmetric_eigen(tensor));
+}
+
+template <typename DataType>
+static void symmetric_eigen_EIG(benchmark::State& state, int size)
+{
+    using MatType = Eigen::Matrix<DataType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    const std::vector<DataType> values = symmetric_matrix<DataType>(size);
+    const MatType matrix = Eigen::Map<const MatType>(values.data(), size, size);
+
+    while (state.KeepRunning()) {
+        Eigen::SelfAdjointEigenSolver<MatType> solver(matrix, Eigen::ComputeEigenvectors);
+        benchmark::DoNotOptimize(solver.eigenvectors());
+    }
+}
+
+template <typename T>
+class RegisterEigenBenchmark
+{
+public:
+    RegisterEigenBenchmark(const std::string& type)
+    {
+        std::vector<int> sizes{4, 16, 32, 100};
+        for (int size : sizes) {
+            std::string suffix = type + ">[" + std::to_string(size) + "x" + std::to_string(size) + "]";
+            benchmark::RegisterBenchmark(("Eigenvalues:TNT <" + suffix).c_str(), eigenvalues_TNT<T>, size);
+            benchmark::RegisterBenchmark(("Eigenvalues:EIG <" + suffix).c_str(), eigenvalues_EIG<T>, size);
+        }
+
+        std::vector<int> large_sizes{100, 512, 2048};
+        for (int size : large_sizes) {
+            std::string suffix = type + ">[" + std::to_string(size) + "x" + std::to_string(size) + "]";
+            benchmark::RegisterBenchmark(("SymmetricEigen:TNT <" + suffix).c_str(), symmetric_eigen_TNT<T>, size);
+            benchmark::RegisterBenchmark(("SymmetricEigen:EIG <" + suffix).c_str(), symmetric_eigen_EIG<T>, size);
+        }
+    }
+};
+
+static RegisterEigenBenchmark<float>  eigen_benchmark_float("float");
+static RegisterEigenBenchmark<double> eigen_benchmark_double("double");
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <tnt/core/core.hpp>
+#include <tnt/linear/linear.hpp>
+
+#include <Eigen/Dense>
+
+#include <random>
+
+/// A random matrix, stored row major
+template <typename DataType>
+static std::vector<DataType> random_matrix(int rows, int cols)
+{
+    std::mt19937 generator(rows * cols);
+    std::uniform_real_distribution<DataType> distribution(-1, 1);
+
+    std::vector<DataType> values(rows * cols);
+    for (DataType& value : values)
+        value = distribution(generator);
+
+    return values;
+}
+
+template <typename DataType>
+static void svd_TNT(benchmark::State& state, int rows, int cols)
+{
+    const std::vector<DataType> values = random_matrix<DataType>(rows, cols);
+
+    tnt::Tensor<DataType> tensor(tnt::Shape{rows, cols});
+    std::copy(values.begin(), values.end(), tensor.data.data);
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(tnt::svd(tensor));
+}
+
+template <typename DataType>
+static void truncated_svd_TNT(benchmark::State& state, int rows, int cols, int k)
+{
+    const std::vector<DataType> values = random_matrix<DataType>(rows, cols);
+
+    tnt::Tensor<DataType> tensor(tnt::Shape{rows, cols});
+    std::copy(values.begin(), values.end(), tensor.data.data);
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(tnt::truncated_svd(tensor, k));
+}
+
+template <typename DataType>
+static void svd_EIG(benchmark::State& state, int rows, int cols)
+{
+    using MatType = Eigen::Matrix<DataType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    const std::vector<DataType> values = random_matrix<DataType>(rows, cols);
+    const MatType matrix = Eigen::Map<const MatType>(values.data(), rows, cols);
+
+    while (state.KeepRunning()) {
+        Eigen::BDCSVD<MatType> solver(matrix, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        benchmark::DoNotOptimize(solver.singularValues());
+    }
+}
+
+template <typename T>
+class RegisterSVDBenchmark
+{
+public:
+    RegisterSVDBenchmark(const std::string& type)
+    {
+        std::vector<std::pair<int, int>> shapes{{32, 32}, {128, 128}, {512, 512}, {1024, 256}};
+        for (const auto& shape : shapes) {
+            std::string suffix = type + ">[" + std::to_string(shape.first) + "x" + std::to_string(shape.second) + "]";
+            benchmark::RegisterBenchmark(("SVD:TNT <" + suffix).c_str(), svd_TNT<T>, shape.first, shape.second);
+            benchmark::RegisterBenchmark(("SVD:EIG <" + suffix).c_str(), svd_EIG<T>, shape.first, shape.second);
+        }
+
+        // The leading 20 singular triplets against the full decomposition
+        std::vector<std::pair<int, int>> large_shapes{{1024, 1024}, {4096, 1024}};
+        for (const auto& shape : large_shapes) {
+            std::string suffix = type + ">[" + std::to_string(shape.first) + "x" + std::to_string(shape.second) + "]";
+            benchmark::RegisterBenchmark(("TruncatedSVD:TNT <" + suffix + "[k=20]").c_str(), truncated_svd_TNT<T>, shape.first, shape.second, 20);
+            benchmark::RegisterBenchmark(("SVD:EIG <" + suffix).c_str(), svd_EIG<T>, shape.first, shape.second);
+        }
+    }
+};
+
+static RegisterSVDBenchmark<float>  svd_benchmark_float("float");
+static RegisterSVDBenchmark<double> svd_benchmark_double("double");
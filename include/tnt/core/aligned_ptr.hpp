@@ -1,6 +1,7 @@
 #ifndef TNT_ALIGNED_PTR_HPP
 #define TNT_ALIGNED_PTR_HPP
 
+#include <tnt/core/complex.hpp>
 #include <tnt/utils/errors.hpp>
 
 namespace tnt
@@ -18,12 +19,12 @@ namespace tnt
 ///     5. Indexing
 ///     6. Destruction
 ///
-/// \requires Type `Data` is arithmetic
+/// \requires Type `Data` is arithmetic or a complex floating point type
 template <typename Data>
 class TNT_EXPORT AlignedPtr
 {
-    static_assert(std::is_arithmetic<Data>::value,
-                    "AlignedPtr requires that type `Data` be arithmetic");
+    static_assert(IsTensorElement<Data>::value,
+                    "AlignedPtr requires that type `Data` be arithmetic or complex");
 
 public:
     using DataType = Data;
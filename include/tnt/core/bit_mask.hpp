@@ -0,0 +1,98 @@
+#ifndef TNT_BIT_MASK_HPP
+#define TNT_BIT_MASK_HPP
+
+#include <tnt/core/export.hpp>
+
+#include <tnt/core/aligned_ptr.hpp>
+#include <tnt/core/shape.hpp>
+
+#include <cstdint>
+
+namespace tnt
+{
+
+template <typename Data>
+class Tensor;
+
+/// \brief A bit-packed boolean mask
+///
+/// A BitMask stores one bit per element of a tensor with the same
+/// [shape](tnt::BitMask::shape), packed into 64 bit words in row-major order.
+/// Bit `i` of the mask is bit `i % 64` of word `i / 64`. Bits past the end of
+/// the mask are always zero.
+class TNT_EXPORT BitMask
+{
+public:
+    using SelfType = BitMask;
+    using WordType = uint64_t;
+    using PtrType  = AlignedPtr<WordType>;
+
+    constexpr static int WordBits = 64;
+
+// ----------------------------------------------------------------------------
+// Constructors
+
+    BitMask() noexcept;
+    BitMask(const Shape& shape);
+    BitMask(const Shape& shape, bool value);
+
+    /// \brief Pack a byte mask. Every non-zero byte becomes a set bit.
+    explicit BitMask(const Tensor<uint8_t>& mask);
+
+    BitMask(const SelfType& other) = default;
+    SelfType& operator=(const SelfType& other) = default;
+
+    BitMask(SelfType&& other) = default;
+    SelfType& operator=(SelfType&& other) = default;
+
+// ----------------------------------------------------------------------------
+// Operators
+
+    bool operator== (const SelfType& other) const noexcept;
+    bool operator!= (const SelfType& other) const noexcept;
+
+    /// \brief Read the bit at a flat index
+    ///
+    /// \notes Bounds checking on the index is performed by default. It can be
+    /// disabled by `#define DISABLE_CHECKS` before this function is called.
+    bool operator[] (int index) const;
+
+    SelfType  operator~  () const;
+
+    SelfType  operator&  (const SelfType& other) const;
+    SelfType& operator&= (const SelfType& other);
+    SelfType  operator|  (const SelfType& other) const;
+    SelfType& operator|= (const SelfType& other);
+    SelfType  operator^  (const SelfType& other) const;
+    SelfType& operator^= (const SelfType& other);
+
+// ----------------------------------------------------------------------------
+// Functions
+
+    /// \brief Set or clear the bit at a flat index
+    void set(int index, bool value);
+
+    /// \brief The number of set bits
+    int count() const noexcept;
+
+    /// \brief The number of 64 bit words backing the mask
+    int num_words() const noexcept;
+
+    /// \brief Expand to a byte mask with `255` where a bit is set and `0`
+    /// everywhere else
+    Tensor<uint8_t> to_bytes() const;
+
+// ----------------------------------------------------------------------------
+// Members
+
+    Shape   shape;
+    PtrType data;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace tnt
+
+// ----------------------------------------------------------------------------
+
+#endif // TNT_BIT_MASK_HPP
@@ -0,0 +1,44 @@
+#ifndef TNT_COMPLEX_HPP
+#define TNT_COMPLEX_HPP
+
+#include <complex>
+#include <type_traits>
+
+namespace tnt
+{
+
+/// \brief True for `std::complex<float>` and `std::complex<double>`
+template <typename T>
+struct IsComplex : std::false_type {};
+
+template <typename T>
+struct IsComplex<std::complex<T>> : std::is_floating_point<T> {};
+
+/// \brief True for the types a [Tensor]() can hold, which are the arithmetic
+/// types and the complex floating point types
+template <typename T>
+struct IsTensorElement
+    : std::integral_constant<bool, std::is_arithmetic<T>::value || IsComplex<T>::value> {};
+
+/// \brief The arithmetic type of the parts of an element
+///
+/// Complex values are stored interleaved, as a real part followed by an
+/// imaginary part, so a tensor of `N` complex values is also an array of
+/// `2 * N` values of `ScalarType<T>::type`.
+template <typename T>
+struct ScalarType
+{
+    using type = T;
+    constexpr static int parts = 1;
+};
+
+template <typename T>
+struct ScalarType<std::complex<T>>
+{
+    using type = T;
+    constexpr static int parts = 2;
+};
+
+} // namespace tnt
+
+#endif // TNT_COMPLEX_HPP
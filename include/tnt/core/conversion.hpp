@@ -0,0 +1,111 @@
+#ifndef TNT_CONVERSION_HPP
+#define TNT_CONVERSION_HPP
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace tnt
+{
+
+template <typename Data>
+class Tensor;
+
+/// \brief How [Tensor::as]() handles values outside the range of an integer
+/// destination type
+enum class Overflow
+{
+    /// Integer sources keep their low bits like a `static_cast`. Out of
+    /// range floating point sources give unspecified values.
+    Wrap,
+    /// Values clamp to the smallest or largest value of the destination and
+    /// NaN becomes `0`, like [saturate_cast](tnt::saturate_cast)
+    Saturate
+};
+
+/// \brief How [Tensor::as]() rounds floating point values converted to an
+/// integer type
+enum class Rounding
+{
+    /// Truncate towards zero like a `static_cast`
+    TowardZero,
+    /// Round to the nearest integer, ties to even
+    Nearest
+};
+
+namespace detail
+{
+
+template <typename To, typename From, typename Enable = void>
+struct SaturateCast
+{
+    static To eval(const From& value) noexcept
+    {
+        return static_cast<To>(value);
+    }
+};
+
+// Floating point to integer. NaN maps to 0.
+template <typename To, typename From>
+struct SaturateCast<To, From, typename std::enable_if<std::is_integral<To>::value
+                                                      && std::is_floating_point<From>::value>::type>
+{
+    static To eval(const From& value) noexcept
+    {
+        if (value != value)
+            return 0;
+        if (value <= static_cast<From>(std::numeric_limits<To>::lowest()))
+            return std::numeric_limits<To>::lowest();
+        if (value >= static_cast<From>(std::numeric_limits<To>::max()))
+            return std::numeric_limits<To>::max();
+
+        return static_cast<To>(value);
+    }
+};
+
+// Integer to integer
+template <typename To, typename From>
+struct SaturateCast<To, From, typename std::enable_if<std::is_integral<To>::value
+                                                      && std::is_integral<From>::value>::type>
+{
+    static To eval(const From& value) noexcept
+    {
+        if (is_negative(value))
+            return (std::is_unsigned<To>::value || (intmax_t) value < (intmax_t) std::numeric_limits<To>::min())
+                    ? std::numeric_limits<To>::min() : static_cast<To>(value);
+
+        return (uintmax_t) value > (uintmax_t) std::numeric_limits<To>::max()
+                ? std::numeric_limits<To>::max() : static_cast<To>(value);
+    }
+
+private:
+    template <typename T>
+    static typename std::enable_if<std::is_signed<T>::value, bool>::type is_negative(const T& value) noexcept { return value < 0; }
+
+    template <typename T>
+    static typename std::enable_if<std::is_unsigned<T>::value, bool>::type is_negative(const T&) noexcept { return false; }
+};
+
+template <typename SrcType, typename DstType, typename Enable = void>
+struct OptimizedConvert
+{
+    static void eval(const Tensor<SrcType>&, Tensor<DstType>&, Overflow, Rounding) noexcept;
+};
+
+} // namespace detail
+
+/// \brief Convert a value to type `To`, clamping it to the range of `To`
+///
+/// Integer and floating point values outside the range of an integer type
+/// `To` become its smallest or largest value, NaN becomes `0`. Floating point
+/// values are truncated towards zero. Conversions to floating point types are
+/// plain casts.
+template <typename To, typename From>
+inline To saturate_cast(const From& value) noexcept
+{
+    return detail::SaturateCast<To, From>::eval(value);
+}
+
+} // namespace tnt
+
+#endif // TNT_CONVERSION_HPP
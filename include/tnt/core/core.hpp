@@ -10,5 +10,7 @@
 #include <tnt/core/impl/range_impl.hpp>
 #include <tnt/core/impl/tensor_view_impl.hpp>
 #include <tnt/core/impl/tensor_impl.hpp>
+#include <tnt/core/impl/conversion_impl.hpp>
+#include <tnt/core/impl/bit_mask_impl.hpp>
 
 #endif // TNT_CORE_HPP
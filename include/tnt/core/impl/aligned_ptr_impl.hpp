@@ -25,7 +25,9 @@ TNT_INL DataType* aligned_malloc(size_t size)
     if (size == 0)
         return nullptr;
 
-    size_t aligned_size = AlignSIMDType<DataType>::aligned_buffer_size(size) * sizeof(DataType);
+    // Complex values are padded as arrays of their parts
+    using Scalar = typename ScalarType<DataType>::type;
+    size_t aligned_size = AlignSIMDType<Scalar>::aligned_buffer_size(size * ScalarType<DataType>::parts) * sizeof(Scalar);
 
     void* buffer;
     if (posix_memalign(&buffer, 32, aligned_size)) {
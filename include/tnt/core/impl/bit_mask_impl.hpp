@@ -0,0 +1,466 @@
+#ifndef TNT_BIT_MASK_IMPL_HPP
+#define TNT_BIT_MASK_IMPL_HPP
+
+#include <tnt/core/bit_mask.hpp>
+#include <tnt/core/tensor.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <cstring>
+#include <ostream>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+TNT_INL int popcount(uint64_t word)
+{
+#if __GNUC__
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (int) ((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/// Apply a bitwise operation to the packed words of two masks. Word buffers
+/// are padded to a whole number of SIMD blocks so the loop has no tail.
+template <typename Operation>
+inline void bit_mask_apply(BitMask& left, const BitMask& right, Operation op)
+{
+    using VecType = typename SIMDType<uint64_t>::VecType;
+
+    if (left.num_words() == 0)
+        return;
+
+    uint64_t*       l_ptr = left.data.data;
+    const uint64_t* r_ptr = right.data.data;
+
+    int offset = 0, num_blocks = AlignSIMDType<uint64_t>::num_aligned_blocks(left.num_words());
+    for ( ; num_blocks--; offset += OptimalSIMDSize<uint64_t>::value) {
+        VecType l_block = simdpp::load<VecType>(l_ptr + offset);
+        VecType r_block = simdpp::load<VecType>(r_ptr + offset);
+        simdpp::store(l_ptr + offset, op(l_block, r_block));
+    }
+}
+
+/// Zero the bits of the last word that lie past the end of the mask
+TNT_INL void bit_mask_clear_tail(BitMask& mask)
+{
+    const int remainder = mask.shape.total() % BitMask::WordBits;
+    if (remainder != 0)
+        mask.data.data[mask.num_words() - 1] &= (uint64_t(1) << remainder) - 1;
+}
+
+/// Index of the lowest set bit. `word` must not be zero.
+TNT_INL int count_trailing_zeros(uint64_t word)
+{
+#if __GNUC__
+    return __builtin_ctzll(word);
+#else
+    int count = 0;
+    for ( ; !(word & 1); word >>= 1)
+        ++count;
+    return count;
+#endif
+}
+
+/// Lookup table expanding 8 bits to 8 bytes of `0` or `255`
+struct BitExpandTable
+{
+    BitExpandTable()
+    {
+        for (int b = 0; b < 256; ++b)
+            for (int i = 0; i < 8; ++i)
+                bytes[b][i] = ((b >> i) & 1) ? 255 : 0;
+    }
+
+    uint8_t bytes[256][8];
+};
+
+TNT_INL const BitExpandTable& bit_expand_table()
+{
+    static const BitExpandTable table;
+    return table;
+}
+
+/// Read a mask in groups of [Size]() elements, the granularity of
+/// [PackMaskBits]() and [ExpandMaskBytes](). [load](*::load) returns the
+/// group as a bitfield so callers can take fast paths for empty and full
+/// groups. Only when the group is mixed is `bytes` guaranteed to hold the
+/// group as `0` / `255` bytes.
+template <typename MaskType>
+struct MaskGroups;
+
+template <>
+struct MaskGroups<Tensor<uint8_t>>
+{
+    constexpr static int Size = 16;
+
+    explicit MaskGroups(const Tensor<uint8_t>& mask) : ptr(mask.data.data) {}
+
+    TNT_INL uint16_t load(int group, simdpp::int8<Size>& bytes) const
+    {
+        const uint8_t zero = 0;
+        auto block = simdpp::load<simdpp::uint8<Size>>(ptr + group * Size);
+
+        // Normalize any non-zero byte to 255
+        bytes = simdpp::bit_cast<simdpp::int8<Size>>(simdpp::cmp_neq(block, simdpp::load_splat<simdpp::uint8<Size>>(&zero)));
+        return PackMaskBits<uint8_t>::pack(simdpp::bit_cast<simdpp::uint8<Size>>(bytes));
+    }
+
+    TNT_INL bool test(int index) const
+    {
+        return ptr[index] != 0;
+    }
+
+    const uint8_t* ptr;
+};
+
+template <>
+struct MaskGroups<BitMask>
+{
+    constexpr static int Size = 16;
+
+    explicit MaskGroups(const BitMask& mask) : ptr(mask.data.data) {}
+
+    TNT_INL uint16_t load(int group, simdpp::int8<Size>& bytes) const
+    {
+        const uint16_t bits = (uint16_t) (ptr[group / 4] >> (Size * (group % 4)));
+        if (bits != 0 && bits != 0xFFFF) {
+            const BitExpandTable& table = bit_expand_table();
+
+            int8_t buffer[Size];
+            memcpy(buffer,     table.bytes[bits & 0xFF], 8);
+            memcpy(buffer + 8, table.bytes[bits >> 8],   8);
+            bytes = simdpp::load_u<simdpp::int8<Size>>(buffer);
+        }
+
+        return bits;
+    }
+
+    TNT_INL bool test(int index) const
+    {
+        return (ptr[index / BitMask::WordBits] >> (index % BitMask::WordBits)) & 1;
+    }
+
+    const BitMask::WordType* ptr;
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Constructors
+
+inline BitMask::BitMask() noexcept {}
+
+inline BitMask::BitMask(const Shape& shape)
+{
+    this->shape = shape;
+    this->data  = PtrType((shape.total() + WordBits - 1) / WordBits);
+}
+
+inline BitMask::BitMask(const Shape& shape, bool value)
+    : BitMask(shape)
+{
+    if (value && this->num_words() > 0) {
+        memset(this->data.data, 0xFF, sizeof(WordType) * this->num_words());
+        detail::bit_mask_clear_tail(*this);
+    }
+}
+
+TEST_CASE("BitMask(const Shape&, bool)")
+{
+    BitMask empty(Shape{3, 5});
+    REQUIRE(empty.num_words() == 1);
+    REQUIRE(empty.count() == 0);
+
+    BitMask full(Shape{10, 13}, true);
+    REQUIRE(full.num_words() == 3);
+    REQUIRE(full.count() == 130);
+    REQUIRE(full[129] == true);
+    REQUIRE_THROWS(full[130]);
+
+    REQUIRE((BitMask(Shape{64}, true).count() == 64));
+}
+
+inline BitMask::BitMask(const Tensor<uint8_t>& mask)
+    : BitMask(mask.shape)
+{
+    using Pack    = PackMaskBits<uint8_t>;
+    using VecType = typename Pack::VecType;
+
+    const uint8_t* m_ptr = mask.data.data;
+    WordType*      w_ptr = this->data.data;
+
+    const uint8_t zero = 0;
+    auto zero_vec = simdpp::load_splat<VecType>(&zero);
+
+    const int total      = mask.shape.total();
+    const int num_groups = total / Pack::Size;
+
+    for (int g = 0; g < num_groups; ++g) {
+        VecType block = simdpp::load<VecType>(m_ptr + g * Pack::Size);
+        w_ptr[g / 4] |= WordType(Pack::pack(simdpp::cmp_neq(block, zero_vec))) << (Pack::Size * (g % 4));
+    }
+
+    for (int i = num_groups * Pack::Size; i < total; ++i)
+        if (m_ptr[i])
+            w_ptr[i / WordBits] |= WordType(1) << (i % WordBits);
+}
+
+TEST_CASE("BitMask(const Tensor<uint8_t>&) / BitMask::to_bytes()")
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<uint8_t> bytes(shape);
+        for (int i = 0; i < shape.total(); ++i)
+            bytes.data[i] = (i % 3 == 0 || i % 7 == 0) ? 255 : 0;
+
+        BitMask mask(bytes);
+
+        int expected = 0;
+        for (int i = 0; i < shape.total(); ++i) {
+            REQUIRE(mask[i] == (bytes.data[i] != 0));
+            expected += bytes.data[i] != 0;
+        }
+
+        REQUIRE(mask.count() == expected);
+        REQUIRE((mask.to_bytes() == bytes));
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{2, 1, 2, 1, 2});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    // Any non-zero byte packs to a set bit
+    uint8_t data[4] = {0, 1, 128, 255};
+    uint8_t expected[4] = {0, 255, 255, 255};
+    REQUIRE((BitMask(Tensor<uint8_t>(Shape{4}, AlignedPtr<uint8_t>(data, 4))).to_bytes()
+                == Tensor<uint8_t>(Shape{4}, AlignedPtr<uint8_t>(expected, 4))));
+}
+
+// ----------------------------------------------------------------------------
+// Operators
+
+inline bool BitMask::operator== (const SelfType& other) const noexcept
+{
+    return this->shape == other.shape
+            && this->data == other.data;
+}
+
+inline bool BitMask::operator!= (const SelfType& other) const noexcept
+{
+    return this->shape != other.shape
+            || this->data != other.data;
+}
+
+inline bool BitMask::operator[] (int index) const
+{
+    BOUNDS_CHECK("BitMask::operator[]", index, 0, this->shape.total())
+    return (this->data.data[index / WordBits] >> (index % WordBits)) & 1;
+}
+
+inline BitMask BitMask::operator~ () const
+{
+    using VecType = typename SIMDType<uint64_t>::VecType;
+
+    BitMask result(this->shape);
+    if (this->num_words() == 0)
+        return result;
+
+    const WordType* ptr = this->data.data;
+    WordType*       out = result.data.data;
+
+    int offset = 0, num_blocks = AlignSIMDType<uint64_t>::num_aligned_blocks(this->num_words());
+    for ( ; num_blocks--; offset += OptimalSIMDSize<uint64_t>::value) {
+        VecType block = simdpp::load<VecType>(ptr + offset);
+        simdpp::store(out + offset, VecType(simdpp::bit_not(block)));
+    }
+
+    detail::bit_mask_clear_tail(result);
+    return result;
+}
+
+TEST_CASE("BitMask::operator~()")
+{
+    BitMask mask(Shape{5, 27});
+    mask.set(0, true);
+    mask.set(77, true);
+
+    BitMask inverted = ~mask;
+    REQUIRE(inverted.count() == 133);
+    REQUIRE(inverted[0] == false);
+    REQUIRE(inverted[1] == true);
+    REQUIRE(inverted[77] == false);
+    REQUIRE(((~inverted) == mask));
+}
+
+inline BitMask BitMask::operator& (const SelfType& other) const
+{
+    BitMask temp = *this;
+    temp &= other;
+
+    return temp;
+}
+
+inline BitMask& BitMask::operator&= (const SelfType& other)
+{
+    using VecType = typename SIMDType<uint64_t>::VecType;
+
+    TNT_ASSERT(this->shape == other.shape,
+               InvalidParameterException("BitMask::operator&=()", __FILE__, __LINE__,
+                   "Combining two masks requires that those masks be of the same size"))
+
+    detail::bit_mask_apply(*this, other, [](const VecType& l, const VecType& r) {
+        return VecType(simdpp::bit_and(l, r));
+    });
+
+    return *this;
+}
+
+inline BitMask BitMask::operator| (const SelfType& other) const
+{
+    BitMask temp = *this;
+    temp |= other;
+
+    return temp;
+}
+
+inline BitMask& BitMask::operator|= (const SelfType& other)
+{
+    using VecType = typename SIMDType<uint64_t>::VecType;
+
+    TNT_ASSERT(this->shape == other.shape,
+               InvalidParameterException("BitMask::operator|=()", __FILE__, __LINE__,
+                   "Combining two masks requires that those masks be of the same size"))
+
+    detail::bit_mask_apply(*this, other, [](const VecType& l, const VecType& r) {
+        return VecType(simdpp::bit_or(l, r));
+    });
+
+    return *this;
+}
+
+inline BitMask BitMask::operator^ (const SelfType& other) const
+{
+    BitMask temp = *this;
+    temp ^= other;
+
+    return temp;
+}
+
+inline BitMask& BitMask::operator^= (const SelfType& other)
+{
+    using VecType = typename SIMDType<uint64_t>::VecType;
+
+    TNT_ASSERT(this->shape == other.shape,
+               InvalidParameterException("BitMask::operator^=()", __FILE__, __LINE__,
+                   "Combining two masks requires that those masks be of the same size"))
+
+    detail::bit_mask_apply(*this, other, [](const VecType& l, const VecType& r) {
+        return VecType(simdpp::bit_xor(l, r));
+    });
+
+    return *this;
+}
+
+TEST_CASE("BitMask::operator& / BitMask::operator| / BitMask::operator^")
+{
+    const Shape shape{9, 31};
+
+    BitMask threes(shape), fives(shape);
+    for (int i = 0; i < shape.total(); ++i) {
+        threes.set(i, i % 3 == 0);
+        fives.set(i, i % 5 == 0);
+    }
+
+    BitMask both = threes & fives, either = threes | fives, one = threes ^ fives;
+    for (int i = 0; i < shape.total(); ++i) {
+        REQUIRE(both[i]   == (i % 15 == 0));
+        REQUIRE(either[i] == (i % 3 == 0 || i % 5 == 0));
+        REQUIRE(one[i]    == ((i % 3 == 0) != (i % 5 == 0)));
+    }
+
+    REQUIRE((both.count() + one.count() == either.count()));
+
+    BitMask temp = threes;
+    temp ^= threes;
+    REQUIRE((temp == BitMask(shape)));
+
+    REQUIRE_THROWS(threes & BitMask(Shape{9, 30}));
+    REQUIRE_THROWS(threes | BitMask(Shape{9, 30}));
+    REQUIRE_THROWS(threes ^ BitMask(Shape{9, 30}));
+}
+
+// ----------------------------------------------------------------------------
+// Functions
+
+inline void BitMask::set(int index, bool value)
+{
+    BOUNDS_CHECK("BitMask::set()", index, 0, this->shape.total())
+
+    const WordType bit = WordType(1) << (index % WordBits);
+    if (value)
+        this->data.data[index / WordBits] |= bit;
+    else
+        this->data.data[index / WordBits] &= ~bit;
+}
+
+inline int BitMask::count() const noexcept
+{
+    int count = 0;
+    for (int i = 0; i < this->num_words(); ++i)
+        count += detail::popcount(this->data.data[i]);
+
+    return count;
+}
+
+inline int BitMask::num_words() const noexcept
+{
+    return (int) this->data.size;
+}
+
+inline Tensor<uint8_t> BitMask::to_bytes() const
+{
+    const detail::BitExpandTable& table = detail::bit_expand_table();
+
+    Tensor<uint8_t> bytes(this->shape);
+
+    uint8_t* b_ptr = bytes.data.data;
+
+    // Expand 8 bits at a time through the lookup table
+    const int total = this->shape.total();
+    for (int i = 0; i < total; i += 8) {
+        const uint64_t word = this->data.data[i / WordBits];
+        const uint8_t  bits = (uint8_t) (word >> (i % WordBits));
+
+        const int count = std::min(8, total - i);
+        memcpy(b_ptr + i, table.bytes[bits], count);
+    }
+
+    return bytes;
+}
+
+// ----------------------------------------------------------------------------
+// BitMask Stream Operator
+
+TNT_EXPORT inline std::ostream& operator<<(std::ostream& stream, const BitMask& mask)
+{
+    stream << "BitMask: {" << mask.shape << ", [";
+    for (int i = 0; i < mask.shape.total(); ++i)
+        stream << (mask[i] ? '1' : '0');
+    return stream << "]}";
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace tnt
+
+// ----------------------------------------------------------------------------
+
+#endif // TNT_BIT_MASK_IMPL_HPP
@@ -0,0 +1,437 @@
+#ifndef TNT_CONVERSION_IMPL_HPP
+#define TNT_CONVERSION_IMPL_HPP
+
+#include <tnt/core/conversion.hpp>
+#include <tnt/core/tensor.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Convert every lane of a vector to type `T`, keeping the lane count
+template <typename T, int Size>
+struct ConvertLanes {};
+
+#define CONVERT_LANES(TYPE, FUNC)                                              \
+template <int Size>                                                            \
+struct ConvertLanes<TYPE, Size>                                                \
+{                                                                              \
+    template <typename VecType>                                                \
+    static TNT_INL typename FullSIMDType<TYPE, Size>::VecType convert(const VecType& value) \
+    {                                                                          \
+        return simdpp::FUNC(value);                                            \
+    }                                                                          \
+};
+
+CONVERT_LANES(uint8_t,  to_uint8)
+CONVERT_LANES(uint16_t, to_uint16)
+CONVERT_LANES(uint32_t, to_uint32)
+CONVERT_LANES(uint64_t, to_uint64)
+CONVERT_LANES(int8_t,   to_int8)
+CONVERT_LANES(int16_t,  to_int16)
+CONVERT_LANES(int32_t,  to_int32)
+CONVERT_LANES(int64_t,  to_int64)
+CONVERT_LANES(float,    to_float32)
+CONVERT_LANES(double,   to_float64)
+
+#undef CONVERT_LANES
+
+/// Scalar conversion with the semantics of [Tensor::as](), used for tails
+/// and for the pairs without a vector path
+template <typename SrcType, typename DstType>
+struct ConvertScalar
+{
+    static TNT_INL DstType run(SrcType value, Overflow overflow, Rounding rounding) noexcept
+    {
+        if (std::is_floating_point<SrcType>::value && std::is_integral<DstType>::value && rounding == Rounding::Nearest)
+            value = static_cast<SrcType>(std::nearbyint(value));
+
+        return overflow == Overflow::Saturate ? saturate_cast<DstType>(value) : static_cast<DstType>(value);
+    }
+};
+
+/// The vector path taken by a pair of types. simdpp converts every pair of
+/// integers, 32 bit integers to and from floating point, and floats to and
+/// from doubles. Other pairs are built from those steps, except 64 bit
+/// integers to and from floating point, which stay scalar.
+enum class ConversionPath { Copy, Integer, ToFloat, FromFloat, Float, Scalar };
+
+template <typename SrcType, typename DstType>
+struct ConversionPathOf
+{
+    constexpr static ConversionPath value =
+          std::is_same<SrcType, DstType>::value                                   ? ConversionPath::Copy
+        : std::is_integral<SrcType>::value && std::is_integral<DstType>::value    ? ConversionPath::Integer
+        : std::is_floating_point<SrcType>::value
+              && std::is_floating_point<DstType>::value                           ? ConversionPath::Float
+        : sizeof(SrcType) == 8 && std::is_integral<SrcType>::value                ? ConversionPath::Scalar
+        : sizeof(DstType) == 8 && std::is_integral<DstType>::value                ? ConversionPath::Scalar
+        : std::is_integral<SrcType>::value                                        ? ConversionPath::ToFloat
+                                                                                  : ConversionPath::FromFloat;
+};
+
+template <typename SrcType, typename DstType>
+struct ConvertSIMD
+{
+    constexpr static int max(int a, int b) { return a > b ? a : b; }
+
+    /// Enough lanes to fill a full vector of both types, and at least 4 so
+    /// 32 bit intermediates fill a 128 bit register
+    constexpr static int Size = max(max(OptimalSIMDSize<SrcType>::value, OptimalSIMDSize<DstType>::value),
+                                    max(16 / sizeof(SrcType), 16 / sizeof(DstType)));
+
+    using SrcVecType = typename FullSIMDType<SrcType, Size>::VecType;
+    using DstVecType = typename FullSIMDType<DstType, Size>::VecType;
+    using Int32Type  = typename FullSIMDType<int32_t, Size>::VecType;
+    using DoubleType = typename FullSIMDType<double, Size>::VecType;
+
+    template <typename T>
+    static TNT_INL typename FullSIMDType<T, Size>::VecType splat(T value)
+    {
+        return simdpp::load_splat<typename FullSIMDType<T, Size>::VecType>(&value);
+    }
+
+    static TNT_INL DstVecType run(const SrcVecType& value, Overflow overflow, Rounding rounding)
+    {
+        return run(value, overflow, rounding, std::integral_constant<ConversionPath, ConversionPathOf<SrcType, DstType>::value>());
+    }
+
+private:
+    using Path = ConversionPath;
+
+    // Integers clamp in the source type before they are narrowed or change
+    // signedness. The bounds are the intersection of both ranges.
+    static TNT_INL DstVecType run(const SrcVecType& value, Overflow overflow, Rounding,
+                                  std::integral_constant<Path, Path::Integer>)
+    {
+        using SrcLimits = std::numeric_limits<SrcType>;
+        using DstLimits = std::numeric_limits<DstType>;
+
+        if (overflow == Overflow::Wrap)
+            return ConvertLanes<DstType, Size>::convert(value);
+
+        const SrcType low  = (intmax_t) SrcLimits::min() < (intmax_t) DstLimits::min()
+                                 ? static_cast<SrcType>(DstLimits::min()) : SrcLimits::min();
+        const SrcType high = (uintmax_t) SrcLimits::max() > (uintmax_t) DstLimits::max()
+                                 ? static_cast<SrcType>(DstLimits::max()) : SrcLimits::max();
+
+        SrcVecType clamped = simdpp::min(simdpp::max(value, splat(low)), splat(high));
+        return ConvertLanes<DstType, Size>::convert(clamped);
+    }
+
+    // Up to 32 bit integers convert through int32, which is exact. uint32
+    // is biased into the signed range and converted through double.
+    static TNT_INL DstVecType run(const SrcVecType& value, Overflow, Rounding,
+                                  std::integral_constant<Path, Path::ToFloat>)
+    {
+        return to_float(value, std::integral_constant<bool, std::is_same<SrcType, uint32_t>::value>());
+    }
+
+    static TNT_INL DstVecType to_float(const SrcVecType& value, std::false_type)
+    {
+        return ConvertLanes<DstType, Size>::convert(Int32Type(simdpp::to_int32(value)));
+    }
+
+    static TNT_INL DstVecType to_float(const SrcVecType& value, std::true_type)
+    {
+        Int32Type  biased = simdpp::bit_cast<Int32Type>(simdpp::bit_xor(value, splat<uint32_t>(0x80000000u)));
+        DoubleType result = simdpp::add(simdpp::to_float64(biased), splat(2147483648.0));
+
+        return ConvertLanes<DstType, Size>::convert(result);
+    }
+
+    static TNT_INL DstVecType run(const SrcVecType& value, Overflow overflow, Rounding rounding,
+                                  std::integral_constant<Path, Path::FromFloat>)
+    {
+        SrcVecType rounded = rounding == Rounding::Nearest ? round_nearest(value) : value;
+
+        // The largest 32 bit integers are not floats, so floats headed for
+        // 32 bit integers are widened to double first, which is exact
+        return from_floating(rounded, overflow,
+                             std::integral_constant<bool, std::is_same<SrcType, float>::value && sizeof(DstType) == 4>());
+    }
+
+    static TNT_INL DstVecType run(const SrcVecType& value, Overflow, Rounding,
+                                  std::integral_constant<Path, Path::Float>)
+    {
+        return ConvertLanes<DstType, Size>::convert(value);
+    }
+
+    /// Round to nearest, ties to even. Adding and subtracting 2^mantissa
+    /// rounds away the fraction in the current rounding mode. Larger values
+    /// are already integers.
+    static TNT_INL SrcVecType round_nearest(const SrcVecType& value)
+    {
+        const SrcType magic = std::is_same<SrcType, float>::value ? SrcType(8388608.0) : SrcType(4503599627370496.0);
+
+        SrcVecType magnitude = simdpp::abs(value);
+        SrcVecType rounded   = simdpp::sub(simdpp::add(magnitude, splat(magic)), splat(magic));
+        rounded = simdpp::blend(magnitude, rounded, simdpp::cmp_ge(magnitude, splat(magic)));
+
+        // Restore the sign, which also keeps -0.4 as -0
+        SrcVecType sign = simdpp::bit_xor(value, magnitude);
+        return simdpp::bit_or(rounded, sign);
+    }
+
+    static TNT_INL DstVecType from_floating(const SrcVecType& value, Overflow overflow, std::true_type)
+    {
+        return from_floating(DoubleType(simdpp::to_float64(value)), overflow);
+    }
+
+    static TNT_INL DstVecType from_floating(const SrcVecType& value, Overflow overflow, std::false_type)
+    {
+        return from_floating(value, overflow);
+    }
+
+    template <typename FloatVecType>
+    static TNT_INL DstVecType from_floating(const FloatVecType& value, Overflow overflow)
+    {
+        using FloatType = typename FloatVecType::element_type;
+        using DstLimits = std::numeric_limits<DstType>;
+
+        FloatVecType clamped = value;
+        if (overflow == Overflow::Saturate) {
+            const FloatType zero = 0, low = DstLimits::min(), high = DstLimits::max();
+
+            clamped = simdpp::blend(simdpp::load_splat<FloatVecType>(&zero), clamped, simdpp::cmp_neq(value, value));
+            clamped = simdpp::min(simdpp::max(clamped, simdpp::load_splat<FloatVecType>(&low)),
+                                  simdpp::load_splat<FloatVecType>(&high));
+        }
+
+        return to_integer(clamped, std::integral_constant<bool, std::is_same<DstType, uint32_t>::value>());
+    }
+
+    template <typename FloatVecType>
+    static TNT_INL DstVecType to_integer(const FloatVecType& value, std::false_type)
+    {
+        return ConvertLanes<DstType, Size>::convert(Int32Type(simdpp::to_int32(value)));
+    }
+
+    // uint32 is shifted into the int32 range, converted and shifted back.
+    // The fraction is dropped first, truncating after the shift would round
+    // towards the negative bias instead of towards zero.
+    template <typename FloatVecType>
+    static TNT_INL DstVecType to_integer(const FloatVecType& value, std::true_type)
+    {
+        const double bias = 2147483648.0;
+
+        Int32Type shifted = simdpp::to_int32(simdpp::sub(simdpp::trunc(value), simdpp::load_splat<FloatVecType>(&bias)));
+        return simdpp::bit_xor(simdpp::bit_cast<DstVecType>(shifted), splat<uint32_t>(0x80000000u));
+    }
+};
+
+template <typename SrcType, typename DstType, ConversionPath Path = ConversionPathOf<SrcType, DstType>::value>
+struct ConvertTensor
+{
+    using Kernel = ConvertSIMD<SrcType, DstType>;
+
+    constexpr static int Size = Kernel::Size;
+
+    static void eval(const SrcType* src, DstType* dst, int total, Overflow overflow, Rounding rounding) noexcept
+    {
+        int offset = 0;
+        for ( ; offset + Size <= total; offset += Size) {
+            auto block = simdpp::load<typename Kernel::SrcVecType>(src + offset);
+            simdpp::store(dst + offset, Kernel::run(block, overflow, rounding));
+        }
+
+        for ( ; offset < total; ++offset)
+            dst[offset] = ConvertScalar<SrcType, DstType>::run(src[offset], overflow, rounding);
+    }
+};
+
+template <typename SrcType, typename DstType>
+struct ConvertTensor<SrcType, DstType, ConversionPath::Copy>
+{
+    static void eval(const SrcType* src, DstType* dst, int total, Overflow, Rounding) noexcept
+    {
+        memcpy(dst, src, sizeof(DstType) * total);
+    }
+};
+
+template <typename SrcType, typename DstType>
+struct ConvertTensor<SrcType, DstType, ConversionPath::Scalar>
+{
+    static void eval(const SrcType* src, DstType* dst, int total, Overflow overflow, Rounding rounding) noexcept
+    {
+        for (int i = 0; i < total; ++i)
+            dst[i] = ConvertScalar<SrcType, DstType>::run(src[i], overflow, rounding);
+    }
+};
+
+template <typename SrcType, typename DstType>
+struct OptimizedConvert<SrcType, DstType>
+{
+    static void eval(const Tensor<SrcType>& src, Tensor<DstType>& dst, Overflow overflow, Rounding rounding) noexcept
+    {
+        ConvertTensor<SrcType, DstType>::eval(src.data.data, dst.data.data, src.shape.total(), overflow, rounding);
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE("saturate_cast<To>(From)")
+{
+    REQUIRE(saturate_cast<uint8_t>(300)     == 255);
+    REQUIRE(saturate_cast<uint8_t>(-5)      == 0);
+    REQUIRE(saturate_cast<int8_t>(-200)     == -128);
+    REQUIRE(saturate_cast<int8_t>(100)      == 100);
+    REQUIRE(saturate_cast<int16_t>(70000u)  == 32767);
+    REQUIRE(saturate_cast<uint32_t>(-1ll)   == 0u);
+    REQUIRE(saturate_cast<int64_t>(UINT64_MAX) == INT64_MAX);
+    REQUIRE(saturate_cast<uint64_t>(INT64_MIN) == 0u);
+
+    REQUIRE(saturate_cast<uint8_t>(255.9)   == 255);
+    REQUIRE(saturate_cast<uint8_t>(1e10)    == 255);
+    REQUIRE(saturate_cast<int32_t>(-1e20f)  == INT32_MIN);
+    REQUIRE(saturate_cast<int32_t>(-2.7)    == -2);
+    REQUIRE(saturate_cast<int32_t>(std::numeric_limits<double>::quiet_NaN()) == 0);
+
+    REQUIRE(saturate_cast<float>(3)         == 3.f);
+}
+
+namespace
+{
+
+template <typename T>
+Tensor<T> conversion_input(int count)
+{
+    using Limits = std::numeric_limits<T>;
+
+    std::mt19937_64 generator(31415);
+    Tensor<T> tensor(Shape{count});
+
+    for (int i = 0; i < count; ++i) {
+        if (std::is_integral<T>::value) {
+            tensor.data[i] = (T) (generator() >> (generator() % 64));
+        } else {
+            // Magnitudes from 2^-4 to 2^40, with exact halves mixed in
+            const double scale = std::ldexp(1.0, (int) (generator() % 45) - 4);
+            const double value = (double) (generator() % 2000000) / 1000000.0 - 1.0;
+            tensor.data[i] = (T) (i % 5 == 0 ? std::floor(value * 100) + 0.5 : value * scale);
+        }
+    }
+
+    tensor.data[0] = Limits::max();
+    tensor.data[1] = Limits::lowest();
+    tensor.data[2] = 0;
+
+    if (!std::is_integral<T>::value) {
+        tensor.data[3] = Limits::quiet_NaN();
+        tensor.data[4] = Limits::infinity();
+        tensor.data[5] = -Limits::infinity();
+        tensor.data[6] = (T) -2.5;
+        tensor.data[7] = (T) 2.5;
+        tensor.data[8] = (T) -0.5;
+        tensor.data[9] = (T) 4294967295.0;
+    }
+
+    return tensor;
+}
+
+// Wrapped conversions from floating point are only defined for values in
+// the range of the destination
+template <typename Src, typename Dst>
+bool wrap_defined(Src value, Rounding rounding)
+{
+    if (!std::is_floating_point<Src>::value || std::is_floating_point<Dst>::value)
+        return true;
+
+    const long double rounded = rounding == Rounding::Nearest ? std::nearbyint((long double) value)
+                                                              : std::trunc((long double) value);
+
+    return rounded >= (long double) std::numeric_limits<Dst>::min()
+        && rounded <= (long double) std::numeric_limits<Dst>::max();
+}
+
+template <typename Src, typename Dst>
+void check_conversion(const Tensor<Src>& input)
+{
+    const Overflow overflows[] = {Overflow::Wrap, Overflow::Saturate};
+    const Rounding roundings[] = {Rounding::TowardZero, Rounding::Nearest};
+
+    for (Overflow overflow : overflows) {
+        for (Rounding rounding : roundings) {
+            Tensor<Dst> result = input.template as<Dst>(overflow, rounding);
+            REQUIRE(result.shape == input.shape);
+
+            for (int i = 0; i < input.shape.total(); ++i) {
+                const Src value = input.data[i];
+                if (overflow == Overflow::Wrap && (value != value || !wrap_defined<Src, Dst>(value, rounding)))
+                    continue;
+
+                const Dst expected = detail::ConvertScalar<Src, Dst>::run(value, overflow, rounding);
+                if (expected != expected)
+                    REQUIRE(result.data[i] != result.data[i]);
+                else
+                    REQUIRE(result.data[i] == expected);
+            }
+        }
+    }
+}
+
+template <typename Src>
+void check_all_conversions(const Tensor<Src>& input)
+{
+    check_conversion<Src, uint8_t>(input);
+    check_conversion<Src, uint16_t>(input);
+    check_conversion<Src, uint32_t>(input);
+    check_conversion<Src, uint64_t>(input);
+    check_conversion<Src, int8_t>(input);
+    check_conversion<Src, int16_t>(input);
+    check_conversion<Src, int32_t>(input);
+    check_conversion<Src, int64_t>(input);
+    check_conversion<Src, float>(input);
+    check_conversion<Src, double>(input);
+}
+
+} // namespace
+
+TEST_CASE_TEMPLATE("Tensor::as<DstType>(Overflow, Rounding)", T, test_data_types)
+{
+    check_all_conversions(conversion_input<T>(1000));
+    check_all_conversions(conversion_input<T>(37));
+    check_all_conversions(conversion_input<T>(10));
+}
+
+TEST_CASE("Tensor::as<DstType>(Overflow, Rounding) examples")
+{
+    float data[8] = {-1.5f, -0.5f, 0.5f, 1.5f, 2.5f, 254.6f, 300.f, std::numeric_limits<float>::quiet_NaN()};
+
+    Tensor<float> tensor(Shape{2, 4}, AlignedPtr<float>(data, 8));
+
+    uint8_t saturated[8] = {0, 0, 0, 1, 2, 254, 255, 0};
+    uint8_t nearest[8]   = {0, 0, 0, 2, 2, 255, 255, 0};
+    int32_t truncated[4] = {-1, 0, 0, 1};
+    int32_t rounded[4]   = {-2, 0, 0, 2};
+
+    REQUIRE((tensor.as<uint8_t>(Overflow::Saturate) == Tensor<uint8_t>(Shape{2, 4}, AlignedPtr<uint8_t>(saturated, 8))));
+    REQUIRE((tensor.as<uint8_t>(Overflow::Saturate, Rounding::Nearest) == Tensor<uint8_t>(Shape{2, 4}, AlignedPtr<uint8_t>(nearest, 8))));
+
+    Tensor<float> small(Shape{4}, AlignedPtr<float>(data, 4));
+    REQUIRE((small.as<int32_t>() == Tensor<int32_t>(Shape{4}, AlignedPtr<int32_t>(truncated, 4))));
+    REQUIRE((small.as<int32_t>(Overflow::Wrap, Rounding::Nearest) == Tensor<int32_t>(Shape{4}, AlignedPtr<int32_t>(rounded, 4))));
+
+    Tensor<int32_t> wide(Shape{3}, 70000);
+    wide.data[1] = -70000;
+    wide.data[2] = 100;
+
+    int16_t clamped[3] = {32767, -32768, 100};
+    REQUIRE((wide.as<int16_t>(Overflow::Saturate) == Tensor<int16_t>(Shape{3}, AlignedPtr<int16_t>(clamped, 3))));
+    REQUIRE((wide.as<uint8_t>().data[2] == 100));
+}
+
+} // namespace tnt
+
+#endif // TNT_CONVERSION_IMPL_HPP
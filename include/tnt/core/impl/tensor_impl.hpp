@@ -578,11 +578,10 @@ inline Tensor<DataType> Tensor<DataType>::mul(const Tensor<OtherType>& other) co
 // Functions
 
 template <typename DataType> template <typename DstType>
-inline Tensor<DstType> Tensor<DataType>::as() const
+inline Tensor<DstType> Tensor<DataType>::as(Overflow overflow, Rounding rounding) const
 {
     Tensor<DstType> output(this->shape);
-    for (int i = 0; i < this->shape.total(); ++i)
-        output.data[i] = (DstType) this->data[i];
+    detail::OptimizedConvert<DataType, DstType>::eval(*this, output, overflow, rounding);
 
     return output;
 }
@@ -287,7 +287,7 @@ inline TensorView<DataType>::operator DataType()
 template <typename DataType> template <typename OtherType>
 inline TensorView<DataType>& TensorView<DataType>::operator= (const OtherType& _scalar)
 {
-    static_assert(std::is_arithmetic<OtherType>::value,
+    static_assert(IsTensorElement<OtherType>::value,
                    "TensorView operator=() expects a Scalar, Tensor, or TensorView");
 
     const DataType scalar = static_cast<DataType>(_scalar);
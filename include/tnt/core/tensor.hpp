@@ -4,6 +4,8 @@
 #include <tnt/core/export.hpp>
 
 #include <tnt/core/aligned_ptr.hpp>
+#include <tnt/core/complex.hpp>
+#include <tnt/core/conversion.hpp>
 #include <tnt/core/shape.hpp>
 #include <tnt/core/stride.hpp>
 #include <tnt/core/range.hpp>
@@ -19,11 +21,11 @@ namespace tnt
 /// tnt::Tensor
 /// An N-Dimensional tensor class
 ///
-/// \requires Type `Data` shall be arithmetic
+/// \requires Type `Data` shall be arithmetic or a complex floating point type
 template <typename Data>
 class TNT_EXPORT Tensor
 {
-    static_assert(std::is_arithmetic<Data>::value, "Type `Data` must be arithmetic");
+    static_assert(IsTensorElement<Data>::value, "Type `Data` must be arithmetic or complex");
 
 public:
     using DataType          = Data;
@@ -148,7 +150,7 @@ public:
 // Functions
 
     template <typename DstType>
-    Tensor<DstType> as() const;
+    Tensor<DstType> as(Overflow overflow = Overflow::Wrap, Rounding rounding = Rounding::TowardZero) const;
 
     void reshape(const Shape& shape);
 
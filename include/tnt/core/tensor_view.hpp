@@ -2,6 +2,7 @@
 #define TNT_TENSOR_VIEW_HPP
 
 #include <tnt/core/aligned_ptr.hpp>
+#include <tnt/core/complex.hpp>
 #include <tnt/core/shape.hpp>
 #include <tnt/core/stride.hpp>
 #include <tnt/core/range.hpp>
@@ -12,12 +13,12 @@ namespace tnt
 
 /// \brief An iterator over a non-contiguous TensorView
 ///
-/// \requires Type `Data` shall be arithmetic
+/// \requires Type `Data` shall be arithmetic or a complex floating point type
 template <typename Data>
 class TNT_EXPORT TensorViewIterator
 {
-    static_assert(std::is_arithmetic<Data>::value,
-                    "TensorViewIterator requires type `Data` is arithmetic");
+    static_assert(IsTensorElement<Data>::value,
+                    "TensorViewIterator requires type `Data` is arithmetic or complex");
 
 public:
     using DataType = Data;
@@ -51,12 +52,12 @@ public:
 
 /// \brief A non-contiguous view of a [Tensor](*::Tensor)
 ///
-/// \requires Type `Data` shall be arithmetic
+/// \requires Type `Data` shall be arithmetic or a complex floating point type
 template <typename Data>
 class TNT_EXPORT TensorView
 {
-    static_assert(std::is_arithmetic<Data>::value,
-                    "TensorView requires type `Data` is arithmetic");
+    static_assert(IsTensorElement<Data>::value,
+                    "TensorView requires type `Data` is arithmetic or complex");
 
 public:
     using DataType          = Data;
@@ -0,0 +1,6 @@
+#ifndef TNT_IMAGE_HPP
+#define TNT_IMAGE_HPP
+
+#include <tnt/image/impl/jpeg_impl.hpp>
+
+#endif // TNT_IMAGE_HPP
@@ -0,0 +1,1187 @@
+#ifndef TNT_IMAGE_JPEG_IMPL_HPP
+#define TNT_IMAGE_JPEG_IMPL_HPP
+
+#include <tnt/image/jpeg.hpp>
+#include <tnt/linear/impl/discrete_cosine_transform_impl.hpp>
+#include <tnt/utils/parallel.hpp>
+#include <tnt/utils/testing.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+// ----------------------------------------------------------------------------
+// Tables
+
+/// The natural (row major) index of each coefficient in zigzag order
+inline const uint8_t* jpeg_zigzag()
+{
+    static const uint8_t table[64] = {
+         0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+        12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+        35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+        58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+    };
+
+    return table;
+}
+
+/// The example quantization tables of Annex K.1 in natural order, luma
+/// first and chroma second
+inline const uint8_t* jpeg_base_quantization(int table)
+{
+    static const uint8_t tables[2][64] = {
+        { 16,  11,  10,  16,  24,  40,  51,  61,
+          12,  12,  14,  19,  26,  58,  60,  55,
+          14,  13,  16,  24,  40,  57,  69,  56,
+          14,  17,  22,  29,  51,  87,  80,  62,
+          18,  22,  37,  56,  68, 109, 103,  77,
+          24,  35,  55,  64,  81, 104, 113,  92,
+          49,  64,  78,  87, 103, 121, 120, 101,
+          72,  92,  95,  98, 112, 100, 103,  99 },
+        { 17,  18,  24,  47,  99,  99,  99,  99,
+          18,  21,  26,  66,  99,  99,  99,  99,
+          24,  26,  56,  99,  99,  99,  99,  99,
+          47,  66,  99,  99,  99,  99,  99,  99,
+          99,  99,  99,  99,  99,  99,  99,  99,
+          99,  99,  99,  99,  99,  99,  99,  99,
+          99,  99,  99,  99,  99,  99,  99,  99,
+          99,  99,  99,  99,  99,  99,  99,  99 }
+    };
+
+    return tables[table];
+}
+
+/// A Huffman table as stored in a DHT segment, the number of codes of each
+/// length from 1 to 16 followed by the symbols in code order
+struct JPEGHuffmanSpec
+{
+    const uint8_t* counts;
+    const uint8_t* symbols;
+    int num_symbols;
+};
+
+/// The example Huffman tables of Annex K.3. Table 0 is the luma DC table, 1
+/// the luma AC table, 2 the chroma DC table and 3 the chroma AC table.
+inline JPEGHuffmanSpec jpeg_standard_huffman(int table)
+{
+    static const uint8_t dc_luma_counts[16]   = { 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
+    static const uint8_t dc_chroma_counts[16] = { 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0 };
+    static const uint8_t dc_symbols[12]       = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+    static const uint8_t ac_luma_counts[16] = { 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d };
+    static const uint8_t ac_luma_symbols[162] = {
+        0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+        0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+        0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+        0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+        0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+        0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+        0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+        0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+        0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+        0xf9, 0xfa
+    };
+
+    static const uint8_t ac_chroma_counts[16] = { 0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77 };
+    static const uint8_t ac_chroma_symbols[162] = {
+        0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+        0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+        0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+        0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+        0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+        0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+        0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+        0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+        0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+        0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+        0xf9, 0xfa
+    };
+
+    static const JPEGHuffmanSpec specs[4] = {
+        { dc_luma_counts,   dc_symbols,        12 },
+        { ac_luma_counts,   ac_luma_symbols,   162 },
+        { dc_chroma_counts, dc_symbols,        12 },
+        { ac_chroma_counts, ac_chroma_symbols, 162 }
+    };
+
+    return specs[table];
+}
+
+/// Scale a base quantization table to a quality the same way as the IJG
+/// library, 50 leaves the table unchanged and 100 sets every entry to 1
+inline void jpeg_scale_quantization(const uint8_t* base, int quality, uint16_t* table)
+{
+    const int scale = quality < 50 ? 5000 / quality : 200 - 2 * quality;
+    for (int i = 0; i < 64; ++i)
+        table[i] = static_cast<uint16_t>(std::min(std::max((base[i] * scale + 50) / 100, 1), 255));
+}
+
+/// The number of bits needed for the magnitude of a coefficient
+inline int jpeg_category(int value) noexcept
+{
+    unsigned magnitude = static_cast<unsigned>(std::abs(value));
+
+    int bits = 0;
+    for (; magnitude != 0; magnitude >>= 1)
+        ++bits;
+
+    return bits;
+}
+
+// ----------------------------------------------------------------------------
+// Color conversion
+
+/// Fixed point RGB to YCbCr and back with 16 fractional bits and the
+/// coefficients of the JFIF specification. Luma is level shifted by -128 so
+/// every component is centered on 0, ready for the DCT.
+struct JPEGColor
+{
+    template <typename Lanes>
+    static TNT_INL void forward(const int32_t* r, const int32_t* g, const int32_t* b,
+                                int32_t* y, int32_t* cb, int32_t* cr)
+    {
+        using Type = typename Lanes::Type;
+
+        const Type red = Lanes::load(r), green = Lanes::load(g), blue = Lanes::load(b);
+
+        const Type luma = Lanes::add(Lanes::add(Lanes::mul(red, 19595), Lanes::mul(green, 38470)),
+                                     Lanes::add(Lanes::mul(blue, 7471), Lanes::splat(-(128 << 16))));
+        const Type blue_difference = Lanes::sub(Lanes::mul(blue, 32768),
+                                                Lanes::add(Lanes::mul(red, 11059), Lanes::mul(green, 21709)));
+        const Type red_difference = Lanes::sub(Lanes::mul(red, 32768),
+                                               Lanes::add(Lanes::mul(green, 27439), Lanes::mul(blue, 5329)));
+
+        Lanes::store(y, Lanes::descale(luma, 16));
+        Lanes::store(cb, Lanes::descale(blue_difference, 16));
+        Lanes::store(cr, Lanes::descale(red_difference, 16));
+    }
+
+    template <typename Lanes>
+    static TNT_INL void inverse(const int32_t* y, const int32_t* cb, const int32_t* cr,
+                                int32_t* r, int32_t* g, int32_t* b)
+    {
+        using Type = typename Lanes::Type;
+
+        const Type luma = Lanes::add(Lanes::load(y), Lanes::splat(128));
+        const Type blue_difference = Lanes::load(cb), red_difference = Lanes::load(cr);
+
+        const Type green = Lanes::add(Lanes::mul(blue_difference, 22554), Lanes::mul(red_difference, 46802));
+
+        Lanes::store(r, Lanes::add(luma, Lanes::descale(Lanes::mul(red_difference, 91881), 16)));
+        Lanes::store(g, Lanes::sub(luma, Lanes::descale(green, 16)));
+        Lanes::store(b, Lanes::add(luma, Lanes::descale(Lanes::mul(blue_difference, 116130), 16)));
+    }
+
+    /// Convert `length` pixels from planar RGB to planar YCbCr
+    static void forward_row(const int32_t* r, const int32_t* g, const int32_t* b,
+                            int32_t* y, int32_t* cb, int32_t* cr, int length)
+    {
+        int x = 0;
+        for (; x + DCTVector<int32_t>::Width <= length; x += DCTVector<int32_t>::Width)
+            forward<DCTVector<int32_t>>(r + x, g + x, b + x, y + x, cb + x, cr + x);
+
+        for (; x < length; ++x)
+            forward<DCTScalar<int32_t>>(r + x, g + x, b + x, y + x, cb + x, cr + x);
+    }
+
+    /// Convert `length` pixels from planar YCbCr to planar RGB, unclamped
+    static void inverse_row(const int32_t* y, const int32_t* cb, const int32_t* cr,
+                            int32_t* r, int32_t* g, int32_t* b, int length)
+    {
+        int x = 0;
+        for (; x + DCTVector<int32_t>::Width <= length; x += DCTVector<int32_t>::Width)
+            inverse<DCTVector<int32_t>>(y + x, cb + x, cr + x, r + x, g + x, b + x);
+
+        for (; x < length; ++x)
+            inverse<DCTScalar<int32_t>>(y + x, cb + x, cr + x, r + x, g + x, b + x);
+    }
+};
+
+inline uint8_t jpeg_clamp(int32_t value) noexcept
+{
+    return static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+}
+
+// ----------------------------------------------------------------------------
+// Huffman coding
+
+struct JPEGHuffmanEncoder
+{
+    uint16_t code[256];
+    uint8_t size[256];
+
+    explicit JPEGHuffmanEncoder(const JPEGHuffmanSpec& spec)
+    {
+        std::memset(size, 0, sizeof(size));
+
+        int next = 0, k = 0;
+        for (int length = 1; length <= 16; ++length, next <<= 1) {
+            for (int i = 0; i < spec.counts[length - 1]; ++i, ++k, ++next) {
+                code[spec.symbols[k]] = static_cast<uint16_t>(next);
+                size[spec.symbols[k]] = static_cast<uint8_t>(length);
+            }
+        }
+    }
+};
+
+/// Appends bits most significant first, stuffing a zero byte after every
+/// 0xFF so the coded data can not be mistaken for a marker
+class JPEGBitWriter
+{
+public:
+    explicit JPEGBitWriter(std::vector<uint8_t>& output) : output(output), buffer(0), count(0) {}
+
+    void put(uint32_t bits, int length)
+    {
+        buffer = (buffer << length) | bits;
+        count += length;
+
+        for (; count >= 8; count -= 8) {
+            const uint8_t byte = static_cast<uint8_t>(buffer >> (count - 8));
+            output.push_back(byte);
+            if (byte == 0xFF)
+                output.push_back(0);
+        }
+
+        buffer &= (1u << count) - 1;
+    }
+
+    void put(const JPEGHuffmanEncoder& table, int symbol)
+    {
+        put(table.code[symbol], table.size[symbol]);
+    }
+
+    /// Pad the last byte with 1 bits
+    void flush()
+    {
+        if (count > 0)
+            put((1u << (8 - count)) - 1, 8 - count);
+    }
+
+private:
+    std::vector<uint8_t>& output;
+    uint32_t buffer;
+    int count;
+};
+
+/// Decodes codes of up to LookupBits bits with one table lookup and longer
+/// codes by comparing against the largest code of each length
+struct JPEGHuffmanDecoder
+{
+    constexpr static int LookupBits = 9;
+
+    uint16_t lookup[1 << LookupBits]; //< (length << 8) | symbol, or 0 for longer codes
+    int32_t max_code[17];
+    int32_t offset[17];
+    uint8_t symbols[256];
+    bool defined = false;
+
+    /// Returns false if the counts describe more codes than fit in 16 bits
+    bool build(const uint8_t* counts, const uint8_t* values, int num_symbols)
+    {
+        std::memset(lookup, 0, sizeof(lookup));
+        std::copy(values, values + num_symbols, symbols);
+
+        int next = 0, k = 0;
+        for (int length = 1; length <= 16; ++length, next <<= 1) {
+            offset[length] = k - next;
+
+            for (int i = 0; i < counts[length - 1]; ++i, ++k, ++next) {
+                if (next >= (1 << length))
+                    return false;
+
+                if (length <= LookupBits) {
+                    const int shift = LookupBits - length;
+                    std::fill(lookup + (next << shift), lookup + ((next + 1) << shift),
+                              static_cast<uint16_t>((length << 8) | symbols[k]));
+                }
+            }
+
+            max_code[length] = counts[length - 1] ? next - 1 : -1;
+        }
+
+        defined = true;
+        return true;
+    }
+};
+
+/// Reads the bits of one entropy coded segment, which holds no markers. Past
+/// the end of the segment it reads zeros and records the overrun.
+class JPEGBitReader
+{
+public:
+    JPEGBitReader(const uint8_t* begin, const uint8_t* end)
+        : position(begin), end(end), buffer(0), count(0), consumed(0), available(0) {}
+
+    /// The next `length` bits, where `length` is from 1 to 16
+    uint32_t peek(int length)
+    {
+        fill();
+        return static_cast<uint32_t>(buffer >> (count - length)) & ((1u << length) - 1);
+    }
+
+    void skip(int length)
+    {
+        count -= length;
+        consumed += length;
+    }
+
+    /// A coefficient with `length` bits in the sign folded JPEG encoding
+    int receive(int length)
+    {
+        if (length == 0)
+            return 0;
+
+        const int value = static_cast<int>(peek(length));
+        skip(length);
+
+        return value < (1 << (length - 1)) ? value - (1 << length) + 1 : value;
+    }
+
+    int decode(const JPEGHuffmanDecoder& table)
+    {
+        const uint32_t bits = peek(16);
+
+        const int entry = table.lookup[bits >> (16 - JPEGHuffmanDecoder::LookupBits)];
+        if (entry != 0) {
+            skip(entry >> 8);
+            return entry & 0xFF;
+        }
+
+        for (int length = JPEGHuffmanDecoder::LookupBits + 1; length <= 16; ++length) {
+            const int32_t code = static_cast<int32_t>(bits >> (16 - length));
+            if (code <= table.max_code[length]) {
+                skip(length);
+                return table.symbols[table.offset[length] + code];
+            }
+        }
+
+        return -1;
+    }
+
+    bool overrun() const noexcept
+    {
+        return consumed > available;
+    }
+
+private:
+    void fill()
+    {
+        for (; count <= 56; count += 8) {
+            uint8_t byte = 0;
+            if (position < end) {
+                byte = *position;
+                position += byte == 0xFF ? 2 : 1;
+                available += 8;
+            }
+
+            buffer = (buffer << 8) | byte;
+        }
+    }
+
+    const uint8_t* position;
+    const uint8_t* end;
+    uint64_t buffer;
+    int count;
+    long consumed, available;
+};
+
+// ----------------------------------------------------------------------------
+// Encoder
+
+/// Quantize a block of coefficients in natural order and Huffman code it
+inline void jpeg_encode_block(const int32_t* block,
+                              int stride,
+                              const uint16_t* quantization,
+                              int& predictor,
+                              const JPEGHuffmanEncoder& dc,
+                              const JPEGHuffmanEncoder& ac,
+                              JPEGBitWriter& writer)
+{
+    const uint8_t* zigzag = jpeg_zigzag();
+
+    int values[64];
+    for (int k = 0; k < 64; ++k) {
+        const int index = zigzag[k];
+        const int coefficient = block[(index / 8) * stride + index % 8], step = quantization[index];
+
+        values[k] = coefficient < 0 ? -((step / 2 - coefficient) / step) : (coefficient + step / 2) / step;
+        values[k] = std::min(std::max(values[k], -1023), 1023);
+    }
+
+    const int difference = values[0] - predictor;
+    predictor = values[0];
+
+    const int dc_bits = jpeg_category(difference);
+    writer.put(dc, dc_bits);
+    if (dc_bits != 0)
+        writer.put(static_cast<uint32_t>(difference < 0 ? difference - 1 : difference) & ((1u << dc_bits) - 1), dc_bits);
+
+    int run = 0;
+    for (int k = 1; k < 64; ++k) {
+        if (values[k] == 0) {
+            ++run;
+            continue;
+        }
+
+        for (; run >= 16; run -= 16)
+            writer.put(ac, 0xF0);
+
+        const int bits = jpeg_category(values[k]);
+        writer.put(ac, (run << 4) | bits);
+        writer.put(static_cast<uint32_t>(values[k] < 0 ? values[k] - 1 : values[k]) & ((1u << bits) - 1), bits);
+        run = 0;
+    }
+
+    if (run > 0)
+        writer.put(ac, 0x00);
+}
+
+/// Encode one row of MCUs as an entropy coded segment. `sampling` is the
+/// luma sampling factor in both directions, 2 for 4:2:0 and 1 otherwise.
+inline void jpeg_encode_row(const Tensor<uint8_t>& image,
+                            int row,
+                            int sampling,
+                            const uint16_t (*quantization)[64],
+                            const JPEGHuffmanEncoder* dc,
+                            const JPEGHuffmanEncoder* ac,
+                            std::vector<uint8_t>& output)
+{
+    const int height = image.shape[0], width = image.shape[1], channels = image.shape[2];
+    const int mcu_size = 8 * sampling;
+    const int mcus_x = (width + mcu_size - 1) / mcu_size;
+    const int padded_width = mcus_x * mcu_size;
+
+    // Replicate the edge pixels out to whole MCUs and convert to YCbCr
+    Tensor<int32_t> bands[3];
+    for (int c = 0; c < channels; ++c)
+        bands[c] = Tensor<int32_t>(Shape{mcu_size, padded_width});
+
+    std::vector<int32_t> planar(channels * padded_width);
+    for (int y = 0; y < mcu_size; ++y) {
+        const uint8_t* pixels = image.data.data + std::min(row * mcu_size + y, height - 1) * width * channels;
+
+        for (int c = 0; c < channels; ++c) {
+            int32_t* plane = planar.data() + c * padded_width;
+            for (int x = 0; x < padded_width; ++x)
+                plane[x] = pixels[std::min(x, width - 1) * channels + c];
+        }
+
+        if (channels == 1) {
+            int32_t* luma = bands[0].data.data + y * padded_width;
+            for (int x = 0; x < padded_width; ++x)
+                luma[x] = planar[x] - 128;
+        } else {
+            JPEGColor::forward_row(planar.data(), planar.data() + padded_width, planar.data() + 2 * padded_width,
+                                   bands[0].data.data + y * padded_width,
+                                   bands[1].data.data + y * padded_width,
+                                   bands[2].data.data + y * padded_width,
+                                   padded_width);
+        }
+    }
+
+    // Average 2x2 blocks of chroma, alternating the rounding bias like libjpeg
+    if (sampling == 2) {
+        for (int c = 1; c < channels; ++c) {
+            Tensor<int32_t> half(Shape{mcu_size / 2, padded_width / 2});
+
+            for (int y = 0; y < mcu_size / 2; ++y) {
+                const int32_t* top = bands[c].data.data + 2 * y * padded_width;
+                const int32_t* bottom = top + padded_width;
+                int32_t* out = half.data.data + y * (padded_width / 2);
+
+                for (int x = 0; x < padded_width / 2; ++x)
+                    out[x] = (top[2 * x] + top[2 * x + 1] + bottom[2 * x] + bottom[2 * x + 1] + 1 + (x & 1)) >> 2;
+            }
+
+            bands[c] = std::move(half);
+        }
+    }
+
+    for (int c = 0; c < channels; ++c)
+        bands[c] = dct(bands[c]);
+
+    JPEGBitWriter writer(output);
+    int predictors[3] = {0, 0, 0};
+
+    for (int mcu = 0; mcu < mcus_x; ++mcu) {
+        for (int c = 0; c < channels; ++c) {
+            const int blocks = c == 0 ? sampling : 1;
+            const int stride = bands[c].shape[1];
+            const int table = c == 0 ? 0 : 1;
+
+            for (int v = 0; v < blocks; ++v)
+                for (int h = 0; h < blocks; ++h)
+                    jpeg_encode_block(bands[c].data.data + v * 8 * stride + (mcu * blocks + h) * 8,
+                                      stride, quantization[table], predictors[c], dc[table], ac[table], writer);
+        }
+    }
+
+    writer.flush();
+}
+
+inline void jpeg_put_marker(std::vector<uint8_t>& output, uint8_t marker, int length)
+{
+    output.push_back(0xFF);
+    output.push_back(marker);
+    output.push_back(static_cast<uint8_t>(length >> 8));
+    output.push_back(static_cast<uint8_t>(length & 0xFF));
+}
+
+inline std::vector<uint8_t> OptimizedJPEGEncoder::eval(const Tensor<uint8_t>& image,
+                                                       int quality,
+                                                       bool subsample,
+                                                       int num_threads)
+{
+    const int height = image.shape[0], width = image.shape[1], channels = image.shape[2];
+    const int num_tables = channels == 3 ? 2 : 1;
+    const int sampling = channels == 3 && subsample ? 2 : 1;
+    const int mcus_x = (width + 8 * sampling - 1) / (8 * sampling);
+    const int mcus_y = (height + 8 * sampling - 1) / (8 * sampling);
+
+    uint16_t quantization[2][64];
+    for (int t = 0; t < num_tables; ++t)
+        jpeg_scale_quantization(jpeg_base_quantization(t), quality, quantization[t]);
+
+    const JPEGHuffmanEncoder dc[2] = { JPEGHuffmanEncoder(jpeg_standard_huffman(0)),
+                                       JPEGHuffmanEncoder(jpeg_standard_huffman(2)) };
+    const JPEGHuffmanEncoder ac[2] = { JPEGHuffmanEncoder(jpeg_standard_huffman(1)),
+                                       JPEGHuffmanEncoder(jpeg_standard_huffman(3)) };
+
+    // Each row of MCUs follows a restart marker, so the rows are independent
+    std::vector<std::vector<uint8_t>> rows(mcus_y);
+    parallel_for(mcus_y, num_threads, [&](int row) {
+        jpeg_encode_row(image, row, sampling, quantization, dc, ac, rows[row]);
+    });
+
+    std::vector<uint8_t> output = { 0xFF, 0xD8 };
+
+    // JFIF 1.01 without a thumbnail
+    const uint8_t jfif[14] = { 'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0 };
+    jpeg_put_marker(output, 0xE0, 16);
+    output.insert(output.end(), jfif, jfif + 14);
+
+    const uint8_t* zigzag = jpeg_zigzag();
+    jpeg_put_marker(output, 0xDB, 2 + 65 * num_tables);
+    for (int t = 0; t < num_tables; ++t) {
+        output.push_back(static_cast<uint8_t>(t));
+        for (int k = 0; k < 64; ++k)
+            output.push_back(static_cast<uint8_t>(quantization[t][zigzag[k]]));
+    }
+
+    jpeg_put_marker(output, 0xC0, 8 + 3 * channels);
+    const uint8_t frame[5] = { 8, uint8_t(height >> 8), uint8_t(height & 0xFF), uint8_t(width >> 8), uint8_t(width & 0xFF) };
+    output.insert(output.end(), frame, frame + 5);
+    output.push_back(static_cast<uint8_t>(channels));
+    for (int c = 0; c < channels; ++c) {
+        output.push_back(static_cast<uint8_t>(c + 1));
+        output.push_back(static_cast<uint8_t>(c == 0 ? (sampling << 4) | sampling : 0x11));
+        output.push_back(static_cast<uint8_t>(c == 0 ? 0 : 1));
+    }
+
+    int huffman_length = 2;
+    for (int t = 0; t < 2 * num_tables; ++t)
+        huffman_length += 17 + jpeg_standard_huffman(t).num_symbols;
+
+    jpeg_put_marker(output, 0xC4, huffman_length);
+    for (int t = 0; t < 2 * num_tables; ++t) {
+        const JPEGHuffmanSpec spec = jpeg_standard_huffman(t);
+        output.push_back(static_cast<uint8_t>(((t % 2) << 4) | (t / 2)));
+        output.insert(output.end(), spec.counts, spec.counts + 16);
+        output.insert(output.end(), spec.symbols, spec.symbols + spec.num_symbols);
+    }
+
+    jpeg_put_marker(output, 0xDD, 4);
+    output.push_back(static_cast<uint8_t>(mcus_x >> 8));
+    output.push_back(static_cast<uint8_t>(mcus_x & 0xFF));
+
+    jpeg_put_marker(output, 0xDA, 6 + 2 * channels);
+    output.push_back(static_cast<uint8_t>(channels));
+    for (int c = 0; c < channels; ++c) {
+        output.push_back(static_cast<uint8_t>(c + 1));
+        output.push_back(static_cast<uint8_t>(c == 0 ? 0x00 : 0x11));
+    }
+    output.push_back(0);
+    output.push_back(63);
+    output.push_back(0);
+
+    for (int row = 0; row < mcus_y; ++row) {
+        if (row > 0) {
+            output.push_back(0xFF);
+            output.push_back(static_cast<uint8_t>(0xD0 + (row - 1) % 8));
+        }
+
+        output.insert(output.end(), rows[row].begin(), rows[row].end());
+    }
+
+    output.push_back(0xFF);
+    output.push_back(0xD9);
+
+    return output;
+}
+
+// ----------------------------------------------------------------------------
+// Decoder
+
+struct JPEGComponent
+{
+    int id, h, v, quantization, dc, ac;
+    int blocks_w, blocks_h;
+    Tensor<int32_t> coefficients; //< Dequantized coefficients of every block in natural order
+};
+
+/// Reads marker segments and throws on truncated data
+class JPEGReader
+{
+public:
+    JPEGReader(const uint8_t* data, std::size_t size) : data(data), size(size), position(0) {}
+
+    int byte()
+    {
+        check(1);
+        return data[position++];
+    }
+
+    int word()
+    {
+        check(2);
+        position += 2;
+        return (data[position - 2] << 8) | data[position - 1];
+    }
+
+    void skip(std::size_t length)
+    {
+        check(length);
+        position += length;
+    }
+
+    static void fail(const char* message)
+    {
+        throw InvalidParameterException("tnt::decode_jpeg()", __FILE__, __LINE__, message);
+    }
+
+    static void unsupported(const char* message)
+    {
+        throw FeatureNotSupportedException("tnt::decode_jpeg()", __FILE__, __LINE__, message);
+    }
+
+    const uint8_t* data;
+    std::size_t size, position;
+
+private:
+    void check(std::size_t length) const
+    {
+        if (size - position < length)
+            fail("The JPEG data is truncated");
+    }
+};
+
+/// Decode the MCUs of one entropy coded segment into the coefficient planes.
+/// Returns false for corrupt data instead of throwing, since it runs on
+/// worker threads.
+inline bool jpeg_decode_segment(const uint8_t* begin,
+                                const uint8_t* end,
+                                int first_mcu,
+                                int last_mcu,
+                                int mcus_x,
+                                std::vector<JPEGComponent>& components,
+                                const uint16_t (*quantization)[64],
+                                const JPEGHuffmanDecoder* dc,
+                                const JPEGHuffmanDecoder* ac)
+{
+    const uint8_t* zigzag = jpeg_zigzag();
+
+    JPEGBitReader reader(begin, end);
+    int predictors[3] = {0, 0, 0};
+
+    for (int mcu = first_mcu; mcu < last_mcu; ++mcu) {
+        const int mcu_x = mcu % mcus_x, mcu_y = mcu / mcus_x;
+
+        for (std::size_t c = 0; c < components.size(); ++c) {
+            JPEGComponent& component = components[c];
+            const uint16_t* steps = quantization[component.quantization];
+            const int stride = component.blocks_w * 8;
+
+            for (int v = 0; v < component.v; ++v) {
+                for (int h = 0; h < component.h; ++h) {
+                    int32_t* block = component.coefficients.data.data
+                                   + (mcu_y * component.v + v) * 8 * stride + (mcu_x * component.h + h) * 8;
+
+                    const int dc_bits = reader.decode(dc[component.dc]);
+                    if (dc_bits < 0 || dc_bits > 11)
+                        return false;
+
+                    predictors[c] += reader.receive(dc_bits);
+                    block[0] = predictors[c] * steps[0];
+
+                    for (int k = 1; k < 64; ++k) {
+                        const int symbol = reader.decode(ac[component.ac]);
+                        if (symbol < 0)
+                            return false;
+
+                        const int run = symbol >> 4, bits = symbol & 15;
+                        if (bits == 0) {
+                            if (run != 15)
+                                break;
+
+                            k += 15;
+                            continue;
+                        }
+
+                        k += run;
+                        if (k > 63)
+                            return false;
+
+                        const int index = zigzag[k];
+                        block[(index / 8) * stride + index % 8] = reader.receive(bits) * steps[index];
+                    }
+                }
+            }
+        }
+    }
+
+    return !reader.overrun();
+}
+
+/// Inverse transform, upsample and color convert one row of MCUs
+inline void jpeg_reconstruct_row(const std::vector<JPEGComponent>& components,
+                                 int row,
+                                 int h_max,
+                                 int v_max,
+                                 Tensor<uint8_t>& image)
+{
+    const int height = image.shape[0], width = image.shape[1], channels = image.shape[2];
+    const int mcu_height = 8 * v_max;
+
+    Tensor<int32_t> samples[3];
+    for (int c = 0; c < channels; ++c) {
+        const JPEGComponent& component = components[c];
+        const int band_rows = component.v * 8, stride = component.blocks_w * 8;
+
+        Tensor<int32_t> band(Shape{band_rows, stride});
+        std::copy(component.coefficients.data.data + row * band_rows * stride,
+                  component.coefficients.data.data + (row + 1) * band_rows * stride,
+                  band.data.data);
+
+        samples[c] = idct(band);
+    }
+
+    std::vector<int32_t> planar(6 * width);
+    int32_t* ycc = planar.data();
+    int32_t* rgb = planar.data() + 3 * width;
+
+    const int last = std::min(height, (row + 1) * mcu_height);
+    for (int y = row * mcu_height; y < last; ++y) {
+        // Clamp the samples to 8 bits before color conversion, as the
+        // standard requires, and replicate each subsampled chroma sample over
+        // the pixels it covers
+        for (int c = 0; c < channels; ++c) {
+            const JPEGComponent& component = components[c];
+            const int32_t* source = samples[c].data.data
+                                  + ((y - row * mcu_height) * component.v / v_max) * samples[c].shape[1];
+            int32_t* plane = ycc + c * width;
+
+            for (int x = 0; x < width; ++x)
+                plane[x] = std::min(std::max(source[x * component.h / h_max], -128), 127);
+        }
+
+        uint8_t* pixels = image.data.data + y * width * channels;
+        if (channels == 1) {
+            for (int x = 0; x < width; ++x)
+                pixels[x] = jpeg_clamp(ycc[x] + 128);
+        } else {
+            JPEGColor::inverse_row(ycc, ycc + width, ycc + 2 * width, rgb, rgb + width, rgb + 2 * width, width);
+
+            for (int x = 0; x < width; ++x) {
+                pixels[3 * x + 0] = jpeg_clamp(rgb[x]);
+                pixels[3 * x + 1] = jpeg_clamp(rgb[width + x]);
+                pixels[3 * x + 2] = jpeg_clamp(rgb[2 * width + x]);
+            }
+        }
+    }
+}
+
+inline Tensor<uint8_t> OptimizedJPEGDecoder::eval(const uint8_t* data, std::size_t size, int num_threads)
+{
+    JPEGReader reader(data, size);
+
+    if (reader.byte() != 0xFF || reader.byte() != 0xD8)
+        JPEGReader::fail("The data is not a JPEG file");
+
+    uint16_t quantization[4][64];
+    bool quantization_defined[4] = {false, false, false, false};
+    JPEGHuffmanDecoder dc[4], ac[4];
+
+    std::vector<JPEGComponent> components;
+    int height = 0, width = 0, restart_interval = 0;
+    bool scanned = false;
+
+    const uint8_t* zigzag = jpeg_zigzag();
+
+    for (;;) {
+        if (reader.byte() != 0xFF)
+            JPEGReader::fail("Expected a JPEG marker");
+
+        int marker = reader.byte();
+        while (marker == 0xFF)
+            marker = reader.byte();
+
+        if (marker == 0xD9) {
+            if (!scanned)
+                JPEGReader::fail("The JPEG file has no image data");
+            break;
+        }
+
+        if (marker == 0xD8 || marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7))
+            JPEGReader::fail("Unexpected JPEG marker");
+
+        const int length = reader.word();
+        if (length < 2)
+            JPEGReader::fail("Invalid JPEG segment length");
+        const std::size_t segment_end = reader.position + length - 2;
+
+        if (marker == 0xC0 || marker == 0xC1) {
+            if (!components.empty())
+                JPEGReader::fail("The JPEG file has more than one frame");
+
+            if (reader.byte() != 8)
+                JPEGReader::unsupported("Only 8 bit JPEG samples are supported");
+
+            height = reader.word();
+            width = reader.word();
+            if (height == 0 || width == 0)
+                JPEGReader::unsupported("JPEG files that define their height after the scan are not supported");
+
+            const int num_components = reader.byte();
+            if (num_components != 1 && num_components != 3)
+                JPEGReader::unsupported("Only gray and YCbCr JPEG files are supported");
+
+            for (int c = 0; c < num_components; ++c) {
+                JPEGComponent component;
+                component.id = reader.byte();
+
+                const int sampling = reader.byte();
+                component.h = num_components == 1 ? 1 : sampling >> 4;
+                component.v = num_components == 1 ? 1 : sampling & 15;
+                component.quantization = reader.byte();
+
+                if (component.h < 1 || component.h > 4 || component.v < 1 || component.v > 4 || component.quantization > 3)
+                    JPEGReader::fail("Invalid JPEG component");
+
+                components.push_back(std::move(component));
+            }
+        } else if (marker == 0xC4) {
+            while (reader.position < segment_end) {
+                const int table = reader.byte();
+                if ((table >> 4) > 1 || (table & 15) > 3)
+                    JPEGReader::fail("Invalid JPEG Huffman table");
+
+                uint8_t counts[16];
+                int num_symbols = 0;
+                for (int i = 0; i < 16; ++i)
+                    num_symbols += counts[i] = static_cast<uint8_t>(reader.byte());
+
+                if (num_symbols > 256)
+                    JPEGReader::fail("Invalid JPEG Huffman table");
+
+                reader.skip(num_symbols);
+                JPEGHuffmanDecoder& decoder = (table >> 4) == 0 ? dc[table & 15] : ac[table & 15];
+                if (!decoder.build(counts, reader.data + reader.position - num_symbols, num_symbols))
+                    JPEGReader::fail("Invalid JPEG Huffman table");
+            }
+        } else if (marker == 0xDB) {
+            while (reader.position < segment_end) {
+                const int table = reader.byte();
+                if ((table >> 4) > 1 || (table & 15) > 3)
+                    JPEGReader::fail("Invalid JPEG quantization table");
+
+                for (int k = 0; k < 64; ++k)
+                    quantization[table & 15][zigzag[k]] = static_cast<uint16_t>((table >> 4) ? reader.word() : reader.byte());
+
+                quantization_defined[table & 15] = true;
+            }
+        } else if (marker == 0xDD) {
+            restart_interval = reader.word();
+        } else if (marker == 0xDA) {
+            if (components.empty())
+                JPEGReader::fail("The JPEG scan precedes the frame header");
+            if (scanned)
+                JPEGReader::unsupported("JPEG files with more than one scan are not supported");
+
+            const int num_scan_components = reader.byte();
+            if (num_scan_components != static_cast<int>(components.size()))
+                JPEGReader::unsupported("JPEG scans that do not include every component are not supported");
+
+            // Order the components as they are coded in the scan
+            std::vector<JPEGComponent> ordered;
+            for (int c = 0; c < num_scan_components; ++c) {
+                const int id = reader.byte(), tables = reader.byte();
+
+                auto match = std::find_if(components.begin(), components.end(),
+                                          [id](const JPEGComponent& component) { return component.id == id; });
+                if (match == components.end())
+                    JPEGReader::fail("The JPEG scan refers to an unknown component");
+
+                match->dc = tables >> 4;
+                match->ac = tables & 15;
+                if (match->dc > 3 || match->ac > 3 || !dc[match->dc].defined || !ac[match->ac].defined
+                    || !quantization_defined[match->quantization])
+                    JPEGReader::fail("The JPEG scan refers to an undefined table");
+
+                ordered.push_back(*match);
+            }
+
+            reader.skip(3);
+            if (reader.position != segment_end)
+                JPEGReader::fail("Invalid JPEG scan header");
+
+            // The color conversion expects Y, Cb, Cr in frame order, so only
+            // the coding order changes and the output order is restored below
+            std::vector<int> frame_order(components.size());
+            for (std::size_t c = 0; c < components.size(); ++c)
+                frame_order[c] = static_cast<int>(std::find_if(ordered.begin(), ordered.end(),
+                                 [&](const JPEGComponent& component) { return component.id == components[c].id; })
+                                 - ordered.begin());
+            components = std::move(ordered);
+
+            int h_max = 1, v_max = 1, blocks_per_mcu = 0;
+            for (const JPEGComponent& component : components) {
+                h_max = std::max(h_max, component.h);
+                v_max = std::max(v_max, component.v);
+                blocks_per_mcu += component.h * component.v;
+            }
+
+            if (blocks_per_mcu > 10)
+                JPEGReader::fail("The JPEG sampling factors are invalid");
+
+            const int mcus_x = (width + 8 * h_max - 1) / (8 * h_max);
+            const int mcus_y = (height + 8 * v_max - 1) / (8 * v_max);
+            const int num_mcus = mcus_x * mcus_y;
+
+            for (JPEGComponent& component : components) {
+                component.blocks_w = mcus_x * component.h;
+                component.blocks_h = mcus_y * component.v;
+                component.coefficients = Tensor<int32_t>(Shape{component.blocks_h * 8, component.blocks_w * 8}, 0);
+            }
+
+            // Split the entropy coded data at the restart markers
+            std::vector<const uint8_t*> segments(1, data + reader.position);
+            std::size_t position = reader.position;
+            for (;;) {
+                if (position + 1 >= size)
+                    JPEGReader::fail("The JPEG data is truncated");
+
+                if (data[position] != 0xFF || data[position + 1] == 0x00) {
+                    position += data[position] == 0xFF ? 2 : 1;
+                    continue;
+                }
+
+                std::size_t next = position + 1;
+                while (next < size && data[next] == 0xFF)
+                    ++next;
+                if (next >= size)
+                    JPEGReader::fail("The JPEG data is truncated");
+
+                if (data[next] < 0xD0 || data[next] > 0xD7)
+                    break;
+
+                segments.push_back(data + position);
+                segments.push_back(data + next + 1);
+                position = next + 1;
+            }
+            segments.push_back(data + position);
+            reader.position = position;
+
+            const int num_segments = static_cast<int>(segments.size() / 2);
+            const int mcus_per_segment = restart_interval > 0 ? restart_interval : num_mcus;
+            if (num_segments != (num_mcus + mcus_per_segment - 1) / mcus_per_segment)
+                JPEGReader::fail("The JPEG restart markers do not match the restart interval");
+
+            std::vector<char> failed(num_segments, 0);
+            parallel_for(num_segments, num_threads, [&](int s) {
+                failed[s] = !jpeg_decode_segment(segments[2 * s], segments[2 * s + 1],
+                                                 s * mcus_per_segment,
+                                                 std::min(num_mcus, (s + 1) * mcus_per_segment),
+                                                 mcus_x, components, quantization, dc, ac);
+            });
+
+            if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+                JPEGReader::fail("The JPEG entropy coded data is corrupt");
+
+            std::vector<JPEGComponent> restored;
+            for (int index : frame_order)
+                restored.push_back(std::move(components[index]));
+            components = std::move(restored);
+
+            scanned = true;
+            continue;
+        } else if ((marker >= 0xC2 && marker <= 0xCF) || marker == 0xDE || marker == 0xDF) {
+            JPEGReader::unsupported("Only baseline and extended sequential Huffman coded JPEG files are supported");
+        }
+
+        // Skip APPn, COM and any other segment we have no use for
+        if (segment_end < reader.position)
+            JPEGReader::fail("Invalid JPEG segment length");
+        reader.skip(segment_end - reader.position);
+    }
+
+    int h_max = 1, v_max = 1;
+    for (const JPEGComponent& component : components) {
+        h_max = std::max(h_max, component.h);
+        v_max = std::max(v_max, component.v);
+    }
+
+    const int channels = static_cast<int>(components.size());
+    const int mcus_y = (height + 8 * v_max - 1) / (8 * v_max);
+
+    Tensor<uint8_t> image(Shape{height, width, channels});
+    parallel_for(mcus_y, num_threads, [&](int row) {
+        jpeg_reconstruct_row(components, row, h_max, v_max, image);
+    });
+
+    return image;
+}
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit Tests
+
+namespace
+{
+
+/// Smooth color ramps, the kind of content JPEG is designed for
+inline Tensor<uint8_t> jpeg_test_image(int height, int width, int channels)
+{
+    Tensor<uint8_t> image(Shape{height, width, channels});
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int rgb[3] = { x * 255 / (width - 1),
+                                 y * 255 / (height - 1),
+                                 255 - (x + y) * 255 / (width + height - 2) };
+
+            for (int c = 0; c < channels; ++c)
+                image.data[(y * width + x) * channels + c] = static_cast<uint8_t>(rgb[c]);
+        }
+    }
+
+    return image;
+}
+
+inline double jpeg_mean_error(const Tensor<uint8_t>& a, const Tensor<uint8_t>& b)
+{
+    double error = 0;
+    for (int i = 0; i < a.shape.total(); ++i)
+        error += std::abs(int(a.data[i]) - int(b.data[i]));
+
+    return error / a.shape.total();
+}
+
+} // namespace
+
+TEST_CASE("encode_jpeg(const Tensor<uint8_t>&, int, bool, int)")
+{
+    const Tensor<uint8_t> color = jpeg_test_image(45, 61, 3);
+
+    std::vector<uint8_t> bytes = encode_jpeg(color, 90, true, 1);
+    REQUIRE(bytes.size() > 4);
+    REQUIRE(((bytes[0] == 0xFF) && (bytes[1] == 0xD8)));
+    REQUIRE(((bytes[bytes.size() - 2] == 0xFF) && (bytes[bytes.size() - 1] == 0xD9)));
+
+    Tensor<uint8_t> decoded = decode_jpeg(bytes, 1);
+    REQUIRE((decoded.shape == color.shape));
+    REQUIRE(jpeg_mean_error(decoded, color) < 3.0);
+
+    // The coded rows are independent, so threading changes nothing
+    REQUIRE((encode_jpeg(color, 90, true, 3) == bytes));
+    REQUIRE((decode_jpeg(bytes, 3) == decoded));
+
+    // 4:4:4 at full quality is close to lossless
+    decoded = decode_jpeg(encode_jpeg(color, 100, false));
+    REQUIRE(jpeg_mean_error(decoded, color) < 1.0);
+
+    const Tensor<uint8_t> gray = jpeg_test_image(30, 17, 1);
+    decoded = decode_jpeg(encode_jpeg(gray, 75));
+    REQUIRE((decoded.shape == gray.shape));
+    REQUIRE(jpeg_mean_error(decoded, gray) < 2.0);
+
+    // Lower quality gives smaller files
+    REQUIRE(encode_jpeg(color, 20).size() < encode_jpeg(color, 80).size());
+
+    REQUIRE_THROWS(encode_jpeg(Tensor<uint8_t>(Shape{8, 8})));
+    REQUIRE_THROWS(encode_jpeg(Tensor<uint8_t>(Shape{8, 8, 2})));
+    REQUIRE_THROWS(encode_jpeg(color, 0));
+    REQUIRE_THROWS(encode_jpeg(color, 101));
+}
+
+TEST_CASE("decode_jpeg(const std::vector<uint8_t>&, int)")
+{
+    // A 16x16 4:2:0 file from libjpeg with optimized Huffman tables and no
+    // JFIF header or restart markers
+    const std::vector<uint8_t> bytes = {
+        0xff, 0xd8, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x03, 0x02, 0x02, 0x03, 0x02, 0x02, 0x03, 0x03, 0x03,
+        0x03, 0x04, 0x03, 0x03, 0x04, 0x05, 0x08, 0x05, 0x05, 0x04, 0x04, 0x05, 0x0a, 0x07, 0x07, 0x06,
+        0x08, 0x0c, 0x0a, 0x0c, 0x0c, 0x0b, 0x0a, 0x0b, 0x0b, 0x0d, 0x0e, 0x12, 0x10, 0x0d, 0x0e, 0x11,
+        0x0e, 0x0b, 0x0b, 0x10, 0x16, 0x10, 0x11, 0x13, 0x14, 0x15, 0x15, 0x15, 0x0c, 0x0f, 0x17, 0x18,
+        0x16, 0x14, 0x18, 0x12, 0x14, 0x15, 0x14, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x03, 0x04, 0x04, 0x05,
+        0x04, 0x05, 0x09, 0x05, 0x05, 0x09, 0x14, 0x0d, 0x0b, 0x0d, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+        0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+        0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+        0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0xff, 0xc0, 0x00, 0x11,
+        0x08, 0x00, 0x10, 0x00, 0x10, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xff,
+        0xc4, 0x00, 0x15, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x07, 0x08, 0xff, 0xc4, 0x00, 0x1b, 0x10, 0x00, 0x01, 0x05, 0x01, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x07, 0x23, 0x32,
+        0xa1, 0x02, 0x21, 0xff, 0xc4, 0x00, 0x14, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xc4, 0x00, 0x1c, 0x11, 0x00, 0x02,
+        0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07,
+        0x06, 0x22, 0x23, 0x32, 0x33, 0x51, 0xa1, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11,
+        0x03, 0x11, 0x00, 0x3f, 0x00, 0x9c, 0x93, 0x2d, 0x6d, 0x61, 0xc1, 0x5d, 0x32, 0xd6, 0xd6, 0x1c,
+        0x1a, 0x53, 0x2d, 0x6f, 0x9c, 0xc3, 0x82, 0xc2, 0x65, 0xad, 0xac, 0x38, 0x18, 0x2d, 0xab, 0xea,
+        0x74, 0x2a, 0xe3, 0xbc, 0x73, 0xe8, 0xff, 0xd9
+    };
+
+    // The first row as decoded by libjpeg with its integer IDCT and without
+    // fancy upsampling. Rounding in the transforms differs by a few levels.
+    const int expected[48] = {
+          1,   4, 241,   4,   7, 244,  37,   0, 227,  42,   5, 232,  70,   3, 207,  74,
+          7, 211, 103,   5, 190, 106,   8, 193, 141,   0, 174, 144,   3, 177, 171,   2,
+        157, 175,   6, 161, 204,   3, 135, 209,   8, 140, 241,   1, 124, 244,   4, 127
+    };
+
+    Tensor<uint8_t> decoded = decode_jpeg(bytes);
+    REQUIRE((decoded.shape == Shape{16, 16, 3}));
+    for (int i = 0; i < 48; ++i)
+        REQUIRE(std::abs(decoded.data[i] - expected[i]) <= 3);
+
+    REQUIRE(jpeg_mean_error(decoded, jpeg_test_image(16, 16, 3)) < 8.0);
+
+    // Truncated, garbage and corrupt data
+    REQUIRE_THROWS(decode_jpeg(std::vector<uint8_t>()));
+    REQUIRE_THROWS(decode_jpeg(std::vector<uint8_t>(bytes.begin(), bytes.begin() + 200)));
+    REQUIRE_THROWS(decode_jpeg(std::vector<uint8_t>(bytes.begin(), bytes.end() - 20)));
+    REQUIRE_THROWS(decode_jpeg(std::vector<uint8_t>(64, 0x5A)));
+
+    std::vector<uint8_t> corrupt = bytes;
+    std::fill(corrupt.end() - 30, corrupt.end() - 2, 0xFE);
+    REQUIRE_THROWS(decode_jpeg(corrupt));
+
+    // Progressive files are recognized but not supported
+    std::vector<uint8_t> progressive = bytes;
+    const uint8_t frame[2] = { 0xFF, 0xC0 };
+    std::search(progressive.begin(), progressive.end(), frame, frame + 2)[1] = 0xC2;
+    REQUIRE_THROWS_AS(decode_jpeg(progressive), FeatureNotSupportedException);
+}
+
+} // namespace tnt
+
+#endif // TNT_IMAGE_JPEG_IMPL_HPP
@@ -0,0 +1,92 @@
+#ifndef TNT_IMAGE_JPEG_HPP
+#define TNT_IMAGE_JPEG_HPP
+
+#include <tnt/core/tensor.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+struct OptimizedJPEGEncoder
+{
+    static std::vector<uint8_t> eval(const Tensor<uint8_t>& image, int quality, bool subsample, int num_threads);
+};
+
+struct OptimizedJPEGDecoder
+{
+    static Tensor<uint8_t> eval(const uint8_t* data, std::size_t size, int num_threads);
+};
+
+} // namespace detail
+
+/// \brief Compress an image as a baseline JPEG
+///
+/// \param image An image with shape `H x W x 3` holding RGB pixels, or
+/// `H x W x 1` holding gray pixels
+/// \param quality The quality from 1 to 100, which scales the example
+/// quantization tables of the standard the same way as the IJG library
+/// \param subsample If true the chroma of color images is sampled at half
+/// the resolution in both directions (4:2:0), otherwise it is kept at full
+/// resolution (4:4:4)
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The bytes of a JFIF file
+/// \notes Every row of MCUs (the 8x8 or 16x16 blocks of pixels that are coded
+/// together) ends with a restart marker. The rows are independent, so each
+/// one is color converted, transformed with [dct](), quantized and Huffman
+/// coded on its own thread, and the coded rows are concatenated. The output
+/// does not depend on the number of threads. The standard's example Huffman
+/// tables are used. This function asserts that the image and quality are
+/// valid and will throw an exception if they are not.
+inline std::vector<uint8_t> encode_jpeg(const Tensor<uint8_t>& image,
+                                        int quality = 90,
+                                        bool subsample = true,
+                                        int num_threads = 0)
+{
+    TNT_ASSERT(image.shape.num_axes() == 3 && (image.shape[2] == 1 || image.shape[2] == 3),
+               InvalidParameterException("tnt::encode_jpeg()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "JPEG encoding requires an H x W x 1 or H x W x 3 image"))
+
+    TNT_ASSERT(image.shape[0] <= 65535 && image.shape[1] <= 65535,
+               InvalidParameterException("tnt::encode_jpeg()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "JPEG images are limited to 65535 rows and columns"))
+
+    TNT_ASSERT(quality >= 1 && quality <= 100,
+               InvalidParameterException("tnt::encode_jpeg()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "JPEG quality must be between 1 and 100"))
+
+    return detail::OptimizedJPEGEncoder::eval(image, quality, subsample, num_threads);
+}
+
+/// \brief Decompress a baseline JPEG
+///
+/// \param data The bytes of a JPEG file
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns An image with shape `H x W x 3` holding RGB pixels for color
+/// files, or `H x W x 1` for gray files
+/// \notes Supports baseline and extended sequential Huffman coded files with
+/// 8 bit samples, one (gray) or three (YCbCr) components, any sampling
+/// factors and restart markers. The entropy coded segments between restart
+/// markers are decoded in parallel, then rows of MCUs are inverse
+/// transformed with [idct](), upsampled and color converted in parallel.
+/// Chroma is upsampled by replication. Throws an InvalidParameterException
+/// for malformed data and a FeatureNotSupportedException for progressive,
+/// lossless, arithmetic coded, multi-scan and CMYK files.
+inline Tensor<uint8_t> decode_jpeg(const std::vector<uint8_t>& data, int num_threads = 0)
+{
+    return detail::OptimizedJPEGDecoder::eval(data.data(), data.size(), num_threads);
+}
+
+} // namespace tnt
+
+#endif // TNT_IMAGE_JPEG_HPP
@@ -0,0 +1,231 @@
+#ifndef TNT_LINEAR_BLAS1_HPP
+#define TNT_LINEAR_BLAS1_HPP
+
+#include <tnt/core/tensor.hpp>
+#include <tnt/core/tensor_view.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType, typename Enable = void>
+struct OptimizedAxpy
+{
+    static void eval(const DataType&, const Tensor<DataType>&, Tensor<DataType>&) noexcept;
+    static void eval(const DataType&, const TensorView<DataType>&, const TensorView<DataType>&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedAxpby
+{
+    static void eval(const DataType&, const Tensor<DataType>&, const DataType&, Tensor<DataType>&) noexcept;
+    static void eval(const DataType&, const TensorView<DataType>&, const DataType&, const TensorView<DataType>&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedFma
+{
+    static Tensor<DataType> eval(const Tensor<DataType>&, const Tensor<DataType>&, const Tensor<DataType>&);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedScal
+{
+    static void eval(const DataType&, Tensor<DataType>&) noexcept;
+    static void eval(const DataType&, const TensorView<DataType>&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedNrm2
+{
+    static DataType eval(const Tensor<DataType>&) noexcept;
+    static DataType eval(const TensorView<DataType>&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedAsum
+{
+    static DataType eval(const Tensor<DataType>&) noexcept;
+    static DataType eval(const TensorView<DataType>&) noexcept;
+};
+
+} // namespace detail
+
+/// \brief Compute `y = a * x + y` in place
+///
+/// \param a A scalar
+/// \param x A tensor
+/// \param y A tensor with the same shape as [x](*::x). It is overwritten with
+/// the result.
+/// \notes Floating point tensors use a fused multiply-add when the target
+/// supports one. Integer results wrap on overflow. This function asserts that
+/// [x](*::x) and [y](*::y) have the same shape and will throw an exception if
+/// they do not.
+template <typename DataType, typename ScalarType>
+inline void axpy(const ScalarType& a, const Tensor<DataType>& x, Tensor<DataType>& y)
+{
+    TNT_ASSERT(x.shape == y.shape,
+               InvalidParameterException("tnt::axpy()", __FILE__, __LINE__,
+                   "axpy requires that x and y have the same shape"));
+
+    detail::OptimizedAxpy<DataType>::eval(static_cast<DataType>(a), x, y);
+}
+
+/// \brief Compute `y = a * x + y` in place over strided views
+///
+/// \param a A scalar
+/// \param x A view
+/// \param y A view with the same shape as [x](*::x). The viewed elements are
+/// overwritten with the result.
+/// \notes Rows along the last axis are processed with their own increment,
+/// like the `incx` and `incy` arguments of BLAS. This function asserts that
+/// [x](*::x) and [y](*::y) have the same shape and will throw an exception if
+/// they do not.
+template <typename DataType, typename ScalarType>
+inline void axpy(const ScalarType& a, const TensorView<DataType>& x, const TensorView<DataType>& y)
+{
+    TNT_ASSERT(x.shape == y.shape,
+               InvalidParameterException("tnt::axpy()", __FILE__, __LINE__,
+                   "axpy requires that x and y have the same shape"));
+
+    detail::OptimizedAxpy<DataType>::eval(static_cast<DataType>(a), x, y);
+}
+
+/// \brief Compute `y = a * x + b * y` in place
+///
+/// \param a A scalar applied to [x](*::x)
+/// \param x A tensor
+/// \param b A scalar applied to [y](*::y)
+/// \param y A tensor with the same shape as [x](*::x). It is overwritten with
+/// the result.
+/// \notes This function asserts that [x](*::x) and [y](*::y) have the same
+/// shape and will throw an exception if they do not.
+template <typename DataType, typename AlphaType, typename BetaType>
+inline void axpby(const AlphaType& a, const Tensor<DataType>& x, const BetaType& b, Tensor<DataType>& y)
+{
+    TNT_ASSERT(x.shape == y.shape,
+               InvalidParameterException("tnt::axpby()", __FILE__, __LINE__,
+                   "axpby requires that x and y have the same shape"));
+
+    detail::OptimizedAxpby<DataType>::eval(static_cast<DataType>(a), x, static_cast<DataType>(b), y);
+}
+
+/// \brief Compute `y = a * x + b * y` in place over strided views
+///
+/// \param a A scalar applied to [x](*::x)
+/// \param x A view
+/// \param b A scalar applied to [y](*::y)
+/// \param y A view with the same shape as [x](*::x). The viewed elements are
+/// overwritten with the result.
+/// \notes This function asserts that [x](*::x) and [y](*::y) have the same
+/// shape and will throw an exception if they do not.
+template <typename DataType, typename AlphaType, typename BetaType>
+inline void axpby(const AlphaType& a, const TensorView<DataType>& x, const BetaType& b, const TensorView<DataType>& y)
+{
+    TNT_ASSERT(x.shape == y.shape,
+               InvalidParameterException("tnt::axpby()", __FILE__, __LINE__,
+                   "axpby requires that x and y have the same shape"));
+
+    detail::OptimizedAxpby<DataType>::eval(static_cast<DataType>(a), x, static_cast<DataType>(b), y);
+}
+
+/// \brief Compute `a * b + c` elementwise
+///
+/// \param a A tensor
+/// \param b A tensor with the same shape as [a](*::a)
+/// \param c A tensor with the same shape as [a](*::a)
+/// \returns A new tensor holding `a * b + c`
+/// \notes Floating point tensors round once per element when the target
+/// supports a fused multiply-add and twice otherwise. No intermediate product
+/// tensor is allocated. This function asserts that all three tensors have the
+/// same shape and will throw an exception if they do not.
+template <typename DataType>
+inline Tensor<DataType> fma(const Tensor<DataType>& a, const Tensor<DataType>& b, const Tensor<DataType>& c)
+{
+    TNT_ASSERT(a.shape == b.shape && a.shape == c.shape,
+               InvalidParameterException("tnt::fma()", __FILE__, __LINE__,
+                   "fma requires that all three tensors have the same shape"));
+
+    return detail::OptimizedFma<DataType>::eval(a, b, c);
+}
+
+/// \brief Compute `x = a * x` in place
+///
+/// \param a A scalar
+/// \param x A tensor. It is overwritten with the result.
+template <typename DataType, typename ScalarType>
+inline void scal(const ScalarType& a, Tensor<DataType>& x)
+{
+    detail::OptimizedScal<DataType>::eval(static_cast<DataType>(a), x);
+}
+
+/// \brief Compute `x = a * x` in place over a strided view
+///
+/// \param a A scalar
+/// \param x A view. The viewed elements are overwritten with the result.
+template <typename DataType, typename ScalarType>
+inline void scal(const ScalarType& a, const TensorView<DataType>& x)
+{
+    detail::OptimizedScal<DataType>::eval(static_cast<DataType>(a), x);
+}
+
+/// \brief Compute the euclidean norm of a tensor
+///
+/// \param x A tensor
+/// \returns `sqrt(sum(x * x))`
+/// \requires Type `DataType` shall be floating point
+/// \notes Elements are scaled by a power of two close to the largest
+/// magnitude before squaring, so the result does not overflow or underflow
+/// unless the norm itself does.
+template <typename DataType>
+inline DataType nrm2(const Tensor<DataType>& x)
+{
+    static_assert(std::is_floating_point<DataType>::value, "nrm2 requires a floating point type");
+
+    return detail::OptimizedNrm2<DataType>::eval(x);
+}
+
+/// \brief Compute the euclidean norm of a strided view
+///
+/// \param x A view
+/// \returns `sqrt(sum(x * x))`
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline DataType nrm2(const TensorView<DataType>& x)
+{
+    static_assert(std::is_floating_point<DataType>::value, "nrm2 requires a floating point type");
+
+    return detail::OptimizedNrm2<DataType>::eval(x);
+}
+
+/// \brief Compute the sum of absolute values of a tensor
+///
+/// \param x A tensor
+/// \returns `sum(abs(x))`
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline DataType asum(const Tensor<DataType>& x)
+{
+    static_assert(std::is_floating_point<DataType>::value, "asum requires a floating point type");
+
+    return detail::OptimizedAsum<DataType>::eval(x);
+}
+
+/// \brief Compute the sum of absolute values of a strided view
+///
+/// \param x A view
+/// \returns `sum(abs(x))`
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline DataType asum(const TensorView<DataType>& x)
+{
+    static_assert(std::is_floating_point<DataType>::value, "asum requires a floating point type");
+
+    return detail::OptimizedAsum<DataType>::eval(x);
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_BLAS1_HPP
@@ -3,9 +3,42 @@
 
 #include <tnt/core/tensor.hpp>
 
+#include <complex>
+#include <vector>
+
 namespace tnt
 {
 
+/// tnt::KernelSpectrum
+/// The Fourier transforms of a bank of kernels, zero padded to the tile size
+/// of an overlap-add FFT convolution. The spectra only depend on the kernels,
+/// so one KernelSpectrum can be passed to any number of [conv3D]() or
+/// [correlate2D]() calls and the kernels are transformed once.
+///
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+struct KernelSpectrum
+{
+    static_assert(std::is_floating_point<DataType>::value, "Type `DataType` must be floating point");
+
+    /// \brief Transform a bank of kernels
+    ///
+    /// \param kernel A bank of kernels with shape `K x KH x KW x C`, or a
+    /// single kernel with shape `KH x KW x C`
+    /// \param fft_size The side of the square transforms, a power of 2 larger
+    /// than `KH` and `KW`. Zero picks the size with the least work per output
+    /// pixel on a large tensor.
+    explicit KernelSpectrum(const Tensor<DataType>& kernel, int fft_size = 0);
+
+    int kernel_rows, kernel_cols, channels, num_kernels;
+    int fft_size;
+
+    /// Pairs of kernels packed as `S_k + i S_k+1`, scaled by the inverse
+    /// transform's `1 / fft_size^2`, with shape
+    /// `ceil(K / 2) x C x fft_size x fft_size`
+    std::vector<std::complex<DataType>> values;
+};
+
 namespace detail
 {
 
@@ -19,8 +52,29 @@ struct OptimizedConvolution3D
                                  int stride);
 };
 
+/// Winograd minimal filtering F(OutputTile x OutputTile, 3x3) for 3x3
+/// kernels with unit stride
+template <typename DataType, int OutputTile, typename Enable = void>
+struct OptimizedWinogradConvolution
+{
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor,
+                                 const Tensor<DataType>& kernel,
+                                 int pad,
+                                 DataType pad_value);
+};
+
+/// Overlap-add convolution with precomputed kernel spectra
+template <typename DataType, typename Enable = void>
+struct OptimizedFFTConvolution
+{
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor,
+                                 const KernelSpectrum<DataType>& spectrum,
+                                 int pad,
+                                 DataType pad_value);
+};
+
 template <typename DataType, typename Enable = void>
-struct OptimizedWinogradConvoluton
+struct OptimizedDepthwiseConvolution
 {
     static Tensor<DataType> eval(const Tensor<DataType>& tensor,
                                  const Tensor<DataType>& kernel,
@@ -29,8 +83,40 @@ struct OptimizedWinogradConvoluton
                                  int stride);
 };
 
+template <typename DataType, typename Enable = void>
+struct OptimizedSeparableFilter
+{
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor,
+                                 const Tensor<DataType>& row_kernel,
+                                 const Tensor<DataType>& column_kernel,
+                                 int pad,
+                                 DataType pad_value);
+};
+
 } // namespace detail
 
+/// \brief Convolve a multi-channel tensor with a bank of kernels
+///
+/// \param tensor A tensor with shape `H x W x C`
+/// \param kernel A bank of kernels with shape `K x KH x KW x C`, or a single
+/// kernel with shape `KH x KW x C`
+/// \param pad The number of rows and columns added to each side of
+/// [tensor](*::tensor)
+/// \param pad_value The value of the added rows and columns
+/// \param stride The distance between consecutive kernel positions
+/// \returns A tensor with shape `OH x OW x K` where
+/// `OH = (H + 2 * pad - KH) / stride + 1` and `OW = (W + 2 * pad - KW) / stride + 1`.
+/// A single kernel produces `K = 1`.
+/// \notes Like most neural network libraries this computes a cross
+/// correlation, kernels are not flipped. Blocks of output pixels are lowered
+/// to a matrix of patches (im2col) and multiplied with the kernels by the
+/// packed GEMM behind [matrix_multiply](). A 1x1 kernel with unit stride and
+/// no padding skips the lowering. Floating point 3x3 kernels with unit stride
+/// and at least 8 input channels and 8 kernels use Winograd's minimal
+/// filtering algorithm instead, and floating point kernels of at least 11x11
+/// taps with unit stride use an overlap-add FFT, both of which round
+/// differently from the direct sum. This function asserts that the shapes are
+/// compatible and will throw an exception if they are not.
 template <typename DataType>
 inline Tensor<DataType> conv3D(const Tensor<DataType>& tensor,
                                const Tensor<DataType>& kernel,
@@ -44,20 +130,28 @@ inline Tensor<DataType> conv3D(const Tensor<DataType>& tensor,
                                          __LINE__,
                                          "3D convolution requires a 3D tensor"))
 
-    TNT_ASSERT(kernel.shape.num_axes() == 3,
+    TNT_ASSERT(kernel.shape.num_axes() == 3 || kernel.shape.num_axes() == 4,
                InvalidParameterException("tnt::conv3D()",
                                          __FILE__,
                                          __LINE__,
-                                         "3D convolution requires a 3D kernel"))
+                                         "3D convolution requires a 3D kernel or a 4D bank of kernels"))
 
-    TNT_ASSERT(tensor.shape[2] == kernel.shape[2],
+    const int kernel_axis = kernel.shape.num_axes() - 3;
+
+    TNT_ASSERT(tensor.shape[2] == kernel.shape[kernel_axis + 2],
                InvalidParameterException("tnt::conv3D()",
                                          __FILE__,
                                          __LINE__,
                                          "3D convolution requires the tensor and kernel to have the same size least significant dimension"))
 
-    TNT_ASSERT(tensor.shape[0] + pad >= kernel.shape[0]
-                && tensor.shape[1] + pad >= kernel.shape[1],
+    TNT_ASSERT(pad >= 0 && stride > 0,
+               InvalidParameterException("tnt::conv3D()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "3D convolution requires a non-negative padding and a positive stride"))
+
+    TNT_ASSERT(tensor.shape[0] + 2 * pad >= kernel.shape[kernel_axis]
+                && tensor.shape[1] + 2 * pad >= kernel.shape[kernel_axis + 1],
                InvalidParameterException("tnt::conv3D()",
                                          __FILE__,
                                          __LINE__,
@@ -66,6 +160,194 @@ inline Tensor<DataType> conv3D(const Tensor<DataType>& tensor,
     return detail::OptimizedConvolution3D<DataType>::eval(tensor, kernel, pad, pad_value, stride);
 }
 
+/// \brief Convolve a multi-channel tensor with a bank of transformed kernels
+///
+/// \param tensor A tensor with shape `H x W x C`
+/// \param spectrum The spectra of `K` kernels with shape `KH x KW x C`
+/// \param pad The number of rows and columns added to each side of
+/// [tensor](*::tensor)
+/// \param pad_value The value of the added rows and columns
+/// \returns A tensor with shape `OH x OW x K` where `OH = H + 2 * pad - KH + 1`
+/// and `OW = W + 2 * pad - KW + 1`
+/// \notes The same cross correlation as [conv3D]() with unit stride, computed
+/// by overlap-add. The padded tensor is cut into tiles, each tile is
+/// transformed, multiplied by the kernel spectra and transformed back, and
+/// the results are summed into the output. The cost grows with
+/// `N log N` of the tensor instead of with the kernel area. This function
+/// asserts that the shapes are compatible and will throw an exception if
+/// they are not.
+template <typename DataType>
+inline Tensor<DataType> conv3D(const Tensor<DataType>& tensor,
+                               const KernelSpectrum<DataType>& spectrum,
+                               int pad = 0,
+                               DataType pad_value = 0)
+{
+    TNT_ASSERT(tensor.shape.num_axes() == 3,
+               InvalidParameterException("tnt::conv3D()", __FILE__, __LINE__,
+                   "3D convolution requires a 3D tensor"))
+
+    TNT_ASSERT(tensor.shape[2] == spectrum.channels,
+               InvalidParameterException("tnt::conv3D()", __FILE__, __LINE__,
+                   "3D convolution requires the tensor and kernel to have the same size least significant dimension"))
+
+    TNT_ASSERT(pad >= 0,
+               InvalidParameterException("tnt::conv3D()", __FILE__, __LINE__,
+                   "3D convolution requires a non-negative padding"))
+
+    TNT_ASSERT(tensor.shape[0] + 2 * pad >= spectrum.kernel_rows && tensor.shape[1] + 2 * pad >= spectrum.kernel_cols,
+               InvalidParameterException("tnt::conv3D()", __FILE__, __LINE__,
+                   "3D convolution requires the tensor + padding to be larger than the kernel"))
+
+    return detail::OptimizedFFTConvolution<DataType>::eval(tensor, spectrum, pad, pad_value);
+}
+
+/// \brief Cross correlate a 2D tensor with a 2D kernel
+///
+/// \param tensor A tensor with shape `H x W`
+/// \param kernel A kernel with shape `KH x KW`
+/// \param pad The number of rows and columns added to each side of
+/// [tensor](*::tensor)
+/// \param pad_value The value of the added rows and columns
+/// \returns A tensor with shape `(H + 2 * pad - KH + 1) x (W + 2 * pad - KW + 1)`
+/// \notes A single channel [conv3D](), including its switch to an FFT for
+/// large floating point kernels. This function asserts that the shapes are
+/// compatible and will throw an exception if they are not.
+template <typename DataType>
+inline Tensor<DataType> correlate2D(const Tensor<DataType>& tensor,
+                                    const Tensor<DataType>& kernel,
+                                    int pad = 0,
+                                    DataType pad_value = 0)
+{
+    TNT_ASSERT(tensor.shape.num_axes() == 2 && kernel.shape.num_axes() == 2,
+               InvalidParameterException("tnt::correlate2D()", __FILE__, __LINE__,
+                   "2D correlation requires a 2D tensor and a 2D kernel"))
+
+    Tensor<DataType> planar = tensor;
+    planar.reshape(Shape{tensor.shape[0], tensor.shape[1], 1});
+
+    Tensor<DataType> weights = kernel;
+    weights.reshape(Shape{kernel.shape[0], kernel.shape[1], 1});
+
+    Tensor<DataType> output = conv3D(planar, weights, pad, pad_value);
+    output.reshape(Shape{output.shape[0], output.shape[1]});
+
+    return output;
+}
+
+/// \brief Cross correlate a 2D tensor with a transformed 2D kernel
+///
+/// \param tensor A tensor with shape `H x W`
+/// \param spectrum The spectrum of a single kernel with shape `KH x KW x 1`
+/// \param pad The number of rows and columns added to each side of
+/// [tensor](*::tensor)
+/// \param pad_value The value of the added rows and columns
+/// \returns A tensor with shape `(H + 2 * pad - KH + 1) x (W + 2 * pad - KW + 1)`
+/// \notes Reusing the spectrum makes repeated template matching against the
+/// same template cost one forward and one inverse transform per tile. This
+/// function asserts that the shapes are compatible and will throw an
+/// exception if they are not.
+template <typename DataType>
+inline Tensor<DataType> correlate2D(const Tensor<DataType>& tensor,
+                                    const KernelSpectrum<DataType>& spectrum,
+                                    int pad = 0,
+                                    DataType pad_value = 0)
+{
+    TNT_ASSERT(tensor.shape.num_axes() == 2 && spectrum.num_kernels == 1,
+               InvalidParameterException("tnt::correlate2D()", __FILE__, __LINE__,
+                   "2D correlation requires a 2D tensor and a single kernel"))
+
+    Tensor<DataType> planar = tensor;
+    planar.reshape(Shape{tensor.shape[0], tensor.shape[1], 1});
+
+    Tensor<DataType> output = conv3D(planar, spectrum, pad, pad_value);
+    output.reshape(Shape{output.shape[0], output.shape[1]});
+
+    return output;
+}
+
+/// \brief Convolve every channel of a tensor with its own kernel
+///
+/// \param tensor A tensor with shape `H x W x C`
+/// \param kernel The per channel kernels with shape `KH x KW x C`
+/// \param pad The number of rows and columns added to each side of
+/// [tensor](*::tensor)
+/// \param pad_value The value of the added rows and columns
+/// \param stride The distance between consecutive kernel positions
+/// \returns A tensor with shape `OH x OW x C` where
+/// `OH = (H + 2 * pad - KH) / stride + 1` and `OW = (W + 2 * pad - KW) / stride + 1`
+/// \notes Channels are contiguous in both the tensor and the kernel, so each
+/// output pixel is accumulated in SIMD registers across channels. This is a
+/// cross correlation, kernels are not flipped. This function asserts that the
+/// shapes are compatible and will throw an exception if they are not.
+template <typename DataType>
+inline Tensor<DataType> depthwise_conv2D(const Tensor<DataType>& tensor,
+                                         const Tensor<DataType>& kernel,
+                                         int pad = 0,
+                                         DataType pad_value = 0,
+                                         int stride = 1)
+{
+    TNT_ASSERT(tensor.shape.num_axes() == 3 && kernel.shape.num_axes() == 3,
+               InvalidParameterException("tnt::depthwise_conv2D()", __FILE__, __LINE__,
+                   "Depthwise convolution requires a 3D tensor and a 3D kernel"))
+
+    TNT_ASSERT(tensor.shape[2] == kernel.shape[2],
+               InvalidParameterException("tnt::depthwise_conv2D()", __FILE__, __LINE__,
+                   "Depthwise convolution requires one kernel per channel"))
+
+    TNT_ASSERT(pad >= 0 && stride > 0,
+               InvalidParameterException("tnt::depthwise_conv2D()", __FILE__, __LINE__,
+                   "Depthwise convolution requires a non-negative padding and a positive stride"))
+
+    TNT_ASSERT(tensor.shape[0] + 2 * pad >= kernel.shape[0] && tensor.shape[1] + 2 * pad >= kernel.shape[1],
+               InvalidParameterException("tnt::depthwise_conv2D()", __FILE__, __LINE__,
+                   "Depthwise convolution requires the tensor + padding to be larger than the kernel"))
+
+    return detail::OptimizedDepthwiseConvolution<DataType>::eval(tensor, kernel, pad, pad_value, stride);
+}
+
+/// \brief Filter every channel of a tensor with the outer product of a column
+/// and a row kernel
+///
+/// \param tensor A tensor with shape `H x W` or `H x W x C`
+/// \param row_kernel A 1D kernel of length `KW` applied along rows
+/// \param column_kernel A 1D kernel of length `KH` applied along columns
+/// \param pad The number of rows and columns added to each side of
+/// [tensor](*::tensor)
+/// \param pad_value The value of the added rows and columns
+/// \returns A tensor with shape `OH x OW` or `OH x OW x C` where
+/// `OH = H + 2 * pad - KH + 1` and `OW = W + 2 * pad - KW + 1`
+/// \notes Equivalent to a 2D correlation with `column_kernel * row_kernel^T`
+/// at `KH + KW` instead of `KH * KW` multiplies per output. Rows are filtered
+/// once each into a ring buffer of `KH` rows, which the column pass reads, so
+/// the working set stays in cache. Integer results wrap on overflow. This
+/// function asserts that the shapes are compatible and will throw an
+/// exception if they are not.
+template <typename DataType>
+inline Tensor<DataType> separable_filter2D(const Tensor<DataType>& tensor,
+                                           const Tensor<DataType>& row_kernel,
+                                           const Tensor<DataType>& column_kernel,
+                                           int pad = 0,
+                                           DataType pad_value = 0)
+{
+    TNT_ASSERT(tensor.shape.num_axes() == 2 || tensor.shape.num_axes() == 3,
+               InvalidParameterException("tnt::separable_filter2D()", __FILE__, __LINE__,
+                   "Separable filtering requires a 2D or 3D tensor"))
+
+    TNT_ASSERT(row_kernel.shape.num_axes() == 1 && column_kernel.shape.num_axes() == 1,
+               InvalidParameterException("tnt::separable_filter2D()", __FILE__, __LINE__,
+                   "Separable filtering requires 1D row and column kernels"))
+
+    TNT_ASSERT(pad >= 0,
+               InvalidParameterException("tnt::separable_filter2D()", __FILE__, __LINE__,
+                   "Separable filtering requires a non-negative padding"))
+
+    TNT_ASSERT(tensor.shape[0] + 2 * pad >= column_kernel.shape[0] && tensor.shape[1] + 2 * pad >= row_kernel.shape[0],
+               InvalidParameterException("tnt::separable_filter2D()", __FILE__, __LINE__,
+                   "Separable filtering requires the tensor + padding to be larger than the kernels"))
+
+    return detail::OptimizedSeparableFilter<DataType>::eval(tensor, row_kernel, column_kernel, pad, pad_value);
+}
+
 } // namespace tnt
 
 #endif // TNT_LINEAR_CONVOLUTION_HPP
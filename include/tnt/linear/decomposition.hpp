@@ -0,0 +1,256 @@
+#ifndef TNT_LINEAR_DECOMPOSITION_HPP
+#define TNT_LINEAR_DECOMPOSITION_HPP
+
+#include <tnt/core/tensor.hpp>
+
+// Dense factorizations of row-major matrices. Each one works on panels of
+// columns and applies a panel to the rest of the matrix (the trailing matrix)
+// with the packed matrix multiplication of [matrix_multiply](). The trailing
+// updates are split into fixed blocks of rows spread over threads, so results
+// do not depend on the number of threads.
+
+namespace tnt
+{
+
+/// \brief The result of an [lu](tnt::lu) factorization, `P A = L U`
+///
+/// [factors](*::factors) holds `U` on and above the diagonal and the unit
+/// lower triangular `L` below it. Row `i` was swapped with row `pivots[i]`,
+/// in increasing order of `i`, to give `P A`.
+template <typename DataType>
+struct TNT_EXPORT LU
+{
+    Tensor<DataType> factors;
+    Tensor<int32_t>  pivots;
+};
+
+/// \brief The result of a [qr](tnt::qr) factorization, `A = Q R`
+///
+/// For an `m x n` matrix and `p = min(m, n)`, [q](*::q) is `m x p` with
+/// orthonormal columns and [r](*::r) is `p x n` and upper triangular.
+template <typename DataType>
+struct TNT_EXPORT QR
+{
+    Tensor<DataType> q;
+    Tensor<DataType> r;
+};
+
+namespace detail
+{
+
+template <typename DataType, typename Enable = void>
+struct OptimizedLU
+{
+    static LU<DataType> eval(const Tensor<DataType>&, int);
+    static Tensor<DataType> solve(const LU<DataType>&, const Tensor<DataType>&, int);
+    static DataType det(const LU<DataType>&);
+    static bool singular(const LU<DataType>&);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedCholesky
+{
+    static bool eval(const Tensor<DataType>&, Tensor<DataType>&, int);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedQR
+{
+    static QR<DataType> eval(const Tensor<DataType>&, int);
+    static bool lstsq(const Tensor<DataType>&, const Tensor<DataType>&, Tensor<DataType>&, int);
+};
+
+} // namespace detail
+
+/// \brief LU factorization with partial pivoting
+///
+/// \param tensor A square 2D floating point tensor
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The factors and row swaps with `P A = L U`
+/// \requires Type `DataType` shall be floating
+/// \requires Parameter [tensor](*::tensor) shall be 2D and square
+/// \notes Right-looking and blocked: each panel of 64 columns is factored
+/// with row swaps, then the rest of `U` is solved and the trailing matrix
+/// updated with one matrix product. A singular matrix is factored without
+/// error and gives a zero on the diagonal of `U`. This function asserts that
+/// [tensor](*::tensor) is square and will throw an exception if it is not.
+/// This check can be disabled by `#define DISABLE_CHECKS` before calling the
+/// function.
+template <typename DataType>
+inline LU<DataType> lu(const Tensor<DataType>& tensor, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value, "lu() requires floating point data");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 2 && tensor.shape[0] == tensor.shape[1],
+               InvalidParameterException("tnt::lu()", __FILE__, __LINE__,
+                   "LU factorization requires a square two dimensional matrix"))
+
+    return detail::OptimizedLU<DataType>::eval(tensor, num_threads);
+}
+
+/// \brief Cholesky factorization of a symmetric positive definite matrix
+///
+/// \param tensor A square 2D floating point tensor. Only the lower triangle
+/// is read.
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The lower triangular `L` with `A = L L^T`
+/// \requires Type `DataType` shall be floating
+/// \requires Parameter [tensor](*::tensor) shall be 2D, square and positive
+/// definite
+/// \notes Right-looking and blocked like [lu](). Only the lower triangle of
+/// the trailing matrix is updated. This function asserts that
+/// [tensor](*::tensor) is square and positive definite and will throw an
+/// exception if it is not. These checks can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<DataType> cholesky(const Tensor<DataType>& tensor, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value, "cholesky() requires floating point data");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 2 && tensor.shape[0] == tensor.shape[1],
+               InvalidParameterException("tnt::cholesky()", __FILE__, __LINE__,
+                   "Cholesky factorization requires a square two dimensional matrix"))
+
+    Tensor<DataType> result;
+    const bool positive = detail::OptimizedCholesky<DataType>::eval(tensor, result, num_threads);
+
+    TNT_ASSERT(positive, InvalidParameterException("tnt::cholesky()", __FILE__, __LINE__,
+                             "Cholesky factorization requires a positive definite matrix"))
+
+    return result;
+}
+
+/// \brief Householder QR factorization
+///
+/// \param tensor A 2D floating point tensor of size `m x n`
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The thin factors `Q` (`m x p`) and `R` (`p x n`), `p = min(m, n)`
+/// \requires Type `DataType` shall be floating
+/// \requires Parameter [tensor](*::tensor) shall be 2D
+/// \notes Panels of 32 reflectors are combined into the compact WY form
+/// `I - V T V^T`, which is applied to the trailing columns, and later to
+/// form `Q`, as matrix products. The diagonal of `R` may be negative. This
+/// function asserts that [tensor](*::tensor) is 2D and will throw an
+/// exception if it is not. This check can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline QR<DataType> qr(const Tensor<DataType>& tensor, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value, "qr() requires floating point data");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 2,
+               InvalidParameterException("tnt::qr()", __FILE__, __LINE__,
+                   "QR factorization requires a two dimensional matrix"))
+
+    return detail::OptimizedQR<DataType>::eval(tensor, num_threads);
+}
+
+/// \brief Solve the linear system `A X = B`
+///
+/// \param tensor The square 2D matrix `A`
+/// \param rhs The right hand side `B`, a vector of length `n` or an `n x k`
+/// matrix of `k` right hand sides
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns `X` with the shape of [rhs](*::rhs)
+/// \requires Type `DataType` shall be floating
+/// \requires Parameter [tensor](*::tensor) shall be square and non-singular
+/// \notes Uses [lu]() followed by forward and back substitution, split over
+/// threads by blocks of right hand sides. This function asserts that the
+/// shapes agree and that `A` is not singular, and will throw an exception if
+/// they do not or it is. These checks can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<DataType> solve(const Tensor<DataType>& tensor, const Tensor<DataType>& rhs, int num_threads = 0)
+{
+    TNT_ASSERT(rhs.shape.num_axes() >= 1 && rhs.shape.num_axes() <= 2 && rhs.shape[0] == tensor.shape[0],
+               InvalidParameterException("tnt::solve()", __FILE__, __LINE__,
+                   "The right hand side must be a vector or matrix with as many rows as the system"))
+
+    LU<DataType> factors = lu(tensor, num_threads);
+
+    TNT_ASSERT(!detail::OptimizedLU<DataType>::singular(factors),
+               InvalidParameterException("tnt::solve()", __FILE__, __LINE__, "Cannot solve a singular system"))
+
+    return detail::OptimizedLU<DataType>::solve(factors, rhs, num_threads);
+}
+
+/// \brief The inverse of a square matrix
+///
+/// \param tensor A square 2D floating point tensor
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns `A^-1`
+/// \requires Parameter [tensor](*::tensor) shall be square and non-singular
+/// \notes Computed as [solve]() with the identity. Prefer [solve]() when the
+/// inverse is only multiplied by vectors. This function asserts that
+/// [tensor](*::tensor) is square and not singular, and will throw an
+/// exception if it is not. These checks can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<DataType> inverse(const Tensor<DataType>& tensor, int num_threads = 0)
+{
+    TNT_ASSERT(tensor.shape.num_axes() == 2 && tensor.shape[0] == tensor.shape[1],
+               InvalidParameterException("tnt::inverse()", __FILE__, __LINE__,
+                   "Only square two dimensional matrices have an inverse"))
+
+    const int n = tensor.shape[0];
+
+    Tensor<DataType> identity = zeros<DataType>(Shape{n, n});
+    for (int i = 0; i < n; ++i)
+        identity.data[i * n + i] = 1;
+
+    return solve(tensor, identity, num_threads);
+}
+
+/// \brief The determinant of a square matrix
+///
+/// \param tensor A square 2D floating point tensor
+/// \returns `det(A)`, the signed product of the diagonal of `U` from [lu]()
+/// \requires Parameter [tensor](*::tensor) shall be square
+/// \notes The product can overflow for large matrices even when the
+/// factorization does not. This function asserts that [tensor](*::tensor) is
+/// square and will throw an exception if it is not. This check can be
+/// disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline DataType det(const Tensor<DataType>& tensor)
+{
+    return detail::OptimizedLU<DataType>::det(lu(tensor, 1));
+}
+
+/// \brief Least squares solution of the overdetermined system `A X = B`
+///
+/// \param tensor The `m x n` matrix `A` with `m >= n` and full column rank
+/// \param rhs The right hand side `B`, a vector of length `m` or an `m x k`
+/// matrix of `k` right hand sides
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns `X`, of length `n` or size `n x k`, minimizing `|A X - B|`
+/// \requires Type `DataType` shall be floating
+/// \notes Applies the reflectors of [qr]() to `B` without forming `Q`, then
+/// solves `R X = Q^T B`. This function asserts that the shapes agree and that
+/// `A` has full column rank, and will throw an exception if they do not or
+/// it does not. These checks can be disabled by `#define DISABLE_CHECKS`
+/// before calling the function.
+template <typename DataType>
+inline Tensor<DataType> lstsq(const Tensor<DataType>& tensor, const Tensor<DataType>& rhs, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value, "lstsq() requires floating point data");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 2 && tensor.shape[0] >= tensor.shape[1],
+               InvalidParameterException("tnt::lstsq()", __FILE__, __LINE__,
+                   "Least squares requires a two dimensional matrix with at least as many rows as columns"))
+
+    TNT_ASSERT(rhs.shape.num_axes() >= 1 && rhs.shape.num_axes() <= 2 && rhs.shape[0] == tensor.shape[0],
+               InvalidParameterException("tnt::lstsq()", __FILE__, __LINE__,
+                   "The right hand side must be a vector or matrix with as many rows as the system"))
+
+    Tensor<DataType> result;
+    const bool full_rank = detail::OptimizedQR<DataType>::lstsq(tensor, rhs, result, num_threads);
+
+    TNT_ASSERT(full_rank, InvalidParameterException("tnt::lstsq()", __FILE__, __LINE__,
+                              "Least squares requires a matrix with full column rank"))
+
+    return result;
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_DECOMPOSITION_HPP
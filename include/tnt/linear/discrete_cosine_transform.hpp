@@ -15,18 +15,85 @@ struct OptimizedDCT
     static Tensor<DataType> eval(const Tensor<DataType>& tensor);
 };
 
+template <typename DataType, typename Enable = void>
+struct OptimizedIDCT
+{
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor);
+};
+
 } // namespace detail
 
+/// \brief Compute the 2D discrete cosine transform of every 8x8 block of a
+/// tensor
+///
+/// \param tensor A tensor with shape `H x W`, where `H` and `W` are
+/// multiples of 8
+/// \returns A tensor with the same shape where each 8x8 block holds the
+/// coefficients of the corresponding input block, with the vertical
+/// frequency along rows and the horizontal frequency along columns
+/// \notes The transform is the orthonormal DCT-II used by JPEG,
+/// `F(r, c) = C(r) C(c) / 4 sum f(y, x) cos((2y + 1) r pi / 16) cos((2x + 1) c pi / 16)`
+/// where `f(y, x)` is the sample at row `y` and column `x` of the block,
+/// `C(0) = 1 / sqrt(2)` and `C(k) = 1` otherwise. Floating point tensors
+/// use the Arai-Agui-Nakajima factorization. `int16_t` and `int32_t` tensors
+/// use the Loeffler factorization in 13 bit fixed point and round the
+/// coefficients to integers. The fixed point intermediates do not overflow
+/// for samples of up to 8 bits, such as level shifted pixels. This function
+/// asserts that the shape is valid and will throw an exception if it is not.
+/// \requires Type `DataType` shall be floating point, `int16_t` or `int32_t`
 template <typename DataType>
 inline Tensor<DataType> dct(const Tensor<DataType>& tensor)
 {
+    static_assert(std::is_floating_point<DataType>::value
+                    || std::is_same<DataType, int16_t>::value || std::is_same<DataType, int32_t>::value,
+                  "The discrete cosine transform requires a floating point, `int16_t` or `int32_t` tensor");
+
     TNT_ASSERT(tensor.shape.num_axes() == 2,
-               InvalidParamterException("tnt::dct()",
-                                        __FILE__,
-                                        __LINE__,
-                                        "The discrete cosine transform requires a 2D tensor"))
+               InvalidParameterException("tnt::dct()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "The discrete cosine transform requires a 2D tensor"))
+
+    TNT_ASSERT(tensor.shape[0] % 8 == 0 && tensor.shape[1] % 8 == 0,
+               InvalidParameterException("tnt::dct()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "The discrete cosine transform requires a tensor of whole 8x8 blocks"))
+
+    return detail::OptimizedDCT<DataType>::eval(tensor);
+}
+
+/// \brief Compute the 2D inverse discrete cosine transform of every 8x8
+/// block of a tensor
+///
+/// \param tensor A tensor of coefficients with shape `H x W`, where `H` and
+/// `W` are multiples of 8
+/// \returns A tensor with the same shape where each 8x8 block holds the
+/// samples reconstructed from the corresponding block of coefficients
+/// \notes The inverse of [dct](), with the same factorizations. Integer
+/// results are rounded and not clamped to any sample range. This function
+/// asserts that the shape is valid and will throw an exception if it is not.
+/// \requires Type `DataType` shall be floating point, `int16_t` or `int32_t`
+template <typename DataType>
+inline Tensor<DataType> idct(const Tensor<DataType>& tensor)
+{
+    static_assert(std::is_floating_point<DataType>::value
+                    || std::is_same<DataType, int16_t>::value || std::is_same<DataType, int32_t>::value,
+                  "The inverse discrete cosine transform requires a floating point, `int16_t` or `int32_t` tensor");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 2,
+               InvalidParameterException("tnt::idct()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "The inverse discrete cosine transform requires a 2D tensor"))
+
+    TNT_ASSERT(tensor.shape[0] % 8 == 0 && tensor.shape[1] % 8 == 0,
+               InvalidParameterException("tnt::idct()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "The inverse discrete cosine transform requires a tensor of whole 8x8 blocks"))
 
-    return detail::OptimizedDCT::eval(tensor);
+    return detail::OptimizedIDCT<DataType>::eval(tensor);
 }
 
 } // namespace tnt
@@ -6,6 +6,19 @@
 namespace tnt
 {
 
+/// \brief The result of a [symmetric_eigen](tnt::symmetric_eigen)
+/// decomposition
+///
+/// [values](*::values) holds the `n` eigenvalues sorted from smallest to
+/// largest. Column `i` of the `n x n` tensor [vectors](*::vectors) is the unit
+/// eigenvector of `values[i]`, so `A = vectors * diag(values) * vectors^T`.
+template <typename DataType>
+struct TNT_EXPORT SymmetricEigen
+{
+    Tensor<DataType> values;
+    Tensor<DataType> vectors;
+};
+
 namespace detail
 {
 
@@ -15,16 +28,47 @@ struct OptimizedEigenvalues
     static Tensor<DataType> eval(const Tensor<DataType>&, int, float);
 };
 
+template <typename DataType, typename Enable = void>
+struct OptimizedSymmetricEigen
+{
+    static bool eval(const Tensor<DataType>&, bool, int, SymmetricEigen<DataType>&);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedBatchedEigenvalues
+{
+    static Tensor<DataType> eval(const Tensor<DataType>&, int);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedEigenvaluesTopK
+{
+    static SymmetricEigen<DataType> eval(const Tensor<DataType>&, int, int, float, int);
+};
+
 } // namespace detail
 
-/// \brief Compute the eigenvalues of a square 2D tensor
+/// \brief Compute the eigenvalues of a symmetric 2D tensor
 ///
-/// \param tensor A 2D floating point tensor to compute eigenvalues from
-/// \param max_iterations The maximum number of iterations to run before stopping
+/// \param tensor A symmetric 2D floating point tensor to compute eigenvalues
+/// from
+/// \param max_iterations The maximum number of sweeps, each of which rotates
+/// every off-diagonal pair once
 /// \param eps Early stopping criteria. If the largest off-diagonal value of the
 /// intermediate matrix is less than eps, stop early.
+/// \returns The eigenvalues in the order they appear on the diagonal of the
+/// converged matrix, or sorted from smallest to largest for matrices of more
+/// than 40 rows
 /// \requires Type `DataType` shall be floating
 /// \requires Parameter [tensor](*::tensor)shall be 2D
+/// \notes Uses the cyclic Jacobi method with Rutishauser's thresholds: the
+/// first sweeps only rotate elements that are large compared to the average
+/// off-diagonal magnitude. Each rotation updates the two affected rows in
+/// place with SIMD and mirrors them into the columns, so it costs O(n).
+/// Matrices of more than 40 rows are passed to
+/// [symmetric_eigenvalues](tnt::symmetric_eigenvalues) on one thread, which
+/// is faster at that size, and [max_iterations](*::max_iterations) and
+/// [eps](*::eps) are not used.
 template <typename DataType>
 inline Tensor<DataType> eigenvalues(const Tensor<DataType>& tensor, int max_iterations = 1000, float eps = 0.001)
 {
@@ -46,6 +90,156 @@ inline Tensor<DataType> eigenvalues(const Tensor<DataType>& tensor, int max_iter
     return detail::OptimizedEigenvalues<DataType>::eval(tensor, max_iterations, eps);
 }
 
+/// \brief Compute the eigenvalues and eigenvectors of a symmetric 2D tensor
+///
+/// \param tensor A symmetric 2D floating point tensor. Only the upper
+/// triangle is read.
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The eigenvalues, sorted from smallest to largest, and the
+/// orthonormal eigenvectors as the columns of an `n x n` tensor
+/// \requires Type `DataType` shall be floating
+/// \requires Parameter [tensor](*::tensor) shall be 2D and square
+/// \notes The matrix is reduced to tridiagonal form with blocked Householder
+/// reflections, whose trailing updates are matrix products split over
+/// threads. The eigenvectors of the tridiagonal matrix are found with
+/// implicitly shifted QL iterations, and the rotations of each batch of
+/// iterations are applied to the eigenvectors in column blocks over threads.
+/// The cost is O(n^3) with a much smaller constant than
+/// [eigenvalues](tnt::eigenvalues), which should be preferred only for small
+/// matrices. This function asserts that [tensor](*::tensor) is a square
+/// matrix and that the QL iterations converge, which fails for a matrix
+/// holding NaN or infinity, and will throw an exception if not. These checks
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline SymmetricEigen<DataType> symmetric_eigen(const Tensor<DataType>& tensor, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value,
+                    "symmetric_eigen() requires floating point data");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 2 && tensor.shape[0] == tensor.shape[1],
+               InvalidParameterException("tnt::symmetric_eigen()", __FILE__, __LINE__,
+                   "Eigen decomposition requires a square two dimensional matrix"))
+
+    SymmetricEigen<DataType> result;
+    const bool converged = detail::OptimizedSymmetricEigen<DataType>::eval(tensor, true, num_threads, result);
+
+    TNT_ASSERT(converged, InvalidParameterException("tnt::symmetric_eigen()", __FILE__, __LINE__,
+                              "Eigen decomposition did not converge, the matrix may hold NaN or infinity"))
+
+    return result;
+}
+
+/// \brief Compute the eigenvalues of a symmetric 2D tensor without its
+/// eigenvectors
+///
+/// \param tensor A symmetric 2D floating point tensor. Only the upper
+/// triangle is read.
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The eigenvalues sorted from smallest to largest
+/// \requires Type `DataType` shall be floating
+/// \requires Parameter [tensor](*::tensor) shall be 2D and square
+/// \notes See [symmetric_eigen](tnt::symmetric_eigen). Without eigenvectors
+/// the QL iterations cost O(n^2), so the tridiagonal reduction is almost all
+/// of the work.
+template <typename DataType>
+inline Tensor<DataType> symmetric_eigenvalues(const Tensor<DataType>& tensor, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value,
+                    "symmetric_eigenvalues() requires floating point data");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 2 && tensor.shape[0] == tensor.shape[1],
+               InvalidParameterException("tnt::symmetric_eigenvalues()", __FILE__, __LINE__,
+                   "Eigen decomposition requires a square two dimensional matrix"))
+
+    SymmetricEigen<DataType> result;
+    const bool converged = detail::OptimizedSymmetricEigen<DataType>::eval(tensor, false, num_threads, result);
+
+    TNT_ASSERT(converged, InvalidParameterException("tnt::symmetric_eigenvalues()", __FILE__, __LINE__,
+                              "Eigen decomposition did not converge, the matrix may hold NaN or infinity"))
+
+    return result.values;
+}
+
+/// \brief Compute the eigenvalues of a batch of small symmetric matrices
+///
+/// \param tensor A `[N, n, n]` floating point tensor holding `N` symmetric
+/// matrices of size `n x n`, with `n <= 8`
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns A `[N, n]` tensor whose row `i` holds the eigenvalues of matrix
+/// `i`, sorted from smallest to largest
+/// \requires Type `DataType` shall be floating
+/// \requires Parameter [tensor](*::tensor) shall be 3D with square matrices
+/// of at most 8 x 8
+/// \notes Each SIMD lane solves one matrix: a block of matrices is
+/// transposed so that each matrix element is one vector. 2 x 2 and 3 x 3
+/// matrices have closed forms. The 3 x 3 form solves the characteristic
+/// cubic with trigonometry, which is accurate to about `sqrt(epsilon)` times
+/// the norm of the matrix when two eigenvalues (nearly) coincide. Larger
+/// matrices use cyclic Jacobi sweeps that rotate every lane at once. Nothing
+/// is allocated apart from the result. This function asserts the shape of
+/// [tensor](*::tensor) and will throw an exception if it is invalid. These
+/// checks can be disabled by `#define DISABLE_CHECKS` before calling the
+/// function.
+template <typename DataType>
+inline Tensor<DataType> batched_eigenvalues(const Tensor<DataType>& tensor, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value,
+                    "batched_eigenvalues() requires floating point data");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 3 && tensor.shape[1] == tensor.shape[2],
+               InvalidParameterException("tnt::batched_eigenvalues()", __FILE__, __LINE__,
+                   "Batched eigen decomposition requires a [N, n, n] tensor"))
+
+    TNT_ASSERT(tensor.shape[1] <= 8,
+               InvalidParameterException("tnt::batched_eigenvalues()", __FILE__, __LINE__,
+                   "Batched eigen decomposition supports matrices of at most 8x8"))
+
+    return detail::OptimizedBatchedEigenvalues<DataType>::eval(tensor, num_threads);
+}
+
+/// \brief Compute the `k` largest eigenvalues of a symmetric 2D tensor and
+/// their eigenvectors
+///
+/// \param tensor A symmetric 2D floating point tensor
+/// \param k The number of eigenpairs, `0 < k <= n`
+/// \param max_iterations The maximum number of subspace iterations, each of
+/// which multiplies the matrix by a block of vectors once
+/// \param eps Stopping criteria. Iteration stops once every returned pair
+/// has `|A x - lambda x| <= eps * |lambda_0|`.
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The `k` eigenvalues of largest magnitude, from largest to
+/// smallest magnitude, and their unit eigenvectors as the columns of an
+/// `n x k` tensor. For positive semi-definite matrices, such as covariances,
+/// these are the `k` largest eigenvalues.
+/// \requires Type `DataType` shall be floating
+/// \requires Parameter [tensor](*::tensor) shall be 2D and square
+/// \notes Uses randomized subspace iteration with Rayleigh-Ritz projection on
+/// a block of `k + max(k, 10)` vectors. Each iteration is one matrix product
+/// of the tensor with the block, split over threads by columns, so a
+/// `10000 x 10000` matrix needs no more memory than its own and a few blocks
+/// of vectors. Convergence of eigenvalue `i` depends on the gap between it
+/// and the first eigenvalue outside the block. Results are deterministic.
+/// This function asserts that [tensor](*::tensor) is a square matrix and that
+/// `0 < k <= n`, and will throw an exception if they are not. These checks
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline SymmetricEigen<DataType> eigenvalues_topk(const Tensor<DataType>& tensor, int k, int max_iterations = 300,
+                                                 float eps = 1e-4f, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value,
+                    "eigenvalues_topk() requires floating point data");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 2 && tensor.shape[0] == tensor.shape[1],
+               InvalidParameterException("tnt::eigenvalues_topk()", __FILE__, __LINE__,
+                   "Eigen decomposition requires a square two dimensional matrix"))
+
+    TNT_ASSERT(k > 0 && k <= tensor.shape[0],
+               InvalidParameterException("tnt::eigenvalues_topk()", __FILE__, __LINE__,
+                   "eigenvalues_topk requires 0 < k <= the size of the matrix"))
+
+    return detail::OptimizedEigenvaluesTopK<DataType>::eval(tensor, k, max_iterations, eps, num_threads);
+}
+
 } // namespace tnt
 
 #endif // TNT_EIGEN_HPP
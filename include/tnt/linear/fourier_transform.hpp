@@ -0,0 +1,296 @@
+#ifndef TNT_LINEAR_FOURIER_TRANSFORM_HPP
+#define TNT_LINEAR_FOURIER_TRANSFORM_HPP
+
+#include <tnt/core/tensor.hpp>
+
+#include <complex>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tnt
+{
+
+/// tnt::FFTPlan
+/// The precomputed factorization, digit reversal permutation and twiddles for
+/// discrete Fourier transforms of one length
+///
+/// Lengths whose prime factors are at most 13 are transformed with an
+/// iterative mixed radix decimation in time algorithm, powers of 2 in radix 8
+/// and 4 stages. Other lengths use Bluestein's algorithm, which expresses
+/// the transform as a convolution computed with a power of 2 transform. The
+/// butterflies are written once for SIMD lanes, each lane holding one of a
+/// batch of sequences, so batches of transforms are vectorized without any
+/// shuffles.
+///
+/// Plans are immutable, so one plan can be shared by any number of threads.
+/// [get](tnt::FFTPlan<DataType>::get) caches a plan per length.
+///
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+struct FFTPlan
+{
+    static_assert(std::is_floating_point<DataType>::value, "FFT plans require a floating point type");
+
+    using Complex = std::complex<DataType>;
+
+    /// \brief Build a plan for transforms of `size` elements
+    explicit FFTPlan(int size);
+
+    /// \brief A shared plan for transforms of `size` elements, built on first
+    /// use and cached for the life of the program
+    static std::shared_ptr<const FFTPlan> get(int size);
+
+    /// \brief Transform every sequence along the middle axis of an
+    /// `outer x size x inner` array of complex values in place
+    ///
+    /// \param data The array
+    /// \param inner The distance between consecutive elements of a sequence,
+    /// 1 for contiguous sequences
+    /// \param outer The number of blocks of `inner` interleaved sequences
+    /// \param inverse If true compute the inverse transform, which is not
+    /// scaled by `1 / size`
+    /// \param num_threads The number of threads, or 0 for one per hardware
+    /// thread
+    void run(Complex* data, int inner, int outer, bool inverse, int num_threads = 1) const;
+
+    /// \brief Transform sequences stored as SIMD lanes
+    ///
+    /// \notes Element `k` of the sequences is the vector at `re + k * Width`
+    /// and `im + k * Width`, where `Width` is the number of lanes. `work`
+    /// holds at least `2 * workspace() * Width` values.
+    template <typename Lanes>
+    void execute(DataType* re, DataType* im, DataType* work, bool inverse) const;
+
+    /// \brief The number of complex elements of workspace per lane
+    int workspace() const noexcept;
+
+    int size;
+
+    std::vector<int> radices;      //< The radix of each stage, from the shortest span to the longest
+    std::vector<int> permutation;  //< The position of each input element before the first stage
+    std::vector<int> offsets;      //< The first twiddle of each stage
+    std::vector<DataType> twiddle_re, twiddle_im;
+
+    /// `exp(-i pi k / size)` for `k` in `[0, size]`, the twiddles that
+    /// combine the two halves of a real transform of length `2 * size`
+    std::vector<DataType> real_re, real_im;
+
+    /// Bluestein's algorithm, used when a prime factor is larger than 13
+    std::shared_ptr<const FFTPlan> convolution;
+    std::vector<DataType> chirp_re, chirp_im;        //< `exp(-i pi k^2 / size)`
+    std::vector<DataType> response_re, response_im;  //< The scaled spectrum of the conjugate chirp
+};
+
+namespace detail
+{
+
+template <typename DataType, typename Enable = void>
+struct OptimizedFFT
+{
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor, const std::vector<int>& axes, bool inverse, int num_threads);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedRealFFT
+{
+    static Tensor<std::complex<DataType>> forward(const Tensor<DataType>& tensor, int axis, int num_threads);
+    static Tensor<DataType> inverse(const Tensor<std::complex<DataType>>& tensor, int length, int axis, int num_threads);
+};
+
+} // namespace detail
+
+/// \brief Compute the discrete Fourier transform of a complex tensor along
+/// an axis
+///
+/// \param tensor A tensor of complex values
+/// \param axis The axis to transform
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns A tensor with the same shape holding
+/// `X(k) = sum x(n) exp(-2 pi i k n / N)` along [axis](*::axis)
+/// \notes Every sequence along [axis](*::axis) is transformed with the
+/// cached [FFTPlan]() for its length. Sequences are transformed a SIMD
+/// vector at a time and the vectors are spread over threads. This function
+/// asserts that the axis is valid and will throw an exception if it is not.
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline Tensor<std::complex<DataType>> fft(const Tensor<std::complex<DataType>>& tensor, int axis, int num_threads = 0)
+{
+    TNT_ASSERT(axis >= 0 && axis < tensor.shape.num_axes(),
+               InvalidParameterException("tnt::fft()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "Invalid axis " + std::to_string(axis) + " for fft"))
+
+    return detail::OptimizedFFT<std::complex<DataType>>::eval(tensor, std::vector<int>(1, axis), false, num_threads);
+}
+
+/// \brief Compute the inverse discrete Fourier transform of a complex tensor
+/// along an axis
+///
+/// \param tensor A tensor of complex values
+/// \param axis The axis to transform
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns A tensor with the same shape holding
+/// `x(n) = 1 / N sum X(k) exp(2 pi i k n / N)` along [axis](*::axis)
+/// \notes This function asserts that the axis is valid and will throw an
+/// exception if it is not.
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline Tensor<std::complex<DataType>> ifft(const Tensor<std::complex<DataType>>& tensor, int axis, int num_threads = 0)
+{
+    TNT_ASSERT(axis >= 0 && axis < tensor.shape.num_axes(),
+               InvalidParameterException("tnt::ifft()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "Invalid axis " + std::to_string(axis) + " for ifft"))
+
+    return detail::OptimizedFFT<std::complex<DataType>>::eval(tensor, std::vector<int>(1, axis), true, num_threads);
+}
+
+/// \brief Compute the N dimensional discrete Fourier transform of a complex
+/// tensor
+///
+/// \param tensor A tensor of complex values
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The transform along every axis
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline Tensor<std::complex<DataType>> fftn(const Tensor<std::complex<DataType>>& tensor, int num_threads = 0)
+{
+    std::vector<int> axes(tensor.shape.num_axes());
+    for (int a = 0; a < (int) axes.size(); ++a)
+        axes[a] = a;
+
+    return detail::OptimizedFFT<std::complex<DataType>>::eval(tensor, axes, false, num_threads);
+}
+
+/// \brief Compute the N dimensional inverse discrete Fourier transform of a
+/// complex tensor
+///
+/// \param tensor A tensor of complex values
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The inverse transform along every axis
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline Tensor<std::complex<DataType>> ifftn(const Tensor<std::complex<DataType>>& tensor, int num_threads = 0)
+{
+    std::vector<int> axes(tensor.shape.num_axes());
+    for (int a = 0; a < (int) axes.size(); ++a)
+        axes[a] = a;
+
+    return detail::OptimizedFFT<std::complex<DataType>>::eval(tensor, axes, true, num_threads);
+}
+
+/// \brief Compute the discrete Fourier transform of real data along an axis
+///
+/// \param tensor A tensor of real values
+/// \param axis The axis to transform
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns A complex tensor holding the `N / 2 + 1` non-negative
+/// frequencies along [axis](*::axis). The others are the complex conjugates
+/// of these.
+/// \notes Even lengths pack pairs of samples into one complex value and
+/// compute a transform of half the length. This function asserts that the
+/// axis is valid and will throw an exception if it is not.
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline Tensor<std::complex<DataType>> rfft(const Tensor<DataType>& tensor, int axis, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value, "The FFT requires a floating point tensor");
+
+    TNT_ASSERT(axis >= 0 && axis < tensor.shape.num_axes(),
+               InvalidParameterException("tnt::rfft()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "Invalid axis " + std::to_string(axis) + " for rfft"))
+
+    return detail::OptimizedRealFFT<DataType>::forward(tensor, axis, num_threads);
+}
+
+/// \brief Compute the inverse discrete Fourier transform of the non-negative
+/// frequencies of real data along an axis
+///
+/// \param tensor A complex tensor with `length / 2 + 1` frequencies along
+/// [axis](*::axis)
+/// \param length The length of the real result along [axis](*::axis)
+/// \param axis The axis to transform
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The real tensor whose [rfft]() is [tensor](*::tensor)
+/// \notes The imaginary parts of the zero frequency, and of the Nyquist
+/// frequency for even lengths, are ignored. This function asserts that the
+/// length and axis are valid and will throw an exception if they are not.
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline Tensor<DataType> irfft(const Tensor<std::complex<DataType>>& tensor, int length, int axis, int num_threads = 0)
+{
+    TNT_ASSERT(axis >= 0 && axis < tensor.shape.num_axes(),
+               InvalidParameterException("tnt::irfft()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "Invalid axis " + std::to_string(axis) + " for irfft"))
+
+    TNT_ASSERT(length > 0 && tensor.shape[axis] == length / 2 + 1,
+               InvalidParameterException("tnt::irfft()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "The real length does not match the number of frequencies"))
+
+    return detail::OptimizedRealFFT<DataType>::inverse(tensor, length, axis, num_threads);
+}
+
+/// \brief Compute the N dimensional discrete Fourier transform of real data
+///
+/// \param tensor A tensor of real values
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns A complex tensor with the [rfft]() of the last axis transformed
+/// along every other axis
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline Tensor<std::complex<DataType>> rfftn(const Tensor<DataType>& tensor, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value, "The FFT requires a floating point tensor");
+
+    const int last = tensor.shape.num_axes() - 1;
+    Tensor<std::complex<DataType>> result = detail::OptimizedRealFFT<DataType>::forward(tensor, last, num_threads);
+
+    std::vector<int> axes(last);
+    for (int a = 0; a < last; ++a)
+        axes[a] = a;
+
+    return axes.empty() ? result : detail::OptimizedFFT<std::complex<DataType>>::eval(result, axes, false, num_threads);
+}
+
+/// \brief Compute the N dimensional inverse discrete Fourier transform of the
+/// output of [rfftn]()
+///
+/// \param tensor A complex tensor
+/// \param length The length of the last axis of the real result
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns The real tensor whose [rfftn]() is [tensor](*::tensor)
+/// \notes This function asserts that the length is valid and will throw an
+/// exception if it is not.
+/// \requires Type `DataType` shall be floating point
+template <typename DataType>
+inline Tensor<DataType> irfftn(const Tensor<std::complex<DataType>>& tensor, int length, int num_threads = 0)
+{
+    const int last = tensor.shape.num_axes() - 1;
+
+    TNT_ASSERT(last >= 0 && length > 0 && tensor.shape[last] == length / 2 + 1,
+               InvalidParameterException("tnt::irfftn()",
+                                         __FILE__,
+                                         __LINE__,
+                                         "The real length does not match the number of frequencies"))
+
+    std::vector<int> axes(last);
+    for (int a = 0; a < last; ++a)
+        axes[a] = a;
+
+    return detail::OptimizedRealFFT<DataType>::inverse(
+        axes.empty() ? tensor : detail::OptimizedFFT<std::complex<DataType>>::eval(tensor, axes, true, num_threads),
+        length, last, num_threads);
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_FOURIER_TRANSFORM_HPP
@@ -0,0 +1,306 @@
+#ifndef TNT_LINEAR_BATCHED_EIGEN_IMPL_HPP
+#define TNT_LINEAR_BATCHED_EIGEN_IMPL_HPP
+
+#include <tnt/linear/eigen.hpp>
+#include <tnt/linear/impl/symmetric_eigen_impl.hpp>
+#include <tnt/math/simd_math.hpp>
+#include <tnt/utils/parallel.hpp>
+#include <tnt/utils/simd.hpp>
+#include <tnt/utils/testing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Eigenvalues of `Size` small symmetric matrices at a time, one per lane.
+/// A block of matrices is transposed into `n * n` vectors on the stack, the
+/// vectors are reduced to `n` vectors of eigenvalues, which a sorting network
+/// orders, and these are transposed back into the result.
+template <typename DataType>
+struct OptimizedBatchedEigenvalues<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using Math    = SIMDMathBase<DataType>;
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    constexpr static int MaxSize = 8;
+
+    /// Matrices handled by one task
+    constexpr static int TaskSize = 1024;
+
+    /// Jacobi sweeps before every lane must have converged. Convergence is
+    /// quadratic, 8 x 8 matrices take 6 to 8 sweeps in double precision.
+    constexpr static int MaxSweeps = 16;
+
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor, int num_threads)
+    {
+        const int count = tensor.shape[0];
+        const int n = tensor.shape[1];
+
+        Tensor<DataType> result(Shape{count, n});
+        const DataType* in = tensor.data.data;
+        DataType* out = result.data.data;
+
+        auto task = [&](int t) {
+            const int end = std::min(count, (t + 1) * TaskSize);
+            for (int b = t * TaskSize; b < end; b += Size)
+                solve(in + b * n * n, out + b * n, std::min(int(Size), end - b), n);
+        };
+
+        parallel_for((count + TaskSize - 1) / TaskSize, num_threads, task);
+
+        return result;
+    }
+
+private:
+    /// The eigenvalues of `lanes` consecutive `n x n` matrices. Missing lanes
+    /// are solved for the zero matrix and discarded.
+    static void solve(const DataType* in, DataType* out, int lanes, int n) noexcept
+    {
+        DataType buffer[MaxSize * MaxSize * Size];
+        VecType a[MaxSize * MaxSize];
+
+        const int elements = n * n;
+        for (int e = 0; e < elements; ++e) {
+            for (int l = 0; l < Size; ++l)
+                buffer[e * Size + l] = l < lanes ? in[l * elements + e] : DataType(0);
+
+            a[e] = simdpp::load_u<VecType>(buffer + e * Size);
+        }
+
+        VecType values[MaxSize];
+        if (n == 1)
+            values[0] = a[0];
+        else if (n == 2)
+            solve_2x2(a, values);
+        else if (n == 3)
+            solve_3x3(a, values);
+        else
+            jacobi(a, n, values);
+
+        // Odd-even transposition sort, n rounds of compare and exchange
+        for (int round = 0; round < n; ++round) {
+            for (int i = round % 2; i + 1 < n; i += 2) {
+                const VecType low = simdpp::min(values[i], values[i + 1]);
+                values[i + 1] = simdpp::max(values[i], values[i + 1]);
+                values[i] = low;
+            }
+        }
+
+        for (int i = 0; i < n; ++i)
+            simdpp::store_u(buffer + i * Size, values[i]);
+
+        for (int l = 0; l < lanes; ++l)
+            for (int i = 0; i < n; ++i)
+                out[l * n + i] = buffer[i * Size + l];
+    }
+
+    /// `(a00 + a11) / 2 -+ hypot((a00 - a11) / 2, a01)`
+    static TNT_INL void solve_2x2(const VecType* a, VecType* values) noexcept
+    {
+        const VecType half = Math::splat(DataType(0.5));
+
+        const VecType mean = simdpp::mul(simdpp::add(a[0], a[3]), half);
+        const VecType radius = HypotSIMD<DataType>().run(simdpp::mul(simdpp::sub(a[0], a[3]), half), a[1]);
+
+        values[0] = simdpp::sub(mean, radius);
+        values[1] = simdpp::add(mean, radius);
+    }
+
+    /// With `A = q I + p B`, where `q` is the mean eigenvalue and `B` has
+    /// unit scale, the eigenvalues of `B` are `2 cos(phi + 2 pi k / 3)` with
+    /// `cos(3 phi) = det(B) / 2`
+    static TNT_INL void solve_3x3(const VecType* a, VecType* values) noexcept
+    {
+        const VecType zero = Math::splat(DataType(0));
+        const VecType one = Math::splat(DataType(1));
+
+        const VecType q = simdpp::mul(simdpp::add(simdpp::add(a[0], a[4]), a[8]), Math::splat(DataType(1) / 3));
+
+        const VecType b00 = simdpp::sub(a[0], q);
+        const VecType b11 = simdpp::sub(a[4], q);
+        const VecType b22 = simdpp::sub(a[8], q);
+        const VecType& a01 = a[1];
+        const VecType& a02 = a[2];
+        const VecType& a12 = a[5];
+
+        const VecType off = simdpp::add(simdpp::add(simdpp::mul(a01, a01), simdpp::mul(a02, a02)), simdpp::mul(a12, a12));
+        const VecType diagonal = simdpp::add(simdpp::add(simdpp::mul(b00, b00), simdpp::mul(b11, b11)), simdpp::mul(b22, b22));
+
+        const VecType p = simdpp::sqrt(simdpp::mul(simdpp::add(diagonal, simdpp::add(off, off)), Math::splat(DataType(1) / 6)));
+
+        // A multiple of the identity has p = 0 and every eigenvalue equal to q
+        const auto scalar = simdpp::cmp_eq(p, zero);
+        const VecType inverse = simdpp::div(one, simdpp::blend(one, p, scalar));
+
+        VecType det = simdpp::mul(b00, simdpp::sub(simdpp::mul(b11, b22), simdpp::mul(a12, a12)));
+        det = simdpp::sub(det, simdpp::mul(a01, simdpp::sub(simdpp::mul(a01, b22), simdpp::mul(a12, a02))));
+        det = simdpp::add(det, simdpp::mul(a02, simdpp::sub(simdpp::mul(a01, a12), simdpp::mul(b11, a02))));
+
+        VecType r = simdpp::mul(simdpp::mul(det, simdpp::mul(inverse, simdpp::mul(inverse, inverse))), Math::splat(DataType(0.5)));
+        r = simdpp::blend(zero, r, scalar);
+        r = simdpp::min(simdpp::max(r, Math::splat(DataType(-1))), one);
+
+        // acos(r) / 3
+        const VecType phi = simdpp::mul(Atan2SIMD<DataType>().run(simdpp::sqrt(simdpp::sub(one, simdpp::mul(r, r))), r),
+                                        Math::splat(DataType(1) / 3));
+
+        // phi is in [0, pi / 3], so 2 cos(phi + 2 pi / 3) = -cos(phi) - sqrt(3) sin(phi)
+        // with a non-negative sine
+        const VecType cos_phi = CosSIMD<DataType>().run(phi);
+        const VecType sin_phi = simdpp::sqrt(simdpp::max(simdpp::sub(one, simdpp::mul(cos_phi, cos_phi)), zero));
+
+        const VecType largest = simdpp::add(q, simdpp::mul(simdpp::add(p, p), cos_phi));
+        const VecType smallest = simdpp::sub(q, simdpp::mul(p, simdpp::add(cos_phi, simdpp::mul(sin_phi, Math::splat(DataType(1.73205080756887729353))))));
+
+        values[0] = smallest;
+        values[1] = simdpp::sub(simdpp::sub(simdpp::mul(q, Math::splat(DataType(3))), largest), smallest);
+        values[2] = largest;
+    }
+
+    /// Cyclic Jacobi on every lane at once, stopping when the off-diagonal
+    /// mass of every lane is negligible against its norm
+    static void jacobi(VecType* a, int n, VecType* values) noexcept
+    {
+        const DataType eps = std::numeric_limits<DataType>::epsilon();
+        const VecType tolerance = Math::splat(eps * eps);
+
+        VecType norm = Math::splat(DataType(0));
+        for (int e = 0; e < n * n; ++e)
+            norm = simdpp::add(norm, simdpp::mul(a[e], a[e]));
+
+        for (int sweep = 0; sweep < MaxSweeps; ++sweep) {
+            VecType off = Math::splat(DataType(0));
+            for (int p = 0; p < n; ++p)
+                for (int q = p + 1; q < n; ++q)
+                    off = simdpp::add(off, simdpp::mul(a[p * n + q], a[p * n + q]));
+
+            using UnsignedVecType = typename VecType::uint_vector_type;
+            if (!simdpp::test_bits_any(simdpp::bit_cast<UnsignedVecType>(simdpp::cmp_gt(off, simdpp::mul(norm, tolerance)))))
+                break;
+
+            for (int p = 0; p < n; ++p)
+                for (int q = p + 1; q < n; ++q)
+                    rotate(a, n, p, q);
+        }
+
+        for (int i = 0; i < n; ++i)
+            values[i] = a[i * n + i];
+    }
+
+    /// Zero `a(p, q)` in every lane, as `OptimizedEigenvalues` does for one
+    /// matrix. Lanes where it already is zero are not rotated.
+    static TNT_INL void rotate(VecType* a, int n, int p, int q) noexcept
+    {
+        const VecType zero = Math::splat(DataType(0));
+        const VecType one = Math::splat(DataType(1));
+
+        const VecType pp = a[p * n + p];
+        const VecType qq = a[q * n + q];
+        const VecType pq = a[p * n + q];
+
+        const auto reduced = simdpp::cmp_eq(pq, zero);
+        const VecType theta = simdpp::div(simdpp::sub(qq, pp), simdpp::blend(one, simdpp::add(pq, pq), reduced));
+
+        // sign(theta) / (|theta| + sqrt(1 + theta^2)), the smaller angle. When
+        // theta^2 overflows a(p, q) is negligible and t rounds to zero.
+        const VecType sign = simdpp::bit_or(simdpp::bit_and(theta, Math::sign_bit()), one);
+        VecType t = simdpp::div(sign, simdpp::add(simdpp::abs(theta), simdpp::sqrt(simdpp::add(one, simdpp::mul(theta, theta)))));
+        t = simdpp::blend(zero, t, reduced);
+
+        const VecType c = simdpp::div(one, simdpp::sqrt(simdpp::add(one, simdpp::mul(t, t))));
+        const VecType s = simdpp::mul(t, c);
+
+        for (int k = 0; k < n; ++k) {
+            if (k == p || k == q)
+                continue;
+
+            const VecType kp = a[k * n + p];
+            const VecType kq = a[k * n + q];
+            a[k * n + p] = a[p * n + k] = simdpp::sub(simdpp::mul(c, kp), simdpp::mul(s, kq));
+            a[k * n + q] = a[q * n + k] = simdpp::add(simdpp::mul(s, kp), simdpp::mul(c, kq));
+        }
+
+        a[p * n + p] = simdpp::sub(pp, simdpp::mul(t, pq));
+        a[q * n + q] = simdpp::add(qq, simdpp::mul(t, pq));
+        a[p * n + q] = a[q * n + p] = zero;
+    }
+};
+
+} // namespace detail
+
+TEST_CASE_TEMPLATE("batched_eigenvalues()", T, test_float_data_types)
+{
+    { // Random symmetric matrices of every size, checked against
+      // symmetric_eigenvalues with a batch that does not fill the last vector
+        for (int n = 1; n <= 8; ++n) {
+            const int count = 37;
+
+            std::mt19937 generator(n);
+            std::uniform_real_distribution<T> distribution(-10, 10);
+
+            Tensor<T> batch(Shape{count, n, n});
+            for (int i = 0; i < count; ++i)
+                for (int r = 0; r < n; ++r)
+                    for (int c = r; c < n; ++c)
+                        batch.data[(i * n + r) * n + c] = batch.data[(i * n + c) * n + r] = distribution(generator);
+
+            Tensor<T> values = batched_eigenvalues(batch, 2);
+            REQUIRE(values.shape == (Shape{count, n}));
+
+            for (int i = 0; i < count; ++i) {
+                Tensor<T> matrix(Shape{n, n});
+                std::copy(batch.data.data + i * n * n, batch.data.data + (i + 1) * n * n, matrix.data.data);
+
+                T norm = 0;
+                for (int e = 0; e < n * n; ++e)
+                    norm += matrix.data[e] * matrix.data[e];
+
+                const T tolerance = (std::is_same<T, float>::value ? T(1e-4) : T(1e-10)) * std::sqrt(norm);
+
+                Tensor<T> expected = symmetric_eigenvalues(matrix, 1);
+                for (int j = 0; j < n; ++j)
+                    REQUIRE(std::abs(values.data[i * n + j] - expected.data[j]) <= tolerance);
+            }
+        }
+    }
+
+    { // Diagonal, scalar and repeated eigenvalues
+        T data[4 * 9] = {3, 0, 0, 0, 1, 0, 0, 0, 2,
+                         5, 0, 0, 0, 5, 0, 0, 0, 5,
+                         0, 0, 0, 0, 0, 0, 0, 0, 0,
+                         2, 1, 1, 1, 2, 1, 1, 1, 2};
+        T expected[4 * 3] = {1, 2, 3,
+                             5, 5, 5,
+                             0, 0, 0,
+                             1, 1, 4};
+
+        Tensor<T> values = batched_eigenvalues(Tensor<T>(Shape{4, 3, 3}, AlignedPtr<T>(data, 36)));
+        for (int i = 0; i < 12; ++i)
+            REQUIRE(std::abs(values.data[i] - expected[i]) <= T(1e-3));
+    }
+
+    { // 2x2 closed form
+        T data[8] = {2, 1, 1, 2, 1, 0, 0, -1};
+        T expected[4] = {1, 3, -1, 1};
+
+        REQUIRE((approx_equal(batched_eigenvalues(Tensor<T>(Shape{2, 2, 2}, AlignedPtr<T>(data, 8))),
+                              Tensor<T>(Shape{2, 2}, AlignedPtr<T>(expected, 4)))));
+    }
+
+    REQUIRE_THROWS((batched_eigenvalues(Tensor<T>(Shape{3, 3}))));
+    REQUIRE_THROWS((batched_eigenvalues(Tensor<T>(Shape{2, 3, 4}))));
+    REQUIRE_THROWS((batched_eigenvalues(Tensor<T>(Shape{2, 9, 9}))));
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_BATCHED_EIGEN_IMPL_HPP
@@ -0,0 +1,764 @@
+#ifndef TNT_LINEAR_BLAS1_IMPL_HPP
+#define TNT_LINEAR_BLAS1_IMPL_HPP
+
+#include <tnt/linear/blas1.hpp>
+
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Walks the rows along the last axis of a strided view. Each row starts at
+/// `offset` and holds `length` elements spaced `increment` apart.
+struct StridedRows
+{
+    StridedRows(const Shape& shape, const Stride& stride, int offset)
+        : count(shape.total() == 0 ? 0 : shape.total() / shape[shape.num_axes() - 1]),
+          length(shape.total() == 0 ? 0 : shape[shape.num_axes() - 1]),
+          increment(shape.total() == 0 ? 0 : stride[stride.num_axes() - 1]),
+          offset(offset), shape(shape), stride(stride), loc(shape.num_axes(), 0)
+    {
+    }
+
+    /// Move `offset` to the start of the next row
+    void next() noexcept
+    {
+        for (int i = shape.num_axes() - 2; i >= 0; --i) {
+            offset += stride[i];
+            if (++loc[i] < shape[i])
+                return;
+
+            offset -= shape[i] * stride[i];
+            loc[i] = 0;
+        }
+    }
+
+    int count;
+    int length;
+    int increment;
+    int offset;
+
+    Shape shape;
+    Stride stride;
+    std::vector<int> loc;
+};
+
+/// Applies a `y = kernel(x, y)` update to contiguous tensors or to the rows of
+/// strided views. `Kernel` provides a SIMD `run` and a matching `scalar`.
+template <typename DataType, typename Kernel>
+struct UpdateLevel1
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static void eval(const Kernel& kernel, const Tensor<DataType>& x, Tensor<DataType>& y) noexcept
+    {
+        contiguous(kernel, x.data.data, y.data.data, x.shape.total(), HasMultiplyAddSIMD<DataType>());
+    }
+
+    /// Update `length` contiguous values
+    static TNT_INL void row(const Kernel& kernel, const DataType* x, DataType* y, int length) noexcept
+    {
+        contiguous(kernel, x, y, length, HasMultiplyAddSIMD<DataType>());
+    }
+
+    static void eval(const Kernel& kernel, const TensorView<DataType>& x, const TensorView<DataType>& y) noexcept
+    {
+        StridedRows x_rows(x.shape, x.stride, x.offset);
+        StridedRows y_rows(y.shape, y.stride, y.offset);
+
+        for (int row = 0; row < x_rows.count; ++row, x_rows.next(), y_rows.next()) {
+            const DataType* x_ptr = x.data + x_rows.offset;
+            DataType*       y_ptr = y.data + y_rows.offset;
+
+            if (x_rows.increment == 1 && y_rows.increment == 1)
+                contiguous(kernel, x_ptr, y_ptr, x_rows.length, HasMultiplyAddSIMD<DataType>());
+            else
+                strided(kernel, x_ptr, x_rows.increment, y_ptr, y_rows.increment, x_rows.length);
+        }
+    }
+
+private:
+    static TNT_INL void contiguous(const Kernel& kernel, const DataType* x, DataType* y, int length, std::true_type) noexcept
+    {
+        const int num_blocks = length / Size;
+
+        for (int offset = 0; offset < num_blocks * Size; offset += Size) {
+            VecType x_block = simdpp::load_u<VecType>(x + offset);
+            VecType y_block = simdpp::load_u<VecType>(y + offset);
+            simdpp::store_u(y + offset, kernel.run(x_block, y_block));
+        }
+
+        strided(kernel, x + num_blocks * Size, 1, y + num_blocks * Size, 1, length - num_blocks * Size);
+    }
+
+    static TNT_INL void contiguous(const Kernel& kernel, const DataType* x, DataType* y, int length, std::false_type) noexcept
+    {
+        strided(kernel, x, 1, y, 1, length);
+    }
+
+    static TNT_INL void strided(const Kernel& kernel, const DataType* x, int incx, DataType* y, int incy, int length) noexcept
+    {
+        for (int i = 0; i < length; ++i, x += incx, y += incy)
+            *y = kernel.scalar(*x, *y);
+    }
+};
+
+/// Reduces contiguous tensors or the rows of strided views. `Reducer`
+/// provides `contiguous` and `strided` row reductions and `combine`, which
+/// merges the results of two rows.
+template <typename DataType, typename Reducer>
+struct ReduceLevel1
+{
+    static DataType eval(const Reducer& reducer, const Tensor<DataType>& x) noexcept
+    {
+        return reducer.contiguous(x.data.data, x.shape.total());
+    }
+
+    static DataType eval(const Reducer& reducer, const TensorView<DataType>& x) noexcept
+    {
+        StridedRows rows(x.shape, x.stride, x.offset);
+
+        DataType result = 0;
+        for (int row = 0; row < rows.count; ++row, rows.next()) {
+            const DataType* ptr = x.data + rows.offset;
+            result = reducer.combine(result, rows.increment == 1 ? reducer.contiguous(ptr, rows.length)
+                                                                 : reducer.strided(ptr, rows.increment, rows.length));
+        }
+
+        return result;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Elementwise kernels
+
+template <typename DataType>
+struct AxpyKernel
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    explicit AxpyKernel(const DataType& a) : a(a), a_vec(simdpp::load_splat<VecType>(&a)) {}
+
+    TNT_INL VecType run(const VecType& x, const VecType& y) const
+    {
+        return MultiplyAddSIMD<DataType>::run(a_vec, x, y);
+    }
+
+    TNT_INL DataType scalar(const DataType& x, const DataType& y) const
+    {
+        return MultiplyAddSIMD<DataType>::scalar(a, x, y);
+    }
+
+    DataType a;
+    VecType  a_vec;
+};
+
+/// Compute `y += a * x` over `length` contiguous values
+template <typename DataType>
+inline void multiply_add_row(const DataType& a, const DataType* x, DataType* y, int length) noexcept
+{
+    UpdateLevel1<DataType, AxpyKernel<DataType>>::row(AxpyKernel<DataType>(a), x, y, length);
+}
+
+/// The plane rotation `x' = c x - s y`, `y' = s x + c y` of two contiguous
+/// arrays
+template <typename DataType>
+struct PlaneRotation
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static TNT_INL void apply(DataType* x, DataType* y, int length, DataType c, DataType s) noexcept
+    {
+        const VecType c_vec = simdpp::load_splat<VecType>(&c);
+        const VecType s_vec = simdpp::load_splat<VecType>(&s);
+
+        int i = 0;
+        for ( ; i + Size <= length; i += Size) {
+            const VecType x_block = simdpp::load_u<VecType>(x + i);
+            const VecType y_block = simdpp::load_u<VecType>(y + i);
+
+            simdpp::store_u(x + i, VecType(simdpp::sub(simdpp::mul(x_block, c_vec), simdpp::mul(y_block, s_vec))));
+            simdpp::store_u(y + i, VecType(simdpp::add(simdpp::mul(x_block, s_vec), simdpp::mul(y_block, c_vec))));
+        }
+
+        for ( ; i < length; ++i) {
+            const DataType x_value = x[i];
+            x[i] = c * x_value - s * y[i];
+            y[i] = s * x_value + c * y[i];
+        }
+    }
+};
+
+template <typename DataType>
+struct AxpbyKernel
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    AxpbyKernel(const DataType& a, const DataType& b)
+        : a(a), b(b), a_vec(simdpp::load_splat<VecType>(&a)), b_vec(simdpp::load_splat<VecType>(&b)) {}
+
+    TNT_INL VecType run(const VecType& x, const VecType& y) const
+    {
+        return MultiplyAddSIMD<DataType>::run(a_vec, x, MultiplySIMD<DataType>::run(b_vec, y));
+    }
+
+    TNT_INL DataType scalar(const DataType& x, const DataType& y) const
+    {
+        return MultiplyAddSIMD<DataType>::scalar(a, x, MultiplyAddSIMD<DataType>::scalar(b, y, 0));
+    }
+
+    DataType a, b;
+    VecType  a_vec, b_vec;
+};
+
+/// Scaling reads and writes the same elements, `x` and `y` alias
+template <typename DataType>
+struct ScalKernel
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    explicit ScalKernel(const DataType& a) : a(a), a_vec(simdpp::load_splat<VecType>(&a)) {}
+
+    TNT_INL VecType run(const VecType& x, const VecType&) const
+    {
+        return MultiplySIMD<DataType>::run(a_vec, x);
+    }
+
+    TNT_INL DataType scalar(const DataType& x, const DataType&) const
+    {
+        return MultiplyAddSIMD<DataType>::scalar(a, x, 0);
+    }
+
+    DataType a;
+    VecType  a_vec;
+};
+
+template <typename DataType>
+struct OptimizedAxpy<DataType, typename std::enable_if<std::is_arithmetic<DataType>::value>::type>
+{
+    static void eval(const DataType& a, const Tensor<DataType>& x, Tensor<DataType>& y) noexcept
+    {
+        UpdateLevel1<DataType, AxpyKernel<DataType>>::eval(AxpyKernel<DataType>(a), x, y);
+    }
+
+    static void eval(const DataType& a, const TensorView<DataType>& x, const TensorView<DataType>& y) noexcept
+    {
+        UpdateLevel1<DataType, AxpyKernel<DataType>>::eval(AxpyKernel<DataType>(a), x, y);
+    }
+};
+
+template <typename DataType>
+struct OptimizedAxpby<DataType, typename std::enable_if<std::is_arithmetic<DataType>::value>::type>
+{
+    static void eval(const DataType& a, const Tensor<DataType>& x, const DataType& b, Tensor<DataType>& y) noexcept
+    {
+        UpdateLevel1<DataType, AxpbyKernel<DataType>>::eval(AxpbyKernel<DataType>(a, b), x, y);
+    }
+
+    static void eval(const DataType& a, const TensorView<DataType>& x, const DataType& b, const TensorView<DataType>& y) noexcept
+    {
+        UpdateLevel1<DataType, AxpbyKernel<DataType>>::eval(AxpbyKernel<DataType>(a, b), x, y);
+    }
+};
+
+template <typename DataType>
+struct OptimizedScal<DataType, typename std::enable_if<std::is_arithmetic<DataType>::value>::type>
+{
+    static void eval(const DataType& a, Tensor<DataType>& x) noexcept
+    {
+        UpdateLevel1<DataType, ScalKernel<DataType>>::eval(ScalKernel<DataType>(a), x, x);
+    }
+
+    static void eval(const DataType& a, const TensorView<DataType>& x) noexcept
+    {
+        UpdateLevel1<DataType, ScalKernel<DataType>>::eval(ScalKernel<DataType>(a), x, x);
+    }
+};
+
+template <typename DataType>
+struct OptimizedFma<DataType, typename std::enable_if<std::is_arithmetic<DataType>::value>::type>
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static Tensor<DataType> eval(const Tensor<DataType>& a, const Tensor<DataType>& b, const Tensor<DataType>& c)
+    {
+        Tensor<DataType> result(a.shape);
+
+        run(a.data.data, b.data.data, c.data.data, result.data.data, a.shape.total(), HasMultiplyAddSIMD<DataType>());
+
+        return result;
+    }
+
+private:
+    // Tensor buffers are padded to whole SIMD blocks, no scalar tail is needed
+    static TNT_INL void run(const DataType* a, const DataType* b, const DataType* c, DataType* out, int total, std::true_type) noexcept
+    {
+        if (total == 0)
+            return;
+
+        int offset = 0, num_blocks = AlignSIMDType<DataType>::num_aligned_blocks(total);
+        for ( ; num_blocks--; offset += Size) {
+            VecType a_block = simdpp::load<VecType>(a + offset);
+            VecType b_block = simdpp::load<VecType>(b + offset);
+            VecType c_block = simdpp::load<VecType>(c + offset);
+            simdpp::store(out + offset, MultiplyAddSIMD<DataType>::run(a_block, b_block, c_block));
+        }
+    }
+
+    static TNT_INL void run(const DataType* a, const DataType* b, const DataType* c, DataType* out, int total, std::false_type) noexcept
+    {
+        for (int i = 0; i < total; ++i)
+            out[i] = MultiplyAddSIMD<DataType>::scalar(a[i], b[i], c[i]);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Reductions
+
+template <typename DataType>
+struct AsumReducer
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    TNT_INL DataType contiguous(const DataType* x, int length) const
+    {
+        const int num_blocks = length / Size;
+
+        DataType sum = 0;
+        if (num_blocks > 0) {
+            VecType sum_vec = simdpp::load_splat<VecType>(&sum);
+            for (int offset = 0; offset < num_blocks * Size; offset += Size)
+                sum_vec = simdpp::add(sum_vec, VecType(simdpp::abs(simdpp::load_u<VecType>(x + offset))));
+
+            sum = simdpp::reduce_add(sum_vec);
+        }
+
+        return sum + strided(x + num_blocks * Size, 1, length - num_blocks * Size);
+    }
+
+    TNT_INL DataType strided(const DataType* x, int incx, int length) const
+    {
+        DataType sum = 0;
+        for (int i = 0; i < length; ++i, x += incx)
+            sum += std::fabs(*x);
+
+        return sum;
+    }
+
+    TNT_INL DataType combine(const DataType& left, const DataType& right) const
+    {
+        return left + right;
+    }
+};
+
+template <typename DataType>
+struct MaxAbsReducer
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    TNT_INL DataType contiguous(const DataType* x, int length) const
+    {
+        const int num_blocks = length / Size;
+
+        DataType result = 0;
+        if (num_blocks > 0) {
+            VecType max_vec = simdpp::load_splat<VecType>(&result);
+            for (int offset = 0; offset < num_blocks * Size; offset += Size)
+                max_vec = simdpp::max(max_vec, VecType(simdpp::abs(simdpp::load_u<VecType>(x + offset))));
+
+            result = simdpp::reduce_max(max_vec);
+        }
+
+        return combine(result, strided(x + num_blocks * Size, 1, length - num_blocks * Size));
+    }
+
+    TNT_INL DataType strided(const DataType* x, int incx, int length) const
+    {
+        DataType result = 0;
+        for (int i = 0; i < length; ++i, x += incx)
+            result = combine(result, std::fabs(*x));
+
+        return result;
+    }
+
+    TNT_INL DataType combine(const DataType& left, const DataType& right) const
+    {
+        return std::max(left, right);
+    }
+};
+
+/// Sum of `(scale * x)^2`. A scale of 1 is the unscaled fast path.
+template <typename DataType>
+struct SquareSumReducer
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    explicit SquareSumReducer(const DataType& scale) : scale(scale) {}
+
+    TNT_INL DataType contiguous(const DataType* x, int length) const
+    {
+        const int num_blocks = length / Size;
+
+        DataType sum = 0;
+        if (num_blocks > 0) {
+            VecType sum_vec   = simdpp::load_splat<VecType>(&sum);
+            VecType scale_vec = simdpp::load_splat<VecType>(&scale);
+            for (int offset = 0; offset < num_blocks * Size; offset += Size) {
+                VecType block = simdpp::mul(simdpp::load_u<VecType>(x + offset), scale_vec);
+                sum_vec = MultiplyAddSIMD<DataType>::run(block, block, sum_vec);
+            }
+
+            sum = simdpp::reduce_add(sum_vec);
+        }
+
+        return sum + strided(x + num_blocks * Size, 1, length - num_blocks * Size);
+    }
+
+    TNT_INL DataType strided(const DataType* x, int incx, int length) const
+    {
+        DataType sum = 0;
+        for (int i = 0; i < length; ++i, x += incx) {
+            const DataType value = *x * scale;
+            sum = MultiplyAddSIMD<DataType>::scalar(value, value, sum);
+        }
+
+        return sum;
+    }
+
+    TNT_INL DataType combine(const DataType& left, const DataType& right) const
+    {
+        return left + right;
+    }
+
+    DataType scale;
+};
+
+/// The inner product of `length` contiguous values of `x` and `y`, with one
+/// accumulator per lane
+template <typename DataType>
+inline DataType dot_row(const DataType* x, const DataType* y, int length) noexcept
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr int Size = OptimalSIMDSize<DataType>::value;
+
+    const int num_blocks = length / Size;
+
+    DataType sum = 0;
+    if (num_blocks > 0) {
+        VecType sum_vec = simdpp::load_splat<VecType>(&sum);
+        for (int offset = 0; offset < num_blocks * Size; offset += Size)
+            sum_vec = MultiplyAddSIMD<DataType>::run(simdpp::load_u<VecType>(x + offset), simdpp::load_u<VecType>(y + offset), sum_vec);
+
+        sum = simdpp::reduce_add(sum_vec);
+    }
+
+    for (int i = num_blocks * Size; i < length; ++i)
+        sum = MultiplyAddSIMD<DataType>::scalar(x[i], y[i], sum);
+
+    return sum;
+}
+
+template <typename DataType>
+struct OptimizedAsum<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    static DataType eval(const Tensor<DataType>& x) noexcept
+    {
+        return ReduceLevel1<DataType, AsumReducer<DataType>>::eval(AsumReducer<DataType>(), x);
+    }
+
+    static DataType eval(const TensorView<DataType>& x) noexcept
+    {
+        return ReduceLevel1<DataType, AsumReducer<DataType>>::eval(AsumReducer<DataType>(), x);
+    }
+};
+
+/// The squares are summed directly first. Only when that sum overflows, or
+/// is small enough that squares may have underflowed, is a second pass made
+/// over the elements scaled by a power of two near the largest magnitude.
+/// Scaling by a power of two is exact.
+template <typename DataType>
+struct OptimizedNrm2<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using Limits = std::numeric_limits<DataType>;
+
+    static DataType eval(const Tensor<DataType>& x) noexcept
+    {
+        return run(x);
+    }
+
+    static DataType eval(const TensorView<DataType>& x) noexcept
+    {
+        return run(x);
+    }
+
+private:
+    template <typename InputType>
+    static DataType run(const InputType& x) noexcept
+    {
+        using SquareSum = ReduceLevel1<DataType, SquareSumReducer<DataType>>;
+        using MaxAbs    = ReduceLevel1<DataType, MaxAbsReducer<DataType>>;
+
+        const DataType sum = SquareSum::eval(SquareSumReducer<DataType>(1), x);
+        if (std::isnan(sum) || (sum >= Limits::min() / Limits::epsilon() && sum <= Limits::max()))
+            return std::sqrt(sum);
+
+        const DataType max = MaxAbs::eval(MaxAbsReducer<DataType>(), x);
+        if (max == 0 || std::isinf(max))
+            return max;
+
+        const int exponent = std::max(std::ilogb(max), Limits::min_exponent - 1);
+        const DataType scaled = SquareSum::eval(SquareSumReducer<DataType>(std::ldexp(DataType(1), -exponent)), x);
+
+        return std::ldexp(std::sqrt(scaled), exponent);
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("axpy(Scalar, const Tensor<T>&, Tensor<T>&)", T, test_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> x(shape), y(shape), expected(shape);
+        for (int i = 0; i < shape.total(); ++i) {
+            x.data[i] = (T) (i % 5);
+            y.data[i] = (T) (i % 7);
+            expected.data[i] = (T) (3 * (i % 5) + (i % 7));
+        }
+
+        axpy(3, x, y);
+        REQUIRE((y == expected));
+    };
+
+    test_shape(Shape{1});
+    test_shape(Shape{37});
+    test_shape(Shape{3, 5, 7});
+
+    Tensor<T> x(Shape{2, 3}), y(Shape{3, 2});
+    REQUIRE_THROWS(axpy(1, x, y));
+}
+
+TEST_CASE_TEMPLATE("axpy(Scalar, const TensorView<T>&, const TensorView<T>&)", T, test_data_types)
+{
+    T x_data[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+
+    { // Columns, increment 4 and 3
+        T y_data[9] = {1, 1, 1, 1, 1, 1, 1, 1, 1};
+
+        axpy(2, TensorView<T>(Shape{3}, Stride{4}, 1, x_data), TensorView<T>(Shape{3}, Stride{3}, 0, y_data));
+
+        T expected[9] = {5, 1, 1, 13, 1, 1, 21, 1, 1};
+        for (int i = 0; i < 9; ++i)
+            REQUIRE(y_data[i] == expected[i]);
+    }
+
+    { // 2x2 blocks with contiguous rows
+        Tensor<T> x(Shape{3, 4}, AlignedPtr<T>(x_data, 12));
+        Tensor<T> y(Shape{3, 4}, 1);
+
+        axpy(1, x(Range{1, 3}, Range{2, 4}), y(Range{0, 2}, Range{0, 2}));
+
+        T expected[12] = {8, 9, 1, 1, 12, 13, 1, 1, 1, 1, 1, 1};
+        REQUIRE((y == Tensor<T>(Shape{3, 4}, AlignedPtr<T>(expected, 12))));
+    }
+
+    { // Long rows exercise the SIMD path
+        Tensor<T> x(Shape{2, 67}), y(Shape{2, 67}, 1), expected(Shape{2, 67}, 1);
+        for (int i = 0; i < x.shape.total(); ++i)
+            x.data[i] = (T) (i % 9);
+        for (int i = 0; i < 67; ++i)
+            expected.data[67 + i] = (T) (1 + 2 * (i % 9));
+
+        axpy(2, x(Range{0, 1}), y(Range{1, 2}));
+        REQUIRE((y == expected));
+    }
+}
+
+TEST_CASE_TEMPLATE("axpby(Scalar, const Tensor<T>&, Scalar, Tensor<T>&)", T, test_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> x(shape), y(shape), expected(shape);
+        for (int i = 0; i < shape.total(); ++i) {
+            x.data[i] = (T) (i % 5);
+            y.data[i] = (T) (i % 7);
+            expected.data[i] = (T) (3 * (i % 5) + 2 * (i % 7));
+        }
+
+        axpby(3, x, 2, y);
+        REQUIRE((y == expected));
+    };
+
+    test_shape(Shape{1});
+    test_shape(Shape{37});
+    test_shape(Shape{3, 5, 7});
+
+    { // Views
+        T x_data[6] = {1, 2, 3, 4, 5, 6};
+        T y_data[6] = {1, 1, 1, 1, 1, 1};
+
+        axpby(1, TensorView<T>(Shape{2}, Stride{3}, 2, x_data), 3, TensorView<T>(Shape{2}, Stride{2}, 1, y_data));
+
+        T expected[6] = {1, 6, 1, 9, 1, 1};
+        for (int i = 0; i < 6; ++i)
+            REQUIRE(y_data[i] == expected[i]);
+    }
+}
+
+TEST_CASE_TEMPLATE("fma(const Tensor<T>&, const Tensor<T>&, const Tensor<T>&)", T, test_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> a(shape), b(shape), c(shape), expected(shape);
+        for (int i = 0; i < shape.total(); ++i) {
+            a.data[i] = (T) (i % 5);
+            b.data[i] = (T) (i % 3);
+            c.data[i] = (T) (i % 7);
+            expected.data[i] = (T) ((i % 5) * (i % 3) + (i % 7));
+        }
+
+        REQUIRE((fma(a, b, c) == expected));
+    };
+
+    test_shape(Shape{1});
+    test_shape(Shape{37});
+    test_shape(Shape{3, 5, 7});
+
+    Tensor<T> a(Shape{2, 3}), b(Shape{2, 3}), c(Shape{6});
+    REQUIRE_THROWS(fma(a, b, c));
+}
+
+TEST_CASE("fma(const Tensor<T>&, const Tensor<T>&, const Tensor<T>&) rounding")
+{
+    // (1 + 2^-23)^2 - (1 + 2^-22) is exactly 2^-46 with one rounding and 0
+    // with two
+    const float e = std::ldexp(1.f, -23);
+
+    Tensor<float> a(Shape{9}, 1 + e), c(Shape{9}, -(1 + 2 * e));
+    Tensor<float> result = fma(a, a, c);
+
+#if SIMDPP_USE_FMA3 || SIMDPP_USE_FMA4
+    for (int i = 0; i < 9; ++i)
+        REQUIRE(result.data[i] == std::ldexp(1.f, -46));
+#else
+    for (int i = 0; i < 9; ++i)
+        REQUIRE(result.data[i] == 0);
+#endif
+}
+
+TEST_CASE_TEMPLATE("scal(Scalar, Tensor<T>&)", T, test_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> x(shape), expected(shape);
+        for (int i = 0; i < shape.total(); ++i) {
+            x.data[i] = (T) (i % 11);
+            expected.data[i] = (T) (5 * (i % 11));
+        }
+
+        scal(5, x);
+        REQUIRE((x == expected));
+    };
+
+    test_shape(Shape{1});
+    test_shape(Shape{37});
+    test_shape(Shape{3, 5, 7});
+
+    { // Every other column of a 2x4 matrix
+        T data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+        scal(2, TensorView<T>(Shape{2, 2}, Stride{4, 2}, 0, data));
+
+        T expected[8] = {2, 2, 6, 4, 10, 6, 14, 8};
+        for (int i = 0; i < 8; ++i)
+            REQUIRE(data[i] == expected[i]);
+    }
+}
+
+TEST_CASE_TEMPLATE("nrm2(const Tensor<T>&)", T, test_float_data_types)
+{
+    using Limits = std::numeric_limits<T>;
+
+    {
+        Tensor<T> x(Shape{4, 9}, 0);
+        x.data[3] = 3; x.data[30] = -4;
+
+        REQUIRE(nrm2(x) == 5);
+        REQUIRE(nrm2(Tensor<T>(Shape{7}, 0)) == 0);
+    }
+
+    { // Sum of squares near the overflow and underflow thresholds
+        const T big   = std::ldexp(T(1), Limits::max_exponent - 4);
+        const T small = std::ldexp(T(1), Limits::min_exponent - 10);
+
+        Tensor<T> large(Shape{33}, 0), tiny(Shape{33}, 0);
+        large.data[0] = 3 * big; large.data[32] = 4 * big;
+        tiny.data[0]  = 3 * small; tiny.data[32] = 4 * small;
+
+        REQUIRE(nrm2(large) == 5 * big);
+        REQUIRE(nrm2(tiny)  == 5 * small);
+    }
+
+    { // Random values against a long double reference
+        Tensor<T> x(Shape{1001});
+        long double reference = 0;
+        for (int i = 0; i < x.shape.total(); ++i) {
+            x.data[i] = (T) std::sin((double) i);
+            reference += (long double) x.data[i] * x.data[i];
+        }
+
+        REQUIRE(std::fabs(nrm2(x) - (T) std::sqrt(reference)) <= 8 * Limits::epsilon() * std::sqrt(reference));
+    }
+
+    { // Special values
+        Tensor<T> x(Shape{17}, 1);
+        x.data[5] = Limits::infinity();
+        REQUIRE(nrm2(x) == Limits::infinity());
+
+        x.data[9] = Limits::quiet_NaN();
+        REQUIRE(std::isnan(nrm2(x)));
+    }
+
+    { // Strided view
+        T data[6] = {3, 1, 1, 4, 1, 1};
+        REQUIRE(nrm2(TensorView<T>(Shape{2}, Stride{3}, 0, data)) == 5);
+    }
+}
+
+TEST_CASE_TEMPLATE("asum(const Tensor<T>&)", T, test_float_data_types)
+{
+    Tensor<T> x(Shape{3, 5, 7});
+    for (int i = 0; i < x.shape.total(); ++i)
+        x.data[i] = (T) ((i % 2 ? -1 : 1) * (i % 6));
+
+    T expected = 0;
+    for (int i = 0; i < x.shape.total(); ++i)
+        expected += (T) (i % 6);
+
+    REQUIRE(asum(x) == expected);
+
+    T data[8] = {-1, 2, -3, 4, -5, 6, -7, 8};
+    REQUIRE(asum(TensorView<T>(Shape{2, 2}, Stride{4, 2}, 1, data)) == 20);
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_BLAS1_IMPL_HPP
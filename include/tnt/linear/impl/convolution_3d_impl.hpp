@@ -2,6 +2,9 @@
 #define TNT_LINEAR_CONVOLUTION_3D_IMPL_HPP
 
 #include <tnt/linear/convolution.hpp>
+#include <tnt/linear/impl/matrix_multiply_impl.hpp>
+#include <tnt/linear/impl/winograd_convolution_impl.hpp>
+#include <tnt/linear/impl/fft_convolution_impl.hpp>
 #include <tnt/utils/testing.hpp>
 #include <tnt/utils/simd.hpp>
 
@@ -11,65 +14,374 @@ namespace tnt
 namespace detail
 {
 
+/// Convolution is lowered to matrix multiplication one block of output
+/// pixels at a time, so the lowered patches stay in cache and never exceed
+/// `BlockElements` values. The orientation of the product depends on the
+/// number of kernels. With many kernels each output pixel is a row of the
+/// product, which is written straight into the `OH x OW x K` output. With
+/// few kernels each kernel is a row, so the long pixel dimension fills the
+/// GEMM register tiles, and the product is transposed into the output.
+///
+/// Floating point 3x3 kernels with unit stride go to
+/// [OptimizedWinogradConvolution]() once there are enough channels and
+/// kernels for the transforms to be paid back by the smaller GEMMs. Floating
+/// point kernels of at least `FFTMinimumTaps` taps with unit stride go to
+/// [OptimizedFFTConvolution](), whose cost does not grow with the kernel area.
 template <typename DataType>
 struct OptimizedConvolution3D<DataType, void>
 {
-    using VecType = typename SIMDType<DataType>::VecType;
+    using Multiply = OptimizedMatrixMultiply<DataType>;
 
-public:
-    static Tensor<DataType> eval(const Tensor<DataType>& tensor, const Tensor<DataType>& kernel, int pad, int stride)
+    constexpr static int BlockElements  = 1 << 15;
+    constexpr static int FFTMinimumTaps = 11 * 11;
+
+    struct Geometry
     {
-        /// Convolution 3D is done by tiling the column x channel operations and
-        /// dispatching them with as element wise multiplication
-        int output_rows = (tensor.shape[0] - kernel.shape[0] + 2 * pad) / stride + 1;
-        int output_cols = (tensor.shape[1] - kernel.shape[1] + 2 * pad) / stride + 1;
-        Tensor<DataType> output(Shape{output_rows, output_cols});
+        int height, width, channels;
+        int kernel_rows, kernel_cols, num_kernels;
+        int out_rows, out_cols;
+        int pad, stride;
+        DataType pad_value;
 
-        const DataType* t_ptr = tensor.data.data;
-        const DataType* k_ptr = kernel.data.data;
-        DataType* o_ptr       = output.data.data;
+        int patch()  const { return kernel_rows * kernel_cols * channels; }
+        int pixels() const { return out_rows * out_cols; }
+        int block()  const { return std::max(1, std::min(pixels(), BlockElements / patch())); }
+    };
 
-        const int row_step = tensor.shape[1] * tensor.shape[2];
-        const int col_step = tensor.shape[2];
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor, const Tensor<DataType>& kernel, int pad, DataType pad_value, int stride)
+    {
+        const int kernel_axis = kernel.shape.num_axes() - 3;
 
-        const int channel_steps     = kernel.shape[2] / OptimalSIMDSize<DataType>::value;
-        const int channel_remainder = kernel.shape[2] - (channel_steps * OptimalSIMDSize<DataType>::value);
+        Geometry geometry;
+        geometry.height      = tensor.shape[0];
+        geometry.width       = tensor.shape[1];
+        geometry.channels    = tensor.shape[2];
+        geometry.kernel_rows = kernel.shape[kernel_axis];
+        geometry.kernel_cols = kernel.shape[kernel_axis + 1];
+        geometry.num_kernels = kernel_axis == 1 ? kernel.shape[0] : 1;
+        geometry.out_rows    = (geometry.height + 2 * pad - geometry.kernel_rows) / stride + 1;
+        geometry.out_cols    = (geometry.width  + 2 * pad - geometry.kernel_cols) / stride + 1;
+        geometry.pad         = pad;
+        geometry.stride      = stride;
+        geometry.pad_value   = pad_value;
 
-        int start_row = -pad, start_col = -pad;
+        if (winograd_profitable(geometry))
+            return winograd(tensor, kernel, geometry, typename std::is_floating_point<DataType>::type());
 
-        int steps = output_rows * output_cols;
-        for (int i = 0; --steps; ++i) {
-            o_ptr[i] = 0;
+        if (fft_profitable(geometry))
+            return fft(tensor, kernel, geometry, typename std::is_floating_point<DataType>::type());
 
-            int kernel_rows = kernel.shape[0];
-            for (int row = start_row; --kernel_rows; ++row) {
-                if (row < 0) {
-                    continue;
-                }
+        Tensor<DataType> output = zeros<DataType>(Shape{geometry.out_rows, geometry.out_cols, geometry.num_kernels});
+
+        if (geometry.num_kernels >= Multiply::TileCols)
+            pixel_major(geometry, tensor.data.data, kernel.data.data, output.data.data);
+        else
+            kernel_major(geometry, tensor.data.data, kernel.data.data, output.data.data);
+
+        return output;
+    }
+
+private:
+    static bool winograd_profitable(const Geometry& geometry)
+    {
+        return std::is_floating_point<DataType>::value
+                && geometry.kernel_rows == 3 && geometry.kernel_cols == 3 && geometry.stride == 1
+                && geometry.channels >= 8 && geometry.num_kernels >= 8;
+    }
+
+    /// F(4x4, 3x3) saves more multiplies than F(2x2, 3x3) but wastes more of
+    /// its edge tiles on small outputs
+    static Tensor<DataType> winograd(const Tensor<DataType>& tensor, const Tensor<DataType>& kernel, const Geometry& geometry, std::true_type)
+    {
+        if (geometry.out_rows >= 8 && geometry.out_cols >= 8)
+            return OptimizedWinogradConvolution<DataType, 4>::eval(tensor, kernel, geometry.pad, geometry.pad_value);
+
+        return OptimizedWinogradConvolution<DataType, 2>::eval(tensor, kernel, geometry.pad, geometry.pad_value);
+    }
+
+    static Tensor<DataType> winograd(const Tensor<DataType>&, const Tensor<DataType>&, const Geometry&, std::false_type)
+    {
+        return Tensor<DataType>();
+    }
+
+    static bool fft_profitable(const Geometry& geometry)
+    {
+        return std::is_floating_point<DataType>::value
+                && geometry.kernel_rows * geometry.kernel_cols >= FFTMinimumTaps && geometry.stride == 1;
+    }
+
+    /// The kernel spectra are sized for this tensor, so small tensors are not
+    /// cut into mostly empty tiles
+    static Tensor<DataType> fft(const Tensor<DataType>& tensor, const Tensor<DataType>& kernel, const Geometry& geometry, std::true_type)
+    {
+        const int size = OptimizedFFTConvolution<DataType>::optimal_size(
+                geometry.kernel_rows, geometry.kernel_cols,
+                (long long) geometry.channels * ((geometry.num_kernels + 1) / 2),
+                geometry.height + 2 * geometry.pad, geometry.width + 2 * geometry.pad);
 
-                int kernel_cols = kernel.shape[1];
-                for (int col = start_col; --kernel_cols; ++col) {
-                    if (col < 0) {
-                        continue;
+        return OptimizedFFTConvolution<DataType>::eval(tensor, KernelSpectrum<DataType>(kernel, size), geometry.pad, geometry.pad_value);
+    }
+
+    static Tensor<DataType> fft(const Tensor<DataType>&, const Tensor<DataType>&, const Geometry&, std::false_type)
+    {
+        return Tensor<DataType>();
+    }
+
+    /// `output (pixels x K) = patches (pixels x patch) * kernels^T (patch x K)`
+    static void pixel_major(const Geometry& geometry, const DataType* input, const DataType* kernel, DataType* output)
+    {
+        const int patch = geometry.patch(), pixels = geometry.pixels(), num_kernels = geometry.num_kernels;
+
+        AlignedPtr<DataType> weights(patch * num_kernels);
+        for (int k = 0; k < num_kernels; ++k)
+            for (int q = 0; q < patch; ++q)
+                weights.data[q * num_kernels + k] = kernel[k * patch + q];
+
+        // The input already is the patch matrix of a 1x1 kernel
+        if (geometry.kernel_rows == 1 && geometry.kernel_cols == 1 && geometry.stride == 1 && geometry.pad == 0) {
+            Multiply::gemm(pixels, num_kernels, patch, input, patch, weights.data, num_kernels, output, num_kernels);
+            return;
+        }
+
+        const int block = geometry.block();
+        AlignedPtr<DataType> patches(block * patch);
+
+        for (int first = 0; first < pixels; first += block) {
+            const int count = std::min(block, pixels - first);
+
+            lower_rows(geometry, input, first, count, patches.data);
+            Multiply::gemm(count, num_kernels, patch, patches.data, patch, weights.data, num_kernels,
+                           output + first * num_kernels, num_kernels);
+        }
+    }
+
+    /// `result (K x pixels) = kernels (K x patch) * patches^T (patch x pixels)`
+    static void kernel_major(const Geometry& geometry, const DataType* input, const DataType* kernel, DataType* output)
+    {
+        const int patch = geometry.patch(), pixels = geometry.pixels(), num_kernels = geometry.num_kernels;
+        const int block = geometry.block();
+
+        AlignedPtr<DataType> patches(patch * block);
+        AlignedPtr<DataType> result(num_kernels * block);
+
+        for (int first = 0; first < pixels; first += block) {
+            const int count = std::min(block, pixels - first);
+
+            lower_columns(geometry, input, first, count, patches.data);
+
+            std::fill(result.data, result.data + num_kernels * count, DataType(0));
+            Multiply::gemm(num_kernels, count, patch, kernel, patch, patches.data, count, result.data, count);
+
+            for (int pixel = 0; pixel < count; ++pixel)
+                for (int k = 0; k < num_kernels; ++k)
+                    output[(first + pixel) * num_kernels + k] = result.data[k * count + pixel];
+        }
+    }
+
+    /// Write the patch of each pixel as a row. Channels are contiguous in the
+    /// input, so every kernel position copies a run of `channels` values.
+    static void lower_rows(const Geometry& geometry, const DataType* input, int first, int count, DataType* patches)
+    {
+        const int channels = geometry.channels;
+
+        for (int pixel = first; pixel < first + count; ++pixel) {
+            const int top  = (pixel / geometry.out_cols) * geometry.stride - geometry.pad;
+            const int left = (pixel % geometry.out_cols) * geometry.stride - geometry.pad;
+
+            for (int ky = 0; ky < geometry.kernel_rows; ++ky) {
+                const int row = top + ky;
+                for (int kx = 0; kx < geometry.kernel_cols; ++kx, patches += channels) {
+                    const int col = left + kx;
+                    if (row < 0 || row >= geometry.height || col < 0 || col >= geometry.width) {
+                        std::fill(patches, patches + channels, geometry.pad_value);
+                    } else {
+                        const DataType* src = input + (row * geometry.width + col) * channels;
+                        std::copy(src, src + channels, patches);
                     }
+                }
+            }
+        }
+    }
+
+    /// Write the patch of each pixel as a column. Each row of the result holds
+    /// one kernel position and channel for `count` consecutive pixels.
+    static void lower_columns(const Geometry& geometry, const DataType* input, int first, int count, DataType* patches)
+    {
+        const int channels = geometry.channels;
 
-                    int t_offset = row * row_step + col * col_step;
+        for (int ky = 0; ky < geometry.kernel_rows; ++ky) {
+            for (int kx = 0; kx < geometry.kernel_cols; ++kx) {
+                for (int c = 0; c < channels; ++c, patches += count) {
+                    int out_row = first / geometry.out_cols;
+                    int out_col = first % geometry.out_cols;
 
-                    int channel_steps_remaining = channel_steps;
-                    for (; --channel_steps_remaining; t_offset += OptimalSIMDSize<DataType>::value) {
+                    for (int i = 0; i < count; ++i) {
+                        const int row = out_row * geometry.stride - geometry.pad + ky;
+                        const int col = out_col * geometry.stride - geometry.pad + kx;
 
+                        patches[i] = (row < 0 || row >= geometry.height || col < 0 || col >= geometry.width)
+                                   ? geometry.pad_value
+                                   : input[(row * geometry.width + col) * channels + c];
+
+                        if (++out_col == geometry.out_cols) {
+                            out_col = 0;
+                            ++out_row;
+                        }
                     }
-                    auto t_block = LoadSIMDType<DataType, DataType>::load(t_ptr + t_offset);
-                    //auto r_block = LoadSIMDType<LeftType, RightType>::load(r_ptr + offset);
-                    //auto result = ConvertSIMDType<LeftType>::convert(simdpp::mull(l_block, r_block));
                 }
             }
-        }        
+        }
     }
 };
 
 } // namespace detail
 
+// ----------------------------------------------------------------------------
+// Unit tests
+
+namespace
+{
+
+template <typename T>
+Tensor<T> reference_conv3D(const Tensor<T>& tensor, const Tensor<T>& kernel, int pad, T pad_value, int stride)
+{
+    const int kernel_axis = kernel.shape.num_axes() - 3;
+    const int num_kernels = kernel_axis == 1 ? kernel.shape[0] : 1;
+    const int kernel_rows = kernel.shape[kernel_axis], kernel_cols = kernel.shape[kernel_axis + 1];
+    const int height = tensor.shape[0], width = tensor.shape[1], channels = tensor.shape[2];
+
+    Tensor<T> output(Shape{(height + 2 * pad - kernel_rows) / stride + 1, (width + 2 * pad - kernel_cols) / stride + 1, num_kernels});
+
+    for (int y = 0; y < output.shape[0]; ++y) {
+        for (int x = 0; x < output.shape[1]; ++x) {
+            for (int k = 0; k < num_kernels; ++k) {
+                T sum = 0;
+                for (int ky = 0; ky < kernel_rows; ++ky) {
+                    for (int kx = 0; kx < kernel_cols; ++kx) {
+                        const int row = y * stride - pad + ky, col = x * stride - pad + kx;
+                        for (int c = 0; c < channels; ++c) {
+                            const T value = (row < 0 || row >= height || col < 0 || col >= width)
+                                          ? pad_value : tensor.data[(row * width + col) * channels + c];
+                            sum += value * kernel.data[((k * kernel_rows + ky) * kernel_cols + kx) * channels + c];
+                        }
+                    }
+                }
+                output.data[(y * output.shape[1] + x) * num_kernels + k] = sum;
+            }
+        }
+    }
+
+    return output;
+}
+
+template <typename T>
+Tensor<T> pattern_tensor(const Shape& shape, int multiplier, int modulus)
+{
+    Tensor<T> tensor(shape);
+    for (int i = 0; i < shape.total(); ++i)
+        tensor.data[i] = (T) ((i * multiplier) % modulus);
+
+    return tensor;
+}
+
+} // namespace
+
+TEST_CASE_TEMPLATE("conv3D(const Tensor<T>&, const Tensor<T>&, int, T, int)", T, multiply_data_types)
+{
+    { // 3x3 image, 2x2 box filter
+        T data[9]     = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        T expected[4] = {12, 16, 24, 28};
+
+        Tensor<T> tensor(Shape{3, 3, 1}, AlignedPtr<T>(data, 9));
+        Tensor<T> kernel(Shape{2, 2, 1}, 1);
+
+        REQUIRE((conv3D(tensor, kernel) == Tensor<T>(Shape{2, 2, 1}, AlignedPtr<T>(expected, 4))));
+    }
+
+    auto test_conv = [](const Shape& shape, const Shape& kernel_shape, int pad, T pad_value, int stride) {
+        Tensor<T> tensor = pattern_tensor<T>(shape, 7, 5);
+        Tensor<T> kernel = pattern_tensor<T>(kernel_shape, 3, 4);
+
+        Tensor<T> result = conv3D(tensor, kernel, pad, pad_value, stride);
+        REQUIRE((result == reference_conv3D(tensor, kernel, pad, pad_value, stride)));
+    };
+
+    test_conv(Shape{5, 5, 1},   Shape{3, 3, 1},        0, 0, 1);
+    test_conv(Shape{7, 6, 3},   Shape{4, 3, 3, 3},     1, 2, 2);
+    test_conv(Shape{6, 9, 2},   Shape{3, 2, 4, 2},     2, 1, 3);
+    test_conv(Shape{40, 40, 8}, Shape{2, 3, 3, 8},     1, 0, 1);  // Several lowered blocks
+    test_conv(Shape{12, 10, 4}, Shape{50, 3, 3, 4},    1, 1, 1);  // Pixel major
+    test_conv(Shape{9, 11, 5},  Shape{50, 1, 1, 5},    0, 0, 1);  // 1x1, no lowering
+    test_conv(Shape{9, 11, 5},  Shape{50, 1, 1, 5},    1, 3, 2);
+    test_conv(Shape{9, 11, 5},  Shape{3, 1, 1, 5},     0, 0, 1);
+
+    { // Wide 3x3 floating point banks are computed with Winograd's algorithm
+        Tensor<T> tensor = pattern_tensor<T>(Shape{10, 12, 8}, 7, 5);
+        Tensor<T> kernel = pattern_tensor<T>(Shape{8, 3, 3, 8}, 3, 4);
+
+        Tensor<T> result   = conv3D(tensor, kernel, 1, (T) 1);
+        Tensor<T> expected = reference_conv3D(tensor, kernel, 1, (T) 1, 1);
+
+        REQUIRE((result.shape == expected.shape));
+        for (int i = 0; i < expected.shape.total(); ++i)
+            REQUIRE(std::fabs((double) result.data[i] - (double) expected.data[i]) <= 1e-3 * std::max(1., std::fabs((double) expected.data[i])));
+    }
+
+    REQUIRE_THROWS(conv3D(Tensor<T>(Shape{5, 5, 2}), Tensor<T>(Shape{3, 3, 3})));
+    REQUIRE_THROWS(conv3D(Tensor<T>(Shape{5, 5, 2}), Tensor<T>(Shape{3, 3})));
+    REQUIRE_THROWS(conv3D(Tensor<T>(Shape{2, 2, 1}), Tensor<T>(Shape{3, 3, 1})));
+    REQUIRE_THROWS(conv3D(Tensor<T>(Shape{5, 5, 1}), Tensor<T>(Shape{3, 3, 1}), 0, (T) 0, 0));
+}
+
+TEST_CASE_TEMPLATE("conv3D(const Tensor<T>&, const KernelSpectrum<T>&, int, T)", T, test_float_data_types)
+{
+    auto require_close = [](const Tensor<T>& result, const Tensor<T>& expected) {
+        REQUIRE((result.shape == expected.shape));
+        for (int i = 0; i < expected.shape.total(); ++i)
+            REQUIRE(std::fabs((double) result.data[i] - (double) expected.data[i]) <= 1e-3 * std::max(1., std::fabs((double) expected.data[i])));
+    };
+
+    auto test_conv = [&](const Shape& shape, const Shape& kernel_shape, int pad, T pad_value, int fft_size) {
+        Tensor<T> tensor = pattern_tensor<T>(shape, 7, 5);
+        Tensor<T> kernel = pattern_tensor<T>(kernel_shape, 3, 4);
+
+        const KernelSpectrum<T> spectrum(kernel, fft_size);
+        require_close(conv3D(tensor, spectrum, pad, pad_value), reference_conv3D(tensor, kernel, pad, pad_value, 1));
+    };
+
+    test_conv(Shape{20, 20, 1}, Shape{5, 5, 1},     0, 0, 8);   // Many tiles
+    test_conv(Shape{30, 25, 3}, Shape{3, 6, 4, 3},  2, 1, 16);  // Odd kernels and channels
+    test_conv(Shape{17, 40, 4}, Shape{2, 11, 9, 4}, 5, 2, 0);
+    test_conv(Shape{12, 12, 2}, Shape{12, 12, 2},   0, 0, 16);  // Kernel as large as the tensor
+
+    { // Large kernels switch conv3D to the FFT
+        Tensor<T> tensor = pattern_tensor<T>(Shape{40, 36, 3}, 7, 5);
+        Tensor<T> kernel = pattern_tensor<T>(Shape{3, 11, 11, 3}, 3, 4);
+
+        require_close(conv3D(tensor, kernel, 3, (T) 1), reference_conv3D(tensor, kernel, 3, (T) 1, 1));
+    }
+
+    { // 2D correlation, with the template transformed once
+        Tensor<T> image    = pattern_tensor<T>(Shape{50, 45}, 7, 5);
+        Tensor<T> patch    = pattern_tensor<T>(Shape{13, 12}, 3, 4);
+        Tensor<T> expected = reference_conv3D(Tensor<T>(Shape{50, 45, 1}, image.data), Tensor<T>(Shape{13, 12, 1}, patch.data), 0, (T) 0, 1);
+        expected.reshape(Shape{38, 34});
+
+        require_close(correlate2D(image, patch), expected);
+
+        const KernelSpectrum<T> spectrum(Tensor<T>(Shape{13, 12, 1}, patch.data));
+        require_close(correlate2D(image, spectrum), expected);
+        require_close(correlate2D(image, spectrum), expected);
+    }
+
+    REQUIRE_THROWS(KernelSpectrum<T>(Tensor<T>(Shape{5, 5})));
+    REQUIRE_THROWS(KernelSpectrum<T>(Tensor<T>(Shape{5, 5, 1}), 12));
+    REQUIRE_THROWS(KernelSpectrum<T>(Tensor<T>(Shape{5, 5, 1}), 4));
+    REQUIRE_THROWS(conv3D(Tensor<T>(Shape{9, 9, 2}), KernelSpectrum<T>(Tensor<T>(Shape{5, 5, 1}))));
+    REQUIRE_THROWS(conv3D(Tensor<T>(Shape{3, 9, 1}), KernelSpectrum<T>(Tensor<T>(Shape{5, 5, 1}))));
+    REQUIRE_THROWS(correlate2D(Tensor<T>(Shape{9, 9}), KernelSpectrum<T>(Tensor<T>(Shape{2, 5, 5, 1}))));
+}
+
 } // namespace tnt
 
 #endif // TNT_LINEAR_CONVOLUTION_3D_IMPL_HPP
@@ -0,0 +1,712 @@
+#ifndef TNT_LINEAR_DECOMPOSITION_IMPL_HPP
+#define TNT_LINEAR_DECOMPOSITION_IMPL_HPP
+
+#include <tnt/linear/decomposition.hpp>
+#include <tnt/linear/impl/blas1_impl.hpp>
+#include <tnt/linear/impl/householder_impl.hpp>
+#include <tnt/linear/impl/matrix_multiply_impl.hpp>
+#include <tnt/utils/parallel.hpp>
+#include <tnt/utils/testing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Right-looking blocked LU, LAPACK's `getrf`. A panel of `BlockSize`
+/// columns is factored with partial pivoting, swapping whole rows, then
+/// `U12 = L11^-1 A12` is solved by blocks of columns and the trailing matrix
+/// updated as `A22 -= L21 U12`.
+template <typename DataType>
+struct OptimizedLU<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using Multiply = OptimizedMatrixMultiply<DataType>;
+
+    constexpr static int BlockSize = 64;
+
+    /// Rows of the trailing matrix updated by one task
+    constexpr static int RowBlock = 64;
+
+    /// Columns of `U12`, or of the right hand sides, solved by one task
+    constexpr static int ColumnBlock = 256;
+
+    static LU<DataType> eval(const Tensor<DataType>& tensor, int num_threads)
+    {
+        const int n = tensor.shape[0];
+
+        LU<DataType> result;
+        result.factors = tensor;
+        result.pivots = Tensor<int32_t>(Shape{n});
+
+        DataType* a = result.factors.data.data;
+        int32_t* pivots = result.pivots.data.data;
+
+        std::vector<DataType> upper;
+
+        for (int j0 = 0; j0 < n; j0 += BlockSize) {
+            const int j1 = std::min(j0 + BlockSize, n);
+            const int jb = j1 - j0;
+
+            for (int j = j0; j < j1; ++j) {
+                int p = j;
+                for (int i = j + 1; i < n; ++i) {
+                    if (std::abs(a[i * n + j]) > std::abs(a[p * n + j]))
+                        p = i;
+                }
+
+                pivots[j] = p;
+                if (p != j)
+                    std::swap_ranges(a + j * n, a + (j + 1) * n, a + p * n);
+
+                const DataType pivot = a[j * n + j];
+                if (pivot == 0)
+                    continue;
+
+                const DataType inverse = 1 / pivot;
+                for (int i = j + 1; i < n; ++i) {
+                    a[i * n + j] *= inverse;
+                    multiply_add_row(-a[i * n + j], a + j * n + j + 1, a + i * n + j + 1, j1 - j - 1);
+                }
+            }
+
+            const int m = n - j1;
+            if (m == 0)
+                break;
+
+            auto solve_upper = [&](int block) {
+                const int c0 = j1 + block * ColumnBlock;
+                const int width = std::min(ColumnBlock, n - c0);
+                for (int i = j0 + 1; i < j1; ++i)
+                    for (int l = j0; l < i; ++l)
+                        multiply_add_row(-a[i * n + l], a + l * n + c0, a + i * n + c0, width);
+            };
+
+            parallel_for((m + ColumnBlock - 1) / ColumnBlock, num_threads, solve_upper);
+
+            upper.resize(jb * m);
+            for (int l = 0; l < jb; ++l)
+                for (int c = 0; c < m; ++c)
+                    upper[l * m + c] = -a[(j0 + l) * n + j1 + c];
+
+            auto update = [&](int block) {
+                const int r0 = j1 + block * RowBlock;
+                Multiply::gemm(std::min(RowBlock, n - r0), m, jb, a + r0 * n + j0, n, upper.data(), m, a + r0 * n + j1, n);
+            };
+
+            parallel_for((m + RowBlock - 1) / RowBlock, num_threads, update);
+        }
+
+        return result;
+    }
+
+    /// Forward and back substitution. A single right hand side uses inner
+    /// products along the rows of `L` and `U`, several are updated a row at a
+    /// time by blocks of columns.
+    static Tensor<DataType> solve(const LU<DataType>& factors, const Tensor<DataType>& rhs, int num_threads)
+    {
+        const int n = factors.factors.shape[0];
+        const int k = rhs.shape.num_axes() == 1 ? 1 : rhs.shape[1];
+        const DataType* a = factors.factors.data.data;
+
+        Tensor<DataType> result = rhs;
+        DataType* b = result.data.data;
+
+        for (int i = 0; i < n; ++i) {
+            const int p = factors.pivots.data[i];
+            if (p != i)
+                std::swap_ranges(b + i * k, b + (i + 1) * k, b + p * k);
+        }
+
+        if (k == 1) {
+            for (int i = 1; i < n; ++i)
+                b[i] -= dot_row(a + i * n, b, i);
+
+            for (int i = n - 1; i >= 0; --i)
+                b[i] = (b[i] - dot_row(a + i * n + i + 1, b + i + 1, n - i - 1)) / a[i * n + i];
+
+            return result;
+        }
+
+        auto substitute = [&](int block) {
+            const int c0 = block * ColumnBlock;
+            const int width = std::min(ColumnBlock, k - c0);
+
+            for (int i = 1; i < n; ++i)
+                for (int l = 0; l < i; ++l)
+                    multiply_add_row(-a[i * n + l], b + l * k + c0, b + i * k + c0, width);
+
+            for (int i = n - 1; i >= 0; --i) {
+                DataType* row = b + i * k + c0;
+                for (int l = i + 1; l < n; ++l)
+                    multiply_add_row(-a[i * n + l], b + l * k + c0, row, width);
+
+                const DataType inverse = 1 / a[i * n + i];
+                for (int c = 0; c < width; ++c)
+                    row[c] *= inverse;
+            }
+        };
+
+        parallel_for((k + ColumnBlock - 1) / ColumnBlock, num_threads, substitute);
+
+        return result;
+    }
+
+    static DataType det(const LU<DataType>& factors)
+    {
+        const int n = factors.factors.shape[0];
+
+        DataType result = 1;
+        for (int i = 0; i < n; ++i) {
+            result *= factors.factors.data[i * n + i];
+            if (factors.pivots.data[i] != i)
+                result = -result;
+        }
+
+        return result;
+    }
+
+    static bool singular(const LU<DataType>& factors)
+    {
+        const int n = factors.factors.shape[0];
+        for (int i = 0; i < n; ++i) {
+            if (factors.factors.data[i * n + i] == 0)
+                return true;
+        }
+
+        return false;
+    }
+};
+
+template <typename DataType>
+constexpr int OptimizedLU<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::BlockSize;
+
+template <typename DataType>
+constexpr int OptimizedLU<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::RowBlock;
+
+template <typename DataType>
+constexpr int OptimizedLU<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::ColumnBlock;
+
+/// Right-looking blocked Cholesky, LAPACK's `potrf` for the lower triangle.
+/// Rows of `L21` are independent and solved in parallel, and only the lower
+/// triangle of the trailing matrix is updated, a block of rows up to its
+/// diagonal at a time.
+template <typename DataType>
+struct OptimizedCholesky<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using Multiply = OptimizedMatrixMultiply<DataType>;
+
+    constexpr static int BlockSize = 64;
+
+    /// Rows of `L21` or of the trailing matrix handled by one task
+    constexpr static int RowBlock = 64;
+
+    static bool eval(const Tensor<DataType>& tensor, Tensor<DataType>& result, int num_threads)
+    {
+        const int n = tensor.shape[0];
+
+        result = tensor;
+        DataType* a = result.data.data;
+
+        std::vector<DataType> lower;
+
+        for (int j0 = 0; j0 < n; j0 += BlockSize) {
+            const int j1 = std::min(j0 + BlockSize, n);
+            const int jb = j1 - j0;
+
+            for (int j = j0; j < j1; ++j) {
+                DataType* row_j = a + j * n;
+
+                const DataType d = row_j[j] - dot_row(row_j + j0, row_j + j0, j - j0);
+                if (!(d > 0))
+                    return false;
+
+                row_j[j] = std::sqrt(d);
+                for (int i = j + 1; i < j1; ++i)
+                    a[i * n + j] = (a[i * n + j] - dot_row(a + i * n + j0, row_j + j0, j - j0)) / row_j[j];
+            }
+
+            const int m = n - j1;
+            if (m == 0)
+                break;
+
+            // L21 = A21 L11^-T
+            auto solve_lower = [&](int block) {
+                const int end = std::min(j1 + (block + 1) * RowBlock, n);
+                for (int i = j1 + block * RowBlock; i < end; ++i) {
+                    DataType* row = a + i * n;
+                    for (int j = j0; j < j1; ++j)
+                        row[j] = (row[j] - dot_row(row + j0, a + j * n + j0, j - j0)) / a[j * n + j];
+                }
+            };
+
+            parallel_for((m + RowBlock - 1) / RowBlock, num_threads, solve_lower);
+
+            // A22 -= L21 L21^T
+            lower.resize(jb * m);
+            for (int l = 0; l < jb; ++l)
+                for (int c = 0; c < m; ++c)
+                    lower[l * m + c] = -a[(j1 + c) * n + j0 + l];
+
+            auto update = [&](int block) {
+                const int r0 = block * RowBlock;
+                const int rows = std::min(RowBlock, m - r0);
+                Multiply::gemm(rows, r0 + rows, jb, a + (j1 + r0) * n + j0, n, lower.data(), m, a + (j1 + r0) * n + j1, n);
+            };
+
+            parallel_for((m + RowBlock - 1) / RowBlock, num_threads, update);
+        }
+
+        for (int r = 0; r < n; ++r)
+            std::fill(a + r * n + r + 1, a + (r + 1) * n, DataType(0));
+
+        return true;
+    }
+};
+
+template <typename DataType>
+constexpr int OptimizedCholesky<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::BlockSize;
+
+template <typename DataType>
+constexpr int OptimizedCholesky<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::RowBlock;
+
+/// Blocked Householder QR, LAPACK's `geqrf`. The matrix is factored
+/// transposed, so each column of `A` is a contiguous row and a reflector
+/// acts on every row after it. Panels of `BlockSize` reflectors are applied
+/// to the remaining rows in the compact WY form.
+template <typename DataType>
+struct OptimizedQR<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    constexpr static int BlockSize = 32;
+
+    static QR<DataType> eval(const Tensor<DataType>& tensor, int num_threads)
+    {
+        const int m = tensor.shape[0];
+        const int n = tensor.shape[1];
+        const int p = std::min(m, n);
+
+        std::vector<DataType> at(n * m), tau(p), beta(p);
+        transpose(tensor.data.data, m, n, at.data());
+        factor(at.data(), m, n, tau.data(), beta.data(), num_threads);
+
+        QR<DataType> result;
+        result.r = zeros<DataType>(Shape{p, n});
+        for (int i = 0; i < p; ++i) {
+            result.r.data[i * n + i] = beta[i];
+            for (int c = i + 1; c < n; ++c)
+                result.r.data[i * n + c] = at[c * m + i];
+        }
+
+        // Q^T = [I 0] H_(p-1) ... H_0, from the last panel, which only
+        // touches rows and columns after its first reflector
+        std::vector<DataType> qt(p * m, DataType(0)), vt, t(BlockSize * BlockSize);
+        for (int i = 0; i < p; ++i)
+            qt[i * m + i] = 1;
+
+        for (int j0 = ((p - 1) / BlockSize) * BlockSize; j0 >= 0; j0 -= BlockSize) {
+            const int nb = std::min(BlockSize, p - j0);
+            reflectors(at.data(), m, j0, nb, vt);
+
+            Householder<DataType>::triangular_factor(vt.data(), nb, m - j0, tau.data() + j0, t.data(), BlockSize);
+            Householder<DataType>::apply_right(qt.data() + j0 * m + j0, p - j0, m, vt.data(), nb, m - j0,
+                                               t.data(), BlockSize, true, num_threads);
+        }
+
+        result.q = Tensor<DataType>(Shape{m, p});
+        transpose(qt.data(), p, m, result.q.data.data);
+
+        return result;
+    }
+
+    /// Returns false, without a result, when `R` is numerically singular
+    static bool lstsq(const Tensor<DataType>& tensor, const Tensor<DataType>& rhs, Tensor<DataType>& result, int num_threads)
+    {
+        const int m = tensor.shape[0];
+        const int n = tensor.shape[1];
+        const int k = rhs.shape.num_axes() == 1 ? 1 : rhs.shape[1];
+
+        std::vector<DataType> at(n * m), tau(n), beta(n);
+        transpose(tensor.data.data, m, n, at.data());
+        factor(at.data(), m, n, tau.data(), beta.data(), num_threads);
+
+        DataType largest = 0;
+        for (int i = 0; i < n; ++i)
+            largest = std::max(largest, std::abs(beta[i]));
+
+        const DataType threshold = largest * std::numeric_limits<DataType>::epsilon() * m;
+        for (int i = 0; i < n; ++i) {
+            if (!(std::abs(beta[i]) > threshold))
+                return false;
+        }
+
+        // Q^T B, one right hand side per row
+        std::vector<DataType> bt(k * m), vt, t(BlockSize * BlockSize);
+        transpose(rhs.data.data, m, k, bt.data());
+
+        for (int j0 = 0; j0 < n; j0 += BlockSize) {
+            const int nb = std::min(BlockSize, n - j0);
+            reflectors(at.data(), m, j0, nb, vt);
+
+            Householder<DataType>::triangular_factor(vt.data(), nb, m - j0, tau.data() + j0, t.data(), BlockSize);
+            Householder<DataType>::apply_right(bt.data() + j0, k, m, vt.data(), nb, m - j0,
+                                               t.data(), BlockSize, false, num_threads);
+        }
+
+        // R X = Q^T B, row i of R is column i of the transposed factor
+        std::vector<DataType> r(n * n);
+        for (int i = 0; i < n; ++i) {
+            r[i * n + i] = beta[i];
+            for (int c = i + 1; c < n; ++c)
+                r[i * n + c] = at[c * m + i];
+        }
+
+        auto substitute = [&](int column) {
+            DataType* x = bt.data() + column * m;
+            for (int i = n - 1; i >= 0; --i)
+                x[i] = (x[i] - dot_row(r.data() + i * n + i + 1, x + i + 1, n - i - 1)) / r[i * n + i];
+        };
+
+        parallel_for(k, num_threads, substitute);
+
+        result = rhs.shape.num_axes() == 1 ? Tensor<DataType>(Shape{n}) : Tensor<DataType>(Shape{n, k});
+        for (int i = 0; i < n; ++i)
+            for (int c = 0; c < k; ++c)
+                result.data[i * k + c] = bt[c * m + i];
+
+        return true;
+    }
+
+private:
+    static void transpose(const DataType* in, int rows, int cols, DataType* out) noexcept
+    {
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < cols; ++c)
+                out[c * rows + r] = in[r * cols + c];
+    }
+
+    /// Factor the `n x m` transpose `at`. Reflector `j` is left in row `j`
+    /// from column `j + 1` on, its scale in `tau[j]` and `R(j, j)` in
+    /// `beta[j]`. Rows after `j` hold row `j` of `R` in column `j`.
+    static void factor(DataType* at, int m, int n, DataType* tau, DataType* beta, int num_threads)
+    {
+        const int p = std::min(m, n);
+
+        std::vector<DataType> vt, t(BlockSize * BlockSize);
+
+        for (int j0 = 0; j0 < p; j0 += BlockSize) {
+            const int j1 = std::min(j0 + BlockSize, p);
+
+            for (int j = j0; j < j1; ++j) {
+                DataType* row = at + j * m;
+                beta[j] = Householder<DataType>::generate(row + j, m - j, tau[j]);
+                if (tau[j] == 0)
+                    continue;
+
+                for (int c = j + 1; c < j1; ++c)
+                    Householder<DataType>::apply(at + c * m + j, row + j, tau[j], m - j);
+            }
+
+            if (j1 == n)
+                continue;
+
+            reflectors(at, m, j0, j1 - j0, vt);
+            Householder<DataType>::triangular_factor(vt.data(), j1 - j0, m - j0, tau + j0, t.data(), BlockSize);
+            Householder<DataType>::apply_right(at + j1 * m + j0, n - j1, m, vt.data(), j1 - j0, m - j0,
+                                               t.data(), BlockSize, false, num_threads);
+        }
+    }
+
+    /// Reflectors `j0` to `j0 + nb` as the rows of `vt`, from column `j0` on
+    static void reflectors(const DataType* at, int m, int j0, int nb, std::vector<DataType>& vt)
+    {
+        const int length = m - j0;
+
+        vt.assign(nb * length, DataType(0));
+        for (int i = 0; i < nb; ++i) {
+            const int j = j0 + i;
+            DataType* v = vt.data() + i * length;
+
+            v[j - j0] = 1;
+            std::copy(at + j * m + j + 1, at + (j + 1) * m, v + j - j0 + 1);
+        }
+    }
+};
+
+template <typename DataType>
+constexpr int OptimizedQR<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::BlockSize;
+
+} // namespace detail
+
+namespace
+{
+
+/// A random `rows x cols` matrix with a larger diagonal, for the tests below
+template <typename T>
+Tensor<T> random_matrix(int rows, int cols, T diagonal, int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<T> distribution(-1, 1);
+
+    Tensor<T> result(Shape{rows, cols});
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c)
+            result.data[r * cols + c] = distribution(generator) + (r == c ? diagonal : T(0));
+
+    return result;
+}
+
+} // namespace
+
+TEST_CASE_TEMPLATE("lu()", T, test_float_data_types)
+{
+    const T tolerance = std::is_same<T, float>::value ? T(1e-4) : T(1e-12);
+
+    for (int n : {1, 5, 64, 65, 150}) {
+        Tensor<T> A = random_matrix<T>(n, n, T(0), n);
+        LU<T> result = lu(A, 1);
+
+        REQUIRE(result.factors.shape == (Shape{n, n}));
+        REQUIRE(result.pivots.shape == Shape{n});
+
+        // P A = L U
+        Tensor<T> PA = A;
+        for (int i = 0; i < n; ++i)
+            std::swap_ranges(PA.data.data + i * n, PA.data.data + (i + 1) * n, PA.data.data + result.pivots.data[i] * n);
+
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) {
+                T sum = 0;
+                for (int l = 0; l <= std::min(r, c); ++l)
+                    sum += (l == r ? T(1) : result.factors.data[r * n + l]) * result.factors.data[l * n + c];
+                REQUIRE(std::abs(sum - PA.data[r * n + c]) <= 10 * tolerance * n);
+            }
+
+            // Partial pivoting bounds the multipliers
+            for (int l = 0; l < r; ++l)
+                REQUIRE(std::abs(result.factors.data[r * n + l]) <= T(1));
+        }
+
+        LU<T> threaded = lu(A, 3);
+        REQUIRE(threaded.factors == result.factors);
+        REQUIRE(threaded.pivots == result.pivots);
+    }
+
+    REQUIRE_THROWS((lu(Tensor<T>(Shape{3, 4}))));
+}
+
+TEST_CASE_TEMPLATE("cholesky()", T, test_float_data_types)
+{
+    const T tolerance = std::is_same<T, float>::value ? T(1e-4) : T(1e-12);
+
+    for (int n : {1, 5, 64, 65, 150}) {
+        // M M^T + n I, with junk above the diagonal that must be ignored
+        Tensor<T> M = random_matrix<T>(n, n, T(0), n);
+        Tensor<T> A(Shape{n, n});
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) {
+                T sum = r == c ? T(n) : T(0);
+                for (int l = 0; l < n; ++l)
+                    sum += M.data[r * n + l] * M.data[c * n + l];
+                A.data[r * n + c] = c <= r ? sum : T(1000);
+            }
+        }
+
+        Tensor<T> L = cholesky(A, 1);
+        REQUIRE(L.shape == (Shape{n, n}));
+
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c <= r; ++c) {
+                T sum = 0;
+                for (int l = 0; l <= c; ++l)
+                    sum += L.data[r * n + l] * L.data[c * n + l];
+                REQUIRE(std::abs(sum - A.data[r * n + c]) <= tolerance * n * n);
+            }
+            for (int c = r + 1; c < n; ++c)
+                REQUIRE(L.data[r * n + c] == 0);
+        }
+
+        REQUIRE(cholesky(A, 3) == L);
+    }
+
+    T indefinite[4] = {1, 2, 2, 1};
+    REQUIRE_THROWS((cholesky(Tensor<T>(Shape{2, 2}, AlignedPtr<T>(indefinite, 4)))));
+    REQUIRE_THROWS((cholesky(Tensor<T>(Shape{3, 4}))));
+}
+
+TEST_CASE_TEMPLATE("qr()", T, test_float_data_types)
+{
+    const T tolerance = std::is_same<T, float>::value ? T(1e-4) : T(1e-12);
+
+    const int shapes[][2] = {{1, 3}, {3, 1}, {5, 5}, {70, 40}, {40, 70}, {100, 100}};
+    for (const auto& shape : shapes) {
+        const int m = shape[0], n = shape[1], p = std::min(m, n);
+
+        Tensor<T> A = random_matrix<T>(m, n, T(0), m * n);
+        QR<T> result = qr(A, 1);
+
+        REQUIRE(result.q.shape == (Shape{m, p}));
+        REQUIRE(result.r.shape == (Shape{p, n}));
+
+        for (int i = 0; i < p; ++i) {
+            for (int j = 0; j < p; ++j) {
+                T dot = 0;
+                for (int r = 0; r < m; ++r)
+                    dot += result.q.data[r * p + i] * result.q.data[r * p + j];
+                REQUIRE(std::abs(dot - (i == j)) <= tolerance * m);
+            }
+
+            for (int c = 0; c < i; ++c)
+                REQUIRE(result.r.data[i * n + c] == 0);
+        }
+
+        for (int r = 0; r < m; ++r) {
+            for (int c = 0; c < n; ++c) {
+                T sum = 0;
+                for (int l = 0; l < p; ++l)
+                    sum += result.q.data[r * p + l] * result.r.data[l * n + c];
+                REQUIRE(std::abs(sum - A.data[r * n + c]) <= tolerance * m);
+            }
+        }
+
+        QR<T> threaded = qr(A, 3);
+        REQUIRE(threaded.q == result.q);
+        REQUIRE(threaded.r == result.r);
+    }
+
+    REQUIRE_THROWS((qr(Tensor<T>(Shape{2, 2, 2}))));
+}
+
+TEST_CASE_TEMPLATE("solve()", T, test_float_data_types)
+{
+    const T tolerance = std::is_same<T, float>::value ? T(1e-4) : T(1e-12);
+
+    for (int n : {1, 7, 100, 300}) {
+        Tensor<T> A = random_matrix<T>(n, n, T(4), n);
+
+        for (int k : {0, 1, 3, 300}) {
+            // k = 0 is a vector right hand side
+            Tensor<T> X = k == 0 ? random_matrix<T>(n, 1, T(0), k) : random_matrix<T>(n, k, T(0), k);
+            const int columns = std::max(k, 1);
+            if (k == 0)
+                X = Tensor<T>(Shape{n}, AlignedPtr<T>(X.data.data, n));
+
+            Tensor<T> B = zeros<T>(X.shape);
+            for (int r = 0; r < n; ++r)
+                for (int l = 0; l < n; ++l)
+                    for (int c = 0; c < columns; ++c)
+                        B.data[r * columns + c] += A.data[r * n + l] * X.data[l * columns + c];
+
+            Tensor<T> solution = solve(A, B, 2);
+            REQUIRE(solution.shape == X.shape);
+            for (int i = 0; i < n * columns; ++i)
+                REQUIRE(std::abs(solution.data[i] - X.data[i]) <= tolerance * 10);
+        }
+    }
+
+    T singular[4] = {1, 2, 2, 4};
+    REQUIRE_THROWS((solve(Tensor<T>(Shape{2, 2}, AlignedPtr<T>(singular, 4)), ones<T>(Shape{2}))));
+    REQUIRE_THROWS((solve(Tensor<T>(Shape{2, 2}), ones<T>(Shape{3}))));
+}
+
+TEST_CASE_TEMPLATE("inverse()", T, test_float_data_types)
+{
+    const T tolerance = std::is_same<T, float>::value ? T(1e-4) : T(1e-12);
+
+    for (int n : {1, 3, 70}) {
+        Tensor<T> A = random_matrix<T>(n, n, T(3), n);
+        Tensor<T> I = inverse(A);
+
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) {
+                T sum = 0;
+                for (int l = 0; l < n; ++l)
+                    sum += A.data[r * n + l] * I.data[l * n + c];
+                REQUIRE(std::abs(sum - (r == c)) <= tolerance * 10);
+            }
+        }
+    }
+
+    REQUIRE_THROWS((inverse(zeros<T>(Shape{3, 3}))));
+    REQUIRE_THROWS((inverse(Tensor<T>(Shape{3, 4}))));
+}
+
+TEST_CASE_TEMPLATE("det()", T, test_float_data_types)
+{
+    T data[9] = {2, -3, 1, 2, 0, -1, 1, 4, 5};
+    REQUIRE(det(Tensor<T>(Shape{3, 3}, AlignedPtr<T>(data, 9))) == doctest::Approx(49));
+
+    // A row swap flips the sign
+    T swapped[9] = {2, 0, -1, 2, -3, 1, 1, 4, 5};
+    REQUIRE(det(Tensor<T>(Shape{3, 3}, AlignedPtr<T>(swapped, 9))) == doctest::Approx(-49));
+
+    T singular[4] = {1, 2, 2, 4};
+    REQUIRE(det(Tensor<T>(Shape{2, 2}, AlignedPtr<T>(singular, 4))) == 0);
+
+    // Triangular with a 2 x 2 block of 1.5 on the diagonal, larger than a panel
+    Tensor<T> A = random_matrix<T>(100, 100, T(0), 1);
+    for (int r = 0; r < 100; ++r)
+        for (int c = 0; c <= r; ++c)
+            A.data[r * 100 + c] = r == c ? (r < 2 ? T(1.5) : T(1)) : T(0);
+    REQUIRE(det(A) == doctest::Approx(2.25));
+
+    REQUIRE_THROWS((det(Tensor<T>(Shape{3, 4}))));
+}
+
+TEST_CASE_TEMPLATE("lstsq()", T, test_float_data_types)
+{
+    const T tolerance = std::is_same<T, float>::value ? T(1e-4) : T(1e-12);
+
+    const int shapes[][2] = {{3, 3}, {50, 3}, {120, 70}};
+    for (const auto& shape : shapes) {
+        const int m = shape[0], n = shape[1];
+        Tensor<T> A = random_matrix<T>(m, n, T(2), m + n);
+
+        // Consistent systems are solved exactly
+        Tensor<T> x = random_matrix<T>(n, 2, T(0), n);
+        Tensor<T> B = zeros<T>(Shape{m, 2});
+        for (int r = 0; r < m; ++r)
+            for (int l = 0; l < n; ++l)
+                for (int c = 0; c < 2; ++c)
+                    B.data[r * 2 + c] += A.data[r * n + l] * x.data[l * 2 + c];
+
+        Tensor<T> solution = lstsq(A, B, 2);
+        REQUIRE(solution.shape == (Shape{n, 2}));
+        for (int i = 0; i < 2 * n; ++i)
+            REQUIRE(std::abs(solution.data[i] - x.data[i]) <= tolerance * 10);
+
+        // Otherwise the residual is orthogonal to the columns of A
+        Tensor<T> b = random_matrix<T>(m, 1, T(0), 7);
+        b = Tensor<T>(Shape{m}, AlignedPtr<T>(b.data.data, m));
+        Tensor<T> y = lstsq(A, b);
+        REQUIRE(y.shape == Shape{n});
+
+        std::vector<T> residual(m);
+        for (int r = 0; r < m; ++r) {
+            residual[r] = b.data[r];
+            for (int l = 0; l < n; ++l)
+                residual[r] -= A.data[r * n + l] * y.data[l];
+        }
+
+        for (int c = 0; c < n; ++c) {
+            T dot = 0;
+            for (int r = 0; r < m; ++r)
+                dot += A.data[r * n + c] * residual[r];
+            REQUIRE(std::abs(dot) <= tolerance * m);
+        }
+    }
+
+    // Rank deficient: the second column is twice the first
+    T deficient[6] = {1, 2, 2, 4, 3, 6};
+    REQUIRE_THROWS((lstsq(Tensor<T>(Shape{3, 2}, AlignedPtr<T>(deficient, 6)), ones<T>(Shape{3}))));
+    REQUIRE_THROWS((lstsq(Tensor<T>(Shape{2, 3}), ones<T>(Shape{2}))));
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_DECOMPOSITION_IMPL_HPP
@@ -0,0 +1,175 @@
+#ifndef TNT_LINEAR_DEPTHWISE_CONVOLUTION_IMPL_HPP
+#define TNT_LINEAR_DEPTHWISE_CONVOLUTION_IMPL_HPP
+
+#include <tnt/linear/convolution.hpp>
+#include <tnt/linear/impl/convolution_3d_impl.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Each output pixel is computed one SIMD block of channels at a time. The
+/// pointers to the `KH x KW` input pixels under the kernel are gathered
+/// first, taps that fall in the padding point to a row of `C` pad values, so
+/// the accumulation loop has no bounds checks. Every tap is then a load of
+/// the input, a load of the kernel and a multiply-add into a register.
+template <typename DataType>
+struct OptimizedDepthwiseConvolution<DataType, void>
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor, const Tensor<DataType>& kernel, int pad, DataType pad_value, int stride)
+    {
+        const int height = tensor.shape[0], width = tensor.shape[1], channels = tensor.shape[2];
+        const int kernel_rows = kernel.shape[0], kernel_cols = kernel.shape[1];
+        const int out_rows = (height + 2 * pad - kernel_rows) / stride + 1;
+        const int out_cols = (width  + 2 * pad - kernel_cols) / stride + 1;
+
+        Tensor<DataType> output(Shape{out_rows, out_cols, channels});
+
+        const std::vector<DataType> pad_pixel(channels, pad_value);
+        std::vector<const DataType*> taps(kernel_rows * kernel_cols);
+
+        for (int y = 0; y < out_rows; ++y) {
+            for (int x = 0; x < out_cols; ++x) {
+                for (int ky = 0; ky < kernel_rows; ++ky) {
+                    const int row = y * stride - pad + ky;
+                    for (int kx = 0; kx < kernel_cols; ++kx) {
+                        const int col = x * stride - pad + kx;
+                        taps[ky * kernel_cols + kx] = (row < 0 || row >= height || col < 0 || col >= width)
+                                                    ? pad_pixel.data()
+                                                    : tensor.data.data + (row * width + col) * channels;
+                    }
+                }
+
+                accumulate(taps, kernel.data.data, output.data.data + (y * out_cols + x) * channels, channels,
+                           HasMultiplyAddSIMD<DataType>());
+            }
+        }
+
+        return output;
+    }
+
+private:
+    static TNT_INL void accumulate(const std::vector<const DataType*>& taps, const DataType* kernel, DataType* out, int channels, std::true_type) noexcept
+    {
+        const DataType zero = 0;
+        const int num_blocks = channels / Size;
+
+        for (int c = 0; c < num_blocks * Size; c += Size) {
+            VecType sum = simdpp::load_splat<VecType>(&zero);
+
+            for (std::size_t t = 0; t < taps.size(); ++t)
+                sum = MultiplyAddSIMD<DataType>::run(simdpp::load_u<VecType>(taps[t] + c),
+                                                     simdpp::load_u<VecType>(kernel + t * channels + c), sum);
+
+            simdpp::store_u(out + c, sum);
+        }
+
+        accumulate_scalar(taps, kernel, out, num_blocks * Size, channels);
+    }
+
+    static TNT_INL void accumulate(const std::vector<const DataType*>& taps, const DataType* kernel, DataType* out, int channels, std::false_type) noexcept
+    {
+        accumulate_scalar(taps, kernel, out, 0, channels);
+    }
+
+    static TNT_INL void accumulate_scalar(const std::vector<const DataType*>& taps, const DataType* kernel, DataType* out, int begin, int channels) noexcept
+    {
+        for (int c = begin; c < channels; ++c) {
+            DataType sum = 0;
+            for (std::size_t t = 0; t < taps.size(); ++t)
+                sum = MultiplyAddSIMD<DataType>::scalar(taps[t][c], kernel[t * channels + c], sum);
+
+            out[c] = sum;
+        }
+    }
+};
+
+template <typename DataType>
+constexpr int OptimizedDepthwiseConvolution<DataType, void>::Size;
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+namespace
+{
+
+template <typename T>
+Tensor<T> reference_depthwise_conv2D(const Tensor<T>& tensor, const Tensor<T>& kernel, int pad, T pad_value, int stride)
+{
+    const int height = tensor.shape[0], width = tensor.shape[1], channels = tensor.shape[2];
+    const int kernel_rows = kernel.shape[0], kernel_cols = kernel.shape[1];
+
+    Tensor<T> output(Shape{(height + 2 * pad - kernel_rows) / stride + 1, (width + 2 * pad - kernel_cols) / stride + 1, channels});
+
+    for (int y = 0; y < output.shape[0]; ++y) {
+        for (int x = 0; x < output.shape[1]; ++x) {
+            for (int c = 0; c < channels; ++c) {
+                T sum = 0;
+                for (int ky = 0; ky < kernel_rows; ++ky) {
+                    for (int kx = 0; kx < kernel_cols; ++kx) {
+                        const int row = y * stride - pad + ky, col = x * stride - pad + kx;
+                        const T value = (row < 0 || row >= height || col < 0 || col >= width)
+                                      ? pad_value : tensor.data[(row * width + col) * channels + c];
+                        sum += value * kernel.data[(ky * kernel_cols + kx) * channels + c];
+                    }
+                }
+                output.data[(y * output.shape[1] + x) * channels + c] = sum;
+            }
+        }
+    }
+
+    return output;
+}
+
+} // namespace
+
+TEST_CASE_TEMPLATE("depthwise_conv2D(const Tensor<T>&, const Tensor<T>&, int, T, int)", T, test_data_types)
+{
+    { // Two channels, a box filter and an identity
+        T data[18]    = {1, 9, 2, 8, 3, 7,
+                         4, 6, 5, 5, 6, 4,
+                         7, 3, 8, 2, 9, 1};
+        T weights[8]  = {1, 0, 1, 0,
+                         1, 0, 1, 1};
+        T expected[8] = {12, 5, 16, 4, 24, 2, 28, 1};
+
+        Tensor<T> tensor(Shape{3, 3, 2}, AlignedPtr<T>(data, 18));
+        Tensor<T> kernel(Shape{2, 2, 2}, AlignedPtr<T>(weights, 8));
+
+        REQUIRE((depthwise_conv2D(tensor, kernel) == Tensor<T>(Shape{2, 2, 2}, AlignedPtr<T>(expected, 8))));
+    }
+
+    auto test_conv = [](const Shape& shape, const Shape& kernel_shape, int pad, T pad_value, int stride) {
+        Tensor<T> tensor = pattern_tensor<T>(shape, 7, 5);
+        Tensor<T> kernel = pattern_tensor<T>(kernel_shape, 3, 3);
+
+        REQUIRE((depthwise_conv2D(tensor, kernel, pad, pad_value, stride) == reference_depthwise_conv2D(tensor, kernel, pad, pad_value, stride)));
+    };
+
+    test_conv(Shape{5, 5, 1},   Shape{3, 3, 1},  0, 0, 1);
+    test_conv(Shape{7, 6, 3},   Shape{3, 3, 3},  1, 2, 2);
+    test_conv(Shape{9, 8, 37},  Shape{3, 3, 37}, 1, 1, 1);  // SIMD blocks and a tail
+    test_conv(Shape{6, 9, 64},  Shape{2, 3, 64}, 2, 1, 3);
+    test_conv(Shape{4, 4, 16},  Shape{1, 1, 16}, 0, 0, 1);
+
+    REQUIRE_THROWS(depthwise_conv2D(Tensor<T>(Shape{5, 5, 2}), Tensor<T>(Shape{3, 3, 3})));
+    REQUIRE_THROWS(depthwise_conv2D(Tensor<T>(Shape{5, 5, 2}), Tensor<T>(Shape{3, 3})));
+    REQUIRE_THROWS(depthwise_conv2D(Tensor<T>(Shape{2, 2, 1}), Tensor<T>(Shape{3, 3, 1})));
+    REQUIRE_THROWS(depthwise_conv2D(Tensor<T>(Shape{5, 5, 1}), Tensor<T>(Shape{3, 3, 1}), 0, (T) 0, 0));
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_DEPTHWISE_CONVOLUTION_IMPL_HPP
@@ -5,48 +5,518 @@
 #include <tnt/utils/testing.hpp>
 #include <tnt/utils/simd.hpp>
 
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
 namespace tnt
 {
 
 namespace detail
 {
 
-constexpr static int dct_forward_coeffs[64] = {
-       1,    1,    1,    1,    1,    1,    1,    1,
-      15,  101,   35,    1,   -1,  -35, -101,  -15,
-       3,    1,   -1,   -3,   -3,   -1,    1,    3,
-       1,    3,  -11,   -1,    1,   11,   -3,   -1,
-       1,   -1,   -1,    1,    1,   -1,   -1,    1,
-       1,  -23,   -1,    1,   -1,    1,   23,   -1,
-       1,   -1,    1,   -1,   -1,    1,   -1,    1,
-       1,  -21,   13,   -1,    1,  -13,   21,   -1
+/// Lanes of a block transform pass. Each lane is one column of an 8 row
+/// strip, DCTVector holds a SIMD block of columns and DCTScalar the columns
+/// left over at the end of a row.
+template <typename T>
+struct DCTVector
+{
+    using Type = typename SIMDType<T>::VecType;
+
+    constexpr static int Width = OptimalSIMDSize<T>::value;
+
+    static TNT_INL Type splat(T value)                        { return simdpp::load_splat<Type>(&value); }
+    static TNT_INL Type load(const T* ptr)                    { return simdpp::load_u<Type>(ptr); }
+    static TNT_INL void store(T* ptr, const Type& value)      { simdpp::store_u(ptr, value); }
+    static TNT_INL Type add(const Type& a, const Type& b)     { return simdpp::add(a, b); }
+    static TNT_INL Type sub(const Type& a, const Type& b)     { return simdpp::sub(a, b); }
+    static TNT_INL Type shift(const Type& a, unsigned bits)   { return simdpp::shift_l(a, bits); }
+
+    static TNT_INL Type mul(const Type& a, T constant)
+    {
+        return multiply(a, simdpp::load_splat<Type>(&constant), typename std::is_floating_point<T>::type());
+    }
+
+    /// Arithmetic shift right, rounding half up
+    static TNT_INL Type descale(const Type& a, unsigned bits)
+    {
+        const T half = T(1) << (bits - 1);
+        return simdpp::shift_r(simdpp::add(a, simdpp::load_splat<Type>(&half)), bits);
+    }
+
+private:
+    static TNT_INL Type multiply(const Type& a, const Type& b, std::true_type)  { return MultiplySIMD<T>::run(a, b); }
+
+    // The fixed point products fit in 32 bits, so the low half is enough
+    static TNT_INL Type multiply(const Type& a, const Type& b, std::false_type) { return simdpp::mul_lo(a, b); }
 };
 
-constexpr static int dct_forward_shifts[64] = {
-       0,    0,    0,    0,    0,    0,    0,    0,
-       4,    7,    6,    2,    2,    6,    7,    4,  
-       2,    1,    1,    2,    2,    1,    1,    2,
-       1,    5,    4,    1,    1,    4,    5,    1,
-       1,    1,    1,    1,    1,    1,    1,    1,
-       0,    4,    3,    0,    0,    3,    4,    0,
-       1,    0,    0,    1,    1,    0,    0,    1,
-       2,    5,    4,    0,    0,    4,    5,    2
+template <typename T>
+struct DCTScalar
+{
+    using Type = T;
+
+    constexpr static int Width = 1;
+
+    static TNT_INL Type splat(T value)                      { return value; }
+    static TNT_INL Type load(const T* ptr)                  { return *ptr; }
+    static TNT_INL void store(T* ptr, const Type& value)    { *ptr = value; }
+    static TNT_INL Type add(const Type& a, const Type& b)   { return a + b; }
+    static TNT_INL Type sub(const Type& a, const Type& b)   { return a - b; }
+    static TNT_INL Type shift(const Type& a, unsigned bits) { return a * (T(1) << bits); }
+    static TNT_INL Type mul(const Type& a, T constant)      { return a * constant; }
+    static TNT_INL Type descale(const Type& a, unsigned bits) { return (a + (T(1) << (bits - 1))) >> bits; }
 };
 
+/// `a(k) = sqrt(2) cos(k pi / 16)` and `a(0) = 1`. The Arai-Agui-Nakajima
+/// transforms leave coefficient `(u, v)` scaled by `8 a(u) a(v)`.
+template <typename T>
+inline const T* aan_scales(bool inverse)
+{
+    struct Tables
+    {
+        T forward[64], inverse[64];
+
+        Tables()
+        {
+            const double pi = std::acos(-1.0);
+            for (int u = 0; u < 8; ++u) {
+                for (int v = 0; v < 8; ++v) {
+                    const double scale = (u == 0 ? 1 : std::sqrt(2.) * std::cos(u * pi / 16))
+                                       * (v == 0 ? 1 : std::sqrt(2.) * std::cos(v * pi / 16));
+                    forward[u * 8 + v] = T(1 / (8 * scale));
+                    inverse[u * 8 + v] = T(scale / 8);
+                }
+            }
+        }
+    };
+
+    static const Tables tables;
+    return inverse ? tables.inverse : tables.forward;
+}
+
+/// 1D forward DCT from Arai, Agui and Nakajima with 5 multiplies, as in
+/// libjpeg's jfdctflt.c. The output is unnormalized, see aan_scales().
+template <typename T>
+struct AANForward
+{
+    using WorkType = T;
+
+    template <typename Lanes>
+    static TNT_INL void run(typename Lanes::Type* v, bool)
+    {
+        using Type = typename Lanes::Type;
+
+        const Type tmp0 = Lanes::add(v[0], v[7]), tmp7 = Lanes::sub(v[0], v[7]);
+        const Type tmp1 = Lanes::add(v[1], v[6]), tmp6 = Lanes::sub(v[1], v[6]);
+        const Type tmp2 = Lanes::add(v[2], v[5]), tmp5 = Lanes::sub(v[2], v[5]);
+        const Type tmp3 = Lanes::add(v[3], v[4]), tmp4 = Lanes::sub(v[3], v[4]);
+
+        // Even part
+        const Type tmp10 = Lanes::add(tmp0, tmp3), tmp13 = Lanes::sub(tmp0, tmp3);
+        const Type tmp11 = Lanes::add(tmp1, tmp2), tmp12 = Lanes::sub(tmp1, tmp2);
+
+        v[0] = Lanes::add(tmp10, tmp11);
+        v[4] = Lanes::sub(tmp10, tmp11);
+
+        const Type z1 = Lanes::mul(Lanes::add(tmp12, tmp13), T(0.707106781186547524));
+        v[2] = Lanes::add(tmp13, z1);
+        v[6] = Lanes::sub(tmp13, z1);
+
+        // Odd part
+        const Type odd10 = Lanes::add(tmp4, tmp5);
+        const Type odd11 = Lanes::add(tmp5, tmp6);
+        const Type odd12 = Lanes::add(tmp6, tmp7);
+
+        const Type z5 = Lanes::mul(Lanes::sub(odd10, odd12), T(0.382683432365089772));
+        const Type z2 = Lanes::add(Lanes::mul(odd10, T(0.541196100146196984)), z5);
+        const Type z4 = Lanes::add(Lanes::mul(odd12, T(1.306562964876376527)), z5);
+        const Type z3 = Lanes::mul(odd11, T(0.707106781186547524));
+
+        const Type z11 = Lanes::add(tmp7, z3), z13 = Lanes::sub(tmp7, z3);
+
+        v[5] = Lanes::add(z13, z2);
+        v[3] = Lanes::sub(z13, z2);
+        v[1] = Lanes::add(z11, z4);
+        v[7] = Lanes::sub(z11, z4);
+    }
+
+    static TNT_INL T prepare(T value, int, int) { return value; }
+    static TNT_INL T finish(T value, int u, int v) { return value * aan_scales<T>(false)[u * 8 + v]; }
+};
+
+/// 1D inverse DCT from Arai, Agui and Nakajima, as in libjpeg's jidctflt.c.
+/// The input is prescaled by aan_scales().
+template <typename T>
+struct AANInverse
+{
+    using WorkType = T;
+
+    template <typename Lanes>
+    static TNT_INL void run(typename Lanes::Type* v, bool)
+    {
+        using Type = typename Lanes::Type;
+
+        // Even part
+        const Type tmp10 = Lanes::add(v[0], v[4]), tmp11 = Lanes::sub(v[0], v[4]);
+        const Type tmp13 = Lanes::add(v[2], v[6]);
+        const Type tmp12 = Lanes::sub(Lanes::mul(Lanes::sub(v[2], v[6]), T(1.414213562373095049)), tmp13);
+
+        const Type even0 = Lanes::add(tmp10, tmp13), even3 = Lanes::sub(tmp10, tmp13);
+        const Type even1 = Lanes::add(tmp11, tmp12), even2 = Lanes::sub(tmp11, tmp12);
+
+        // Odd part
+        const Type z13 = Lanes::add(v[5], v[3]), z10 = Lanes::sub(v[5], v[3]);
+        const Type z11 = Lanes::add(v[1], v[7]), z12 = Lanes::sub(v[1], v[7]);
+
+        const Type odd7  = Lanes::add(z11, z13);
+        const Type odd11 = Lanes::mul(Lanes::sub(z11, z13), T(1.414213562373095049));
+
+        const Type z5    = Lanes::mul(Lanes::add(z10, z12), T(1.847759065022573512));
+        const Type odd10 = Lanes::sub(Lanes::mul(z12, T(1.082392200292393968)), z5);
+        const Type odd12 = Lanes::sub(z5, Lanes::mul(z10, T(2.613125929752753055)));
+
+        const Type odd6 = Lanes::sub(odd12, odd7);
+        const Type odd5 = Lanes::sub(odd11, odd6);
+        const Type odd4 = Lanes::add(odd10, odd5);
+
+        v[0] = Lanes::add(even0, odd7);
+        v[7] = Lanes::sub(even0, odd7);
+        v[1] = Lanes::add(even1, odd6);
+        v[6] = Lanes::sub(even1, odd6);
+        v[2] = Lanes::add(even2, odd5);
+        v[5] = Lanes::sub(even2, odd5);
+        v[4] = Lanes::add(even3, odd4);
+        v[3] = Lanes::sub(even3, odd4);
+    }
+
+    static TNT_INL T prepare(T value, int u, int v) { return value * aan_scales<T>(true)[u * 8 + v]; }
+    static TNT_INL T finish(T value, int, int) { return value; }
+};
+
+/// Fixed point constants of the Loeffler, Ligtenberg and Moschytz
+/// factorization, `round(c * 2^ConstBits)`
+struct LoefflerConstants
+{
+    constexpr static int ConstBits = 13;
+    constexpr static int PassBits  = 2;
+
+    constexpr static int32_t C0_298631336 = 2446;
+    constexpr static int32_t C0_390180644 = 3196;
+    constexpr static int32_t C0_541196100 = 4433;
+    constexpr static int32_t C0_765366865 = 6270;
+    constexpr static int32_t C0_899976223 = 7373;
+    constexpr static int32_t C1_175875602 = 9633;
+    constexpr static int32_t C1_501321110 = 12299;
+    constexpr static int32_t C1_847759065 = 15137;
+    constexpr static int32_t C1_961570560 = 16069;
+    constexpr static int32_t C2_053119869 = 16819;
+    constexpr static int32_t C2_562915447 = 20995;
+    constexpr static int32_t C3_072711026 = 25172;
+};
+
+/// 1D forward DCT from Loeffler, Ligtenberg and Moschytz with 12 multiplies,
+/// as in libjpeg's jfdctint.c. The first pass keeps `PassBits` fractional
+/// bits, the last removes them and the factor of 8 of the unnormalized sum.
+template <typename DataType>
+struct LoefflerForward : public LoefflerConstants
+{
+    using WorkType = int32_t;
+
+    template <typename Lanes>
+    static TNT_INL void run(typename Lanes::Type* v, bool last)
+    {
+        using Type = typename Lanes::Type;
+
+        const unsigned bits = last ? ConstBits + PassBits + 3 : ConstBits - PassBits;
+
+        Type tmp0 = Lanes::add(v[0], v[7]), tmp7 = Lanes::sub(v[0], v[7]);
+        Type tmp1 = Lanes::add(v[1], v[6]), tmp6 = Lanes::sub(v[1], v[6]);
+        Type tmp2 = Lanes::add(v[2], v[5]), tmp5 = Lanes::sub(v[2], v[5]);
+        Type tmp3 = Lanes::add(v[3], v[4]), tmp4 = Lanes::sub(v[3], v[4]);
+
+        // Even part
+        const Type tmp10 = Lanes::add(tmp0, tmp3), tmp13 = Lanes::sub(tmp0, tmp3);
+        const Type tmp11 = Lanes::add(tmp1, tmp2), tmp12 = Lanes::sub(tmp1, tmp2);
+
+        v[0] = last ? Lanes::descale(Lanes::add(tmp10, tmp11), PassBits + 3) : Lanes::shift(Lanes::add(tmp10, tmp11), PassBits);
+        v[4] = last ? Lanes::descale(Lanes::sub(tmp10, tmp11), PassBits + 3) : Lanes::shift(Lanes::sub(tmp10, tmp11), PassBits);
+
+        const Type z1 = Lanes::mul(Lanes::add(tmp12, tmp13), C0_541196100);
+        v[2] = Lanes::descale(Lanes::add(z1, Lanes::mul(tmp13, C0_765366865)), bits);
+        v[6] = Lanes::descale(Lanes::sub(z1, Lanes::mul(tmp12, C1_847759065)), bits);
+
+        // Odd part, the negated products of z1 and z2 are subtracted
+        const Type z5 = Lanes::mul(Lanes::add(Lanes::add(tmp4, tmp6), Lanes::add(tmp5, tmp7)), C1_175875602);
+        const Type n1 = Lanes::mul(Lanes::add(tmp4, tmp7), C0_899976223);
+        const Type n2 = Lanes::mul(Lanes::add(tmp5, tmp6), C2_562915447);
+        const Type z3 = Lanes::sub(z5, Lanes::mul(Lanes::add(tmp4, tmp6), C1_961570560));
+        const Type z4 = Lanes::sub(z5, Lanes::mul(Lanes::add(tmp5, tmp7), C0_390180644));
+
+        tmp4 = Lanes::mul(tmp4, C0_298631336);
+        tmp5 = Lanes::mul(tmp5, C2_053119869);
+        tmp6 = Lanes::mul(tmp6, C3_072711026);
+        tmp7 = Lanes::mul(tmp7, C1_501321110);
+
+        v[7] = Lanes::descale(Lanes::sub(Lanes::add(tmp4, z3), n1), bits);
+        v[5] = Lanes::descale(Lanes::sub(Lanes::add(tmp5, z4), n2), bits);
+        v[3] = Lanes::descale(Lanes::sub(Lanes::add(tmp6, z3), n2), bits);
+        v[1] = Lanes::descale(Lanes::sub(Lanes::add(tmp7, z4), n1), bits);
+    }
+
+    static TNT_INL int32_t prepare(DataType value, int, int) { return value; }
+    static TNT_INL DataType finish(int32_t value, int, int) { return static_cast<DataType>(value); }
+};
+
+/// 1D inverse DCT from Loeffler, Ligtenberg and Moschytz, as in libjpeg's
+/// jidctint.c
+template <typename DataType>
+struct LoefflerInverse : public LoefflerConstants
+{
+    using WorkType = int32_t;
+
+    template <typename Lanes>
+    static TNT_INL void run(typename Lanes::Type* v, bool last)
+    {
+        using Type = typename Lanes::Type;
+
+        const unsigned bits = last ? ConstBits + PassBits + 3 : ConstBits - PassBits;
+
+        // Even part
+        const Type z1   = Lanes::mul(Lanes::add(v[2], v[6]), C0_541196100);
+        const Type tmp2 = Lanes::sub(z1, Lanes::mul(v[6], C1_847759065));
+        const Type tmp3 = Lanes::add(z1, Lanes::mul(v[2], C0_765366865));
+        const Type tmp0 = Lanes::shift(Lanes::add(v[0], v[4]), ConstBits);
+        const Type tmp1 = Lanes::shift(Lanes::sub(v[0], v[4]), ConstBits);
+
+        const Type tmp10 = Lanes::add(tmp0, tmp3), tmp13 = Lanes::sub(tmp0, tmp3);
+        const Type tmp11 = Lanes::add(tmp1, tmp2), tmp12 = Lanes::sub(tmp1, tmp2);
+
+        // Odd part, the negated products of z1 and z2 are subtracted
+        const Type z5 = Lanes::mul(Lanes::add(Lanes::add(v[7], v[3]), Lanes::add(v[5], v[1])), C1_175875602);
+        const Type n1 = Lanes::mul(Lanes::add(v[7], v[1]), C0_899976223);
+        const Type n2 = Lanes::mul(Lanes::add(v[5], v[3]), C2_562915447);
+        const Type z3 = Lanes::sub(z5, Lanes::mul(Lanes::add(v[7], v[3]), C1_961570560));
+        const Type z4 = Lanes::sub(z5, Lanes::mul(Lanes::add(v[5], v[1]), C0_390180644));
+
+        const Type odd0 = Lanes::sub(Lanes::add(Lanes::mul(v[7], C0_298631336), z3), n1);
+        const Type odd1 = Lanes::sub(Lanes::add(Lanes::mul(v[5], C2_053119869), z4), n2);
+        const Type odd2 = Lanes::sub(Lanes::add(Lanes::mul(v[3], C3_072711026), z3), n2);
+        const Type odd3 = Lanes::sub(Lanes::add(Lanes::mul(v[1], C1_501321110), z4), n1);
+
+        v[0] = Lanes::descale(Lanes::add(tmp10, odd3), bits);
+        v[7] = Lanes::descale(Lanes::sub(tmp10, odd3), bits);
+        v[1] = Lanes::descale(Lanes::add(tmp11, odd2), bits);
+        v[6] = Lanes::descale(Lanes::sub(tmp11, odd2), bits);
+        v[2] = Lanes::descale(Lanes::add(tmp12, odd1), bits);
+        v[5] = Lanes::descale(Lanes::sub(tmp12, odd1), bits);
+        v[3] = Lanes::descale(Lanes::add(tmp13, odd0), bits);
+        v[4] = Lanes::descale(Lanes::sub(tmp13, odd0), bits);
+    }
+
+    static TNT_INL int32_t prepare(DataType value, int, int) { return value; }
+    static TNT_INL DataType finish(int32_t value, int, int) { return static_cast<DataType>(value); }
+};
+
+/// Applies a separable 8x8 block transform to a tensor one strip of 8 rows
+/// at a time. Each 1D pass runs down the columns of the strip, so one SIMD
+/// pass transforms `Width` columns of every block in the strip at once. The
+/// strip is copied with every block transposed, transformed, transposed
+/// back and transformed again, which lands the coefficients in place.
+template <typename DataType, typename Kernel>
+struct BlockTransform8x8
+{
+    using WorkType = typename Kernel::WorkType;
+
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor)
+    {
+        const int rows = tensor.shape[0], cols = tensor.shape[1];
+
+        Tensor<DataType> output(tensor.shape);
+
+        std::vector<WorkType> first(8 * cols), second(8 * cols);
+
+        for (int top = 0; top < rows; top += 8) {
+            const DataType* input = tensor.data.data + top * cols;
+            DataType*       out   = output.data.data + top * cols;
+
+            for (int y = 0; y < 8; ++y)
+                for (int col = 0; col < cols; ++col)
+                    first[(col % 8) * cols + col - col % 8 + y] = Kernel::prepare(input[y * cols + col], y, col % 8);
+
+            pass(first.data(), cols, false);
+
+            for (int y = 0; y < 8; ++y)
+                for (int col = 0; col < cols; ++col)
+                    second[(col % 8) * cols + col - col % 8 + y] = first[y * cols + col];
+
+            pass(second.data(), cols, true);
+
+            for (int u = 0; u < 8; ++u)
+                for (int col = 0; col < cols; ++col)
+                    out[u * cols + col] = Kernel::finish(second[u * cols + col], u, col % 8);
+        }
+
+        return output;
+    }
+
+private:
+    static void pass(WorkType* data, int length, bool last)
+    {
+        int col = 0;
+        for (; col + DCTVector<WorkType>::Width <= length; col += DCTVector<WorkType>::Width)
+            lanes<DCTVector<WorkType>>(data + col, length, last);
+
+        for (; col < length; ++col)
+            lanes<DCTScalar<WorkType>>(data + col, length, last);
+    }
+
+    template <typename Lanes>
+    static TNT_INL void lanes(WorkType* data, int length, bool last)
+    {
+        typename Lanes::Type v[8];
+        for (int i = 0; i < 8; ++i)
+            v[i] = Lanes::load(data + i * length);
+
+        Kernel::template run<Lanes>(v, last);
+
+        for (int i = 0; i < 8; ++i)
+            Lanes::store(data + i * length, v[i]);
+    }
+};
 
 template <typename DataType>
 struct OptimizedDCT<DataType, void>
 {
-    using VecType = typename SIMDType<DataType>::VecType;
+    using Kernel = typename std::conditional<std::is_floating_point<DataType>::value,
+                                             AANForward<DataType>, LoefflerForward<DataType>>::type;
+
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor)
+    {
+        return BlockTransform8x8<DataType, Kernel>::eval(tensor);
+    }
+};
+
+template <typename DataType>
+struct OptimizedIDCT<DataType, void>
+{
+    using Kernel = typename std::conditional<std::is_floating_point<DataType>::value,
+                                             AANInverse<DataType>, LoefflerInverse<DataType>>::type;
 
     static Tensor<DataType> eval(const Tensor<DataType>& tensor)
     {
-        
+        return BlockTransform8x8<DataType, Kernel>::eval(tensor);
     }
 };
 
 } // namespace detail
 
+// ----------------------------------------------------------------------------
+// Unit tests
+
+namespace
+{
+
+/// The orthonormal 8x8 DCT, or its inverse, of every block in long double
+template <typename T>
+std::vector<long double> reference_dct(const Tensor<T>& tensor, bool inverse)
+{
+    const long double pi = std::acos(-1.0L);
+    const int rows = tensor.shape[0], cols = tensor.shape[1];
+
+    auto basis = [pi](int k, int n) {
+        return (k == 0 ? std::sqrt(0.125L) : 0.5L) * std::cos((2 * n + 1) * k * pi / 16);
+    };
+
+    std::vector<long double> result(rows * cols, 0);
+    for (int top = 0; top < rows; top += 8) {
+        for (int left = 0; left < cols; left += 8) {
+            for (int r = 0; r < 8; ++r) {
+                for (int c = 0; c < 8; ++c) {
+                    long double sum = 0;
+                    for (int y = 0; y < 8; ++y)
+                        for (int x = 0; x < 8; ++x)
+                            sum += (long double) tensor.data[(top + y) * cols + left + x]
+                                 * (inverse ? basis(y, r) * basis(x, c) : basis(r, y) * basis(c, x));
+
+                    result[(top + r) * cols + left + c] = sum;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+using dct_integer_data_types = doctest::Types<int16_t, int32_t>;
+
+} // namespace
+
+TEST_CASE_TEMPLATE("dct(const Tensor<T>&)", T, test_float_data_types)
+{
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<T> distribution(-128, 128);
+
+    Tensor<T> tensor(Shape{16, 40});
+    for (int i = 0; i < tensor.shape.total(); ++i)
+        tensor.data[i] = distribution(generator);
+
+    const T tolerance = 1024 * 64 * std::numeric_limits<T>::epsilon();
+
+    Tensor<T> coefficients = dct(tensor);
+    REQUIRE((coefficients.shape == tensor.shape));
+
+    std::vector<long double> expected = reference_dct(tensor, false);
+    for (int i = 0; i < tensor.shape.total(); ++i)
+        REQUIRE(std::fabs(coefficients.data[i] - expected[i]) <= tolerance);
+
+    expected = reference_dct(coefficients, true);
+    Tensor<T> samples = idct(coefficients);
+    for (int i = 0; i < tensor.shape.total(); ++i) {
+        REQUIRE(std::fabs(samples.data[i] - expected[i]) <= tolerance);
+        REQUIRE(std::fabs(samples.data[i] - tensor.data[i]) <= tolerance);
+    }
+
+    REQUIRE_THROWS(dct(Tensor<T>(Shape{8, 8, 1})));
+    REQUIRE_THROWS(dct(Tensor<T>(Shape{8, 12})));
+    REQUIRE_THROWS(idct(Tensor<T>(Shape{64})));
+    REQUIRE_THROWS(idct(Tensor<T>(Shape{4, 8})));
+}
+
+TEST_CASE_TEMPLATE("dct(const Tensor<T>&)", T, dct_integer_data_types)
+{
+    { // A flat block only has a DC coefficient
+        Tensor<T> coefficients = dct(Tensor<T>(Shape{8, 8}, 10));
+        REQUIRE(coefficients.data[0] == 80);
+        for (int i = 1; i < 64; ++i)
+            REQUIRE(coefficients.data[i] == 0);
+
+        REQUIRE((idct(coefficients) == Tensor<T>(Shape{8, 8}, 10)));
+    }
+
+    std::mt19937 generator(13);
+    std::uniform_int_distribution<int> distribution(-128, 127);
+
+    Tensor<T> tensor(Shape{24, 48});
+    for (int i = 0; i < tensor.shape.total(); ++i)
+        tensor.data[i] = (T) distribution(generator);
+
+    // The fixed point transforms are within one of the rounded exact result
+    Tensor<T> coefficients = dct(tensor);
+    std::vector<long double> expected = reference_dct(tensor, false);
+    for (int i = 0; i < tensor.shape.total(); ++i)
+        REQUIRE(std::fabs(coefficients.data[i] - expected[i]) <= 1.5);
+
+    expected = reference_dct(coefficients, true);
+    Tensor<T> samples = idct(coefficients);
+    for (int i = 0; i < tensor.shape.total(); ++i)
+        REQUIRE(std::fabs(samples.data[i] - expected[i]) <= 1.5);
+
+    REQUIRE_THROWS(dct(Tensor<T>(Shape{16, 20})));
+    REQUIRE_THROWS(idct(Tensor<T>(Shape{8, 8, 8})));
+}
+
 } // namespace tnt
 
 #endif // TNT_LINEAR_DISCRETE_COSINE_TRANSFORM_IMPL_HPP
@@ -2,7 +2,15 @@
 #define TNT_LINEAR_EIGEN_IMPL_HPP
 
 #include <tnt/linear/eigen.hpp>
+#include <tnt/linear/impl/blas1_impl.hpp>
+#include <tnt/linear/impl/symmetric_eigen_impl.hpp>
 #include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
 
 namespace tnt
 {
@@ -11,61 +19,106 @@ namespace detail
 {
 
 template <typename DataType>
-struct OptimizedEigenvalues<DataType>
+struct OptimizedEigenvalues<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
 {
+    /// The largest matrix solved with Jacobi rotations. Above it the
+    /// tridiagonal reduction of [OptimizedSymmetricEigen]() is faster, from
+    /// about 48 rows for float and 24 for double.
+    constexpr static int JacobiSize = 40;
+
     static Tensor<DataType> eval(const Tensor<DataType>& tensor, int max_iterations, float eps)
     {
-        Tensor<DataType> A = tensor;
-        int p, q;
-
-        // Find largest off diagonal value
-        for (int i = 0; i < max_iterations; ++i) {
-            DataType max_value = -std::numeric_limits<DataType>::max();
-            for (int r = 0; r < A.shape[0]; ++r) {
-                for (int c = 0; c < A.shape[1]; ++c) {
-                    if (r == c)
-                        continue;
+        const int n = tensor.shape[0];
 
-                    const DataType value = std::abs((DataType) A(r, c));
-                    if (value > max_value) {
-                        max_value = value;
-                        p = r;
-                        q = c;
-                    }
+        if (n > JacobiSize) {
+            SymmetricEigen<DataType> result;
+            const bool converged = OptimizedSymmetricEigen<DataType>::eval(tensor, false, 1, result);
+
+            TNT_ASSERT(converged, InvalidParameterException("tnt::eigenvalues()", __FILE__, __LINE__,
+                                      "Eigen decomposition did not converge, the matrix may hold NaN or infinity"))
+
+            return result.values;
+        }
+
+        Tensor<DataType> A = tensor;
+        DataType* a = A.data.data;
+
+        for (int sweep = 0; sweep < max_iterations; ++sweep) {
+            DataType largest = 0, total = 0;
+            for (int p = 0; p < n; ++p) {
+                for (int q = p + 1; q < n; ++q) {
+                    const DataType value = std::abs(a[p * n + q]);
+                    largest = std::max(largest, value);
+                    total += value;
                 }
             }
 
-            if (max_value < eps) // basically diagonal
+            if (largest == 0 || largest < eps) // basically diagonal
                 break;
 
-            const DataType pp = A(p, p);
-            const DataType qq = A(q, q);
-            const DataType pq = A(p, q);
+            // Early sweeps skip the elements below a fifth of the average
+            const DataType threshold = sweep < 3 ? DataType(0.2) * total / (DataType(n) * n) : DataType(0);
 
-            const DataType tau = (qq - pp) / (2 * pq);
-            const DataType phi = ((tau > 0) - (tau < 0)) / (std::abs(tau) + std::sqrt(1 + std::pow(tau, 2)));
+            for (int p = 0; p < n; ++p) {
+                for (int q = p + 1; q < n; ++q) {
+                    const DataType pq = std::abs(a[p * n + q]);
 
-            const DataType c = 1 / std::sqrt(1 + std::pow(phi, 2));
-            const DataType s = phi * c;
-
-            Tensor<DataType> givens = identity<DataType>(tensor.shape);
-            givens(p, p) =  c;
-            givens(q, q) =  c;
-            givens(p, q) =  s;
-            givens(q, p) = -s;
+                    // Once an element cannot change either diagonal element
+                    // it is dropped instead of rotated
+                    const DataType g = 100 * pq;
+                    if (sweep > 3 && std::abs(a[p * n + p]) + g == std::abs(a[p * n + p])
+                                  && std::abs(a[q * n + q]) + g == std::abs(a[q * n + q])) {
+                        a[p * n + q] = a[q * n + p] = 0;
+                        continue;
+                    }
 
-            A = givens.transpose().mul(A);
-            A = A.mul(givens);
+                    if (pq > threshold)
+                        rotate(a, n, p, q);
+                }
+            }
         }
 
-        Tensor<DataType> evals(Shape{tensor.shape[0]});
-        for (int r = 0; r < tensor.shape[0]; ++r)
-            evals(r) = (DataType) A(r, r);
+        Tensor<DataType> evals(Shape{n});
+        for (int r = 0; r < n; ++r)
+            evals.data[r] = a[r * n + r];
 
         return evals;
     }
+
+private:
+    /// Zero `a(p, q)` with the rotation `A = J^T A J`
+    static void rotate(DataType* a, int n, int p, int q) noexcept
+    {
+        DataType* row_p = a + p * n;
+        DataType* row_q = a + q * n;
+
+        const DataType pp = row_p[p];
+        const DataType qq = row_q[q];
+        const DataType pq = row_p[q];
+
+        // The smaller of the two rotation angles that zero a(p, q)
+        const DataType theta = (qq - pp) / (2 * pq);
+        const DataType t = (theta >= 0 ? 1 : -1) / (std::abs(theta) + std::hypot(DataType(1), theta));
+
+        const DataType c = 1 / std::sqrt(1 + t * t);
+        const DataType s = t * c;
+
+        // Rows p and q become the rotated columns by symmetry
+        PlaneRotation<DataType>::apply(row_p, row_q, n, c, s);
+        for (int k = 0; k < n; ++k) {
+            a[k * n + p] = row_p[k];
+            a[k * n + q] = row_q[k];
+        }
+
+        row_p[p] = pp - t * pq;
+        row_q[q] = qq + t * pq;
+        row_p[q] = row_q[p] = 0;
+    }
 };
 
+template <typename DataType>
+constexpr int OptimizedEigenvalues<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::JacobiSize;
+
 } // namespace detail
 
 TEST_CASE_TEMPLATE("eigenvalues()", T, test_float_data_types)
@@ -78,6 +131,49 @@ TEST_CASE_TEMPLATE("eigenvalues()", T, test_float_data_types)
                                           Tensor<T>(Shape{3}, AlignedPtr<T>(expected, 3)))));
     }
 
+    { // Symmetric matrices with a known spectrum, Q diag(lambda) Q^T with a
+      // Householder reflection Q = I - 2 v v^T / v^T v
+        for (int n : {1, 2, 7, 16, 33, 100}) {
+            std::mt19937 generator(n);
+            std::uniform_real_distribution<T> distribution(-1, 1);
+
+            std::vector<T> lambda(n), v(n);
+            for (int i = 0; i < n; ++i) {
+                lambda[i] = distribution(generator) * 10;
+                v[i] = distribution(generator);
+            }
+
+            T norm = 0;
+            for (int i = 0; i < n; ++i)
+                norm += v[i] * v[i];
+
+            Tensor<T> A(Shape{n, n});
+            for (int r = 0; r < n; ++r) {
+                for (int c = 0; c < n; ++c) {
+                    T sum = 0;
+                    for (int k = 0; k < n; ++k) {
+                        const T q_rk = (r == k) - 2 * v[r] * v[k] / norm;
+                        const T q_ck = (c == k) - 2 * v[c] * v[k] / norm;
+                        sum += q_rk * lambda[k] * q_ck;
+                    }
+                    A.data[r * n + c] = sum;
+                }
+            }
+
+            const T eps = std::is_same<T, float>::value ? T(1e-5) : T(1e-10);
+            Tensor<T> evals = eigenvalues(A, 100, eps);
+            REQUIRE(evals.shape == Shape{n});
+
+            std::vector<T> sorted(evals.data.data, evals.data.data + n);
+            std::sort(sorted.begin(), sorted.end());
+            std::sort(lambda.begin(), lambda.end());
+
+            const T tolerance = std::is_same<T, float>::value ? T(1e-3) : T(1e-9);
+            for (int i = 0; i < n; ++i)
+                REQUIRE(std::fabs(sorted[i] - lambda[i]) <= tolerance);
+        }
+    }
+
     REQUIRE_THROWS((eigenvalues(Tensor<T>(Shape{3, 4}))));
     REQUIRE_THROWS((eigenvalues(Tensor<T>(Shape{2, 2, 2}))));
 }
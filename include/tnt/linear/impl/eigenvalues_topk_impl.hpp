@@ -0,0 +1,272 @@
+#ifndef TNT_LINEAR_EIGENVALUES_TOPK_IMPL_HPP
+#define TNT_LINEAR_EIGENVALUES_TOPK_IMPL_HPP
+
+#include <tnt/linear/eigen.hpp>
+#include <tnt/linear/impl/blas1_impl.hpp>
+#include <tnt/linear/impl/symmetric_eigen_impl.hpp>
+#include <tnt/linear/impl/matrix_multiply_impl.hpp>
+#include <tnt/utils/parallel.hpp>
+#include <tnt/utils/testing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Randomized subspace iteration. A block of `b` orthonormal vectors `Q` is
+/// multiplied by `A` and the eigenpairs of the projection `Q^T A Q` give the
+/// Ritz pairs `(theta, Q s)`. The next block is the orthonormalized `A Q s`.
+/// Blocks are stored transposed, one vector per contiguous row, so the
+/// product with `A` is the row-major `Q^T A` and the vectors are combined with
+/// [dot_row]() and [multiply_add_row]().
+template <typename DataType>
+struct OptimizedEigenvaluesTopK<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using Multiply = OptimizedMatrixMultiply<DataType>;
+
+    /// Extra vectors in the block beyond `k`, at least
+    constexpr static int MinOversample = 10;
+
+    /// Columns of `Q^T A` computed by one task
+    constexpr static int ColumnBlock = 256;
+
+    static SymmetricEigen<DataType> eval(const Tensor<DataType>& tensor, int k, int max_iterations, float eps, int num_threads)
+    {
+        const int n = tensor.shape[0];
+        const int b = std::min(n, k + std::max(k, int(MinOversample)));
+        const DataType* a = tensor.data.data;
+
+        std::mt19937 generator(n);
+        std::vector<DataType> Q(b * n), Y(b * n), X(b * n), AX(b * n), S(b * b), residual(n);
+
+        std::normal_distribution<DataType> distribution;
+        for (DataType& value : Q)
+            value = distribution(generator);
+
+        orthonormalize(Q.data(), b, n, generator);
+
+        Tensor<DataType> H(Shape{b, b});
+        std::vector<DataType> theta(b);
+        std::vector<int> order(b);
+
+        for (int iteration = 0; ; ++iteration) {
+            // Y^T = Q^T A, as A is symmetric
+            std::fill(Y.begin(), Y.end(), DataType(0));
+            multiply(b, n, n, Q.data(), a, Y.data(), num_threads);
+
+            for (int i = 0; i < b; ++i) {
+                for (int j = i; j < b; ++j) {
+                    const DataType ij = dot_row(Q.data() + i * n, Y.data() + j * n, n);
+                    const DataType ji = dot_row(Q.data() + j * n, Y.data() + i * n, n);
+                    H.data[i * b + j] = H.data[j * b + i] = (ij + ji) / 2;
+                }
+            }
+
+            // Ritz pairs by decreasing magnitude, S holds their coordinates
+            // in Q as rows
+            SymmetricEigen<DataType> ritz;
+            const bool solved = OptimizedSymmetricEigen<DataType>::eval(H, true, 1, ritz);
+
+            TNT_ASSERT(solved, InvalidParameterException("tnt::eigenvalues_topk()", __FILE__, __LINE__,
+                                   "Eigen decomposition did not converge, the matrix may hold NaN or infinity"))
+
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](int i, int j) {
+                return std::abs(ritz.values.data[i]) > std::abs(ritz.values.data[j]);
+            });
+
+            for (int i = 0; i < b; ++i) {
+                theta[i] = ritz.values.data[order[i]];
+                for (int j = 0; j < b; ++j)
+                    S[i * b + j] = ritz.vectors.data[j * b + order[i]];
+            }
+
+            std::fill(X.begin(), X.end(), DataType(0));
+            std::fill(AX.begin(), AX.end(), DataType(0));
+            multiply(b, n, b, S.data(), Q.data(), X.data(), num_threads);
+            multiply(b, n, b, S.data(), Y.data(), AX.data(), num_threads);
+
+            const DataType tolerance = DataType(eps) * std::abs(theta[0]);
+
+            bool converged = true;
+            for (int i = 0; i < k && converged; ++i) {
+                std::copy(AX.begin() + i * n, AX.begin() + (i + 1) * n, residual.begin());
+                multiply_add_row(-theta[i], X.data() + i * n, residual.data(), n);
+
+                converged = std::sqrt(dot_row(residual.data(), residual.data(), n)) <= tolerance;
+            }
+
+            if (converged || iteration + 1 >= max_iterations)
+                break;
+
+            Q.swap(AX);
+            orthonormalize(Q.data(), b, n, generator);
+        }
+
+        SymmetricEigen<DataType> result;
+        result.values = Tensor<DataType>(Shape{k});
+        result.vectors = Tensor<DataType>(Shape{n, k});
+        for (int i = 0; i < k; ++i) {
+            result.values.data[i] = theta[i];
+            for (int r = 0; r < n; ++r)
+                result.vectors.data[r * k + i] = X[i * n + r];
+        }
+
+        return result;
+    }
+
+private:
+    /// `C += A B` for a `rows x depth` matrix A and a `depth x n` matrix B,
+    /// split into blocks of columns
+    static void multiply(int rows, int n, int depth, const DataType* left, const DataType* right, DataType* out, int num_threads)
+    {
+        auto product = [&](int block) {
+            const int c0 = block * ColumnBlock;
+            Multiply::gemm(rows, std::min(ColumnBlock, n - c0), depth, left, depth, right + c0, n, out + c0, n);
+        };
+
+        parallel_for((n + ColumnBlock - 1) / ColumnBlock, num_threads, product);
+    }
+
+    /// Modified Gram-Schmidt on the rows, applied twice. A row that is
+    /// (numerically) in the span of the rows before it is replaced by a random
+    /// direction, so the block keeps its size when `A` has low rank.
+    static void orthonormalize(DataType* q, int b, int n, std::mt19937& generator)
+    {
+        std::normal_distribution<DataType> distribution;
+
+        for (int i = 0; i < b; ++i) {
+            DataType* row = q + i * n;
+            const DataType length = std::sqrt(dot_row(row, row, n));
+
+            DataType norm = 0;
+            for (bool random = false; ; random = true) {
+                if (random) {
+                    for (int c = 0; c < n; ++c)
+                        row[c] = distribution(generator);
+                }
+
+                for (int pass = 0; pass < 2; ++pass) {
+                    for (int j = 0; j < i; ++j) {
+                        const DataType* previous = q + j * n;
+                        multiply_add_row(-dot_row(row, previous, n), previous, row, n);
+                    }
+                }
+
+                norm = std::sqrt(dot_row(row, row, n));
+                if (random || norm > 64 * std::numeric_limits<DataType>::epsilon() * length)
+                    break;
+            }
+
+            const DataType inverse = 1 / norm;
+            for (int c = 0; c < n; ++c)
+                row[c] *= inverse;
+        }
+    }
+};
+
+template <typename DataType>
+constexpr int OptimizedEigenvaluesTopK<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::ColumnBlock;
+
+} // namespace detail
+
+TEST_CASE_TEMPLATE("eigenvalues_topk()", T, test_float_data_types)
+{
+    const T eps = std::is_same<T, float>::value ? T(1e-4) : T(1e-9);
+
+    { // Covariance-like spectra lambda_i = 100 * 0.8^i in a random basis
+        for (int n : {5, 60, 300}) {
+            std::mt19937 generator(n);
+            std::uniform_real_distribution<T> distribution(-1, 1);
+
+            std::vector<T> lambda(n), u(n), v(n);
+            for (int i = 0; i < n; ++i) {
+                lambda[i] = T(100 * std::pow(0.8, i));
+                u[i] = distribution(generator);
+                v[i] = distribution(generator);
+            }
+
+            T u_norm = 0, v_norm = 0;
+            for (int i = 0; i < n; ++i) {
+                u_norm += u[i] * u[i];
+                v_norm += v[i] * v[i];
+            }
+
+            std::vector<T> Q(n * n);
+            for (int r = 0; r < n; ++r) {
+                for (int c = 0; c < n; ++c) {
+                    T sum = 0;
+                    for (int k = 0; k < n; ++k)
+                        sum += ((r == k) - 2 * u[r] * u[k] / u_norm) * ((k == c) - 2 * v[k] * v[c] / v_norm);
+                    Q[r * n + c] = sum;
+                }
+            }
+
+            Tensor<T> A(Shape{n, n});
+            for (int r = 0; r < n; ++r) {
+                for (int c = 0; c < n; ++c) {
+                    T sum = 0;
+                    for (int k = 0; k < n; ++k)
+                        sum += Q[r * n + k] * lambda[k] * Q[c * n + k];
+                    A.data[r * n + c] = sum;
+                }
+            }
+
+            for (int k : {1, 5}) {
+                SymmetricEigen<T> result = eigenvalues_topk(A, k, 500, float(eps), 1);
+                REQUIRE(result.values.shape == Shape{k});
+                REQUIRE(result.vectors.shape == (Shape{n, k}));
+
+                for (int i = 0; i < k; ++i) {
+                    REQUIRE(std::abs(result.values.data[i] - lambda[i]) <= 100 * eps * lambda[0]);
+
+                    for (int j = 0; j < k; ++j) {
+                        T dot = 0;
+                        for (int r = 0; r < n; ++r)
+                            dot += result.vectors.data[r * k + i] * result.vectors.data[r * k + j];
+                        REQUIRE(std::abs(dot - (i == j)) <= 100 * eps);
+                    }
+
+                    for (int r = 0; r < n; ++r) {
+                        T ax = 0;
+                        for (int c = 0; c < n; ++c)
+                            ax += A.data[r * n + c] * result.vectors.data[c * k + i];
+                        REQUIRE(std::abs(ax - result.values.data[i] * result.vectors.data[r * k + i]) <= 10 * eps * lambda[0]);
+                    }
+                }
+
+                SymmetricEigen<T> threaded = eigenvalues_topk(A, k, 500, float(eps), 3);
+                REQUIRE(threaded.values == result.values);
+                REQUIRE(threaded.vectors == result.vectors);
+            }
+        }
+    }
+
+    { // Low rank and indefinite: diag(-7, 3, 0, ..., 0)
+        Tensor<T> A = zeros<T>(Shape{50, 50});
+        A.data[0] = -7;
+        A.data[51] = 3;
+
+        SymmetricEigen<T> result = eigenvalues_topk(A, 3);
+        REQUIRE(std::abs(result.values.data[0] + 7) <= T(1e-3));
+        REQUIRE(std::abs(result.values.data[1] - 3) <= T(1e-3));
+        REQUIRE(std::abs(result.values.data[2]) <= T(1e-3));
+        REQUIRE(std::abs(std::abs(result.vectors.data[0]) - 1) <= T(1e-3));
+    }
+
+    REQUIRE_THROWS((eigenvalues_topk(Tensor<T>(Shape{3, 4}), 1)));
+    REQUIRE_THROWS((eigenvalues_topk(Tensor<T>(Shape{4, 4}), 0)));
+    REQUIRE_THROWS((eigenvalues_topk(Tensor<T>(Shape{4, 4}), 5)));
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_EIGENVALUES_TOPK_IMPL_HPP
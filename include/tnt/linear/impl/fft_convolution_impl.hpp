@@ -0,0 +1,281 @@
+#ifndef TNT_LINEAR_FFT_CONVOLUTION_IMPL_HPP
+#define TNT_LINEAR_FFT_CONVOLUTION_IMPL_HPP
+
+#include <tnt/linear/convolution.hpp>
+#include <tnt/linear/impl/fourier_transform_impl.hpp>
+#include <tnt/utils/testing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Overlap-add cross correlation. The padded tensor is cut into tiles of
+/// `(N - KH + 1) x (N - KW + 1)` pixels. Each tile is zero padded to `N x N`
+/// and its linear convolution with the flipped kernels is the circular one,
+/// computed as a pointwise product of spectra. The tile results overlap by
+/// `KH - 1` rows and `KW - 1` columns and are summed into the output.
+///
+/// The tensor and the output are real, which halves the transforms. Two
+/// channels share one forward transform as `a + i b` and are separated with
+/// the conjugate symmetry of real spectra. Two kernels share one inverse
+/// transform, their spectra are stored as `S_k + i S_k+1`, so the real and
+/// imaginary parts of the result are the two outputs.
+template <typename DataType>
+struct OptimizedFFTConvolution<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using Complex = std::complex<DataType>;
+
+    constexpr static int MaxSize = 256;
+
+    /// Limit on the number of complex values in a KernelSpectrum
+    constexpr static long long MaxSpectrumValues = 1LL << 24;
+
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor, const KernelSpectrum<DataType>& spectrum, int pad, DataType pad_value)
+    {
+        const int height = tensor.shape[0], width = tensor.shape[1], channels = tensor.shape[2];
+        const int kernel_rows = spectrum.kernel_rows, kernel_cols = spectrum.kernel_cols;
+        const int num_kernels = spectrum.num_kernels, pairs = (num_kernels + 1) / 2;
+        const int size = spectrum.fft_size, area = size * size;
+
+        const int padded_rows = height + 2 * pad, padded_cols = width + 2 * pad;
+        const int out_rows = padded_rows - kernel_rows + 1, out_cols = padded_cols - kernel_cols + 1;
+        const int tile_rows = size - kernel_rows + 1, tile_cols = size - kernel_cols + 1;
+
+        Tensor<DataType> output(Shape{out_rows, out_cols, num_kernels});
+
+        const FFTPlan<DataType>& fft = *FFTPlan<DataType>::get(size);
+        std::vector<Complex> inputs(channels * area);
+        std::vector<Complex> product(area);
+
+        for (int top = 0; top < padded_rows; top += tile_rows) {
+            for (int left = 0; left < padded_cols; left += tile_cols) {
+                const int rows = std::min(tile_rows, padded_rows - top);
+                const int cols = std::min(tile_cols, padded_cols - left);
+
+                for (int c = 0; c < channels; c += 2) {
+                    Complex* packed = inputs.data() + c * area;
+                    const bool paired = c + 1 < channels;
+
+                    gather(tensor, c, paired, top - pad, left - pad, rows, cols, pad_value, size, packed);
+                    forward2D(fft, packed, rows);
+
+                    if (paired)
+                        separate(packed, packed + area, size);
+                }
+
+                for (int p = 0; p < pairs; ++p) {
+                    std::fill(product.begin(), product.end(), Complex(0));
+
+                    for (int c = 0; c < channels; ++c)
+                        multiply_add(inputs.data() + c * area, spectrum.values.data() + (p * channels + c) * area,
+                                     product.data(), area);
+
+                    const int result_rows = rows + kernel_rows - 1, result_cols = cols + kernel_cols - 1;
+                    inverse2D(fft, product.data(), result_rows);
+
+                    // Result (i, j) is the output at (top + i - KH + 1, left + j - KW + 1)
+                    for (int i = std::max(0, kernel_rows - 1 - top); i < result_rows; ++i) {
+                        const int y = top + i - kernel_rows + 1;
+                        if (y >= out_rows)
+                            break;
+
+                        for (int j = std::max(0, kernel_cols - 1 - left); j < result_cols; ++j) {
+                            const int x = left + j - kernel_cols + 1;
+                            if (x >= out_cols)
+                                break;
+
+                            DataType* out = output.data.data + (y * out_cols + x) * num_kernels + 2 * p;
+                            out[0] += product[i * size + j].real();
+                            if (2 * p + 1 < num_kernels)
+                                out[1] += product[i * size + j].imag();
+                        }
+                    }
+                }
+            }
+        }
+
+        return output;
+    }
+
+    /// The transform size with the least work on a `height x width` padded
+    /// tensor, or per output pixel of a large tensor when both are zero
+    static int optimal_size(int kernel_rows, int kernel_cols, long long spectra, int height = 0, int width = 0)
+    {
+        int best = 1;
+        while (best < std::max(kernel_rows, kernel_cols))
+            best *= 2;
+
+        double best_cost = cost(best, kernel_rows, kernel_cols, height, width);
+
+        for (int size = 2 * best; size <= MaxSize && spectra * size * size <= MaxSpectrumValues; size *= 2) {
+            const double size_cost = cost(size, kernel_rows, kernel_cols, height, width);
+            if (size_cost < best_cost) {
+                best      = size;
+                best_cost = size_cost;
+            }
+        }
+
+        return best;
+    }
+
+    /// 2D transform of an `N x N` matrix whose rows past `rows` are zero. The
+    /// column transforms run over whole rows, a SIMD vector of columns at a
+    /// time.
+    static void forward2D(const FFTPlan<DataType>& fft, Complex* data, int rows)
+    {
+        fft.run(data, 1, rows, false);
+        fft.run(data, fft.size, 1, false);
+    }
+
+    /// 2D inverse transform of an `N x N` matrix, only the first `rows` rows
+    /// of the result are computed
+    static void inverse2D(const FFTPlan<DataType>& fft, Complex* data, int rows)
+    {
+        fft.run(data, fft.size, 1, true);
+        fft.run(data, 1, rows, true);
+    }
+
+    /// Flip and transform each kernel, packing pairs of kernels into the real
+    /// and imaginary parts of one transform
+    static std::vector<Complex> transform_kernels(const DataType* kernel, int num_kernels, int kernel_rows, int kernel_cols, int channels, int size)
+    {
+        const int area = size * size, pairs = (num_kernels + 1) / 2;
+        const int patch = kernel_rows * kernel_cols * channels;
+        const DataType scale = DataType(1) / area;
+
+        const FFTPlan<DataType>& fft = *FFTPlan<DataType>::get(size);
+        std::vector<Complex> values(pairs * channels * area);
+
+        for (int p = 0; p < pairs; ++p) {
+            for (int c = 0; c < channels; ++c) {
+                Complex* spectrum = values.data() + (p * channels + c) * area;
+
+                for (int ky = 0; ky < kernel_rows; ++ky) {
+                    for (int kx = 0; kx < kernel_cols; ++kx) {
+                        const int flipped = (kernel_rows - 1 - ky) * size + (kernel_cols - 1 - kx);
+                        const int offset  = (ky * kernel_cols + kx) * channels + c;
+
+                        const DataType imag = 2 * p + 1 < num_kernels ? kernel[(2 * p + 1) * patch + offset] : DataType(0);
+                        spectrum[flipped] = Complex(kernel[2 * p * patch + offset] * scale, imag * scale);
+                    }
+                }
+
+                forward2D(fft, spectrum, kernel_rows);
+            }
+        }
+
+        return values;
+    }
+
+private:
+    static double cost(int size, int kernel_rows, int kernel_cols, int height, int width)
+    {
+        const double tiles = (height > 0 ? std::ceil(double(height) / (size - kernel_rows + 1)) : 1. / (size - kernel_rows + 1))
+                           * (width  > 0 ? std::ceil(double(width)  / (size - kernel_cols + 1)) : 1. / (size - kernel_cols + 1));
+
+        return tiles * size * size * std::log2(2. * size);
+    }
+
+    /// Copy channel `c`, and `c + 1` as the imaginary part when `paired`, of
+    /// the tile with padded origin `(row, col) + pad` into a zeroed `N x N`
+    /// matrix
+    static void gather(const Tensor<DataType>& tensor, int c, bool paired, int row, int col, int rows, int cols,
+                       DataType pad_value, int size, Complex* packed)
+    {
+        const int height = tensor.shape[0], width = tensor.shape[1], channels = tensor.shape[2];
+        const DataType* input = tensor.data.data;
+
+        std::fill(packed, packed + size * size, Complex(0));
+
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                const int y = row + i, x = col + j;
+
+                if (y < 0 || y >= height || x < 0 || x >= width) {
+                    packed[i * size + j] = Complex(pad_value, paired ? pad_value : DataType(0));
+                } else {
+                    const DataType* pixel = input + (y * width + x) * channels + c;
+                    packed[i * size + j] = Complex(pixel[0], paired ? pixel[1] : DataType(0));
+                }
+            }
+        }
+    }
+
+    /// Split `Z = A + i B` of two real matrices with
+    /// `A(u) = (Z(u) + conj(Z(-u))) / 2` and `B(u) = (Z(u) - conj(Z(-u))) / 2i`
+    static void separate(Complex* first, Complex* second, int size) noexcept
+    {
+        for (int u = 0; u < size; ++u) {
+            for (int v = 0; v < size; ++v) {
+                const Complex z = first[u * size + v];
+                const Complex w = std::conj(first[((size - u) % size) * size + (size - v) % size]);
+                const Complex d = z - w;
+
+                second[u * size + v] = Complex(d.imag() / 2, -d.real() / 2);
+            }
+        }
+
+        for (int i = 0; i < size * size; ++i)
+            first[i] -= Complex(-second[i].imag(), second[i].real());
+    }
+
+    static void multiply_add(const Complex* x, const Complex* s, Complex* y, int length) noexcept
+    {
+        const DataType* a = reinterpret_cast<const DataType*>(x);
+        const DataType* b = reinterpret_cast<const DataType*>(s);
+        DataType*       r = reinterpret_cast<DataType*>(y);
+
+        for (int i = 0; i < 2 * length; i += 2) {
+            r[i]     += a[i] * b[i]     - a[i + 1] * b[i + 1];
+            r[i + 1] += a[i] * b[i + 1] + a[i + 1] * b[i];
+        }
+    }
+};
+
+template <typename DataType>
+constexpr int OptimizedFFTConvolution<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::MaxSize;
+
+template <typename DataType>
+constexpr long long OptimizedFFTConvolution<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::MaxSpectrumValues;
+
+} // namespace detail
+
+template <typename DataType>
+inline KernelSpectrum<DataType>::KernelSpectrum(const Tensor<DataType>& kernel, int fft_size)
+{
+    TNT_ASSERT(kernel.shape.num_axes() == 3 || kernel.shape.num_axes() == 4,
+               InvalidParameterException("KernelSpectrum::KernelSpectrum()", __FILE__, __LINE__,
+                   "A kernel spectrum requires a 3D kernel or a 4D bank of kernels"))
+
+    const int kernel_axis = kernel.shape.num_axes() - 3;
+
+    this->kernel_rows = kernel.shape[kernel_axis];
+    this->kernel_cols = kernel.shape[kernel_axis + 1];
+    this->channels    = kernel.shape[kernel_axis + 2];
+    this->num_kernels = kernel_axis == 1 ? kernel.shape[0] : 1;
+
+    using Convolution = detail::OptimizedFFTConvolution<DataType>;
+
+    this->fft_size = fft_size != 0 ? fft_size
+                   : Convolution::optimal_size(this->kernel_rows, this->kernel_cols,
+                                               (long long) this->channels * ((this->num_kernels + 1) / 2));
+
+    TNT_ASSERT(this->fft_size > 0 && (this->fft_size & (this->fft_size - 1)) == 0
+                && this->fft_size >= this->kernel_rows && this->fft_size >= this->kernel_cols,
+               InvalidParameterException("KernelSpectrum::KernelSpectrum()", __FILE__, __LINE__,
+                   "The transform size must be a power of 2 at least as large as the kernel"))
+
+    this->values = Convolution::transform_kernels(kernel.data.data, this->num_kernels, this->kernel_rows, this->kernel_cols,
+                                                  this->channels, this->fft_size);
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_FFT_CONVOLUTION_IMPL_HPP
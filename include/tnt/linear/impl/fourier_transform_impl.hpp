@@ -0,0 +1,947 @@
+#ifndef TNT_LINEAR_FOURIER_TRANSFORM_IMPL_HPP
+#define TNT_LINEAR_FOURIER_TRANSFORM_IMPL_HPP
+
+#include <tnt/linear/fourier_transform.hpp>
+#include <tnt/linear/impl/discrete_cosine_transform_impl.hpp>
+#include <tnt/math/impl/complex_impl.hpp>
+#include <tnt/utils/parallel.hpp>
+#include <tnt/utils/testing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <random>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Butterflies of the decimation in time stages. Every value is a vector of
+/// lanes, one element of each sequence in the batch, and every twiddle is a
+/// scalar shared by all lanes. Only forward transforms are computed here,
+/// inverses conjugate their input and output.
+template <typename DataType, typename Lanes>
+struct FFTKernel
+{
+    using Type = typename Lanes::Type;
+
+    /// Multiply by `c + i s`
+    static TNT_INL void rotate(Type& re, Type& im, DataType c, DataType s)
+    {
+        const Type real = Lanes::sub(Lanes::mul(re, c), Lanes::mul(im, s));
+        im = Lanes::add(Lanes::mul(re, s), Lanes::mul(im, c));
+        re = real;
+    }
+
+    static TNT_INL void butterfly2(Type* re, Type* im)
+    {
+        const Type r = Lanes::sub(re[0], re[1]), i = Lanes::sub(im[0], im[1]);
+        re[0] = Lanes::add(re[0], re[1]);
+        im[0] = Lanes::add(im[0], im[1]);
+        re[1] = r;
+        im[1] = i;
+    }
+
+    /// 4 point DFT of `x[0], x[stride], x[2 stride], x[3 stride]`
+    static TNT_INL void butterfly4(Type* r, Type* i, int stride)
+    {
+        const Type r0 = Lanes::add(r[0], r[2 * stride]), i0 = Lanes::add(i[0], i[2 * stride]);
+        const Type r1 = Lanes::sub(r[0], r[2 * stride]), i1 = Lanes::sub(i[0], i[2 * stride]);
+        const Type r2 = Lanes::add(r[stride], r[3 * stride]), i2 = Lanes::add(i[stride], i[3 * stride]);
+
+        // (x1 - x3) * -i
+        const Type r3 = Lanes::sub(i[stride], i[3 * stride]), i3 = Lanes::sub(r[3 * stride], r[stride]);
+
+        r[0] = Lanes::add(r0, r2);
+        i[0] = Lanes::add(i0, i2);
+        r[stride] = Lanes::add(r1, r3);
+        i[stride] = Lanes::add(i1, i3);
+        r[2 * stride] = Lanes::sub(r0, r2);
+        i[2 * stride] = Lanes::sub(i0, i2);
+        r[3 * stride] = Lanes::sub(r1, r3);
+        i[3 * stride] = Lanes::sub(i1, i3);
+    }
+
+    /// 8 point DFT as two 4 point DFTs of the even and odd elements
+    static TNT_INL void butterfly8(Type* re, Type* im)
+    {
+        const DataType half = DataType(0.707106781186547524);
+
+        butterfly4(re, im, 2);
+        butterfly4(re + 1, im + 1, 2);
+
+        // Odd element k of the 4 point results is multiplied by exp(-i pi k / 4)
+        Type odd_re[4] = { re[1], re[3], re[5], re[7] };
+        Type odd_im[4] = { im[1], im[3], im[5], im[7] };
+
+        const Type r1 = Lanes::mul(Lanes::add(odd_re[1], odd_im[1]), half);
+        const Type i1 = Lanes::mul(Lanes::sub(odd_im[1], odd_re[1]), half);
+        const Type r2 = odd_im[2], i2 = Lanes::sub(Lanes::splat(0), odd_re[2]);
+        const Type r3 = Lanes::mul(Lanes::sub(odd_im[3], odd_re[3]), half);
+        const Type i3 = Lanes::mul(Lanes::sub(Lanes::splat(0), Lanes::add(odd_re[3], odd_im[3])), half);
+
+        odd_re[1] = r1; odd_im[1] = i1;
+        odd_re[2] = r2; odd_im[2] = i2;
+        odd_re[3] = r3; odd_im[3] = i3;
+
+        const Type even_re[4] = { re[0], re[2], re[4], re[6] };
+        const Type even_im[4] = { im[0], im[2], im[4], im[6] };
+
+        for (int k = 0; k < 4; ++k) {
+            re[k]     = Lanes::add(even_re[k], odd_re[k]);
+            im[k]     = Lanes::add(even_im[k], odd_im[k]);
+            re[k + 4] = Lanes::sub(even_re[k], odd_re[k]);
+            im[k + 4] = Lanes::sub(even_im[k], odd_im[k]);
+        }
+    }
+
+    /// DFT of an odd prime length, where `cosines` and `sines` hold
+    /// `cos(2 pi t / radix)` and `sin(2 pi t / radix)`. Elements `q` and `radix - q` are combined first,
+    /// which halves the multiplies and gives outputs `k` and `radix - k`
+    /// together.
+    static TNT_INL void butterfly(Type* re, Type* im, int radix, const DataType* cosines, const DataType* sines)
+    {
+        Type sum_re[8], sum_im[8], difference_re[8], difference_im[8];
+
+        const int half = radix / 2;
+        for (int q = 1; q <= half; ++q) {
+            sum_re[q] = Lanes::add(re[q], re[radix - q]);
+            sum_im[q] = Lanes::add(im[q], im[radix - q]);
+            difference_re[q] = Lanes::sub(re[q], re[radix - q]);
+            difference_im[q] = Lanes::sub(im[q], im[radix - q]);
+        }
+
+        Type out_re[16], out_im[16];
+        out_re[0] = re[0];
+        out_im[0] = im[0];
+        for (int q = 1; q <= half; ++q) {
+            out_re[0] = Lanes::add(out_re[0], sum_re[q]);
+            out_im[0] = Lanes::add(out_im[0], sum_im[q]);
+        }
+
+        for (int k = 1; k <= half; ++k) {
+            Type a_re = re[0], a_im = im[0];
+            Type b_re = Lanes::splat(0), b_im = Lanes::splat(0);
+
+            for (int q = 1; q <= half; ++q) {
+                const int t = (k * q) % radix;
+                a_re = Lanes::add(a_re, Lanes::mul(sum_re[q], cosines[t]));
+                a_im = Lanes::add(a_im, Lanes::mul(sum_im[q], cosines[t]));
+                b_re = Lanes::add(b_re, Lanes::mul(difference_im[q], sines[t]));
+                b_im = Lanes::sub(b_im, Lanes::mul(difference_re[q], sines[t]));
+            }
+
+            out_re[k] = Lanes::add(a_re, b_re);
+            out_im[k] = Lanes::add(a_im, b_im);
+            out_re[radix - k] = Lanes::sub(a_re, b_re);
+            out_im[radix - k] = Lanes::sub(a_im, b_im);
+        }
+
+        std::copy(out_re, out_re + radix, re);
+        std::copy(out_im, out_im + radix, im);
+    }
+
+    /// One stage combines `radix` transforms of length `span` into
+    /// transforms of length `span * radix`
+    static void stage(const FFTPlan<DataType>& plan, DataType* re, DataType* im, int s, int span)
+    {
+        const int width = Lanes::Width, radix = plan.radices[s], length = span * radix;
+        const DataType* twiddle_re = plan.twiddle_re.data() + plan.offsets[s];
+        const DataType* twiddle_im = plan.twiddle_im.data() + plan.offsets[s];
+        const DataType* cosines = twiddle_re + span * (radix - 1);
+        const DataType* sines = twiddle_im + span * (radix - 1);
+
+        Type x_re[16], x_im[16];
+
+        for (int k = 0; k < plan.size; k += length) {
+            for (int j = 0; j < span; ++j) {
+                DataType* r = re + (k + j) * width;
+                DataType* i = im + (k + j) * width;
+
+                for (int q = 0; q < radix; ++q) {
+                    x_re[q] = Lanes::load(r + q * span * width);
+                    x_im[q] = Lanes::load(i + q * span * width);
+                }
+
+                if (j > 0)
+                    for (int q = 1; q < radix; ++q)
+                        rotate(x_re[q], x_im[q], twiddle_re[j * (radix - 1) + q - 1], twiddle_im[j * (radix - 1) + q - 1]);
+
+                switch (radix) {
+                    case 2: butterfly2(x_re, x_im); break;
+                    case 4: butterfly4(x_re, x_im, 1); break;
+                    case 8: butterfly8(x_re, x_im); break;
+                    default: butterfly(x_re, x_im, radix, cosines, sines); break;
+                }
+
+                for (int q = 0; q < radix; ++q) {
+                    Lanes::store(r + q * span * width, x_re[q]);
+                    Lanes::store(i + q * span * width, x_im[q]);
+                }
+            }
+        }
+    }
+
+    static TNT_INL Type negate(const Type& value)
+    {
+        return Lanes::sub(Lanes::splat(0), value);
+    }
+
+    static void direct(const FFTPlan<DataType>& plan, DataType* re, DataType* im, DataType* work, bool inverse)
+    {
+        const int width = Lanes::Width, size = plan.size;
+        DataType* work_re = work;
+        DataType* work_im = work + size * width;
+
+        for (int k = 0; k < size; ++k) {
+            const int position = plan.permutation[k] * width;
+            const Type value = Lanes::load(im + k * width);
+            Lanes::store(work_re + position, Lanes::load(re + k * width));
+            Lanes::store(work_im + position, inverse ? negate(value) : value);
+        }
+
+        for (int s = 0, span = 1; s < (int) plan.radices.size(); span *= plan.radices[s++])
+            stage(plan, work_re, work_im, s, span);
+
+        for (int k = 0; k < size; ++k) {
+            const Type value = Lanes::load(work_im + k * width);
+            Lanes::store(re + k * width, Lanes::load(work_re + k * width));
+            Lanes::store(im + k * width, inverse ? negate(value) : value);
+        }
+    }
+
+    /// `X(k) = w(k) sum x(j) w(j) conj(w(k - j))` with the chirp
+    /// `w(k) = exp(-i pi k^2 / N)`, a convolution computed with a power of 2
+    /// transform
+    static void bluestein(const FFTPlan<DataType>& plan, DataType* re, DataType* im, DataType* work, bool inverse)
+    {
+        const FFTPlan<DataType>& convolution = *plan.convolution;
+        const int width = Lanes::Width, size = plan.size, length = convolution.size;
+
+        DataType* a_re = work;
+        DataType* a_im = work + length * width;
+        DataType* scratch = work + 2 * length * width;
+
+        for (int k = 0; k < size; ++k) {
+            Type value_re = Lanes::load(re + k * width), value_im = Lanes::load(im + k * width);
+            if (inverse)
+                value_im = negate(value_im);
+
+            rotate(value_re, value_im, plan.chirp_re[k], plan.chirp_im[k]);
+            Lanes::store(a_re + k * width, value_re);
+            Lanes::store(a_im + k * width, value_im);
+        }
+
+        std::fill(a_re + size * width, a_re + length * width, DataType(0));
+        std::fill(a_im + size * width, a_im + length * width, DataType(0));
+
+        convolution.template execute<Lanes>(a_re, a_im, scratch, false);
+
+        for (int k = 0; k < length; ++k) {
+            Type value_re = Lanes::load(a_re + k * width), value_im = Lanes::load(a_im + k * width);
+            rotate(value_re, value_im, plan.response_re[k], plan.response_im[k]);
+            Lanes::store(a_re + k * width, value_re);
+            Lanes::store(a_im + k * width, value_im);
+        }
+
+        convolution.template execute<Lanes>(a_re, a_im, scratch, true);
+
+        for (int k = 0; k < size; ++k) {
+            Type value_re = Lanes::load(a_re + k * width), value_im = Lanes::load(a_im + k * width);
+            rotate(value_re, value_im, plan.chirp_re[k], plan.chirp_im[k]);
+            Lanes::store(re + k * width, value_re);
+            Lanes::store(im + k * width, inverse ? negate(value_im) : value_im);
+        }
+    }
+};
+
+/// Spread `count` sequences over threads a SIMD vector at a time. `batch`
+/// provides `apply<Lanes>(first, buffer)`, which transforms the sequences
+/// from `first` to `first + Lanes::Width`, and `buffer_size`, the values of
+/// buffer needed per lane. A group of fewer than `Width` sequences at the
+/// end is transformed one sequence at a time.
+template <typename DataType, typename Batch>
+inline void fft_batches(const Batch& batch, int count, int num_threads)
+{
+    const int width = DCTVector<DataType>::Width;
+    const int groups = (count + width - 1) / width;
+
+    num_threads = num_threads <= 0 ? default_num_threads() : num_threads;
+    const int tasks = std::max(1, std::min(groups, num_threads == 1 ? 1 : 4 * num_threads));
+
+    parallel_for(tasks, num_threads, [&](int task) {
+        std::vector<DataType> buffer(static_cast<std::size_t>(batch.buffer_size()) * width);
+
+        const int last = static_cast<int>(static_cast<long long>(groups) * (task + 1) / tasks);
+        for (int group = static_cast<int>(static_cast<long long>(groups) * task / tasks); group < last; ++group) {
+            const int first = group * width;
+
+            if (first + width <= count) {
+                batch.template apply<DCTVector<DataType>>(first, buffer.data());
+            } else {
+                for (int sequence = first; sequence < count; ++sequence)
+                    batch.template apply<DCTScalar<DataType>>(sequence, buffer.data());
+            }
+        }
+    });
+}
+
+/// Complex sequences along the middle axis of `outer x size x inner`
+/// interleaved complex values
+template <typename DataType>
+struct FFTComplexBatch
+{
+    const FFTPlan<DataType>& plan;
+    DataType* data;
+    int inner;
+    bool inverse;
+
+    int buffer_size() const
+    {
+        return 2 * (plan.size + plan.workspace());
+    }
+
+    template <typename Lanes>
+    void apply(int first, DataType* buffer) const
+    {
+        const int width = Lanes::Width, size = plan.size;
+        DataType* re = buffer;
+        DataType* im = buffer + size * width;
+
+        for (int l = 0; l < width; ++l) {
+            const int sequence = first + l;
+            const DataType* values = data + 2 * (static_cast<std::size_t>(sequence / inner) * size * inner + sequence % inner);
+
+            for (int k = 0; k < size; ++k) {
+                re[k * width + l] = values[2 * k * inner];
+                im[k * width + l] = values[2 * k * inner + 1];
+            }
+        }
+
+        plan.template execute<Lanes>(re, im, buffer + 2 * size * width, inverse);
+
+        for (int l = 0; l < width; ++l) {
+            const int sequence = first + l;
+            DataType* values = data + 2 * (static_cast<std::size_t>(sequence / inner) * size * inner + sequence % inner);
+
+            for (int k = 0; k < size; ++k) {
+                values[2 * k * inner]     = re[k * width + l];
+                values[2 * k * inner + 1] = im[k * width + l];
+            }
+        }
+    }
+};
+
+/// Real sequences of even length `2 N` are transformed as `N` complex values
+/// `z(k) = x(2k) + i x(2k + 1)`. With `Z` the transform of `z`, the even and
+/// odd samples have spectra `E(k) = (Z(k) + conj(Z(N - k))) / 2` and
+/// `O(k) = -i (Z(k) - conj(Z(N - k))) / 2`, and `X(k) = E(k) + exp(-i pi k / N) O(k)`.
+/// Odd lengths are transformed as complex sequences with zero imaginary part.
+template <typename DataType>
+struct FFTRealForwardBatch
+{
+    const FFTPlan<DataType>& plan;
+    const DataType* input;
+    DataType* output;
+    int length, inner;
+
+    int buffer_size() const
+    {
+        return 2 * (plan.size + plan.workspace());
+    }
+
+    template <typename Lanes>
+    void apply(int first, DataType* buffer) const
+    {
+        using Type = typename Lanes::Type;
+        using Kernel = FFTKernel<DataType, Lanes>;
+
+        const int width = Lanes::Width, size = plan.size, frequencies = length / 2 + 1;
+        const bool packed = length % 2 == 0;
+        DataType* re = buffer;
+        DataType* im = buffer + size * width;
+
+        for (int l = 0; l < width; ++l) {
+            const int sequence = first + l;
+            const DataType* values = input + static_cast<std::size_t>(sequence / inner) * length * inner + sequence % inner;
+
+            for (int k = 0; k < size; ++k) {
+                re[k * width + l] = values[(packed ? 2 * k : k) * inner];
+                im[k * width + l] = packed ? values[(2 * k + 1) * inner] : DataType(0);
+            }
+        }
+
+        plan.template execute<Lanes>(re, im, buffer + 2 * size * width, false);
+
+        DataType result_re[Lanes::Width], result_im[Lanes::Width];
+
+        for (int k = 0; k < frequencies; ++k) {
+            Type x_re, x_im;
+
+            if (packed) {
+                const int a = k % size, b = (size - k) % size;
+                const Type z_re = Lanes::load(re + a * width), z_im = Lanes::load(im + a * width);
+                const Type c_re = Lanes::load(re + b * width), c_im = Lanes::load(im + b * width);
+
+                // E = (Z(k) + conj(Z(N - k))) / 2, O = -i (Z(k) - conj(Z(N - k))) / 2
+                const Type even_re = Lanes::mul(Lanes::add(z_re, c_re), DataType(0.5));
+                const Type even_im = Lanes::mul(Lanes::sub(z_im, c_im), DataType(0.5));
+                Type odd_re = Lanes::mul(Lanes::add(z_im, c_im), DataType(0.5));
+                Type odd_im = Lanes::mul(Lanes::sub(c_re, z_re), DataType(0.5));
+
+                Kernel::rotate(odd_re, odd_im, plan.real_re[k], plan.real_im[k]);
+                x_re = Lanes::add(even_re, odd_re);
+                x_im = Lanes::add(even_im, odd_im);
+            } else {
+                x_re = Lanes::load(re + k * width);
+                x_im = Lanes::load(im + k * width);
+            }
+
+            Lanes::store(result_re, x_re);
+            Lanes::store(result_im, x_im);
+
+            for (int l = 0; l < width; ++l) {
+                const int sequence = first + l;
+                DataType* values = output + 2 * (static_cast<std::size_t>(sequence / inner) * frequencies * inner + sequence % inner);
+                values[2 * k * inner]     = result_re[l];
+                values[2 * k * inner + 1] = result_im[l];
+            }
+        }
+    }
+};
+
+/// The inverse of FFTRealForwardBatch. For even lengths
+/// `Z(k) = E(k) + i O(k)` with `E(k) = (X(k) + conj(X(N - k))) / 2` and
+/// `O(k) = exp(i pi k / N) (X(k) - conj(X(N - k))) / 2`. The result is not
+/// scaled.
+template <typename DataType>
+struct FFTRealInverseBatch
+{
+    const FFTPlan<DataType>& plan;
+    const DataType* input;
+    DataType* output;
+    int length, inner;
+
+    int buffer_size() const
+    {
+        return 2 * (plan.size + 1 + plan.workspace());
+    }
+
+    template <typename Lanes>
+    void apply(int first, DataType* buffer) const
+    {
+        using Type = typename Lanes::Type;
+        using Kernel = FFTKernel<DataType, Lanes>;
+
+        const int width = Lanes::Width, size = plan.size, frequencies = length / 2 + 1;
+        const bool packed = length % 2 == 0;
+        DataType* re = buffer;
+        DataType* im = buffer + (size + 1) * width;
+
+        // Gather the frequencies, the imaginary parts of the real valued ones
+        // are dropped
+        for (int l = 0; l < width; ++l) {
+            const int sequence = first + l;
+            const DataType* values = input + 2 * (static_cast<std::size_t>(sequence / inner) * frequencies * inner + sequence % inner);
+
+            for (int k = 0; k < frequencies; ++k) {
+                re[k * width + l] = values[2 * k * inner];
+                im[k * width + l] = (k == 0 || (packed && k == frequencies - 1)) ? DataType(0) : values[2 * k * inner + 1];
+            }
+        }
+
+        if (packed) {
+            // Z(k) and Z(N - k) both depend on X(k) and X(N - k), so the
+            // pairs are updated together from the front and back
+            for (int k = 0; 2 * k <= size; ++k) {
+                const int b = size - k;
+                const Type x_re = Lanes::load(re + k * width), x_im = Lanes::load(im + k * width);
+                const Type y_re = Lanes::load(re + b * width), y_im = Lanes::load(im + b * width);
+
+                for (int side = 0; side < (k == b ? 1 : 2); ++side) {
+                    const int index = side == 0 ? k : b;
+                    const Type a_re = side == 0 ? x_re : y_re, a_im = side == 0 ? x_im : y_im;
+                    const Type c_re = side == 0 ? y_re : x_re, c_im = side == 0 ? Kernel::negate(y_im) : Kernel::negate(x_im);
+
+                    const Type even_re = Lanes::mul(Lanes::add(a_re, c_re), DataType(0.5));
+                    const Type even_im = Lanes::mul(Lanes::add(a_im, c_im), DataType(0.5));
+                    Type odd_re = Lanes::mul(Lanes::sub(a_re, c_re), DataType(0.5));
+                    Type odd_im = Lanes::mul(Lanes::sub(a_im, c_im), DataType(0.5));
+                    Kernel::rotate(odd_re, odd_im, plan.real_re[index], -plan.real_im[index]);
+
+                    // E + i O
+                    if (index < size) {
+                        Lanes::store(re + index * width, Lanes::sub(even_re, odd_im));
+                        Lanes::store(im + index * width, Lanes::add(even_im, odd_re));
+                    }
+                }
+            }
+        } else {
+            // Rebuild the negative frequencies from the conjugate symmetry
+            for (int k = frequencies; k < size; ++k) {
+                Lanes::store(re + k * width, Lanes::load(re + (size - k) * width));
+                Lanes::store(im + k * width, Kernel::negate(Lanes::load(im + (size - k) * width)));
+            }
+        }
+
+        plan.template execute<Lanes>(re, im, buffer + 2 * (size + 1) * width, true);
+
+        for (int l = 0; l < width; ++l) {
+            const int sequence = first + l;
+            DataType* values = output + static_cast<std::size_t>(sequence / inner) * length * inner + sequence % inner;
+
+            for (int k = 0; k < size; ++k) {
+                if (packed) {
+                    values[2 * k * inner]       = re[k * width + l];
+                    values[(2 * k + 1) * inner] = im[k * width + l];
+                } else {
+                    values[k * inner] = re[k * width + l];
+                }
+            }
+        }
+    }
+};
+
+} // namespace detail
+
+template <typename DataType>
+inline FFTPlan<DataType>::FFTPlan(int size) : size(size)
+{
+    TNT_ASSERT(size > 0, InvalidParameterException("FFTPlan::FFTPlan()", __FILE__, __LINE__,
+                                                   "The transform size must be positive"))
+
+    const double pi = std::acos(-1.0);
+
+    this->real_re.resize(size + 1);
+    this->real_im.resize(size + 1);
+    for (int k = 0; k <= size; ++k) {
+        this->real_re[k] = (DataType) std::cos(pi * k / size);
+        this->real_im[k] = (DataType) -std::sin(pi * k / size);
+    }
+
+    int remaining = size, twos = 0;
+    for (; remaining % 2 == 0; remaining /= 2)
+        ++twos;
+
+    for (int prime : {3, 5, 7, 11, 13}) {
+        for (; remaining % prime == 0; remaining /= prime)
+            this->radices.push_back(prime);
+    }
+
+    if (remaining > 1) {
+        this->radices.clear();
+
+        int length = 1;
+        while (length < 2 * size - 1)
+            length *= 2;
+
+        this->convolution = std::make_shared<FFTPlan>(length);
+
+        // k^2 is reduced modulo 2N first, the chirp has that period
+        this->chirp_re.resize(size);
+        this->chirp_im.resize(size);
+        for (int k = 0; k < size; ++k) {
+            const double angle = pi * (double) ((long long) k * k % (2LL * size)) / size;
+            this->chirp_re[k] = (DataType) std::cos(angle);
+            this->chirp_im[k] = (DataType) -std::sin(angle);
+        }
+
+        this->response_re.assign(length, DataType(0));
+        this->response_im.assign(length, DataType(0));
+        for (int k = 0; k < size; ++k) {
+            this->response_re[k] = this->chirp_re[k];
+            this->response_im[k] = -this->chirp_im[k];
+            if (k > 0) {
+                this->response_re[length - k] = this->chirp_re[k];
+                this->response_im[length - k] = -this->chirp_im[k];
+            }
+        }
+
+        std::vector<DataType> work(2 * this->convolution->workspace());
+        this->convolution->template execute<detail::DCTScalar<DataType>>(this->response_re.data(), this->response_im.data(),
+                                                                         work.data(), false);
+
+        // The inverse transforms are not scaled
+        for (int k = 0; k < length; ++k) {
+            this->response_re[k] /= length;
+            this->response_im[k] /= length;
+        }
+
+        return;
+    }
+
+    // Radix 8 stages with one radix 4 or 2 stage, or two radix 4 stages,
+    // for the remainder
+    if (twos % 3 == 1 && twos >= 4) {
+        this->radices.push_back(4);
+        this->radices.push_back(4);
+        twos -= 4;
+    } else if (twos % 3 == 1) {
+        this->radices.push_back(2);
+        twos -= 1;
+    } else if (twos % 3 == 2) {
+        this->radices.push_back(4);
+        twos -= 2;
+    }
+
+    for (; twos > 0; twos -= 3)
+        this->radices.push_back(8);
+
+    // The last stage combines the transforms of the elements congruent to
+    // each q modulo its radix, which the earlier stages leave in the q-th
+    // block of the array, and so on recursively
+    this->permutation.resize(size);
+    for (int i = 0; i < size; ++i) {
+        int position = 0, length = size, index = i;
+        for (int s = (int) this->radices.size() - 1; s >= 0; --s) {
+            length /= this->radices[s];
+            position += (index % this->radices[s]) * length;
+            index /= this->radices[s];
+        }
+
+        this->permutation[i] = position;
+    }
+
+    // Stage twiddles exp(-2 pi i j q / L), followed by the roots of unity of
+    // the odd radices
+    for (int s = 0, span = 1; s < (int) this->radices.size(); span *= this->radices[s++]) {
+        const int radix = this->radices[s], length = span * radix;
+        this->offsets.push_back((int) this->twiddle_re.size());
+
+        for (int j = 0; j < span; ++j) {
+            for (int q = 1; q < radix; ++q) {
+                const double angle = 2 * pi * (double) ((long long) j * q % length) / length;
+                this->twiddle_re.push_back((DataType) std::cos(angle));
+                this->twiddle_im.push_back((DataType) -std::sin(angle));
+            }
+        }
+
+        if (radix % 2 == 1) {
+            for (int t = 0; t < radix; ++t) {
+                this->twiddle_re.push_back((DataType) std::cos(2 * pi * t / radix));
+                this->twiddle_im.push_back((DataType) std::sin(2 * pi * t / radix));
+            }
+        }
+    }
+}
+
+template <typename DataType>
+inline std::shared_ptr<const FFTPlan<DataType>> FFTPlan<DataType>::get(int size)
+{
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const FFTPlan>> plans;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::shared_ptr<const FFTPlan>& plan = plans[size];
+    if (!plan)
+        plan = std::make_shared<FFTPlan>(size);
+
+    return plan;
+}
+
+template <typename DataType>
+inline int FFTPlan<DataType>::workspace() const noexcept
+{
+    return this->convolution ? this->convolution->size + this->convolution->workspace() : this->size;
+}
+
+template <typename DataType>
+template <typename Lanes>
+inline void FFTPlan<DataType>::execute(DataType* re, DataType* im, DataType* work, bool inverse) const
+{
+    if (this->convolution)
+        detail::FFTKernel<DataType, Lanes>::bluestein(*this, re, im, work, inverse);
+    else
+        detail::FFTKernel<DataType, Lanes>::direct(*this, re, im, work, inverse);
+}
+
+template <typename DataType>
+inline void FFTPlan<DataType>::run(Complex* data, int inner, int outer, bool inverse, int num_threads) const
+{
+    const detail::FFTComplexBatch<DataType> batch = { *this, reinterpret_cast<DataType*>(data), inner, inverse };
+    detail::fft_batches<DataType>(batch, inner * outer, num_threads);
+}
+
+namespace detail
+{
+
+/// Transform complex data with the first `complex_axes` axes of `shape`
+/// along each of `axes` in place. Returns the product of the transformed
+/// lengths, which scales an inverse transform.
+template <typename DataType>
+inline DataType fft_axes(std::complex<DataType>* data, const Shape& shape, int complex_axes,
+                         const std::vector<int>& axes, bool inverse, int num_threads)
+{
+    DataType scale = 1;
+    for (int axis : axes) {
+        const int size = shape[axis];
+        if (size == 1)
+            continue;
+
+        int outer = 1, inner = 1;
+        for (int a = 0; a < axis; ++a)
+            outer *= shape[a];
+        for (int a = axis + 1; a < complex_axes; ++a)
+            inner *= shape[a];
+
+        FFTPlan<DataType>::get(size)->run(data, inner, outer, inverse, num_threads);
+        scale *= size;
+    }
+
+    return scale;
+}
+
+template <typename DataType>
+struct OptimizedFFT<std::complex<DataType>, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    static Tensor<std::complex<DataType>> eval(const Tensor<std::complex<DataType>>& tensor, const std::vector<int>& axes,
+                                               bool inverse, int num_threads)
+    {
+        Tensor<std::complex<DataType>> result = tensor;
+
+        const DataType scale = fft_axes(result.data.data, tensor.shape, tensor.shape.num_axes(), axes, inverse, num_threads);
+
+        if (inverse && scale != 1)
+            result *= DataType(1) / scale;
+
+        return result;
+    }
+};
+
+template <typename DataType>
+struct OptimizedRealFFT<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    static Tensor<std::complex<DataType>> forward(const Tensor<DataType>& tensor, int axis, int num_threads)
+    {
+        const int length = tensor.shape[axis];
+
+        int outer = 1, inner = 1;
+        for (int a = 0; a < axis; ++a)
+            outer *= tensor.shape[a];
+        for (int a = axis + 1; a < tensor.shape.num_axes(); ++a)
+            inner *= tensor.shape[a];
+
+        Shape shape = tensor.shape;
+        shape[axis] = length / 2 + 1;
+
+        Tensor<std::complex<DataType>> result(shape);
+
+        const FFTPlan<DataType>& plan = *FFTPlan<DataType>::get(length % 2 == 0 ? length / 2 : length);
+        const FFTRealForwardBatch<DataType> batch = { plan, tensor.data.data, reinterpret_cast<DataType*>(result.data.data), length, inner };
+        fft_batches<DataType>(batch, outer * inner, num_threads);
+
+        return result;
+    }
+
+    static Tensor<DataType> inverse(const Tensor<std::complex<DataType>>& tensor, int length, int axis, int num_threads)
+    {
+        int outer = 1, inner = 1;
+        for (int a = 0; a < axis; ++a)
+            outer *= tensor.shape[a];
+        for (int a = axis + 1; a < tensor.shape.num_axes(); ++a)
+            inner *= tensor.shape[a];
+
+        Shape shape = tensor.shape;
+        shape[axis] = length;
+
+        Tensor<DataType> result(shape);
+
+        const FFTPlan<DataType>& plan = *FFTPlan<DataType>::get(length % 2 == 0 ? length / 2 : length);
+        const FFTRealInverseBatch<DataType> batch = { plan, reinterpret_cast<const DataType*>(tensor.data.data), result.data.data, length, inner };
+        fft_batches<DataType>(batch, outer * inner, num_threads);
+
+        // Scale the inverse after the transform of N / 2 or N values
+        result *= DataType(1) / (length % 2 == 0 ? length / 2 : length);
+        return result;
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+namespace
+{
+
+/// The DFT of `count` interleaved complex sequences of `size` elements with
+/// elements `stride` apart, in long double
+template <typename T>
+std::vector<T> reference_dft(const std::vector<T>& values, int size, int stride, int count, bool inverse)
+{
+    const long double pi = std::acos(-1.0L);
+
+    std::vector<T> result(values.size());
+    for (int sequence = 0; sequence < count; ++sequence) {
+        const int base = (sequence / stride) * size * stride + sequence % stride;
+
+        for (int k = 0; k < size; ++k) {
+            std::complex<long double> sum = 0;
+            for (int n = 0; n < size; ++n) {
+                const std::complex<long double> x(values[2 * (base + n * stride)], values[2 * (base + n * stride) + 1]);
+                sum += x * std::polar(1.0L, (inverse ? 2 : -2) * pi * (long double) ((long long) k * n % size) / size);
+            }
+
+            result[2 * (base + k * stride)] = (T) sum.real();
+            result[2 * (base + k * stride) + 1] = (T) sum.imag();
+        }
+    }
+
+    return result;
+}
+
+template <typename T>
+Tensor<T> random_tensor(const Shape& shape, int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<T> distribution(-1, 1);
+
+    Tensor<T> tensor(shape);
+    for (int i = 0; i < shape.total(); ++i)
+        tensor.data[i] = distribution(generator);
+
+    return tensor;
+}
+
+} // namespace
+
+TEST_CASE_TEMPLATE("FFTPlan<T>::run()", T, test_float_data_types)
+{
+    using Complex = std::complex<T>;
+
+    // Powers of 2 for every radix 8 remainder, mixed radices, and primes and
+    // composites for Bluestein's algorithm
+    for (int size : {1, 2, 4, 8, 16, 32, 64, 128, 3, 5, 6, 12, 45, 60, 77, 143, 210, 17, 34, 97, 202}) {
+        for (int inner : {1, 3, 19}) {
+            const int outer = 2;
+            const Tensor<T> values = random_tensor<T>(Shape{outer * size * inner * 2}, size + inner);
+            const std::vector<T> data(values.data.data, values.data.data + values.shape.total());
+
+            const FFTPlan<T>& plan = *FFTPlan<T>::get(size);
+            const T tolerance = 64 * std::numeric_limits<T>::epsilon() * std::sqrt(T(size)) * std::log2(T(2 * size));
+
+            for (bool inverse : {false, true}) {
+                std::vector<T> transformed = data;
+                plan.run(reinterpret_cast<Complex*>(transformed.data()), inner, outer, inverse, inverse ? 3 : 1);
+
+                const std::vector<T> expected = reference_dft(data, size, inner, outer * inner, inverse);
+                for (std::size_t i = 0; i < data.size(); ++i)
+                    REQUIRE(std::fabs(transformed[i] - expected[i]) <= tolerance * std::sqrt(T(size)));
+            }
+        }
+    }
+
+    REQUIRE((FFTPlan<T>::get(12) == FFTPlan<T>::get(12)));
+    REQUIRE_THROWS(FFTPlan<T>(0));
+}
+
+TEST_CASE_TEMPLATE("fft(const Tensor<std::complex<T>>&, int, int)", T, test_float_data_types)
+{
+    using Complex = std::complex<T>;
+
+    const Tensor<Complex> tensor = random_complex<T>(Shape{6, 20, 5}, 3);
+    const T* begin = reinterpret_cast<const T*>(tensor.data.data);
+    const std::vector<T> data(begin, begin + 2 * tensor.shape.total());
+    const T tolerance = 512 * std::numeric_limits<T>::epsilon();
+
+    auto check = [&](const Tensor<Complex>& transformed, const std::vector<T>& expected, T bound) {
+        REQUIRE((transformed.shape == tensor.shape));
+
+        const T* values = reinterpret_cast<const T*>(transformed.data.data);
+        for (std::size_t i = 0; i < expected.size(); ++i)
+            REQUIRE(std::fabs(values[i] - expected[i]) <= bound);
+    };
+
+    { // Along the middle axis
+        const Tensor<Complex> transformed = fft(tensor, 1);
+        check(transformed, reference_dft(data, 20, 5, 6 * 5, false), tolerance * 20);
+
+        const Tensor<Complex> restored = ifft(transformed, 1, 2);
+        check(restored, data, tolerance);
+    }
+
+    { // Along the last axis, with and without threads
+        const Tensor<Complex> transformed = fft(tensor, 2, 1);
+        REQUIRE((fft(tensor, 2, 4) == transformed));
+        check(transformed, reference_dft(data, 5, 1, 6 * 20, false), tolerance * 5);
+    }
+
+    { // The N dimensional transform is the product of the 1D transforms
+        const Tensor<Complex> transformed = fftn(tensor);
+        const Tensor<Complex> expected = fft(fft(fft(tensor, 0), 1), 2);
+        const T* values = reinterpret_cast<const T*>(expected.data.data);
+        check(transformed, std::vector<T>(values, values + 2 * expected.shape.total()), tolerance * 600);
+
+        check(ifftn(transformed), data, tolerance);
+    }
+
+    REQUIRE_THROWS(fft(tensor, 3));
+    REQUIRE_THROWS(ifft(tensor, -1));
+}
+
+TEST_CASE_TEMPLATE("rfft(const Tensor<T>&, int, int)", T, test_float_data_types)
+{
+    using Complex = std::complex<T>;
+
+    const T tolerance = 256 * std::numeric_limits<T>::epsilon();
+
+    auto near = [](const Complex& a, const Complex& b, T bound) {
+        return std::fabs(a.real() - b.real()) <= bound && std::fabs(a.imag() - b.imag()) <= bound;
+    };
+
+    for (int length : {1, 2, 9, 16, 30, 34, 51}) {
+        const Tensor<T> tensor = random_tensor<T>(Shape{3, length, 4}, length);
+
+        Tensor<Complex> complex(tensor.shape);
+        for (int i = 0; i < tensor.shape.total(); ++i)
+            complex.data[i] = tensor.data[i];
+
+        const Tensor<Complex> expected = fft(complex, 1);
+        const Tensor<Complex> transformed = rfft(tensor, 1);
+        REQUIRE((transformed.shape == Shape{3, length / 2 + 1, 4}));
+
+        for (int a = 0; a < 3; ++a)
+            for (int k = 0; k <= length / 2; ++k)
+                for (int b = 0; b < 4; ++b)
+                    REQUIRE(near(transformed.data[(a * (length / 2 + 1) + k) * 4 + b],
+                                 expected.data[(a * length + k) * 4 + b], tolerance * length));
+
+        const Tensor<T> restored = irfft(transformed, length, 1);
+        REQUIRE((restored.shape == tensor.shape));
+        for (int i = 0; i < tensor.shape.total(); ++i)
+            REQUIRE(std::fabs(restored.data[i] - tensor.data[i]) <= tolerance);
+    }
+
+    { // N dimensional
+        const Tensor<T> tensor = random_tensor<T>(Shape{12, 10}, 5);
+
+        Tensor<Complex> complex(tensor.shape);
+        for (int i = 0; i < tensor.shape.total(); ++i)
+            complex.data[i] = tensor.data[i];
+
+        const Tensor<Complex> expected = fftn(complex);
+        const Tensor<Complex> transformed = rfftn(tensor);
+        REQUIRE((transformed.shape == Shape{12, 6}));
+
+        for (int y = 0; y < 12; ++y)
+            for (int x = 0; x < 6; ++x)
+                REQUIRE(near(transformed.data[y * 6 + x], expected.data[y * 10 + x], tolerance * 120));
+
+        const Tensor<T> restored = irfftn(transformed, 10);
+        for (int i = 0; i < tensor.shape.total(); ++i)
+            REQUIRE(std::fabs(restored.data[i] - tensor.data[i]) <= tolerance);
+    }
+
+    REQUIRE_THROWS(rfft(Tensor<T>(Shape{8}), 1));
+    REQUIRE_THROWS(irfft(Tensor<Complex>(Shape{5}), 10, 0));
+    REQUIRE_THROWS(irfft(Tensor<Complex>(Shape{5}), 8, 1));
+    REQUIRE_THROWS(irfftn(Tensor<Complex>(Shape{4, 5}), 10));
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_FOURIER_TRANSFORM_IMPL_HPP
@@ -0,0 +1,139 @@
+#ifndef TNT_LINEAR_HOUSEHOLDER_IMPL_HPP
+#define TNT_LINEAR_HOUSEHOLDER_IMPL_HPP
+
+#include <tnt/linear/impl/blas1_impl.hpp>
+#include <tnt/linear/impl/matrix_multiply_impl.hpp>
+#include <tnt/utils/parallel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Householder reflections `H = I - tau v v^T`, and blocks of them in the
+/// compact WY form `H_0 H_1 ... H_(b-1) = I - V T V^T` with `T` upper
+/// triangular, after LAPACK's `larfg`, `larft` and `larfb`. The reflectors of
+/// a block are passed as the rows of `Vt`, so `V` is its transpose.
+template <typename DataType>
+struct Householder
+{
+    using Multiply = OptimizedMatrixMultiply<DataType>;
+
+    /// Rows of `X` updated by one task
+    constexpr static int RowBlock = 64;
+
+    /// Overwrite `x` with the Householder vector `v` (`v[0] = 1`) and set
+    /// `tau` so that `(I - tau v v^T) x = beta e_0`. Returns `beta`.
+    static DataType generate(DataType* x, int length, DataType& tau) noexcept
+    {
+        const DataType alpha = x[0];
+
+        DataType scale = 0;
+        for (int i = 1; i < length; ++i)
+            scale = std::max(scale, std::abs(x[i]));
+
+        if (scale == 0) {
+            tau = 0;
+            return alpha;
+        }
+
+        DataType sum = 0;
+        for (int i = 1; i < length; ++i)
+            sum += (x[i] / scale) * (x[i] / scale);
+
+        const DataType beta = -std::copysign(std::hypot(alpha, scale * std::sqrt(sum)), alpha);
+        tau = (beta - alpha) / beta;
+
+        const DataType f = 1 / (alpha - beta);
+        for (int i = 1; i < length; ++i)
+            x[i] *= f;
+
+        x[0] = 1;
+        return beta;
+    }
+
+    /// `x = x (I - tau v v^T)` for one row `x`
+    static TNT_INL void apply(DataType* x, const DataType* v, DataType tau, int length) noexcept
+    {
+        multiply_add_row(-tau * dot_row(x, v, length), v, x, length);
+    }
+
+    /// The `nb x nb` triangular factor `T`, with rows `ldt` apart, of the
+    /// reflectors in the rows of `vt`, `length` apart
+    static void triangular_factor(const DataType* vt, int nb, int length, const DataType* tau, DataType* t, int ldt) noexcept
+    {
+        for (int i = 0; i < nb; ++i) {
+            t[i * ldt + i] = tau[i];
+
+            for (int j = 0; j < i; ++j)
+                t[j * ldt + i] = -tau[i] * dot_row(vt + j * length, vt + i * length, length);
+
+            for (int j = 0; j < i; ++j) {
+                DataType sum = 0;
+                for (int l = j; l < i; ++l)
+                    sum += t[j * ldt + l] * t[l * ldt + i];
+                t[j * ldt + i] = sum;
+            }
+
+            for (int j = i + 1; j < nb; ++j)
+                t[j * ldt + i] = 0;
+        }
+    }
+
+    /// `X = X (I - V T V^T)`, or `X (I - V T^T V^T)` when `transpose` is set,
+    /// for the `rows x length` matrix `X` with rows `ldx` apart. Blocks of
+    /// rows are independent matrix products, spread over threads.
+    static void apply_right(DataType* x, int rows, int ldx, const DataType* vt, int nb, int length,
+                            const DataType* t, int ldt, bool transpose, int num_threads)
+    {
+        if (rows <= 0 || nb <= 0)
+            return;
+
+        std::vector<DataType> V(length * nb);
+        for (int r = 0; r < length; ++r)
+            for (int i = 0; i < nb; ++i)
+                V[r * nb + i] = vt[i * length + r];
+
+        auto update = [&](int block) {
+            const int r0 = block * RowBlock;
+            const int count = std::min(RowBlock, rows - r0);
+            DataType* xb = x + r0 * ldx;
+
+            std::vector<DataType> P(count * nb, DataType(0)), PT(count * nb);
+            Multiply::gemm(count, nb, length, xb, ldx, V.data(), nb, P.data(), nb);
+
+            // -P T or -P T^T
+            for (int r = 0; r < count; ++r) {
+                for (int i = 0; i < nb; ++i) {
+                    DataType sum = 0;
+                    if (transpose) {
+                        for (int j = i; j < nb; ++j)
+                            sum += P[r * nb + j] * t[i * ldt + j];
+                    }
+                    else {
+                        for (int j = 0; j <= i; ++j)
+                            sum += P[r * nb + j] * t[j * ldt + i];
+                    }
+                    PT[r * nb + i] = -sum;
+                }
+            }
+
+            Multiply::gemm(count, length, nb, PT.data(), nb, vt, length, xb, ldx);
+        };
+
+        parallel_for((rows + RowBlock - 1) / RowBlock, num_threads, update);
+    }
+};
+
+template <typename DataType> constexpr int Householder<DataType>::RowBlock;
+
+} // namespace detail
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_HOUSEHOLDER_IMPL_HPP
@@ -11,158 +11,158 @@ namespace tnt
 namespace detail
 {
 
-/// This code is adapted from:
-/// https://github.com/pytorch/glow/blob/master/lib/Backends/CPU/libjit/libjit_matmul.cpp
+/// Blocked and packed matrix multiplication. The loop structure follows the
+/// GotoBLAS / BLIS scheme: a `BlockDepth x BlockCols` panel of B and a
+/// `BlockRows x BlockDepth` panel of A are copied into contiguous, zero padded
+/// buffers laid out in the order the micro kernel reads them. The micro kernel
+/// keeps a `RowRegs x TileCols` tile of C in registers for the whole depth of
+/// the panels.
 template <typename DataType>
 struct OptimizedMatrixMultiply<DataType>
 {
     using VecType = typename SIMDType<DataType>::VecType;
 
-    static Tensor<DataType> eval(const Tensor<DataType>& left, const Tensor<DataType>& right)
-    {
-        constexpr int BLOCK_ROWS = 256;
-        constexpr int BLOCK_COLS = 128;
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    constexpr static int RowRegs  = 4;
+    constexpr static int ColRegs  = 3;
+    constexpr static int TileCols = ColRegs * Size;
 
-        constexpr int REGS_A = 3;
-        constexpr int REGS_B = 4;
-        constexpr int REGS_B_SIZE = REGS_B * OptimalSIMDSize<DataType>::value;
+    constexpr static int BlockRows  = 24 * RowRegs;
+    constexpr static int BlockDepth = 256;
+    constexpr static int BlockCols  = (2048 / TileCols) * TileCols;
 
+    static Tensor<DataType> eval(const Tensor<DataType>& left, const Tensor<DataType>& right)
+    {
         Tensor<DataType> result = zeros<DataType>(Shape{left.shape[0], right.shape[1]});
 
-        const DataType* l_ptr = left.data.data;
-        const DataType* r_ptr = right.data.data;
-        DataType*       o_ptr = result.data.data;
-
-        const int m = result.shape[0];
-        const int n = result.shape[1];
-        const int k = left.shape[1];
-
-        /// Tile A into mc * kc blocks, where mc and kc are chosen to approximately fit
-        /// the L2 cache on recent Intel processors (e.g., 256 KB for Skylake).  Stream
-        /// kc * n panels of B through memory to compute each mc * n block of C.
-        /// \p a is an \p m x \p k row-major matrix;
-        /// \p b is a \p k x \p n row-major matrix;
-        /// \p c is a \p m x \p n row-major matrix.
-        /// \p lda, \p ldb, and \p ldc are the leading dimensions of A, B, and C,
-        /// respectively.
-        for (int c = 0; c < k; c += BLOCK_COLS) {
-            int bounded_c = std::min(k - c, BLOCK_COLS);
-            for (int r = 0; r < m; r += BLOCK_ROWS) {
-                int bounded_r = std::min(m - r, BLOCK_ROWS);
-
-                const DataType* l_block = l_ptr + r * k + c;
-                const DataType* r_block = r_ptr + c * n;
-                DataType*       o_block = o_ptr + r * n;
-
-                /// Compute a portion of C one block at a time.  Handle ragged edges with calls
-                /// to a slow but general helper.
-                ///
-                /// The tiling scheme naturally divides the input matrices into 2 parts each;
-                /// one tiled section, and three "ragged" edges.
-                ///
-                /// --------------------    -------
-                /// | A00*B00 | A00*B01|    | A00 |   -------------
-                /// -------------------- += ------- * | B00 | B01 |
-                /// | A10*B00 | A10*B01|    | A10 |   -------------
-                /// --------------------    -------
-                ///
-                /// We can process this as 4 separate matrix multiplications.  A00*B00 is the
-                /// perfectly-tiled portion, which we handly with a 4x16 dot-product kernel.
-                /// The ragged edges are (ideally) less critical, so we handle them with a call
-                /// to a general matrix-multiplication for odd sizes.
-                for (int rb = 0; rb < n - REGS_B_SIZE + 1; rb += REGS_B_SIZE) {
-                    for (int ra = 0; ra < bounded_r - REGS_A + 1; ra += REGS_A) {
-                        const DataType* l_inner_block = l_block + bounded_c * ra;
-                        const DataType* r_inner_block = r_block + rb;
-                        DataType* o_inner_block       = o_block + n * ra + rb;
-                        matmul_dot<REGS_A, REGS_B>(n, bounded_c, l_inner_block, r_inner_block, o_inner_block);
-                    }
-                }
+        gemm(left.shape[0], right.shape[1], left.shape[1],
+             left.data.data, left.shape[1], right.data.data, right.shape[1], result.data.data, right.shape[1]);
 
-                int rem_a = (bounded_r / REGS_A) * REGS_A;
-                int rem_b = (n / REGS_B_SIZE) * REGS_B_SIZE;
+        return result;
+    }
 
-                if (rem_a < bounded_r) {
-                    const DataType* l_inner_block = l_block + bounded_c * rem_a;
-                    const DataType* r_inner_block = r_block;
-                    DataType* o_inner_block       = o_block + rem_a * n;
+    /// Compute `C += A * B` where A is an `m x k` row-major matrix, B is a
+    /// `k x n` row-major matrix and C is an `m x n` row-major matrix.
+    /// `lda`, `ldb` and `ldc` are the distances between consecutive rows.
+    static void gemm(int m, int n, int k,
+                     const DataType* a, int lda,
+                     const DataType* b, int ldb,
+                     DataType* c, int ldc)
+    {
+        if (m == 0 || n == 0 || k == 0)
+            return;
 
-                    matmul_odd(bounded_r - rem_a, rem_b, bounded_c, l_inner_block, r_inner_block, o_inner_block);
-                }
+        AlignedPtr<DataType> a_pack(round_up(std::min(m, BlockRows), RowRegs) * std::min(k, BlockDepth));
+        AlignedPtr<DataType> b_pack(round_up(std::min(n, BlockCols), TileCols) * std::min(k, BlockDepth));
 
-                if (rem_b < n) {
-                    const DataType* l_inner_block = l_block;
-                    const DataType* r_inner_block = r_block + rem_b;
-                    DataType* o_inner_block       = o_block + rem_b;
+        for (int jc = 0; jc < n; jc += BlockCols) {
+            const int nc = std::min(n - jc, BlockCols);
 
-                    matmul_odd(rem_a, n - rem_b, bounded_c, l_inner_block, r_inner_block, o_inner_block);
-                }
+            for (int pc = 0; pc < k; pc += BlockDepth) {
+                const int kc = std::min(k - pc, BlockDepth);
+                pack_right(kc, nc, b + pc * ldb + jc, ldb, b_pack.data);
 
-                if (rem_a < bounded_r && rem_b < n) {
-                    const DataType* l_inner_block = l_block + bounded_c * rem_a;
-                    const DataType* r_inner_block = r_block + rem_b;
-                    DataType* o_inner_block       = o_block + rem_a * n + rem_b;
+                for (int ic = 0; ic < m; ic += BlockRows) {
+                    const int mc = std::min(m - ic, BlockRows);
+                    pack_left(mc, kc, a + ic * lda + pc, lda, a_pack.data);
 
-                    matmul_odd(bounded_r - rem_a, n - rem_b, bounded_c, l_inner_block, r_inner_block, o_inner_block);
+                    for (int jr = 0; jr < nc; jr += TileCols) {
+                        for (int ir = 0; ir < mc; ir += RowRegs) {
+                            micro_kernel(kc, a_pack.data + ir * kc, b_pack.data + jr * kc,
+                                         c + (ic + ir) * ldc + jc + jr, ldc,
+                                         std::min(mc - ir, RowRegs), std::min(nc - jr, TileCols));
+                        }
+                    }
                 }
             }
         }
-
-        return result;
     }
 
 private:
-    /// Naive gemm helper to handle oddly-sized matrices.
-    static void matmul_odd(int m, int n, int k, const DataType* a, const DataType* b, DataType* c)
+    static TNT_INL int round_up(int value, int multiple)
     {
-        for (int p = 0; p < k; p++) {
-            for (int i = 0; i < m; i++) {
-                for (int j = 0; j < n; j++) {
-                   c[i * n + j] += a[i * k + p] * b[p * n + j];
-                }
+        return ((value + multiple - 1) / multiple) * multiple;
+    }
+
+    /// Store `RowRegs` rows at a time, interleaved by column, so the micro
+    /// kernel reads one contiguous run of `RowRegs` values per step
+    static void pack_left(int mc, int kc, const DataType* a, int lda, DataType* buffer)
+    {
+        for (int ir = 0; ir < mc; ir += RowRegs) {
+            const int rows = std::min(mc - ir, RowRegs);
+            for (int p = 0; p < kc; ++p, buffer += RowRegs) {
+                int i = 0;
+                for ( ; i < rows; ++i)
+                    buffer[i] = a[(ir + i) * lda + p];
+                for ( ; i < RowRegs; ++i)
+                    buffer[i] = 0;
             }
         }
     }
 
-    /// Compute a RAxRB block of C using a vectorized dot product, where RA is the
-    /// number of registers to load from matrix A, and RB is the number of registers
-    /// to load from matrix B.
-    template <int regsA, int regsB>
-    static void matmul_dot(int l_cols, int r_cols, const DataType* l_ptr, const DataType* r_ptr, DataType* o_ptr)
+    /// Store `TileCols` columns at a time, row by row, so the micro kernel
+    /// reads aligned vectors
+    static void pack_right(int kc, int nc, const DataType* b, int ldb, DataType* buffer)
     {
-        const DataType zero_val = 0;
-
-        VecType csum[regsA][regsB];
-        for (int ai = 0; ai < regsA; ai++) {
-            for (int bi = 0; bi < regsB; bi++) {
-                csum[ai][bi] = simdpp::load_splat<VecType>(&zero_val);
+        for (int jr = 0; jr < nc; jr += TileCols) {
+            const int cols = std::min(nc - jr, TileCols);
+            for (int p = 0; p < kc; ++p, buffer += TileCols) {
+                std::copy(b + p * ldb + jr, b + p * ldb + jr + cols, buffer);
+                std::fill(buffer + cols, buffer + TileCols, DataType(0));
             }
         }
+    }
 
-        for (int p = 0; p < l_cols; p++) {
-            // Perform the DOT product.
-            for (int bi = 0; bi < regsB; bi++) {
-                VecType bb = LoadSIMDType<DataType, DataType>::load(r_ptr + p * r_cols + bi * 8);
-                for (int ai = 0; ai < regsA; ai++) {
-                    VecType aa = simdpp::load_splat<VecType>(l_ptr + ai * l_cols + p);
-                    csum[ai][bi] = simdpp::add(csum[ai][bi], MultiplySIMD<DataType>::run(aa, bb));
-                }
+    /// Accumulate a `rows x cols` tile of C. Partial tiles at the right and
+    /// bottom edges are computed in full from the zero padded panels and only
+    /// the valid part is written back.
+    static void micro_kernel(int kc, const DataType* a, const DataType* b, DataType* c, int ldc, int rows, int cols)
+    {
+        const DataType zero = 0;
+
+        VecType sums[RowRegs][ColRegs];
+        for (int i = 0; i < RowRegs; ++i)
+            for (int j = 0; j < ColRegs; ++j)
+                sums[i][j] = simdpp::load_splat<VecType>(&zero);
+
+        for (int p = 0; p < kc; ++p, a += RowRegs, b += TileCols) {
+            VecType right[ColRegs];
+            for (int j = 0; j < ColRegs; ++j)
+                right[j] = simdpp::load<VecType>(b + j * Size);
+
+            for (int i = 0; i < RowRegs; ++i) {
+                VecType left = simdpp::load_splat<VecType>(a + i);
+                for (int j = 0; j < ColRegs; ++j)
+                    sums[i][j] = MultiplyAddSIMD<DataType>::run(left, right[j], sums[i][j]);
             }
         }
 
-        // Accumulate the results into C.
-        for (int ai = 0; ai < regsA; ai++) {
-            for (int bi = 0; bi < regsB; bi++) {
-                DataType* ptr = o_ptr + ai * r_cols + bi * 8;
-
-                VecType block = LoadSIMDType<DataType, DataType>::load(ptr);
-                VecType result = simdpp::add(block, csum[ai][bi]);
-                simdpp::store(ptr, result);
+        if (rows == RowRegs && cols == TileCols) {
+            for (int i = 0; i < RowRegs; ++i) {
+                for (int j = 0; j < ColRegs; ++j) {
+                    DataType* ptr = c + i * ldc + j * Size;
+                    simdpp::store_u(ptr, VecType(simdpp::add(simdpp::load_u<VecType>(ptr), sums[i][j])));
+                }
+            }
+        } else {
+            DataType tile[TileCols];
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < ColRegs; ++j)
+                    simdpp::store_u(tile + j * Size, sums[i][j]);
+                for (int j = 0; j < cols; ++j)
+                    c[i * ldc + j] += tile[j];
             }
         }
     }
 };
 
+template <typename DataType> constexpr int OptimizedMatrixMultiply<DataType>::RowRegs;
+template <typename DataType> constexpr int OptimizedMatrixMultiply<DataType>::TileCols;
+template <typename DataType> constexpr int OptimizedMatrixMultiply<DataType>::BlockRows;
+template <typename DataType> constexpr int OptimizedMatrixMultiply<DataType>::BlockDepth;
+template <typename DataType> constexpr int OptimizedMatrixMultiply<DataType>::BlockCols;
+
 } // namespace detail
 
 // ----------------------------------------------------------------------------
@@ -215,6 +215,27 @@ TEST_CASE_TEMPLATE("matrix_multiply(const Tensor<T>&, const Tensor<T>&)", T, mul
         REQUIRE((left.mul(right) == result));
     }
 
+    { // Sizes spanning several cache blocks and partial register tiles
+        const int m = 101, k = 300, n = 2100;
+
+        TensorType left(Shape{m, k}), right(Shape{k, n}), result(Shape{m, n});
+        for (int i = 0; i < m * k; ++i)
+            left.data[i] = (T) ((i * 7) % 3);
+        for (int i = 0; i < k * n; ++i)
+            right.data[i] = (T) ((i * 5) % 4);
+
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < n; ++j) {
+                T sum = 0;
+                for (int p = 0; p < k; ++p)
+                    sum += left.data[i * k + p] * right.data[p * n + j];
+                result.data[i * n + j] = sum;
+            }
+        }
+
+        REQUIRE(matrix_multiply(left, right) == result);
+    }
+
     REQUIRE_THROWS(matrix_multiply(TensorType(Shape{2, 2}), TensorType(Shape{3, 3})));
     REQUIRE_THROWS(matrix_multiply(TensorType(Shape{3, 3, 2}), TensorType(Shape{2, 3, 3})));
 }
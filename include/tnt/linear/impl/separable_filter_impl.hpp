@@ -0,0 +1,188 @@
+#ifndef TNT_LINEAR_SEPARABLE_FILTER_IMPL_HPP
+#define TNT_LINEAR_SEPARABLE_FILTER_IMPL_HPP
+
+#include <tnt/linear/convolution.hpp>
+#include <tnt/linear/impl/blas1_impl.hpp>
+#include <tnt/linear/impl/convolution_3d_impl.hpp>
+#include <tnt/utils/testing.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// The row pass filters each padded input row exactly once into a ring
+/// buffer that holds the last `KH` filtered rows, each `OW x C` values long.
+/// Output row `y` is then the sum of ring rows `y .. y + KH - 1` scaled by
+/// the column kernel. Both passes are multiply-adds of one contiguous row
+/// into another, channels stay interleaved so every row is a single SIMD
+/// loop. Rows that are entirely padding filter to the constant
+/// `pad_value * sum(row_kernel)` and share one precomputed row.
+template <typename DataType>
+struct OptimizedSeparableFilter<DataType, void>
+{
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor,
+                                 const Tensor<DataType>& row_kernel,
+                                 const Tensor<DataType>& column_kernel,
+                                 int pad,
+                                 DataType pad_value)
+    {
+        const int height   = tensor.shape[0], width = tensor.shape[1];
+        const int channels = tensor.shape.num_axes() == 3 ? tensor.shape[2] : 1;
+        const int kernel_rows = column_kernel.shape[0], kernel_cols = row_kernel.shape[0];
+        const int out_rows = height + 2 * pad - kernel_rows + 1;
+        const int out_cols = width  + 2 * pad - kernel_cols + 1;
+        const int length   = out_cols * channels;
+
+        Tensor<DataType> output(tensor.shape.num_axes() == 3 ? Shape{out_rows, out_cols, channels}
+                                                             : Shape{out_rows, out_cols});
+
+        DataType pad_sum = 0;
+        for (int kx = 0; kx < kernel_cols; ++kx)
+            pad_sum = MultiplyAddSIMD<DataType>::scalar(pad_value, row_kernel.data[kx], pad_sum);
+
+        const std::vector<DataType> pad_row(length, pad_sum);
+
+        std::vector<DataType> ring(kernel_rows * length);
+        std::vector<const DataType*> rows(kernel_rows);
+
+        for (int y = 0; y < out_rows; ++y) {
+            // Padded rows y .. y + KH - 2 are already in the ring, except for the first output row
+            for (int r = (y == 0 ? 0 : y + kernel_rows - 1); r < y + kernel_rows; ++r) {
+                const int slot = r % kernel_rows;
+                const int row  = r - pad;
+
+                if (row < 0 || row >= height) {
+                    rows[slot] = pad_row.data();
+                } else {
+                    DataType* filtered = ring.data() + slot * length;
+                    filter_row(tensor.data.data + row * width * channels, row_kernel.data.data, filtered,
+                               width, channels, out_cols, kernel_cols, pad, pad_value);
+                    rows[slot] = filtered;
+                }
+            }
+
+            DataType* out_row = output.data.data + y * length;
+            for (int ky = 0; ky < kernel_rows; ++ky)
+                multiply_add_row(column_kernel.data[ky], rows[(y + ky) % kernel_rows], out_row, length);
+        }
+
+        return output;
+    }
+
+private:
+    static void filter_row(const DataType* input,
+                           const DataType* kernel,
+                           DataType* filtered,
+                           int width,
+                           int channels,
+                           int out_cols,
+                           int kernel_cols,
+                           int pad,
+                           DataType pad_value) noexcept
+    {
+        std::fill(filtered, filtered + out_cols * channels, DataType(0));
+
+        for (int kx = 0; kx < kernel_cols; ++kx) {
+            // Output columns [first, last) read input columns inside the tensor
+            const int first = std::min(out_cols, std::max(0, pad - kx));
+            const int last  = std::max(first, std::min(out_cols, width + pad - kx));
+
+            if (last > first)
+                multiply_add_row(kernel[kx], input + (first + kx - pad) * channels, filtered + first * channels,
+                                 (last - first) * channels);
+
+            if (pad_value != DataType(0)) {
+                const DataType value = MultiplyAddSIMD<DataType>::scalar(pad_value, kernel[kx], DataType(0));
+
+                for (int i = 0; i < first * channels; ++i)
+                    filtered[i] += value;
+                for (int i = last * channels; i < out_cols * channels; ++i)
+                    filtered[i] += value;
+            }
+        }
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+namespace
+{
+
+template <typename T>
+Tensor<T> reference_separable_filter2D(const Tensor<T>& tensor, const Tensor<T>& row_kernel, const Tensor<T>& column_kernel, int pad, T pad_value)
+{
+    const int height = tensor.shape[0], width = tensor.shape[1];
+    const int channels = tensor.shape.num_axes() == 3 ? tensor.shape[2] : 1;
+    const int kernel_rows = column_kernel.shape[0], kernel_cols = row_kernel.shape[0];
+    const int out_rows = height + 2 * pad - kernel_rows + 1, out_cols = width + 2 * pad - kernel_cols + 1;
+
+    Tensor<T> output(tensor.shape.num_axes() == 3 ? Shape{out_rows, out_cols, channels} : Shape{out_rows, out_cols});
+
+    for (int y = 0; y < out_rows; ++y) {
+        for (int x = 0; x < out_cols; ++x) {
+            for (int c = 0; c < channels; ++c) {
+                T sum = 0;
+                for (int ky = 0; ky < kernel_rows; ++ky) {
+                    for (int kx = 0; kx < kernel_cols; ++kx) {
+                        const int row = y - pad + ky, col = x - pad + kx;
+                        const T value = (row < 0 || row >= height || col < 0 || col >= width)
+                                      ? pad_value : tensor.data[(row * width + col) * channels + c];
+                        sum += value * (T) (column_kernel.data[ky] * row_kernel.data[kx]);
+                    }
+                }
+                output.data[(y * out_cols + x) * channels + c] = sum;
+            }
+        }
+    }
+
+    return output;
+}
+
+} // namespace
+
+TEST_CASE_TEMPLATE("separable_filter2D(const Tensor<T>&, const Tensor<T>&, const Tensor<T>&, int, T)", T, test_data_types)
+{
+    { // 3x3 image, 2x2 box filter
+        T data[9]     = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        T expected[4] = {12, 16, 24, 28};
+
+        Tensor<T> tensor(Shape{3, 3}, AlignedPtr<T>(data, 9));
+        Tensor<T> kernel(Shape{2}, 1);
+
+        REQUIRE((separable_filter2D(tensor, kernel, kernel) == Tensor<T>(Shape{2, 2}, AlignedPtr<T>(expected, 4))));
+    }
+
+    auto test_filter = [](const Shape& shape, int kernel_cols, int kernel_rows, int pad, T pad_value) {
+        Tensor<T> tensor        = pattern_tensor<T>(shape, 7, 3);
+        Tensor<T> row_kernel    = pattern_tensor<T>(Shape{kernel_cols}, 5, 3);
+        Tensor<T> column_kernel = pattern_tensor<T>(Shape{kernel_rows}, 2, 3);
+        row_kernel.data[0] = column_kernel.data[0] = 1;
+
+        REQUIRE((separable_filter2D(tensor, row_kernel, column_kernel, pad, pad_value)
+                 == reference_separable_filter2D(tensor, row_kernel, column_kernel, pad, pad_value)));
+    };
+
+    test_filter(Shape{5, 5},      3, 3, 0, 0);
+    test_filter(Shape{9, 40},     3, 3, 1, 2);
+    test_filter(Shape{7, 6, 3},   3, 2, 1, 1);
+    test_filter(Shape{12, 9, 37}, 3, 3, 2, 1);  // Padding on every tap
+    test_filter(Shape{6, 20, 16}, 1, 3, 0, 0);
+    test_filter(Shape{2, 3, 4},   3, 3, 3, 1);  // Mostly padding
+
+    REQUIRE_THROWS(separable_filter2D(Tensor<T>(Shape{5}), Tensor<T>(Shape{3}), Tensor<T>(Shape{3})));
+    REQUIRE_THROWS(separable_filter2D(Tensor<T>(Shape{5, 5}), Tensor<T>(Shape{3, 3}), Tensor<T>(Shape{3})));
+    REQUIRE_THROWS(separable_filter2D(Tensor<T>(Shape{2, 5}), Tensor<T>(Shape{3}), Tensor<T>(Shape{3})));
+    REQUIRE_THROWS(separable_filter2D(Tensor<T>(Shape{5, 5}), Tensor<T>(Shape{3}), Tensor<T>(Shape{3}), -1));
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_SEPARABLE_FILTER_IMPL_HPP
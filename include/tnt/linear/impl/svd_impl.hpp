@@ -0,0 +1,519 @@
+#ifndef TNT_LINEAR_SVD_IMPL_HPP
+#define TNT_LINEAR_SVD_IMPL_HPP
+
+#include <tnt/linear/svd.hpp>
+#include <tnt/linear/impl/blas1_impl.hpp>
+#include <tnt/linear/impl/decomposition_impl.hpp>
+#include <tnt/linear/impl/matrix_multiply_impl.hpp>
+#include <tnt/utils/parallel.hpp>
+#include <tnt/utils/testing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// One-sided Jacobi (Hestenes) on a square matrix `X`, after de Rijk. The
+/// columns of `X` are rotated in pairs until they are mutually orthogonal,
+/// which gives `X = W J^T` with `W` holding the singular values times the
+/// left vectors and `J` orthogonal. Column `i` of `X` and of `J` are stored
+/// side by side in row `i` of one buffer, so a pair is rotated with a single
+/// [PlaneRotation]().
+///
+/// Running this on `X = A^T` (or `R^T` after a QR of a tall `A`) lets the
+/// rows of `A` be used directly and converges faster, per Drmac and Veselic:
+/// `A = J diag(s) W^T`, so `U` comes from `J` and `V` from `W`.
+template <typename DataType>
+struct OptimizedSVD<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using Multiply = OptimizedMatrixMultiply<DataType>;
+
+    constexpr static int MaxSweeps = 30;
+
+    /// The smallest matrix whose sweeps are spread over threads. Below it a
+    /// round of rotations costs less than a few barrier waits.
+    constexpr static int ParallelSize = 256;
+
+    /// Rows of `U = Q J` computed by one task
+    constexpr static int RowBlock = 64;
+
+    static SVD<DataType> eval(const Tensor<DataType>& tensor, int num_threads)
+    {
+        const int m = tensor.shape[0];
+        const int n = tensor.shape[1];
+
+        if (m < n) {
+            SVD<DataType> result = eval(tensor.transpose(), num_threads);
+            std::swap(result.u, result.v);
+            return result;
+        }
+
+        const int ld = 2 * n;
+        std::vector<DataType> g(n * ld, DataType(0));
+
+        QR<DataType> factors;
+        const DataType* x = tensor.data.data;
+        if (m > n) {
+            factors = OptimizedQR<DataType>::eval(tensor, num_threads);
+            x = factors.r.data.data;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            std::copy(x + i * n, x + (i + 1) * n, g.begin() + i * ld);
+            g[i * ld + n + i] = 1;
+        }
+
+        jacobi(g.data(), n, num_threads);
+
+        std::vector<DataType> sigma(n);
+        for (int i = 0; i < n; ++i)
+            sigma[i] = std::sqrt(dot_row(g.data() + i * ld, g.data() + i * ld, n));
+
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int i, int j) { return sigma[i] > sigma[j]; });
+
+        SVD<DataType> result;
+        result.s = Tensor<DataType>(Shape{n});
+
+        std::vector<DataType> vt(n * n), j(n * n);
+        int rank = 0;
+        for (int i = 0; i < n; ++i) {
+            const DataType* row = g.data() + order[i] * ld;
+            const DataType s = sigma[order[i]];
+
+            result.s.data[i] = s;
+            if (s > 0) {
+                for (int c = 0; c < n; ++c)
+                    vt[i * n + c] = row[c] / s;
+                ++rank;
+            }
+
+            for (int r = 0; r < n; ++r)
+                j[r * n + i] = row[n + r];
+        }
+
+        complete(vt.data(), rank, n);
+
+        result.v = Tensor<DataType>(Shape{n, n});
+        for (int r = 0; r < n; ++r)
+            for (int c = 0; c < n; ++c)
+                result.v.data[r * n + c] = vt[c * n + r];
+
+        if (m == n) {
+            result.u = Tensor<DataType>(Shape{n, n});
+            std::copy(j.begin(), j.end(), result.u.data.data);
+            return result;
+        }
+
+        // U = Q J
+        result.u = zeros<DataType>(Shape{m, n});
+        const DataType* q = factors.q.data.data;
+        DataType* u = result.u.data.data;
+
+        auto product = [&](int block) {
+            const int r0 = block * RowBlock;
+            Multiply::gemm(std::min(RowBlock, m - r0), n, n, q + r0 * n, n, j.data(), n, u + r0 * n, n);
+        };
+
+        parallel_for((m + RowBlock - 1) / RowBlock, num_threads, product);
+
+        return result;
+    }
+
+private:
+    /// Sweeps over all pairs in round-robin order: each of the `n - 1`
+    /// rounds (`n` rounded up to even) rotates `n / 2` disjoint pairs, so the
+    /// pairs of a round are independent. The squared column norms are kept up
+    /// to date through the rotations and recomputed once per sweep. A sweep
+    /// runs on one team of threads, each rotating a fixed share of the pairs
+    /// of every round and waiting for the others before the next round.
+    static void jacobi(DataType* g, int n, int num_threads)
+    {
+        const int ld = 2 * n;
+        const int players = n + (n & 1);
+        const int threads = n >= ParallelSize ? num_threads : 1;
+        const DataType tolerance = std::sqrt(DataType(n)) * std::numeric_limits<DataType>::epsilon();
+
+        std::vector<DataType> norms(n);
+        std::vector<char> rotated(players / 2);
+
+        // The round robin schedule: position 0 keeps player 0 and the others
+        // move one position along per round
+        auto player = [players](int position, int round) {
+            return position == 0 ? 0 : 1 + (position - 1 + players - 1 - round % (players - 1)) % (players - 1);
+        };
+
+        auto rotate = [&](int pair, int round) {
+            const int a = player(pair, round);
+            const int b = player(players - 1 - pair, round);
+            const int i = std::min(a, b);
+            const int j = std::max(a, b);
+            if (j == n)
+                return;
+
+            DataType* x = g + i * ld;
+            DataType* y = g + j * ld;
+
+            const DataType alpha = norms[i];
+            const DataType beta = norms[j];
+            const DataType gamma = dot_row(x, y, n);
+
+            if (!(std::abs(gamma) > tolerance * std::sqrt(alpha) * std::sqrt(beta)))
+                return;
+
+            const DataType zeta = (beta - alpha) / (2 * gamma);
+            const DataType t = std::copysign(DataType(1), zeta) / (std::abs(zeta) + std::hypot(DataType(1), zeta));
+            const DataType c = 1 / std::sqrt(1 + t * t);
+
+            PlaneRotation<DataType>::apply(x, y, ld, c, c * t);
+
+            norms[i] = alpha - t * gamma;
+            norms[j] = beta + t * gamma;
+            rotated[pair] = 1;
+        };
+
+        auto sweep = [&](int thread, Barrier& barrier) {
+            const int pairs = players / 2;
+            const int begin = thread * pairs / barrier.size();
+            const int end = (thread + 1) * pairs / barrier.size();
+
+            for (int round = 0; round + 1 < players; ++round) {
+                for (int pair = begin; pair < end; ++pair)
+                    rotate(pair, round);
+                barrier.wait();
+            }
+        };
+
+        for (int s = 0; s < MaxSweeps; ++s) {
+            for (int i = 0; i < n; ++i)
+                norms[i] = dot_row(g + i * ld, g + i * ld, n);
+
+            std::fill(rotated.begin(), rotated.end(), 0);
+            parallel_team(threads, sweep);
+
+            if (std::find(rotated.begin(), rotated.end(), 1) == rotated.end())
+                break;
+        }
+    }
+
+    /// Fill rows `rank` to `n` of `vt` with unit vectors orthogonal to the
+    /// rows before them, for the null space of a rank deficient matrix
+    static void complete(DataType* vt, int rank, int n)
+    {
+        for (int i = rank, candidate = 0; i < n; ++candidate) {
+            DataType* row = vt + i * n;
+            std::fill(row, row + n, DataType(0));
+            row[candidate] = 1;
+
+            for (int pass = 0; pass < 2; ++pass)
+                for (int l = 0; l < i; ++l)
+                    multiply_add_row(-dot_row(row, vt + l * n, n), vt + l * n, row, n);
+
+            const DataType norm = std::sqrt(dot_row(row, row, n));
+            if (norm > DataType(0.5)) {
+                for (int c = 0; c < n; ++c)
+                    row[c] /= norm;
+                ++i;
+            }
+        }
+    }
+};
+
+template <typename DataType>
+constexpr int OptimizedSVD<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::RowBlock;
+
+/// Randomized range finder with power iterations, after Halko, Martinsson
+/// and Tropp. Blocks of vectors are kept as columns, so `A Z` is a row-major
+/// product split over rows of `A`, and `Q^T A` one split over its columns.
+template <typename DataType>
+struct OptimizedTruncatedSVD<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using Multiply = OptimizedMatrixMultiply<DataType>;
+
+    /// Extra vectors in the block beyond `k`, at least
+    constexpr static int MinOversample = 10;
+
+    /// Rows of `A Z` or columns of `Q^T A` computed by one task
+    constexpr static int RowBlock = 64;
+    constexpr static int ColumnBlock = 256;
+
+    static SVD<DataType> eval(const Tensor<DataType>& tensor, int k, int power_iterations, int num_threads)
+    {
+        const int m = tensor.shape[0];
+        const int n = tensor.shape[1];
+        const int b = std::min(std::min(m, n), k + std::max(k, int(MinOversample)));
+
+        std::mt19937 generator(m + n);
+        std::normal_distribution<DataType> distribution;
+
+        Tensor<DataType> Z(Shape{n, b});
+        for (int i = 0; i < n * b; ++i)
+            Z.data[i] = distribution(generator);
+
+        Tensor<DataType> Q = OptimizedQR<DataType>::eval(multiply(tensor, Z, num_threads), num_threads).q;
+
+        for (int iteration = 0; iteration < power_iterations; ++iteration) {
+            Z = OptimizedQR<DataType>::eval(project(Q, tensor, num_threads).transpose(), num_threads).q;
+            Q = OptimizedQR<DataType>::eval(multiply(tensor, Z, num_threads), num_threads).q;
+        }
+
+        // Q^T A = W diag(s) V^T, so A ~ (Q W) diag(s) V^T
+        SVD<DataType> small = OptimizedSVD<DataType>::eval(project(Q, tensor, num_threads), num_threads);
+
+        SVD<DataType> result;
+        result.s = Tensor<DataType>(Shape{k});
+        result.v = Tensor<DataType>(Shape{n, k});
+        result.u = zeros<DataType>(Shape{m, k});
+
+        std::copy(small.s.data.data, small.s.data.data + k, result.s.data.data);
+        for (int r = 0; r < n; ++r)
+            std::copy(small.v.data.data + r * b, small.v.data.data + r * b + k, result.v.data.data + r * k);
+
+        auto product = [&](int block) {
+            const int r0 = block * RowBlock;
+            Multiply::gemm(std::min(RowBlock, m - r0), k, b, Q.data.data + r0 * b, b,
+                           small.u.data.data, b, result.u.data.data + r0 * k, k);
+        };
+
+        parallel_for((m + RowBlock - 1) / RowBlock, num_threads, product);
+
+        return result;
+    }
+
+private:
+    /// `A Z` for an `n x b` block `Z`
+    static Tensor<DataType> multiply(const Tensor<DataType>& tensor, const Tensor<DataType>& Z, int num_threads)
+    {
+        const int m = tensor.shape[0];
+        const int n = tensor.shape[1];
+        const int b = Z.shape[1];
+
+        Tensor<DataType> result = zeros<DataType>(Shape{m, b});
+
+        auto product = [&](int block) {
+            const int r0 = block * RowBlock;
+            Multiply::gemm(std::min(RowBlock, m - r0), b, n, tensor.data.data + r0 * n, n,
+                           Z.data.data, b, result.data.data + r0 * b, b);
+        };
+
+        parallel_for((m + RowBlock - 1) / RowBlock, num_threads, product);
+
+        return result;
+    }
+
+    /// `Q^T A` for an `m x b` block `Q`
+    static Tensor<DataType> project(const Tensor<DataType>& Q, const Tensor<DataType>& tensor, int num_threads)
+    {
+        const int m = tensor.shape[0];
+        const int n = tensor.shape[1];
+        const int b = Q.shape[1];
+
+        const Tensor<DataType> Qt = Q.transpose();
+        Tensor<DataType> result = zeros<DataType>(Shape{b, n});
+
+        auto product = [&](int block) {
+            const int c0 = block * ColumnBlock;
+            Multiply::gemm(b, std::min(ColumnBlock, n - c0), m, Qt.data.data, m,
+                           tensor.data.data + c0, n, result.data.data + c0, n);
+        };
+
+        parallel_for((n + ColumnBlock - 1) / ColumnBlock, num_threads, product);
+
+        return result;
+    }
+};
+
+template <typename DataType>
+constexpr int OptimizedTruncatedSVD<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::RowBlock;
+
+template <typename DataType>
+constexpr int OptimizedTruncatedSVD<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::ColumnBlock;
+
+} // namespace detail
+
+namespace
+{
+
+/// Check `A = U diag(s) V^T` with orthonormal `U` and `V` and sorted `s`
+template <typename T>
+void check_svd(const Tensor<T>& A, const SVD<T>& result, T tolerance)
+{
+    const int m = A.shape[0];
+    const int n = A.shape[1];
+    const int p = result.s.shape[0];
+
+    REQUIRE(result.u.shape == (Shape{m, p}));
+    REQUIRE(result.v.shape == (Shape{n, p}));
+
+    for (int i = 0; i < p; ++i) {
+        REQUIRE(result.s.data[i] >= 0);
+        if (i > 0)
+            REQUIRE(result.s.data[i] <= result.s.data[i - 1]);
+
+        for (int j = 0; j < p; ++j) {
+            T uu = 0, vv = 0;
+            for (int r = 0; r < m; ++r)
+                uu += result.u.data[r * p + i] * result.u.data[r * p + j];
+            for (int r = 0; r < n; ++r)
+                vv += result.v.data[r * p + i] * result.v.data[r * p + j];
+
+            REQUIRE(std::abs(uu - (i == j)) <= tolerance);
+            REQUIRE(std::abs(vv - (i == j)) <= tolerance);
+        }
+    }
+
+    const T scale = std::max(result.s.data[0], T(1));
+    for (int r = 0; r < m; ++r) {
+        for (int c = 0; c < n; ++c) {
+            T sum = 0;
+            for (int i = 0; i < p; ++i)
+                sum += result.u.data[r * p + i] * result.s.data[i] * result.v.data[c * p + i];
+            REQUIRE(std::abs(sum - A.data[r * n + c]) <= tolerance * scale);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE_TEMPLATE("svd()", T, test_float_data_types)
+{
+    const T tolerance = std::is_same<T, float>::value ? T(1e-4) : T(1e-12);
+
+    const int shapes[][2] = {{1, 1}, {1, 5}, {5, 1}, {7, 7}, {40, 25}, {25, 40}, {130, 130}, {200, 140}};
+    for (const auto& shape : shapes) {
+        const int m = shape[0], n = shape[1];
+        Tensor<T> A = random_matrix<T>(m, n, T(0), m * n);
+
+        SVD<T> result = svd(A, 1);
+        REQUIRE(result.s.shape == Shape{std::min(m, n)});
+        check_svd(A, result, tolerance * std::max(m, n));
+
+        SVD<T> threaded = svd(A, 3);
+        REQUIRE(threaded.u == result.u);
+        REQUIRE(threaded.s == result.s);
+        REQUIRE(threaded.v == result.v);
+    }
+
+    { // Known values: diag(3, -2) padded with a zero row
+        T data[6] = {0, -2, 3, 0, 0, 0};
+        Tensor<T> A(Shape{3, 2}, AlignedPtr<T>(data, 6));
+
+        SVD<T> result = svd(A);
+        REQUIRE(result.s.data[0] == doctest::Approx(3));
+        REQUIRE(result.s.data[1] == doctest::Approx(2));
+        check_svd(A, result, tolerance);
+    }
+
+    { // Rank deficient: the null space is completed to orthonormal vectors
+        Tensor<T> A = random_matrix<T>(30, 10, T(0), 3);
+        for (int r = 0; r < 30; ++r)
+            for (int c = 5; c < 10; ++c)
+                A.data[r * 10 + c] = A.data[r * 10 + c - 5] * T(c);
+
+        SVD<T> result = svd(A);
+        REQUIRE(result.s.data[5] <= tolerance * 100 * result.s.data[0]);
+        check_svd(A, result, tolerance * 100);
+
+        check_svd(zeros<T>(Shape{4, 3}), svd(zeros<T>(Shape{4, 3})), tolerance);
+    }
+
+    REQUIRE_THROWS((svd(Tensor<T>(Shape{2, 2, 2}))));
+}
+
+TEST_CASE_TEMPLATE("svd() threaded", T, test_float_data_types)
+{
+    // Large enough for the sweeps to run on a team of threads, which must
+    // rotate exactly as a single thread does
+    const int n = detail::OptimizedSVD<T>::ParallelSize;
+    Tensor<T> A = random_matrix<T>(n, n, T(0), n);
+
+    SVD<T> result = svd(A, 1);
+    SVD<T> threaded = svd(A, 4);
+    REQUIRE(threaded.u == result.u);
+    REQUIRE(threaded.s == result.s);
+    REQUIRE(threaded.v == result.v);
+}
+
+TEST_CASE_TEMPLATE("truncated_svd()", T, test_float_data_types)
+{
+    const T eps = std::is_same<T, float>::value ? T(1e-4) : T(1e-10);
+
+    // A = Q1 diag(100 * 0.5^i) Q2^T with random orthonormal Q1 and Q2
+    const int shapes[][2] = {{300, 120}, {90, 260}};
+    for (const auto& shape : shapes) {
+        const int m = shape[0], n = shape[1], p = std::min(m, n);
+
+        Tensor<T> Q1 = qr(random_matrix<T>(m, p, T(0), m)).q;
+        Tensor<T> Q2 = qr(random_matrix<T>(n, p, T(0), n)).q;
+
+        std::vector<T> sigma(p);
+        for (int i = 0; i < p; ++i)
+            sigma[i] = T(100 * std::pow(0.5, i));
+
+        Tensor<T> A = zeros<T>(Shape{m, n});
+        for (int r = 0; r < m; ++r)
+            for (int i = 0; i < p; ++i)
+                for (int c = 0; c < n; ++c)
+                    A.data[r * n + c] += Q1.data[r * p + i] * sigma[i] * Q2.data[c * p + i];
+
+        for (int k : {1, 6}) {
+            SVD<T> result = truncated_svd(A, k, 2, 1);
+            REQUIRE(result.s.shape == Shape{k});
+            REQUIRE(result.u.shape == (Shape{m, k}));
+            REQUIRE(result.v.shape == (Shape{n, k}));
+
+            for (int i = 0; i < k; ++i) {
+                REQUIRE(std::abs(result.s.data[i] - sigma[i]) <= 100 * eps * sigma[0]);
+
+                for (int j = 0; j < k; ++j) {
+                    T uu = 0, vv = 0;
+                    for (int r = 0; r < m; ++r)
+                        uu += result.u.data[r * k + i] * result.u.data[r * k + j];
+                    for (int r = 0; r < n; ++r)
+                        vv += result.v.data[r * k + i] * result.v.data[r * k + j];
+                    REQUIRE(std::abs(uu - (i == j)) <= 10 * eps);
+                    REQUIRE(std::abs(vv - (i == j)) <= 10 * eps);
+                }
+
+                // A v = s u
+                for (int r = 0; r < m; ++r) {
+                    T av = 0;
+                    for (int c = 0; c < n; ++c)
+                        av += A.data[r * n + c] * result.v.data[c * k + i];
+                    REQUIRE(std::abs(av - result.s.data[i] * result.u.data[r * k + i]) <= 100 * eps * sigma[0]);
+                }
+            }
+
+            SVD<T> threaded = truncated_svd(A, k, 2, 3);
+            REQUIRE(threaded.u == result.u);
+            REQUIRE(threaded.s == result.s);
+            REQUIRE(threaded.v == result.v);
+        }
+    }
+
+    { // Every singular value of a small matrix matches svd()
+        Tensor<T> A = random_matrix<T>(12, 9, T(0), 5);
+        SVD<T> full = svd(A);
+        SVD<T> result = truncated_svd(A, 9);
+        for (int i = 0; i < 9; ++i)
+            REQUIRE(std::abs(result.s.data[i] - full.s.data[i]) <= 100 * eps);
+    }
+
+    REQUIRE_THROWS((truncated_svd(Tensor<T>(Shape{2, 2, 2}), 1)));
+    REQUIRE_THROWS((truncated_svd(Tensor<T>(Shape{4, 3}), 0)));
+    REQUIRE_THROWS((truncated_svd(Tensor<T>(Shape{4, 3}), 4)));
+    REQUIRE_THROWS((truncated_svd(Tensor<T>(Shape{4, 3}), 1, -1)));
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_SVD_IMPL_HPP
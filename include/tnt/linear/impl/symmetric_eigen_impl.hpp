@@ -0,0 +1,481 @@
+#ifndef TNT_LINEAR_SYMMETRIC_EIGEN_IMPL_HPP
+#define TNT_LINEAR_SYMMETRIC_EIGEN_IMPL_HPP
+
+#include <tnt/linear/eigen.hpp>
+#include <tnt/linear/impl/blas1_impl.hpp>
+#include <tnt/linear/impl/householder_impl.hpp>
+#include <tnt/linear/impl/matrix_multiply_impl.hpp>
+#include <tnt/utils/parallel.hpp>
+#include <tnt/utils/testing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Symmetric eigen decomposition in three stages, following LAPACK's `sytrd`,
+/// `orgtr` and `steqr`:
+///
+/// 1. `A = Q T Q^T` with `T` tridiagonal. Reflectors are found one row at a
+///    time but the trailing matrix is only updated once per panel of
+///    `BlockSize` reflectors, as the rank `2 * BlockSize` product
+///    `A -= V W^T + W V^T`. Only the upper triangle is read or written.
+/// 2. `Q^T` is accumulated from the reflectors with the compact WY form
+///    `H_0 ... H_b = I - V T V^T`, again as matrix products.
+/// 3. `T = S diag(d) S^T` by implicitly shifted QL. The eigenvectors
+///    `Q S` are kept transposed so that every rotation combines two
+///    contiguous rows.
+///
+/// The matrix products are split into independent blocks of rows, and the
+/// rotations into independent blocks of columns, so the results do not
+/// depend on the number of threads.
+template <typename DataType>
+struct OptimizedSymmetricEigen<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using Multiply = OptimizedMatrixMultiply<DataType>;
+
+    /// Reflectors per panel
+    constexpr static int BlockSize = 32;
+
+    /// Rows of a matrix product handled by one task
+    constexpr static int RowBlock = 64;
+
+    /// Columns of the eigenvectors rotated by one task
+    constexpr static int ColumnBlock = 256;
+
+    /// Trailing matrices smaller than this are multiplied by vectors on one
+    /// thread
+    constexpr static int ParallelLength = 384;
+
+    /// QL iterations allowed for one eigenvalue before giving up
+    constexpr static int MaxIterations = 60;
+
+    /// Returns false if the QL iterations did not converge
+    static bool eval(const Tensor<DataType>& tensor, bool vectors, int num_threads, SymmetricEigen<DataType>& result)
+    {
+        const int n = tensor.shape[0];
+
+        Tensor<DataType> A = tensor;
+        DataType* a = A.data.data;
+
+        std::vector<DataType> d(n), e(n, 0), tau(n, 0);
+        tridiagonalize(a, n, d.data(), e.data(), tau.data(), num_threads);
+
+        Tensor<DataType> Z;
+        if (vectors)
+            Z = accumulate_reflectors(a, n, tau.data(), num_threads);
+
+        if (!diagonalize(d.data(), e.data(), n, vectors ? Z.data.data : nullptr, num_threads))
+            return false;
+
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int i, int j) { return d[i] < d[j]; });
+
+        result.values = Tensor<DataType>(Shape{n});
+        for (int i = 0; i < n; ++i)
+            result.values.data[i] = d[order[i]];
+
+        if (vectors) {
+            result.vectors = Tensor<DataType>(Shape{n, n});
+            for (int j = 0; j < n; ++j) {
+                const DataType* z = Z.data.data + order[j] * n;
+                for (int r = 0; r < n; ++r)
+                    result.vectors.data[r * n + j] = z[r];
+            }
+        }
+
+        return true;
+    }
+
+private:
+    /// Reduce row `k` after row `k` to a multiple of `e_0`, leaving the
+    /// diagonal in `d`, the off-diagonal in `e` and the Householder vectors in
+    /// the upper triangle of `a`, right of the superdiagonal.
+    static void tridiagonalize(DataType* a, int n, DataType* d, DataType* e, DataType* tau, int num_threads)
+    {
+        // Column i of the panel is V[i * n + r], W[i * n + r]
+        std::vector<DataType> V(BlockSize * n), W(BlockSize * n);
+        std::vector<DataType> left, right, partial;
+
+        for (int k0 = 0; k0 < n; k0 += BlockSize) {
+            const int nb = std::min(BlockSize, n - k0);
+            std::fill(V.begin(), V.end(), DataType(0));
+            std::fill(W.begin(), W.end(), DataType(0));
+
+            for (int j = 0; j < nb; ++j) {
+                const int k = k0 + j;
+                DataType* row = a + k * n;
+
+                // Bring row k up to date with the panel's reflectors
+                for (int i = 0; i < j; ++i) {
+                    const DataType* v = V.data() + i * n;
+                    const DataType* w = W.data() + i * n;
+                    multiply_add_row(-v[k], w + k, row + k, n - k);
+                    multiply_add_row(-w[k], v + k, row + k, n - k);
+                }
+
+                d[k] = row[k];
+                if (k == n - 1)
+                    break;
+
+                const int m = n - k - 1;
+                e[k] = Householder<DataType>::generate(row + k + 1, m, tau[k]);
+                if (tau[k] == 0)
+                    continue;
+
+                DataType* v = V.data() + j * n;
+                DataType* w = W.data() + j * n;
+                std::copy(row + k + 1, row + n, v + k + 1);
+
+                // w = tau A v, with the trailing block of A behind by the
+                // panel's earlier reflectors. Each row of the upper triangle
+                // is read once, as a row and as a column, into one partial
+                // product per block of rows.
+                const DataType* v_tail = v + k + 1;
+                const int num_blocks = (m + RowBlock - 1) / RowBlock;
+                partial.assign(num_blocks * m, DataType(0));
+
+                auto product = [&](int block) {
+                    DataType* y = partial.data() + block * m;
+                    const int end = std::min((block + 1) * RowBlock, m);
+                    for (int r = block * RowBlock; r < end; ++r) {
+                        const DataType* row_r = a + (k + 1 + r) * n + k + 1;
+                        y[r] += dot_row(row_r + r, v_tail + r, m - r);
+                        multiply_add_row(v_tail[r], row_r + r + 1, y + r + 1, m - r - 1);
+                    }
+                };
+
+                parallel_for(num_blocks, m < ParallelLength ? 1 : num_threads, product);
+
+                std::fill(w + k + 1, w + n, DataType(0));
+                for (int block = 0; block < num_blocks; ++block)
+                    multiply_add_row(DataType(1), partial.data() + block * m, w + k + 1, m);
+
+                for (int i = 0; i < j; ++i) {
+                    const DataType* vi = V.data() + i * n;
+                    const DataType* wi = W.data() + i * n;
+                    const DataType wv = dot_row(wi + k + 1, v_tail, m);
+                    const DataType vv = dot_row(vi + k + 1, v_tail, m);
+                    multiply_add_row(-wv, vi + k + 1, w + k + 1, m);
+                    multiply_add_row(-vv, wi + k + 1, w + k + 1, m);
+                }
+
+                for (int r = k + 1; r < n; ++r)
+                    w[r] *= tau[k];
+
+                // w -= tau / 2 (w^T v) v makes the update A - v w^T - w v^T
+                const DataType alpha = -tau[k] / 2 * dot_row(w + k + 1, v_tail, m);
+                multiply_add_row(alpha, v_tail, w + k + 1, m);
+            }
+
+            // Trailing block -= [V W] [W V]^T
+            const int s = k0 + nb;
+            const int m = n - s;
+            if (m <= 0)
+                continue;
+
+            const int depth = 2 * nb;
+            left.resize(m * depth);
+            right.resize(depth * m);
+            for (int i = 0; i < nb; ++i) {
+                const DataType* v = V.data() + i * n + s;
+                const DataType* w = W.data() + i * n + s;
+                for (int r = 0; r < m; ++r) {
+                    left[r * depth + i]      = v[r];
+                    left[r * depth + nb + i] = w[r];
+                }
+                for (int c = 0; c < m; ++c) {
+                    right[i * m + c]        = -w[c];
+                    right[(nb + i) * m + c] = -v[c];
+                }
+            }
+
+            // Only the upper triangle, a block of rows from its diagonal on
+            auto update = [&](int block) {
+                const int r0 = block * RowBlock;
+                Multiply::gemm(std::min(RowBlock, m - r0), m - r0, depth,
+                               left.data() + r0 * depth, depth, right.data() + r0, m,
+                               a + (s + r0) * n + s + r0, n);
+            };
+
+            parallel_for((m + RowBlock - 1) / RowBlock, num_threads, update);
+        }
+    }
+
+    /// `Q^T = H_{n-2} ... H_0` as a row-major matrix. Panels are applied
+    /// from the last, as `X = X (I - V T^T V^T)`; panel `j0` only touches rows
+    /// and columns after `j0`.
+    static Tensor<DataType> accumulate_reflectors(const DataType* a, int n, const DataType* tau, int num_threads)
+    {
+        Tensor<DataType> X = zeros<DataType>(Shape{n, n});
+        DataType* x = X.data.data;
+        for (int i = 0; i < n; ++i)
+            x[i * n + i] = 1;
+
+        if (n < 3)
+            return X;
+
+        std::vector<DataType> Vt, T(BlockSize * BlockSize);
+
+        for (int j0 = ((n - 2) / BlockSize) * BlockSize; j0 >= 0; j0 -= BlockSize) {
+            const int nb = std::min(BlockSize, n - 1 - j0);
+            const int c0 = j0 + 1;
+            const int m = n - c0;
+
+            // The reflectors as the rows of Vt
+            Vt.assign(nb * m, DataType(0));
+            for (int i = 0; i < nb; ++i) {
+                const int k = j0 + i;
+                DataType* v = Vt.data() + i * m;
+                v[k + 1 - c0] = 1;
+                for (int c = k + 2; c < n; ++c)
+                    v[c - c0] = a[k * n + c];
+            }
+
+            Householder<DataType>::triangular_factor(Vt.data(), nb, m, tau + j0, T.data(), BlockSize);
+            Householder<DataType>::apply_right(x + c0 * n + c0, m, n, Vt.data(), nb, m, T.data(), BlockSize, true, num_threads);
+        }
+
+        return X;
+    }
+
+    /// A plane rotation of rows `row` and `row + 1` of the eigenvectors
+    struct Rotation
+    {
+        int row;
+        DataType c, s;
+    };
+
+    /// Rotate column blocks of the `n x n` rows `z` in parallel, each block
+    /// by every rotation in order
+    static void apply_rotations(std::vector<Rotation>& rotations, DataType* z, int n, int num_threads)
+    {
+        auto rotate = [&](int block) {
+            const int c0 = block * ColumnBlock;
+            const int width = std::min(ColumnBlock, n - c0);
+            for (const Rotation& rotation : rotations)
+                PlaneRotation<DataType>::apply(z + rotation.row * n + c0, z + (rotation.row + 1) * n + c0,
+                                               width, rotation.c, rotation.s);
+        };
+
+        parallel_for((n + ColumnBlock - 1) / ColumnBlock, num_threads, rotate);
+        rotations.clear();
+    }
+
+    /// Implicit QL with Wilkinson shifts on the tridiagonal matrix with
+    /// diagonal `d` and off-diagonal `e`, as in EISPACK's `tql2`. The
+    /// eigenvalues are left in `d`. If `z` is given its rows are rotated with
+    /// the matrix, batched so that each batch is one parallel pass. Returns
+    /// false if an eigenvalue needs more than `MaxIterations` iterations.
+    static bool diagonalize(DataType* d, DataType* e, int n, DataType* z, int num_threads)
+    {
+        const DataType eps = std::numeric_limits<DataType>::epsilon();
+
+        std::vector<Rotation> rotations;
+        if (z != nullptr)
+            rotations.reserve(4 * n);
+
+        for (int l = 0; l < n; ++l) {
+            for (int iteration = 0; ; ++iteration) {
+                // Find a negligible off-diagonal element to split at
+                int m = l;
+                for ( ; m < n - 1; ++m) {
+                    if (std::abs(e[m]) <= eps * (std::abs(d[m]) + std::abs(d[m + 1])))
+                        break;
+                }
+
+                if (m == l)
+                    break;
+
+                if (iteration == MaxIterations)
+                    return false;
+
+                DataType g = (d[l + 1] - d[l]) / (2 * e[l]);
+                DataType r = std::hypot(g, DataType(1));
+                g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+
+                DataType s = 1, c = 1, p = 0;
+                int i = m - 1;
+                for ( ; i >= l; --i) {
+                    const DataType f = s * e[i];
+                    const DataType b = c * e[i];
+
+                    r = std::hypot(f, g);
+                    e[i + 1] = r;
+                    if (r == 0) { // underflow, deflate and restart
+                        d[i + 1] -= p;
+                        e[m] = 0;
+                        break;
+                    }
+
+                    s = f / r;
+                    c = g / r;
+                    g = d[i + 1] - p;
+                    r = (d[i] - g) * s + 2 * c * b;
+                    p = s * r;
+                    d[i + 1] = g + p;
+                    g = c * r - b;
+
+                    if (z != nullptr)
+                        rotations.push_back(Rotation{i, c, s});
+                }
+
+                if (z != nullptr && static_cast<int>(rotations.size()) >= 3 * n)
+                    apply_rotations(rotations, z, n, num_threads);
+
+                if (r == 0 && i >= l)
+                    continue;
+
+                d[l] -= p;
+                e[l] = g;
+                e[m] = 0;
+            }
+        }
+
+        if (z != nullptr && !rotations.empty())
+            apply_rotations(rotations, z, n, num_threads);
+
+        return true;
+    }
+};
+
+template <typename DataType>
+constexpr int OptimizedSymmetricEigen<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::BlockSize;
+template <typename DataType>
+constexpr int OptimizedSymmetricEigen<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::RowBlock;
+template <typename DataType>
+constexpr int OptimizedSymmetricEigen<DataType, typename std::enable_if<std::is_floating_point<DataType>::value>::type>::ColumnBlock;
+
+} // namespace detail
+
+TEST_CASE_TEMPLATE("symmetric_eigen()", T, test_float_data_types)
+{
+    const T tolerance = std::is_same<T, float>::value ? T(2e-4) : T(1e-10);
+
+    { // 3x3 case, only the upper triangle is read
+        T data[9] = {2, 0, 0, 100, 3, 4, 100, 100, 9};
+        T expected[3] = {1, 2, 11};
+
+        SymmetricEigen<T> result = symmetric_eigen(Tensor<T>(Shape{3, 3}, AlignedPtr<T>(data, 9)));
+        REQUIRE((approx_equal(result.values, Tensor<T>(Shape{3}, AlignedPtr<T>(expected, 3)))));
+
+        REQUIRE(std::abs(std::abs(result.vectors.data[0 * 3 + 1]) - 1) <= tolerance);
+        REQUIRE(std::abs(result.vectors.data[1 * 3 + 1]) <= tolerance);
+        REQUIRE(std::abs(result.vectors.data[2 * 3 + 1]) <= tolerance);
+    }
+
+    { // Known spectrum Q diag(lambda) Q^T from two Householder reflections,
+      // with sizes around the panel width and a repeated eigenvalue
+        for (int n : {1, 2, 3, 31, 32, 33, 100, 200}) {
+            std::mt19937 generator(n);
+            std::uniform_real_distribution<T> distribution(-1, 1);
+
+            std::vector<T> lambda(n), u(n), v(n);
+            for (int i = 0; i < n; ++i) {
+                lambda[i] = distribution(generator) * 10;
+                u[i] = distribution(generator);
+                v[i] = distribution(generator);
+            }
+            if (n > 3)
+                lambda[1] = lambda[2];
+
+            T u_norm = 0, v_norm = 0;
+            for (int i = 0; i < n; ++i) {
+                u_norm += u[i] * u[i];
+                v_norm += v[i] * v[i];
+            }
+
+            // Q = (I - 2 u u^T / u^T u) (I - 2 v v^T / v^T v)
+            std::vector<T> Q(n * n);
+            for (int r = 0; r < n; ++r) {
+                for (int c = 0; c < n; ++c) {
+                    T sum = 0;
+                    for (int k = 0; k < n; ++k)
+                        sum += ((r == k) - 2 * u[r] * u[k] / u_norm) * ((k == c) - 2 * v[k] * v[c] / v_norm);
+                    Q[r * n + c] = sum;
+                }
+            }
+
+            Tensor<T> A(Shape{n, n});
+            for (int r = 0; r < n; ++r) {
+                for (int c = 0; c < n; ++c) {
+                    T sum = 0;
+                    for (int k = 0; k < n; ++k)
+                        sum += Q[r * n + k] * lambda[k] * Q[c * n + k];
+                    A.data[r * n + c] = sum;
+                }
+            }
+
+            SymmetricEigen<T> result = symmetric_eigen(A, 1);
+            REQUIRE(result.values.shape == Shape{n});
+            REQUIRE(result.vectors.shape == (Shape{n, n}));
+
+            std::sort(lambda.begin(), lambda.end());
+            for (int i = 0; i < n; ++i)
+                REQUIRE(std::abs(result.values.data[i] - lambda[i]) <= 10 * tolerance);
+
+            const Tensor<T>& X = result.vectors;
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    // X^T X = I
+                    T dot = 0;
+                    for (int r = 0; r < n; ++r)
+                        dot += X.data[r * n + i] * X.data[r * n + j];
+                    REQUIRE(std::abs(dot - (i == j)) <= tolerance);
+
+                    // A X = X diag(values)
+                    T ax = 0;
+                    for (int k = 0; k < n; ++k)
+                        ax += A.data[i * n + k] * X.data[k * n + j];
+                    REQUIRE(std::abs(ax - X.data[i * n + j] * result.values.data[j]) <= 10 * tolerance);
+                }
+            }
+
+            REQUIRE(symmetric_eigenvalues(A, 1) == result.values);
+
+            // Blocks of rows and columns are fixed, so threads do not change
+            // the result
+            SymmetricEigen<T> threaded = symmetric_eigen(A, 3);
+            REQUIRE(threaded.values == result.values);
+            REQUIRE(threaded.vectors == result.vectors);
+        }
+    }
+
+    { // Diagonal and zero matrices are already reduced
+        Tensor<T> A = zeros<T>(Shape{40, 40});
+        REQUIRE(symmetric_eigenvalues(A) == zeros<T>(Shape{40}));
+
+        for (int i = 0; i < 40; ++i)
+            A.data[i * 40 + i] = T(39 - i);
+
+        SymmetricEigen<T> result = symmetric_eigen(A);
+        for (int i = 0; i < 40; ++i) {
+            REQUIRE(result.values.data[i] == T(i));
+            REQUIRE(std::abs(result.vectors.data[(39 - i) * 40 + i]) == T(1));
+        }
+    }
+
+    { // The QL iterations cannot converge on NaN
+        Tensor<T> A = zeros<T>(Shape{8, 8});
+        A.data[1] = A.data[8] = std::numeric_limits<T>::quiet_NaN();
+
+        REQUIRE_THROWS((symmetric_eigen(A)));
+        REQUIRE_THROWS((symmetric_eigenvalues(A)));
+    }
+
+    REQUIRE_THROWS((symmetric_eigen(Tensor<T>(Shape{3, 4}))));
+    REQUIRE_THROWS((symmetric_eigenvalues(Tensor<T>(Shape{2, 2, 2}))));
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_SYMMETRIC_EIGEN_IMPL_HPP
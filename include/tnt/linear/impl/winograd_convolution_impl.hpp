@@ -0,0 +1,342 @@
+#ifndef TNT_LINEAR_WINOGRAD_CONVOLUTION_IMPL_HPP
+#define TNT_LINEAR_WINOGRAD_CONVOLUTION_IMPL_HPP
+
+#include <tnt/linear/convolution.hpp>
+#include <tnt/linear/impl/matrix_multiply_impl.hpp>
+#include <tnt/linear/impl/blas1_impl.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Transform matrices of Winograd's minimal filtering algorithm
+/// F(OutputTile x OutputTile, 3x3), from Lavin and Gray, "Fast Algorithms for
+/// Convolutional Neural Networks". An `Alpha x Alpha` input tile `d` and a
+/// 3x3 filter `g` give the `OutputTile x OutputTile` output
+/// `A^T [(G g G^T) * (B^T d B)] A`. All matrices are row-major.
+template <int OutputTile>
+struct WinogradMatrices {};
+
+template <> struct WinogradMatrices<2>
+{
+    constexpr static int Alpha = 4;
+
+    /// B^T, Alpha x Alpha
+    static const double* input()
+    {
+        static const double values[16] = {1,  0, -1,  0,
+                                          0,  1,  1,  0,
+                                          0, -1,  1,  0,
+                                          0,  1,  0, -1};
+        return values;
+    }
+
+    /// G, Alpha x 3
+    static const double* filter()
+    {
+        static const double values[12] = {1,    0,   0,
+                                          0.5,  0.5, 0.5,
+                                          0.5, -0.5, 0.5,
+                                          0,    0,   1};
+        return values;
+    }
+
+    /// A^T, OutputTile x Alpha
+    static const double* output()
+    {
+        static const double values[8] = {1, 1,  1,  0,
+                                         0, 1, -1, -1};
+        return values;
+    }
+};
+
+template <> struct WinogradMatrices<4>
+{
+    constexpr static int Alpha = 6;
+
+    static const double* input()
+    {
+        static const double values[36] = {4,  0, -5,  0, 1, 0,
+                                          0, -4, -4,  1, 1, 0,
+                                          0,  4, -4, -1, 1, 0,
+                                          0, -2, -1,  2, 1, 0,
+                                          0,  2, -1, -2, 1, 0,
+                                          0,  4,  0, -5, 0, 1};
+        return values;
+    }
+
+    static const double* filter()
+    {
+        static const double values[18] = { 1. / 4,   0,        0,
+                                          -1. / 6,  -1. / 6,  -1. / 6,
+                                          -1. / 6,   1. / 6,  -1. / 6,
+                                           1. / 24,  1. / 12,  1. / 6,
+                                           1. / 24, -1. / 12,  1. / 6,
+                                           0,        0,        1};
+        return values;
+    }
+
+    static const double* output()
+    {
+        static const double values[24] = {1, 1,  1, 1,  1, 0,
+                                          0, 1, -1, 2, -2, 0,
+                                          0, 1,  1, 4,  4, 0,
+                                          0, 1, -1, 8, -8, 1};
+        return values;
+    }
+};
+
+/// Tiles are transformed for all channels (or kernels) at once. With HWC
+/// input every element of a tile is a contiguous run of channels, so each
+/// step of a transform is a SIMD multiply-add over that run. The transformed
+/// tiles of a block form `Alpha^2` independent `tiles x C` matrices which are
+/// multiplied with the `C x K` transformed filters by the packed GEMM.
+template <typename DataType, int OutputTile>
+struct OptimizedWinogradConvolution<DataType, OutputTile,
+            typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using Matrices = WinogradMatrices<OutputTile>;
+    using Multiply = OptimizedMatrixMultiply<DataType>;
+
+    constexpr static int Alpha  = Matrices::Alpha;
+    constexpr static int Points = Alpha * Alpha;
+
+    constexpr static int BlockElements = 1 << 17;
+
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor, const Tensor<DataType>& kernel, int pad, DataType pad_value)
+    {
+        const int kernel_axis = kernel.shape.num_axes() - 3;
+
+        const int height      = tensor.shape[0];
+        const int width       = tensor.shape[1];
+        const int channels    = tensor.shape[2];
+        const int num_kernels = kernel_axis == 1 ? kernel.shape[0] : 1;
+        const int out_rows    = height + 2 * pad - 2;
+        const int out_cols    = width  + 2 * pad - 2;
+
+        const int tile_rows = (out_rows + OutputTile - 1) / OutputTile;
+        const int tile_cols = (out_cols + OutputTile - 1) / OutputTile;
+        const int tiles     = tile_rows * tile_cols;
+        const int block     = std::max(1, std::min(tiles, BlockElements / (Points * (channels + num_kernels))));
+
+        Tensor<DataType> output(Shape{out_rows, out_cols, num_kernels});
+
+        AlignedPtr<DataType> filters = transform_filters(kernel.data.data, channels, num_kernels);
+
+        AlignedPtr<DataType> inputs(Points * block * channels);
+        AlignedPtr<DataType> products(Points * block * num_kernels);
+        AlignedPtr<DataType> scratch(2 * Points * std::max(channels, num_kernels));
+
+        for (int first = 0; first < tiles; first += block) {
+            const int count = std::min(block, tiles - first);
+
+            for (int t = 0; t < count; ++t) {
+                const int top  = ((first + t) / tile_cols) * OutputTile - pad;
+                const int left = ((first + t) % tile_cols) * OutputTile - pad;
+
+                gather(tensor.data.data, height, width, channels, top, left, pad_value, scratch.data);
+                transform_input(scratch.data, channels, inputs.data + t * channels, block * channels);
+            }
+
+            std::fill(products.data, products.data + Points * block * num_kernels, DataType(0));
+            for (int point = 0; point < Points; ++point) {
+                Multiply::gemm(count, num_kernels, channels,
+                               inputs.data + point * block * channels, channels,
+                               filters.data + point * channels * num_kernels, num_kernels,
+                               products.data + point * block * num_kernels, num_kernels);
+            }
+
+            for (int t = 0; t < count; ++t) {
+                const int row = ((first + t) / tile_cols) * OutputTile;
+                const int col = ((first + t) % tile_cols) * OutputTile;
+
+                transform_output(products.data + t * num_kernels, block * num_kernels, num_kernels, scratch.data);
+                scatter(scratch.data, num_kernels, row, col, out_rows, out_cols, output.data.data);
+            }
+        }
+
+        return output;
+    }
+
+private:
+    /// `Alpha^2` matrices of `C x K` holding `G g G^T` of every kernel and
+    /// channel, computed once per call and shared by all tiles
+    static AlignedPtr<DataType> transform_filters(const DataType* kernel, int channels, int num_kernels)
+    {
+        const double* G = Matrices::filter();
+
+        AlignedPtr<DataType> filters(Points * channels * num_kernels);
+        for (int k = 0; k < num_kernels; ++k) {
+            for (int c = 0; c < channels; ++c) {
+                const DataType* g = kernel + k * 9 * channels + c;
+
+                double half[Alpha][3];
+                for (int i = 0; i < Alpha; ++i)
+                    for (int j = 0; j < 3; ++j)
+                        half[i][j] = G[i * 3] * g[j * channels] + G[i * 3 + 1] * g[(3 + j) * channels]
+                                   + G[i * 3 + 2] * g[(6 + j) * channels];
+
+                for (int i = 0; i < Alpha; ++i)
+                    for (int j = 0; j < Alpha; ++j)
+                        filters.data[((i * Alpha + j) * channels + c) * num_kernels + k]
+                            = static_cast<DataType>(half[i][0] * G[j * 3] + half[i][1] * G[j * 3 + 1] + half[i][2] * G[j * 3 + 2]);
+            }
+        }
+
+        return filters;
+    }
+
+    /// Copy an `Alpha x Alpha x C` input tile, filling positions outside the
+    /// tensor with the pad value
+    static void gather(const DataType* input, int height, int width, int channels,
+                       int top, int left, DataType pad_value, DataType* tile)
+    {
+        for (int i = 0; i < Alpha; ++i) {
+            for (int j = 0; j < Alpha; ++j, tile += channels) {
+                const int row = top + i, col = left + j;
+                if (row < 0 || row >= height || col < 0 || col >= width) {
+                    std::fill(tile, tile + channels, pad_value);
+                } else {
+                    const DataType* src = input + (row * width + col) * channels;
+                    std::copy(src, src + channels, tile);
+                }
+            }
+        }
+    }
+
+    /// `B^T d B`. Point `(i, j)` of the result is written at
+    /// `inputs + (i * Alpha + j) * point_stride`.
+    static void transform_input(DataType* tile, int channels, DataType* inputs, int point_stride)
+    {
+        const double* BT = Matrices::input();
+        DataType* half = tile + Points * channels;
+
+        for (int i = 0; i < Alpha; ++i)
+            for (int j = 0; j < Alpha; ++j)
+                combine(BT + i * Alpha, 1, tile + j * channels, Alpha * channels, Alpha,
+                        half + (i * Alpha + j) * channels, channels);
+
+        for (int i = 0; i < Alpha; ++i)
+            for (int j = 0; j < Alpha; ++j)
+                combine(BT + j * Alpha, 1, half + i * Alpha * channels, channels, Alpha,
+                        inputs + (i * Alpha + j) * point_stride, channels);
+    }
+
+    /// `A^T M A` into an `OutputTile x OutputTile x K` tile
+    static void transform_output(const DataType* products, int point_stride, int num_kernels, DataType* tile)
+    {
+        const double* AT = Matrices::output();
+        DataType* half = tile + OutputTile * OutputTile * num_kernels;
+
+        for (int i = 0; i < OutputTile; ++i)
+            for (int j = 0; j < Alpha; ++j)
+                combine(AT + i * Alpha, 1, products + j * point_stride, Alpha * point_stride, Alpha,
+                        half + (i * Alpha + j) * num_kernels, num_kernels);
+
+        for (int i = 0; i < OutputTile; ++i)
+            for (int j = 0; j < OutputTile; ++j)
+                combine(AT + j * Alpha, 1, half + i * Alpha * num_kernels, num_kernels, Alpha,
+                        tile + (i * OutputTile + j) * num_kernels, num_kernels);
+    }
+
+    /// Copy the part of an output tile that lies inside the output
+    static void scatter(const DataType* tile, int num_kernels, int row, int col, int out_rows, int out_cols, DataType* output)
+    {
+        const int rows = std::min(OutputTile, out_rows - row);
+        const int cols = std::min(OutputTile, out_cols - col);
+
+        for (int i = 0; i < rows; ++i) {
+            const DataType* src = tile + i * OutputTile * num_kernels;
+            std::copy(src, src + cols * num_kernels, output + ((row + i) * out_cols + col) * num_kernels);
+        }
+    }
+
+    /// `dst = sum_k coefficients[k * coefficient_stride] * sources[k * source_stride]`
+    /// over rows of `length` values. Zero coefficients, which are common in
+    /// the transform matrices, are skipped.
+    static void combine(const double* coefficients, int coefficient_stride,
+                        const DataType* sources, int source_stride, int count,
+                        DataType* dst, int length)
+    {
+        std::fill(dst, dst + length, DataType(0));
+
+        for (int k = 0; k < count; ++k) {
+            const DataType coefficient = static_cast<DataType>(coefficients[k * coefficient_stride]);
+            if (coefficient != 0)
+                multiply_add_row(coefficient, sources + k * source_stride, dst, length);
+        }
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("OptimizedWinogradConvolution<T, OutputTile>::eval()", T, test_float_data_types)
+{
+    // Each output is checked against a long double direct sum, relative to
+    // the sum of the magnitudes of its terms
+    auto test_conv = [](const Shape& shape, int num_kernels, int pad, T pad_value) {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<T> distribution(-1, 1);
+
+        Tensor<T> tensor(shape), kernel(Shape{num_kernels, 3, 3, shape[2]});
+        for (int i = 0; i < tensor.shape.total(); ++i)
+            tensor.data[i] = distribution(generator);
+        for (int i = 0; i < kernel.shape.total(); ++i)
+            kernel.data[i] = distribution(generator);
+
+        Tensor<T> small = detail::OptimizedWinogradConvolution<T, 2>::eval(tensor, kernel, pad, pad_value);
+        Tensor<T> large = detail::OptimizedWinogradConvolution<T, 4>::eval(tensor, kernel, pad, pad_value);
+
+        const int height = shape[0], width = shape[1], channels = shape[2];
+        REQUIRE((small.shape == Shape{height + 2 * pad - 2, width + 2 * pad - 2, num_kernels}));
+        REQUIRE((large.shape == small.shape));
+
+        double worst = 0;
+        for (int y = 0; y < small.shape[0]; ++y) {
+            for (int x = 0; x < small.shape[1]; ++x) {
+                for (int k = 0; k < num_kernels; ++k) {
+                    long double sum = 0, magnitude = 0;
+                    for (int ky = 0; ky < 3; ++ky) {
+                        for (int kx = 0; kx < 3; ++kx) {
+                            const int row = y - pad + ky, col = x - pad + kx;
+                            for (int c = 0; c < channels; ++c) {
+                                const T value = (row < 0 || row >= height || col < 0 || col >= width)
+                                              ? pad_value : tensor.data[(row * width + col) * channels + c];
+                                const long double term = (long double) value * kernel.data[((k * 3 + ky) * 3 + kx) * channels + c];
+                                sum += term;
+                                magnitude += std::fabs(term);
+                            }
+                        }
+                    }
+
+                    const int index = (y * small.shape[1] + x) * num_kernels + k;
+                    worst = std::max(worst, (double) (std::fabs(small.data[index] - sum) / magnitude));
+                    worst = std::max(worst, (double) (std::fabs(large.data[index] - sum) / magnitude));
+                }
+            }
+        }
+
+        REQUIRE(worst <= 64 * std::numeric_limits<T>::epsilon());
+    };
+
+    test_conv(Shape{3, 3, 1},    1,  0, 0);
+    test_conv(Shape{8, 8, 4},    3,  1, 0);
+    test_conv(Shape{13, 10, 9},  17, 1, 0.5);
+    test_conv(Shape{7, 19, 3},   2,  0, 0);
+    test_conv(Shape{40, 33, 16}, 24, 1, -1);  // Several tile blocks
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_WINOGRAD_CONVOLUTION_IMPL_HPP
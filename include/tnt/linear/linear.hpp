@@ -2,9 +2,20 @@
 #define TNT_LINEAR_HPP
 
 #include <tnt/linear/impl/dot_impl.hpp>
+#include <tnt/linear/impl/blas1_impl.hpp>
 #include <tnt/linear/impl/matrix_multiply_impl.hpp>
 #include <tnt/linear/impl/eigen_impl.hpp>
+#include <tnt/linear/impl/symmetric_eigen_impl.hpp>
+#include <tnt/linear/impl/batched_eigen_impl.hpp>
+#include <tnt/linear/impl/eigenvalues_topk_impl.hpp>
+#include <tnt/linear/impl/decomposition_impl.hpp>
+#include <tnt/linear/impl/svd_impl.hpp>
+#include <tnt/linear/impl/winograd_convolution_impl.hpp>
+#include <tnt/linear/impl/fourier_transform_impl.hpp>
+#include <tnt/linear/impl/fft_convolution_impl.hpp>
 #include <tnt/linear/impl/convolution_3d_impl.hpp>
-//#include <tnt/linear/impl/discrete_cosine_transform.hpp>
+#include <tnt/linear/impl/depthwise_convolution_impl.hpp>
+#include <tnt/linear/impl/separable_filter_impl.hpp>
+#include <tnt/linear/impl/discrete_cosine_transform_impl.hpp>
 
 #endif // TNT_LINEAR_HPP
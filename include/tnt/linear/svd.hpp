@@ -0,0 +1,106 @@
+#ifndef TNT_LINEAR_SVD_HPP
+#define TNT_LINEAR_SVD_HPP
+
+#include <tnt/core/tensor.hpp>
+
+namespace tnt
+{
+
+/// \brief The result of an [svd](tnt::svd) or
+/// [truncated_svd](tnt::truncated_svd), `A = U diag(s) V^T`
+///
+/// For an `m x n` matrix and `p` singular values, [u](*::u) is `m x p` and
+/// [v](*::v) is `n x p`, both with orthonormal columns, and [s](*::s) holds
+/// the singular values sorted from largest to smallest.
+template <typename DataType>
+struct TNT_EXPORT SVD
+{
+    Tensor<DataType> u;
+    Tensor<DataType> s;
+    Tensor<DataType> v;
+};
+
+namespace detail
+{
+
+template <typename DataType, typename Enable = void>
+struct OptimizedSVD
+{
+    static SVD<DataType> eval(const Tensor<DataType>&, int);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedTruncatedSVD
+{
+    static SVD<DataType> eval(const Tensor<DataType>&, int, int, int);
+};
+
+} // namespace detail
+
+/// \brief Thin singular value decomposition
+///
+/// \param tensor A 2D floating point tensor of size `m x n`
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns All `p = min(m, n)` singular values with `U` (`m x p`) and `V`
+/// (`n x p`)
+/// \requires Type `DataType` shall be floating
+/// \requires Parameter [tensor](*::tensor) shall be 2D
+/// \notes Uses one-sided Jacobi, which finds small singular values to high
+/// relative accuracy and suits small and medium matrices. A tall matrix is
+/// first reduced to its square `R` factor with [qr](). The rotations of a
+/// sweep are grouped into rounds of disjoint column pairs, which larger
+/// matrices spread over threads with the same result. This function asserts
+/// that [tensor](*::tensor) is 2D and will throw an exception if it is not.
+/// This check can be disabled by `#define DISABLE_CHECKS` before calling the
+/// function.
+template <typename DataType>
+inline SVD<DataType> svd(const Tensor<DataType>& tensor, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value, "svd() requires floating point data");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 2,
+               InvalidParameterException("tnt::svd()", __FILE__, __LINE__,
+                   "Singular value decomposition requires a two dimensional matrix"))
+
+    return detail::OptimizedSVD<DataType>::eval(tensor, num_threads);
+}
+
+/// \brief The `k` largest singular values and their vectors
+///
+/// \param tensor A 2D floating point tensor of size `m x n`
+/// \param k The number of singular values, at most `min(m, n)`
+/// \param power_iterations Multiplications by `A A^T` that sharpen the
+/// sampled range when the singular values decay slowly
+/// \param num_threads The number of threads, or 0 for one per hardware thread
+/// \returns `k` singular values with `U` (`m x k`) and `V` (`n x k`)
+/// \requires Type `DataType` shall be floating
+/// \requires Parameter [tensor](*::tensor) shall be 2D
+/// \notes Randomized range finding: `A` is multiplied by a block of
+/// `k + max(k, 10)` random vectors, the block is orthonormalized with [qr]()
+/// and the small projection `Q^T A` is decomposed with [svd](). Every product
+/// with `A` is a matrix multiplication split over threads, so the cost is
+/// `O(m n k)` instead of the `O(m n min(m, n))` of the full decomposition. The
+/// random vectors are seeded from the shape, so results are reproducible. This
+/// function asserts that [tensor](*::tensor) is 2D and that `k` and
+/// `power_iterations` are in range, and will throw an exception if they are
+/// not. These checks can be disabled by `#define DISABLE_CHECKS` before
+/// calling the function.
+template <typename DataType>
+inline SVD<DataType> truncated_svd(const Tensor<DataType>& tensor, int k, int power_iterations = 2, int num_threads = 0)
+{
+    static_assert(std::is_floating_point<DataType>::value, "truncated_svd() requires floating point data");
+
+    TNT_ASSERT(tensor.shape.num_axes() == 2,
+               InvalidParameterException("tnt::truncated_svd()", __FILE__, __LINE__,
+                   "Singular value decomposition requires a two dimensional matrix"))
+
+    TNT_ASSERT(k >= 1 && k <= std::min(tensor.shape[0], tensor.shape[1]) && power_iterations >= 0,
+               InvalidParameterException("tnt::truncated_svd()", __FILE__, __LINE__,
+                   "The number of singular values must be between 1 and the smaller dimension"))
+
+    return detail::OptimizedTruncatedSVD<DataType>::eval(tensor, k, power_iterations, num_threads);
+}
+
+} // namespace tnt
+
+#endif // TNT_LINEAR_SVD_HPP
@@ -2,6 +2,9 @@
 #define TNT_MATH_ARITHMETIC_OPS_HPP
 
 #include <tnt/core/tensor.hpp>
+#include <tnt/core/conversion.hpp>
+
+#include <type_traits>
 
 namespace tnt
 {
@@ -53,6 +56,67 @@ struct OptimizedDivide
     static void eval(Tensor<LeftType>&, const Tensor<RightType>&) noexcept;
 };
 
+template <
+          typename LeftType,
+          typename RightType,
+          typename Enable = void
+         >
+struct OptimizedMinimum
+{
+    static void eval(Tensor<LeftType>&, const RightType&) noexcept;
+    static void eval(Tensor<LeftType>&, const Tensor<RightType>&) noexcept;
+};
+
+template <
+          typename LeftType,
+          typename RightType,
+          typename Enable = void
+         >
+struct OptimizedMaximum
+{
+    static void eval(Tensor<LeftType>&, const RightType&) noexcept;
+    static void eval(Tensor<LeftType>&, const Tensor<RightType>&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedClamp
+{
+    static void eval(Tensor<DataType>&, const DataType&, const DataType&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedAbs
+{
+    static void eval(Tensor<DataType>&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedNegate
+{
+    static void eval(Tensor<DataType>&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedAddSaturate
+{
+    static void eval(Tensor<DataType>&, const DataType&) noexcept;
+    static void eval(Tensor<DataType>&, const Tensor<DataType>&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedSubtractSaturate
+{
+    static void eval(Tensor<DataType>&, const DataType&) noexcept;
+    static void eval(Tensor<DataType>&, const Tensor<DataType>&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedMultiplySaturate
+{
+    static void eval(Tensor<DataType>&, const DataType&) noexcept;
+    static void eval(Tensor<DataType>&, const Tensor<DataType>&) noexcept;
+};
+
 } // namespace detail
 
 /// \brief Add a scalar to a tensor elementwise
@@ -160,7 +224,7 @@ inline void multiply(Tensor<LeftType>& left, const Tensor<RightType>& right)
 template <typename LeftType, typename RightType>
 inline void divide(Tensor<LeftType>& tensor, const RightType& scalar)
 {
-    TNT_ASSERT(scalar != 0,
+    TNT_ASSERT(scalar != RightType(0),
                InvalidParameterException("tnt::divide()", __FILE__, __LINE__,
                    "Cannot divide by 0"))
 
@@ -187,6 +251,213 @@ inline void divide(Tensor<LeftType>& left, const Tensor<RightType>& right)
     detail::OptimizedDivide<LeftType, RightType>::eval(left, right);
 }
 
+/// \brief Replace each element of a tensor with the smaller of itself and a
+/// scalar
+///
+/// The minimum is computed in place on the tensor
+/// \param tensor A mutable tensor. The minimum is taken in-place
+/// \param scalar A scalar
+template <typename LeftType, typename RightType>
+inline void minimum(Tensor<LeftType>& tensor, const RightType& scalar) noexcept
+{
+    detail::OptimizedMinimum<LeftType, RightType>::eval(tensor, scalar);
+}
+
+/// \brief Take the elementwise minimum of two tensors
+///
+/// The minimum is computed in place on the left tensor.
+/// \param left A mutable tensor. The minimum is taken in-place
+/// \param right An immutable tensor of the same size and type as [left](*::left).
+/// \requires [left](*::left) and [right](*::right) shall have the same shape
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline void minimum(Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::minimum()", __FILE__, __LINE__,
+                   "Element-wise minimum of two tensors requires that those tensors be of the same size"))
+
+    detail::OptimizedMinimum<DataType, DataType>::eval(left, right);
+}
+
+/// \brief Replace each element of a tensor with the larger of itself and a
+/// scalar
+///
+/// The maximum is computed in place on the tensor
+/// \param tensor A mutable tensor. The maximum is taken in-place
+/// \param scalar A scalar
+template <typename LeftType, typename RightType>
+inline void maximum(Tensor<LeftType>& tensor, const RightType& scalar) noexcept
+{
+    detail::OptimizedMaximum<LeftType, RightType>::eval(tensor, scalar);
+}
+
+/// \brief Take the elementwise maximum of two tensors
+///
+/// The maximum is computed in place on the left tensor.
+/// \param left A mutable tensor. The maximum is taken in-place
+/// \param right An immutable tensor of the same size and type as [left](*::left).
+/// \requires [left](*::left) and [right](*::right) shall have the same shape
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline void maximum(Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::maximum()", __FILE__, __LINE__,
+                   "Element-wise maximum of two tensors requires that those tensors be of the same size"))
+
+    detail::OptimizedMaximum<DataType, DataType>::eval(left, right);
+}
+
+/// \brief Clamp every element of a tensor to a range
+///
+/// The clamp is computed in place on the tensor
+/// \param tensor A mutable tensor. The clamp is done in-place
+/// \param low The smallest value in the result
+/// \param high The largest value in the result
+/// \notes This function asserts that `low <= high` and will throw an
+/// exception if it is not. This check can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType, typename LowType, typename HighType>
+inline void clamp(Tensor<DataType>& tensor, const LowType& low, const HighType& high)
+{
+    TNT_ASSERT(static_cast<DataType>(low) <= static_cast<DataType>(high),
+               InvalidParameterException("tnt::clamp()", __FILE__, __LINE__,
+                   "clamp() requires low <= high"))
+
+    detail::OptimizedClamp<DataType>::eval(tensor, static_cast<DataType>(low), static_cast<DataType>(high));
+}
+
+/// \brief Take the absolute value of a tensor elementwise
+///
+/// The absolute value is computed in place on the tensor
+/// \param tensor A mutable tensor. The absolute value is taken in-place
+/// \notes Unsigned tensors are left unchanged. For signed integers the
+/// absolute value of the smallest representable value wraps to itself.
+template <typename DataType>
+inline void abs(Tensor<DataType>& tensor) noexcept
+{
+    detail::OptimizedAbs<DataType>::eval(tensor);
+}
+
+/// \brief Negate a tensor elementwise
+///
+/// The negation is computed in place on the tensor
+/// \param tensor A mutable tensor. Negation is done in-place
+/// \notes Unsigned tensors wrap, so each element `x` becomes `0 - x` modulo
+/// the range of the type.
+template <typename DataType>
+inline void negate(Tensor<DataType>& tensor) noexcept
+{
+    detail::OptimizedNegate<DataType>::eval(tensor);
+}
+
+/// \brief Add a scalar to a tensor elementwise, saturating instead of
+/// wrapping on overflow
+///
+/// The addition is computed in place on the tensor
+/// \param tensor A mutable tensor. Addition is done in-place
+/// \param scalar A scalar. It is first [saturated](tnt::saturate_cast) to
+/// the range of `DataType`.
+/// \requires Type `DataType` is an 8 or 16 bit integer type
+template <typename DataType, typename ScalarType>
+inline void add_saturate(Tensor<DataType>& tensor, const ScalarType& scalar) noexcept
+{
+    detail::OptimizedAddSaturate<DataType>::eval(tensor, saturate_cast<DataType>(scalar));
+}
+
+/// \brief Add a tensor to a tensor elementwise, saturating instead of
+/// wrapping on overflow
+///
+/// The addition is computed in place on the left tensor.
+/// \param left A mutable tensor. Addition is done in-place
+/// \param right An immutable tensor of the same size and type as [left](*::left).
+/// \requires Type `DataType` is an 8 or 16 bit integer type
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline void add_saturate(Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::add_saturate()", __FILE__, __LINE__,
+                   "Element-wise addition of two tensors requires that those tensors be of the same size"))
+
+    detail::OptimizedAddSaturate<DataType>::eval(left, right);
+}
+
+/// \brief Subtract a scalar from a tensor elementwise, saturating instead of
+/// wrapping on overflow
+///
+/// The subtraction is computed in place on the tensor
+/// \param tensor A mutable tensor. Subtraction is done in-place
+/// \param scalar A scalar. It is first [saturated](tnt::saturate_cast) to
+/// the range of `DataType`.
+/// \requires Type `DataType` is an 8 or 16 bit integer type
+template <typename DataType, typename ScalarType>
+inline void subtract_saturate(Tensor<DataType>& tensor, const ScalarType& scalar) noexcept
+{
+    detail::OptimizedSubtractSaturate<DataType>::eval(tensor, saturate_cast<DataType>(scalar));
+}
+
+/// \brief Subtract a tensor from a tensor elementwise, saturating instead of
+/// wrapping on overflow
+///
+/// The subtraction is computed in place on the left tensor.
+/// \param left A mutable tensor. Subtraction is done in-place
+/// \param right An immutable tensor of the same size and type as [left](*::left).
+/// \requires Type `DataType` is an 8 or 16 bit integer type
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline void subtract_saturate(Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::subtract_saturate()", __FILE__, __LINE__,
+                   "Element-wise subtraction of two tensors requires that those tensors be of the same size"))
+
+    detail::OptimizedSubtractSaturate<DataType>::eval(left, right);
+}
+
+/// \brief Multiply a tensor by a scalar elementwise, saturating instead of
+/// wrapping on overflow
+///
+/// The multiplication is computed in place on the tensor
+/// \param tensor A mutable tensor. Multiplication is done in-place
+/// \param scalar A scalar. It is first [saturated](tnt::saturate_cast) to
+/// the range of `DataType`.
+/// \requires Type `DataType` is an 8 or 16 bit integer type
+template <typename DataType, typename ScalarType>
+inline void multiply_saturate(Tensor<DataType>& tensor, const ScalarType& scalar) noexcept
+{
+    detail::OptimizedMultiplySaturate<DataType>::eval(tensor, saturate_cast<DataType>(scalar));
+}
+
+/// \brief Multiply a tensor with a tensor elementwise, saturating instead of
+/// wrapping on overflow
+///
+/// The multiplication is computed in place on the left tensor.
+/// \param left A mutable tensor. Multiplication is done in-place
+/// \param right An immutable tensor of the same size and type as [left](*::left).
+/// \requires Type `DataType` is an 8 or 16 bit integer type
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline void multiply_saturate(Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::multiply_saturate()", __FILE__, __LINE__,
+                   "Element-wise multiplication of two tensors requires that those tensors be of the same size"))
+
+    detail::OptimizedMultiplySaturate<DataType>::eval(left, right);
+}
+
 } // namespace tnt
 
 #endif // TNT_MATH_ARITHMETIC_OPS_HPP
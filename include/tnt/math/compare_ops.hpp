@@ -2,10 +2,24 @@
 #define TNT_MATH_COMPARE_OPS_HPP
 
 #include <tnt/core/tensor.hpp>
+#include <tnt/core/bit_mask.hpp>
 
 namespace tnt
 {
 
+/// \brief The elementwise predicates of the compare operations. Used to
+/// select the predicate of fused compare and reduce functions such as
+/// [count_if](tnt::count_if).
+enum class Comparison
+{
+    Equal,
+    NotEqual,
+    LessThan,
+    GreaterThan,
+    LessOrEqual,
+    GreaterOrEqual
+};
+
 namespace detail
 {
 
@@ -13,36 +27,48 @@ template <typename LeftType, typename RightType, typename Enable = void>
 struct OptimizedCompareEqual
 {
     static Tensor<uint8_t> eval(const Tensor<LeftType>&, const RightType&);
+    static Tensor<uint8_t> eval(const Tensor<LeftType>&, const Tensor<RightType>&);
+    static BitMask eval_bits(const Tensor<LeftType>&, const RightType&);
 };
 
 template <typename LeftType, typename RightType, typename Enable = void>
 struct OptimizedCompareNotEqual
 {
     static Tensor<uint8_t> eval(const Tensor<LeftType>&, const RightType&);
+    static Tensor<uint8_t> eval(const Tensor<LeftType>&, const Tensor<RightType>&);
+    static BitMask eval_bits(const Tensor<LeftType>&, const RightType&);
 };
 
 template <typename LeftType, typename RightType, typename Enable = void>
 struct OptimizedCompareLessThan
 {
     static Tensor<uint8_t> eval(const Tensor<LeftType>&, const RightType&);
+    static Tensor<uint8_t> eval(const Tensor<LeftType>&, const Tensor<RightType>&);
+    static BitMask eval_bits(const Tensor<LeftType>&, const RightType&);
 };
 
 template <typename LeftType, typename RightType, typename Enable = void>
 struct OptimizedCompareGreaterThan
 {
     static Tensor<uint8_t> eval(const Tensor<LeftType>&, const RightType&);
+    static Tensor<uint8_t> eval(const Tensor<LeftType>&, const Tensor<RightType>&);
+    static BitMask eval_bits(const Tensor<LeftType>&, const RightType&);
 };
 
 template <typename LeftType, typename RightType, typename Enable = void>
 struct OptimizedCompareLessOrEqual
 {
     static Tensor<uint8_t> eval(const Tensor<LeftType>&, const RightType&);
+    static Tensor<uint8_t> eval(const Tensor<LeftType>&, const Tensor<RightType>&);
+    static BitMask eval_bits(const Tensor<LeftType>&, const RightType&);
 };
 
 template <typename LeftType, typename RightType, typename Enable = void>
 struct OptimizedCompareGreaterOrEqual
 {
     static Tensor<uint8_t> eval(const Tensor<LeftType>&, const RightType&);
+    static Tensor<uint8_t> eval(const Tensor<LeftType>&, const Tensor<RightType>&);
+    static BitMask eval_bits(const Tensor<LeftType>&, const RightType&);
 };
 
 } // namespace detail
@@ -59,6 +85,39 @@ inline Tensor<uint8_t> compare_equal(const Tensor<LeftType>& left, const RightTy
     return detail::OptimizedCompareEqual<LeftType, RightType>::eval(left, scalar);
 }
 
+/// \brief Check equality of a tensor and scalar elementwise into a bit-packed mask
+///
+/// \param tensor A immutable tensor.
+/// \param right A scalar
+/// \returns A [BitMask](tnt::BitMask) with one bit per element, set where the
+/// condition is true.
+template <typename LeftType, typename RightType>
+inline BitMask compare_equal_bits(const Tensor<LeftType>& left, const RightType& scalar)
+{
+    return detail::OptimizedCompareEqual<LeftType, RightType>::eval_bits(left, scalar);
+}
+
+/// \brief Check equality of two tensors elementwise
+///
+/// \param left A immutable tensor
+/// \param right A immutable tensor of the same shape as [left](*::left)
+/// \returns A mask tensor with DataType `uint8_t`. The mask will contain `255`
+/// where `left == right` and `0` everywhere else.
+/// \requires [left](*::left) and [right](*::right) shall have the same type.
+/// Use [as](tnt::Tensor::as) to compare tensors of different types.
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<uint8_t> compare_equal(const Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::compare_equal()", __FILE__, __LINE__,
+                   "Element-wise comparison of two tensors requires that those tensors be of the same size"))
+
+    return detail::OptimizedCompareEqual<DataType, DataType>::eval(left, right);
+}
+
 /// \brief Check inequality of a tensor and scalar elementwise
 ///
 /// \param tensor A immutable tensor.
@@ -71,6 +130,39 @@ inline Tensor<uint8_t> compare_not_equal(const Tensor<LeftType>& left, const Rig
     return detail::OptimizedCompareNotEqual<LeftType, RightType>::eval(left, scalar);
 }
 
+/// \brief Check inequality of a tensor and scalar elementwise into a bit-packed mask
+///
+/// \param tensor A immutable tensor.
+/// \param right A scalar
+/// \returns A [BitMask](tnt::BitMask) with one bit per element, set where the
+/// condition is true.
+template <typename LeftType, typename RightType>
+inline BitMask compare_not_equal_bits(const Tensor<LeftType>& left, const RightType& scalar)
+{
+    return detail::OptimizedCompareNotEqual<LeftType, RightType>::eval_bits(left, scalar);
+}
+
+/// \brief Check inequality of two tensors elementwise
+///
+/// \param left A immutable tensor
+/// \param right A immutable tensor of the same shape as [left](*::left)
+/// \returns A mask tensor with DataType `uint8_t`. The mask will contain `255`
+/// where `left != right` and `0` everywhere else.
+/// \requires [left](*::left) and [right](*::right) shall have the same type.
+/// Use [as](tnt::Tensor::as) to compare tensors of different types.
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<uint8_t> compare_not_equal(const Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::compare_not_equal()", __FILE__, __LINE__,
+                   "Element-wise comparison of two tensors requires that those tensors be of the same size"))
+
+    return detail::OptimizedCompareNotEqual<DataType, DataType>::eval(left, right);
+}
+
 /// \brief Check if a scalar is less than a tensor elementwise
 ///
 /// \param tensor A immutable tensor.
@@ -83,6 +175,39 @@ inline Tensor<uint8_t> compare_less_than(const Tensor<LeftType>& left, const Rig
     return detail::OptimizedCompareLessThan<LeftType, RightType>::eval(left, scalar);
 }
 
+/// \brief Check if a scalar is less than a tensor elementwise into a bit-packed mask
+///
+/// \param tensor A immutable tensor.
+/// \param right A scalar
+/// \returns A [BitMask](tnt::BitMask) with one bit per element, set where the
+/// condition is true.
+template <typename LeftType, typename RightType>
+inline BitMask compare_less_than_bits(const Tensor<LeftType>& left, const RightType& scalar)
+{
+    return detail::OptimizedCompareLessThan<LeftType, RightType>::eval_bits(left, scalar);
+}
+
+/// \brief Check if a tensor is less than another tensor elementwise
+///
+/// \param left A immutable tensor
+/// \param right A immutable tensor of the same shape as [left](*::left)
+/// \returns A mask tensor with DataType `uint8_t`. The mask will contain `255`
+/// where `left < right` and `0` everywhere else.
+/// \requires [left](*::left) and [right](*::right) shall have the same type.
+/// Use [as](tnt::Tensor::as) to compare tensors of different types.
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<uint8_t> compare_less_than(const Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::compare_less_than()", __FILE__, __LINE__,
+                   "Element-wise comparison of two tensors requires that those tensors be of the same size"))
+
+    return detail::OptimizedCompareLessThan<DataType, DataType>::eval(left, right);
+}
+
 /// \brief Check if a scalar is greater than a tensor elementwise
 ///
 /// \param tensor A immutable tensor.
@@ -95,6 +220,39 @@ inline Tensor<uint8_t> compare_greater_than(const Tensor<LeftType>& left, const
     return detail::OptimizedCompareGreaterThan<LeftType, RightType>::eval(left, scalar);
 }
 
+/// \brief Check if a scalar is greater than a tensor elementwise into a bit-packed mask
+///
+/// \param tensor A immutable tensor.
+/// \param right A scalar
+/// \returns A [BitMask](tnt::BitMask) with one bit per element, set where the
+/// condition is true.
+template <typename LeftType, typename RightType>
+inline BitMask compare_greater_than_bits(const Tensor<LeftType>& left, const RightType& scalar)
+{
+    return detail::OptimizedCompareGreaterThan<LeftType, RightType>::eval_bits(left, scalar);
+}
+
+/// \brief Check if a tensor is greater than another tensor elementwise
+///
+/// \param left A immutable tensor
+/// \param right A immutable tensor of the same shape as [left](*::left)
+/// \returns A mask tensor with DataType `uint8_t`. The mask will contain `255`
+/// where `left > right` and `0` everywhere else.
+/// \requires [left](*::left) and [right](*::right) shall have the same type.
+/// Use [as](tnt::Tensor::as) to compare tensors of different types.
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<uint8_t> compare_greater_than(const Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::compare_greater_than()", __FILE__, __LINE__,
+                   "Element-wise comparison of two tensors requires that those tensors be of the same size"))
+
+    return detail::OptimizedCompareGreaterThan<DataType, DataType>::eval(left, right);
+}
+
 /// \brief Check if a scalar is less than or equal to a tensor elementwise
 ///
 /// \param tensor A immutable tensor.
@@ -107,6 +265,39 @@ inline Tensor<uint8_t> compare_less_or_equal(const Tensor<LeftType>& left, const
     return detail::OptimizedCompareLessOrEqual<LeftType, RightType>::eval(left, scalar);
 }
 
+/// \brief Check if a scalar is less than or equal to a tensor elementwise into a bit-packed mask
+///
+/// \param tensor A immutable tensor.
+/// \param right A scalar
+/// \returns A [BitMask](tnt::BitMask) with one bit per element, set where the
+/// condition is true.
+template <typename LeftType, typename RightType>
+inline BitMask compare_less_or_equal_bits(const Tensor<LeftType>& left, const RightType& scalar)
+{
+    return detail::OptimizedCompareLessOrEqual<LeftType, RightType>::eval_bits(left, scalar);
+}
+
+/// \brief Check if a tensor is less than or equal to another tensor elementwise
+///
+/// \param left A immutable tensor
+/// \param right A immutable tensor of the same shape as [left](*::left)
+/// \returns A mask tensor with DataType `uint8_t`. The mask will contain `255`
+/// where `left <= right` and `0` everywhere else.
+/// \requires [left](*::left) and [right](*::right) shall have the same type.
+/// Use [as](tnt::Tensor::as) to compare tensors of different types.
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<uint8_t> compare_less_or_equal(const Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::compare_less_or_equal()", __FILE__, __LINE__,
+                   "Element-wise comparison of two tensors requires that those tensors be of the same size"))
+
+    return detail::OptimizedCompareLessOrEqual<DataType, DataType>::eval(left, right);
+}
+
 /// \brief Check if a scalar is greater than or equal to a tensor elementwise
 ///
 /// \param tensor A immutable tensor.
@@ -119,6 +310,39 @@ inline Tensor<uint8_t> compare_greater_or_equal(const Tensor<LeftType>& left, co
     return detail::OptimizedCompareGreaterOrEqual<LeftType, RightType>::eval(left, scalar);
 }
 
+/// \brief Check if a scalar is greater than or equal to a tensor elementwise into a bit-packed mask
+///
+/// \param tensor A immutable tensor.
+/// \param right A scalar
+/// \returns A [BitMask](tnt::BitMask) with one bit per element, set where the
+/// condition is true.
+template <typename LeftType, typename RightType>
+inline BitMask compare_greater_or_equal_bits(const Tensor<LeftType>& left, const RightType& scalar)
+{
+    return detail::OptimizedCompareGreaterOrEqual<LeftType, RightType>::eval_bits(left, scalar);
+}
+
+/// \brief Check if a tensor is greater than or equal to another tensor elementwise
+///
+/// \param left A immutable tensor
+/// \param right A immutable tensor of the same shape as [left](*::left)
+/// \returns A mask tensor with DataType `uint8_t`. The mask will contain `255`
+/// where `left >= right` and `0` everywhere else.
+/// \requires [left](*::left) and [right](*::right) shall have the same type.
+/// Use [as](tnt::Tensor::as) to compare tensors of different types.
+/// \notes This function asserts that [left](*::left) and [right](*::right)
+/// have the same shape and will throw an exception if they do not. This check
+/// can be disabled by `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<uint8_t> compare_greater_or_equal(const Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(left.shape == right.shape,
+               InvalidParameterException("tnt::compare_greater_or_equal()", __FILE__, __LINE__,
+                   "Element-wise comparison of two tensors requires that those tensors be of the same size"))
+
+    return detail::OptimizedCompareGreaterOrEqual<DataType, DataType>::eval(left, right);
+}
+
 } // namespace tnt
 
 #endif // TNT_MATH_COMPARE_OPS_HPP
@@ -0,0 +1,134 @@
+#ifndef TNT_MATH_COMPLEX_OPS_HPP
+#define TNT_MATH_COMPLEX_OPS_HPP
+
+#include <tnt/core/tensor.hpp>
+#include <tnt/core/complex.hpp>
+
+#include <complex>
+#include <type_traits>
+
+// Complex tensors store each element as a real part followed by an imaginary
+// part, the layout of `std::complex`, so a tensor of N complex values is an
+// array of 2N floating point values. Addition, subtraction, negation and
+// scaling by a real number act on that array directly. Products, quotients,
+// magnitudes and phases load two vectors at a time and split them into a
+// vector of real parts and a vector of imaginary parts, so the arithmetic is
+// done on full vectors without shuffles inside the loop.
+//
+// The elementwise operators of [Tensor]() dispatch to the complex kernels,
+// so `a * b` multiplies complex tensors and `a * 2.f` scales one.
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType, typename Enable = void>
+struct OptimizedConjugate
+{
+    static void eval(Tensor<DataType>&) noexcept;
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedComplexParts
+{
+    using Scalar = typename ScalarType<DataType>::type;
+
+    static Tensor<Scalar> magnitude(const Tensor<DataType>&) noexcept;
+    static Tensor<Scalar> phase(const Tensor<DataType>&) noexcept;
+    static Tensor<DataType> combine(const Tensor<Scalar>&, const Tensor<Scalar>&) noexcept;
+};
+
+} // namespace detail
+
+/// \brief A view of the real parts of a complex tensor
+///
+/// \param tensor A complex tensor
+/// \returns A view with the shape of [tensor](*::tensor) that aliases its
+/// real parts. Nothing is copied, so writes through the view change the
+/// tensor.
+/// \notes The view has twice the strides of the tensor, counted in real
+/// values. It is invalidated when the tensor is destroyed or reassigned.
+template <typename DataType>
+inline TensorView<DataType> real(const Tensor<std::complex<DataType>>& tensor) noexcept
+{
+    Stride stride(tensor.shape);
+    for (int& s : stride.strides)
+        s *= 2;
+
+    return TensorView<DataType>(tensor.shape, stride, 0, reinterpret_cast<DataType*>(tensor.data.data));
+}
+
+/// \brief A view of the imaginary parts of a complex tensor
+///
+/// \param tensor A complex tensor
+/// \returns A view with the shape of [tensor](*::tensor) that aliases its
+/// imaginary parts. Nothing is copied, so writes through the view change the
+/// tensor.
+/// \notes See [real]()
+template <typename DataType>
+inline TensorView<DataType> imag(const Tensor<std::complex<DataType>>& tensor) noexcept
+{
+    Stride stride(tensor.shape);
+    for (int& s : stride.strides)
+        s *= 2;
+
+    return TensorView<DataType>(tensor.shape, stride, 1, reinterpret_cast<DataType*>(tensor.data.data));
+}
+
+/// \brief Build a complex tensor from its real and imaginary parts
+///
+/// \param real The real parts
+/// \param imag The imaginary parts, with the same shape as [real](*::real)
+/// \returns A complex tensor with the shape of the parts
+/// \requires Type `DataType` is `float` or `double`
+/// \notes This function asserts that the parts have the same shape and will
+/// throw an exception if they do not.
+template <typename DataType>
+inline Tensor<std::complex<DataType>> make_complex(const Tensor<DataType>& real, const Tensor<DataType>& imag)
+{
+    TNT_ASSERT(real.shape == imag.shape,
+               InvalidParameterException("tnt::make_complex()", __FILE__, __LINE__,
+                   "The real and imaginary parts of a complex tensor must have the same shape"))
+
+    return detail::OptimizedComplexParts<std::complex<DataType>>::combine(real, imag);
+}
+
+/// \brief Conjugate a complex tensor elementwise
+///
+/// The conjugate is computed in place on the tensor
+/// \param tensor A mutable complex tensor. The sign of each imaginary part
+/// is flipped in-place
+template <typename DataType>
+inline void conjugate(Tensor<std::complex<DataType>>& tensor) noexcept
+{
+    detail::OptimizedConjugate<std::complex<DataType>>::eval(tensor);
+}
+
+/// \brief The magnitude of each element of a complex tensor, `std::abs`
+///
+/// \param tensor A complex tensor
+/// \returns A real tensor with the same shape
+/// \notes Error is within 2 ulp. The larger part is factored out of the
+/// square root, so the result does not overflow unless the magnitude does.
+template <typename DataType>
+inline Tensor<DataType> magnitude(const Tensor<std::complex<DataType>>& tensor) noexcept
+{
+    return detail::OptimizedComplexParts<std::complex<DataType>>::magnitude(tensor);
+}
+
+/// \brief The phase of each element of a complex tensor, `std::arg`
+///
+/// \param tensor A complex tensor
+/// \returns A real tensor with the same shape holding angles in `[-pi, pi]`
+/// \notes Error is within 2 ulp. Signed zeros are handled like `std::atan2`.
+template <typename DataType>
+inline Tensor<DataType> phase(const Tensor<std::complex<DataType>>& tensor) noexcept
+{
+    return detail::OptimizedComplexParts<std::complex<DataType>>::phase(tensor);
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_COMPLEX_OPS_HPP
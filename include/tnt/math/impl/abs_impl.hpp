@@ -0,0 +1,92 @@
+#ifndef TNT_MATH_ABS_IMPL_HPP
+#define TNT_MATH_ABS_IMPL_HPP
+
+#include <tnt/math/arithmetic_ops.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType>
+struct OptimizedAbs<DataType, typename std::enable_if<std::is_signed<DataType>::value>::type>
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static void eval(Tensor<DataType>& tensor) noexcept
+    {
+        if (tensor.shape.total() == 0)
+            return;
+
+        DataType* ptr = tensor.data.data;
+
+        int offset = 0, num_blocks = AlignSIMDType<DataType>::num_aligned_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType block = simdpp::load<VecType>(ptr + offset);
+            simdpp::store(ptr + offset, VecType(simdpp::abs(block)));
+        }
+    }
+};
+
+// Unsigned values are already their own absolute value
+template <typename DataType>
+struct OptimizedAbs<DataType, typename std::enable_if<std::is_unsigned<DataType>::value>::type>
+{
+    static void eval(Tensor<DataType>&) noexcept {}
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("abs(Tensor<signed>&)", T, test_signed_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> tensor(shape);
+        for (int i = 0; i < shape.total(); ++i)
+            tensor.data[i] = (T) (i % 11 - 5);
+
+        Tensor<T> result = tensor;
+        abs(result);
+
+        for (int i = 0; i < shape.total(); ++i)
+            REQUIRE(result.data[i] == (T) (tensor.data[i] < 0 ? -tensor.data[i] : tensor.data[i]));
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+}
+
+TEST_CASE_TEMPLATE("abs(Tensor<floating>&)", T, test_float_data_types)
+{
+    T data[6]     = {-1.5, 2.25, -0.0, 0, -1e30, 7};
+    T expected[6] = {1.5, 2.25, 0, 0, 1e30, 7};
+
+    Tensor<T> tensor(Shape{2, 3}, AlignedPtr<T>(data, 6));
+    abs(tensor);
+
+    REQUIRE((tensor == Tensor<T>(Shape{2, 3}, AlignedPtr<T>(expected, 6))));
+}
+
+TEST_CASE_TEMPLATE("abs(Tensor<unsigned>&)", T, test_unsigned_data_types)
+{
+    Tensor<T> tensor(Shape{4, 4, 4, 5});
+    for (int i = 0; i < tensor.shape.total(); ++i)
+        tensor.data[i] = (T) (i % 11);
+
+    Tensor<T> result = tensor;
+    abs(result);
+
+    REQUIRE((result == tensor));
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_ABS_IMPL_HPP
@@ -12,7 +12,7 @@ namespace detail
 {
 
 template <typename LeftType, typename RightType>
-struct OptimizedAdd<LeftType, RightType>
+struct OptimizedAdd<LeftType, RightType, typename std::enable_if<std::is_arithmetic<LeftType>::value>::type>
 {
     using VecType = typename SIMDType<LeftType>::VecType;
 
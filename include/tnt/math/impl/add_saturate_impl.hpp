@@ -0,0 +1,104 @@
+#ifndef TNT_MATH_ADD_SATURATE_IMPL_HPP
+#define TNT_MATH_ADD_SATURATE_IMPL_HPP
+
+#include <tnt/math/arithmetic_ops.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <limits>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType>
+struct OptimizedAddSaturate<DataType,
+            typename std::enable_if<std::is_integral<DataType>::value && sizeof(DataType) <= 2>::type>
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static void eval(Tensor<DataType>& tensor, const DataType& scalar) noexcept
+    {
+        if (tensor.shape.total() == 0)
+            return;
+
+        DataType* ptr = tensor.data.data;
+        auto scalar_vec = simdpp::load_splat<VecType>(&scalar);
+
+        int offset = 0, num_blocks = AlignSIMDType<DataType>::num_aligned_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType block = simdpp::load<VecType>(ptr + offset);
+            simdpp::store(ptr + offset, VecType(simdpp::add_sat(block, scalar_vec)));
+        }
+    }
+
+    static void eval(Tensor<DataType>& left, const Tensor<DataType>& right) noexcept
+    {
+        if (left.shape.total() == 0)
+            return;
+
+        DataType*       l_ptr = left.data.data;
+        const DataType* r_ptr = right.data.data;
+
+        int offset = 0, num_blocks = AlignSIMDType<DataType>::num_aligned_blocks(left.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType l_block = simdpp::load<VecType>(l_ptr + offset);
+            VecType r_block = simdpp::load<VecType>(r_ptr + offset);
+            simdpp::store(l_ptr + offset, VecType(simdpp::add_sat(l_block, r_block)));
+        }
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("add_saturate(Tensor<T>&, ...)", T, test_saturate_data_types)
+{
+    using Limits = std::numeric_limits<T>;
+
+    { // 2x2
+        T data[4]     = {(T) (Limits::max() - 1), (T) (Limits::min() + 1), 0, 1};
+        T expected[4] = {Limits::max(), (T) (Limits::min() + 3), 2, 3};
+
+        Tensor<T> tensor(Shape{2, 2}, AlignedPtr<T>(data, 4));
+        add_saturate(tensor, 2);
+        REQUIRE((tensor == Tensor<T>(Shape{2, 2}, AlignedPtr<T>(expected, 4))));
+    }
+
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> left(shape), right(shape);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            left.data[i]  = (T) (Limits::min() + i * 613);
+            right.data[i] = (T) (i * 389 + 7);
+        }
+
+        Tensor<T> result = left;
+        add_saturate(result, right);
+
+        Tensor<T> shifted = left;
+        add_saturate(shifted, 100000);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            REQUIRE(result.data[i]  == saturate_cast<T>((int32_t) left.data[i] + right.data[i]));
+            REQUIRE(shifted.data[i] == saturate_cast<T>((int32_t) left.data[i] + Limits::max()));
+        }
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    Tensor<T> tensor(Shape{2, 2});
+    REQUIRE_THROWS(add_saturate(tensor, Tensor<T>(Shape{4})));
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_ADD_SATURATE_IMPL_HPP
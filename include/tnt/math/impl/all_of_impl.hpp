@@ -0,0 +1,97 @@
+#ifndef TNT_MATH_ALL_OF_IMPL_HPP
+#define TNT_MATH_ALL_OF_IMPL_HPP
+
+#include <tnt/math/reduce_ops.hpp>
+#include <tnt/math/impl/compare_predicate_impl.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType>
+struct OptimizedAllOf<DataType>
+{
+    static bool eval(const Tensor<DataType>& tensor, Comparison op, const DataType& scalar)
+    {
+        return dispatch_comparison<Kernel, bool>(op, tensor, scalar);
+    }
+
+private:
+    /// Return at the first 16 element group with any lane clear
+    template <Comparison Op>
+    struct Kernel
+    {
+        using Pack    = PackMaskBits<DataType>;
+        using VecType = typename Pack::VecType;
+
+        static bool run(const Tensor<DataType>& tensor, const DataType& scalar)
+        {
+            const DataType* t_ptr = tensor.data.data;
+            auto scalar_vec = simdpp::load_splat<VecType>(&scalar);
+
+            const int total      = tensor.shape.total();
+            const int num_groups = total / Pack::Size;
+
+            for (int g = 0; g < num_groups; ++g) {
+                VecType block = simdpp::load<VecType>(t_ptr + g * Pack::Size);
+                if (Pack::pack(ComparePredicate<Op>::simd(block, scalar_vec)) != 0xFFFF)
+                    return false;
+            }
+
+            for (int i = num_groups * Pack::Size; i < total; ++i)
+                if (!ComparePredicate<Op>::scalar(t_ptr[i], scalar))
+                    return false;
+
+            return true;
+        }
+    };
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("all_of(Tensor<T>&, Comparison, Scalar)", T, test_data_types)
+{
+    { // 2x3
+        T data[6] = {1, 4, 2, 4, 7, 0};
+        Tensor<T> tensor(Shape{2, 3}, AlignedPtr<T>(data, 6));
+
+        REQUIRE(all_of(tensor, Comparison::Equal,          4) == false);
+        REQUIRE(all_of(tensor, Comparison::NotEqual,       3) == true);
+        REQUIRE(all_of(tensor, Comparison::LessThan,       8) == true);
+        REQUIRE(all_of(tensor, Comparison::LessThan,       7) == false);
+        REQUIRE(all_of(tensor, Comparison::GreaterThan,    0) == false);
+        REQUIRE(all_of(tensor, Comparison::LessOrEqual,    7) == true);
+        REQUIRE(all_of(tensor, Comparison::GreaterOrEqual, 0) == true);
+    }
+
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> tensor(shape, 5);
+
+        REQUIRE(all_of(tensor, Comparison::Equal,          5) == true);
+        REQUIRE(all_of(tensor, Comparison::GreaterOrEqual, 5) == true);
+
+        // A single mismatch in the last group or the tail
+        tensor.data[shape.total() - 1] = 9;
+        REQUIRE(all_of(tensor, Comparison::Equal,          5) == false);
+        REQUIRE(all_of(tensor, Comparison::GreaterOrEqual, 5) == true);
+        REQUIRE(all_of(tensor, Comparison::LessOrEqual,    5) == false);
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{16, 4});
+    test_shape(Shape{17, 67});
+
+    REQUIRE(all_of(Tensor<T>(), Comparison::Equal, 0) == true);
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_ALL_OF_IMPL_HPP
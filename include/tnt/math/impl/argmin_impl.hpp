@@ -0,0 +1,314 @@
+#ifndef TNT_MATH_ARGMIN_IMPL_HPP
+#define TNT_MATH_ARGMIN_IMPL_HPP
+
+#include <tnt/math/search_ops.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType>
+struct OptimizedArgMin<DataType>
+{
+    using VecType         = typename SIMDType<DataType>::VecType;
+    using UnsignedType    = typename VecType::uint_element_type;
+    using UnsignedVecType = typename VecType::uint_vector_type;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static int eval(const Tensor<DataType>& tensor)
+    {
+        return search(tensor.data.data, tensor.shape.total());
+    }
+
+    static Tensor<int32_t> eval(const Tensor<DataType>& tensor, int axis)
+    {
+        const int outer  = tensor.shape.total(0, axis);
+        const int length = tensor.shape[axis];
+        const int inner  = tensor.shape.total(axis) / length;
+
+        Shape shape = tensor.shape;
+        shape[axis] = 1;
+
+        Tensor<int32_t> indices(shape);
+
+        const DataType* t_ptr = tensor.data.data;
+        int32_t*        i_ptr = indices.data.data;
+
+        if (inner == 1) {
+            for (int o = 0; o < outer; ++o)
+                i_ptr[o] = search(t_ptr + o * length, length);
+        } else {
+            AlignedPtr<DataType> best(inner);
+            for (int o = 0; o < outer; ++o)
+                search_strided(t_ptr + o * length * inner, length, inner, best.data, i_ptr + o * inner);
+        }
+
+        return indices;
+    }
+
+private:
+    /// Search contiguous memory in two passes. The first reduces the minimum
+    /// with SIMD, the second finds the first block containing it with a SIMD
+    /// compare and only scans that block element by element. A NaN anywhere
+    /// takes precedence, the first one is returned.
+    static int search(const DataType* ptr, int total)
+    {
+        const int num_blocks = total / Size;
+
+        DataType min_value = ptr[0];
+        bool     has_nan   = false;
+        if (num_blocks > 0) {
+            VecType min_vec = simdpp::load_u<VecType>(ptr);
+            UnsignedVecType nan_vec = is_nan(min_vec);
+            for (int offset = Size; offset < num_blocks * Size; offset += Size) {
+                VecType block = simdpp::load_u<VecType>(ptr + offset);
+                min_vec = simdpp::min(min_vec, block);
+                nan_vec = simdpp::bit_or(nan_vec, is_nan(block));
+            }
+
+            min_value = simdpp::reduce_min(min_vec);
+            has_nan   = simdpp::test_bits_any(nan_vec);
+        }
+
+        for (int i = num_blocks * Size; i < total; ++i) {
+            has_nan = has_nan || ptr[i] != ptr[i];
+            if (ptr[i] < min_value)
+                min_value = ptr[i];
+        }
+
+        if (has_nan)
+            return std::find_if(ptr, ptr + total, [](DataType value) { return value != value; }) - ptr;
+
+        auto min_vec = simdpp::load_splat<VecType>(&min_value);
+
+        int offset = 0;
+        for ( ; offset < num_blocks * Size; offset += Size) {
+            VecType block = simdpp::load_u<VecType>(ptr + offset);
+            if (simdpp::test_bits_any(simdpp::bit_cast<UnsignedVecType>(simdpp::cmp_eq(block, min_vec))))
+                break;
+        }
+
+        for ( ; offset < total; ++offset)
+            if (ptr[offset] == min_value)
+                break;
+
+        return offset;
+    }
+
+    /// Lanes holding NaN, the only value unequal to itself. Integer lanes
+    /// never are.
+    static TNT_INL UnsignedVecType is_nan(const VecType& block)
+    {
+        if (!std::is_floating_point<DataType>::value)
+            return simdpp::make_zero<UnsignedVecType>();
+
+        return simdpp::bit_cast<UnsignedVecType>(simdpp::cmp_neq(block, block));
+    }
+
+    /// Lanes where `block` replaces the best value so far: it is smaller, or
+    /// it is the first NaN
+    static TNT_INL UnsignedVecType replaces(const VecType& block, const VecType& best)
+    {
+        UnsignedVecType better = simdpp::bit_cast<UnsignedVecType>(simdpp::cmp_lt(block, best));
+        return simdpp::bit_or(better, simdpp::bit_andnot(is_nan(block), is_nan(best)));
+    }
+
+    static TNT_INL bool replaces(DataType value, DataType best)
+    {
+        return value < best || (value != value && best == best);
+    }
+
+    /// Search `length` rows of `inner` elements, vectorized across the rows.
+    /// Positions are tracked in lanes as wide as the data so long axes are
+    /// processed in segments that cannot overflow the lane type.
+    static void search_strided(const DataType* ptr, int length, int inner, DataType* best, int32_t* indices)
+    {
+        const int segment = (int) std::min<uint64_t>(std::numeric_limits<UnsignedType>::max(),
+                                                      std::numeric_limits<int>::max());
+
+        const UnsignedType zero = 0, one = 1;
+        const auto one_vec = simdpp::load_splat<UnsignedVecType>(&one);
+
+        DataType     values[Size];
+        UnsignedType positions[Size];
+
+        const int num_blocks = inner / Size;
+        for (int l = 0; l < num_blocks * Size; l += Size) {
+            for (int start = 0; start < length; start += segment) {
+                const int end = std::min(length, start + segment);
+
+                VecType best_vec = simdpp::load_u<VecType>(ptr + start * inner + l);
+                UnsignedVecType index_vec = simdpp::load_splat<UnsignedVecType>(&zero);
+                UnsignedVecType position  = simdpp::load_splat<UnsignedVecType>(&zero);
+
+                for (int j = start + 1; j < end; ++j) {
+                    position = simdpp::add(position, one_vec);
+
+                    VecType block = simdpp::load_u<VecType>(ptr + j * inner + l);
+                    UnsignedVecType mask = replaces(block, best_vec);
+
+                    best_vec  = simdpp::blend(block, best_vec, mask);
+                    index_vec = simdpp::blend(position, index_vec, mask);
+                }
+
+                simdpp::store_u(values, best_vec);
+                simdpp::store_u(positions, index_vec);
+
+                for (int i = 0; i < Size; ++i) {
+                    if (start == 0 || replaces(values[i], best[l + i])) {
+                        best[l + i]    = values[i];
+                        indices[l + i] = start + (int) positions[i];
+                    }
+                }
+            }
+        }
+
+        for (int l = num_blocks * Size; l < inner; ++l) {
+            best[l]    = ptr[l];
+            indices[l] = 0;
+
+            for (int j = 1; j < length; ++j) {
+                if (replaces(ptr[j * inner + l], best[l])) {
+                    best[l]    = ptr[j * inner + l];
+                    indices[l] = j;
+                }
+            }
+        }
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("argmin(const Tensor<T>&)", T, test_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> tensor(shape);
+        for (int i = 0; i < shape.total(); ++i)
+            tensor.data[i] = (T) ((i * 37) % 101);
+
+        const T* begin = tensor.data.data;
+        const int expected = std::min_element(begin, begin + shape.total()) - begin;
+
+        REQUIRE(argmin(tensor) == expected);
+
+        // Ties resolve to the first occurrence
+        tensor = 3;
+        tensor.data[shape.total() - 1] = 1;
+        tensor.data[shape.total() / 2] = 1;
+        REQUIRE(argmin(tensor) == shape.total() / 2);
+    };
+
+    test_shape(Shape{5});
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{2, 1, 2, 1, 2});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{31, 17});
+
+    REQUIRE_THROWS(argmin(Tensor<T>()));
+}
+
+TEST_CASE_TEMPLATE("argmin(const Tensor<floating>&) with NaN", T, test_float_data_types)
+{
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+
+    for (int total : {3, 5, 64, 67}) {
+        Tensor<T> tensor(Shape{total});
+        for (int i = 0; i < total; ++i)
+            tensor.data[i] = (T) ((i * 37) % 101);
+
+        tensor.data[0] = nan;
+        REQUIRE(argmin(tensor) == 0);
+
+        tensor.data[0] = 1;
+        tensor.data[total - 1] = nan;
+        tensor.data[total / 2] = nan;
+        REQUIRE(argmin(tensor) == total / 2);
+    }
+
+    Tensor<T> tensor(Shape{40, 19});
+    for (int i = 0; i < tensor.shape.total(); ++i)
+        tensor.data[i] = (T) ((i * 37) % 101);
+
+    tensor.data[0 * 19 + 3] = nan;
+    tensor.data[25 * 19 + 3] = nan;
+    tensor.data[30 * 19 + 7] = nan;
+    tensor.data[12 * 19 + 18] = nan;
+
+    Tensor<int32_t> rows = argmin(tensor, 0);
+    REQUIRE(rows.data[3] == 0);
+    REQUIRE(rows.data[7] == 30);
+    REQUIRE(rows.data[18] == 12);
+
+    Tensor<int32_t> cols = argmin(tensor, 1);
+    REQUIRE(cols.data[0] == 3);
+    REQUIRE(cols.data[12] == 18);
+    REQUIRE(cols.data[25] == 3);
+    REQUIRE(cols.data[30] == 7);
+}
+
+TEST_CASE_TEMPLATE("argmin(const Tensor<T>&, int)", T, test_data_types)
+{
+    { // 2x3
+        T data[6] = {1, 7, 3,
+                     9, 2, 9};
+        Tensor<T> tensor(Shape{2, 3}, AlignedPtr<T>(data, 6));
+
+        int32_t rows[3] = {0, 1, 0};
+        int32_t cols[2] = {0, 1};
+
+        REQUIRE((argmin(tensor, 0) == Tensor<int32_t>(Shape{1, 3}, AlignedPtr<int32_t>(rows, 3))));
+        REQUIRE((argmin(tensor, 1) == Tensor<int32_t>(Shape{2, 1}, AlignedPtr<int32_t>(cols, 2))));
+    }
+
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> tensor(shape);
+        for (int i = 0; i < shape.total(); ++i)
+            tensor.data[i] = (T) ((i * 37) % 101);
+
+        for (int axis = 0; axis < shape.num_axes(); ++axis) {
+            const int length = shape[axis];
+            const int inner  = shape.total(axis) / length;
+            const int outer  = shape.total(0, axis);
+
+            Tensor<int32_t> indices = argmin(tensor, axis);
+            REQUIRE(indices.shape.total() == outer * inner);
+
+            for (int o = 0; o < outer; ++o) {
+                for (int l = 0; l < inner; ++l) {
+                    const T* base = tensor.data.data + o * length * inner + l;
+
+                    int expected = 0;
+                    for (int j = 1; j < length; ++j)
+                        if (base[j * inner] < base[expected * inner])
+                            expected = j;
+
+                    REQUIRE(indices.data[o * inner + l] == expected);
+                }
+            }
+        }
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{300, 40});
+    test_shape(Shape{7, 9, 33});
+
+    REQUIRE_THROWS(argmin(Tensor<T>(Shape{2, 2}), 2));
+    REQUIRE_THROWS(argmin(Tensor<T>(Shape{2, 2}), -1));
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_ARGMIN_IMPL_HPP
@@ -0,0 +1,70 @@
+#ifndef TNT_MATH_CLAMP_IMPL_HPP
+#define TNT_MATH_CLAMP_IMPL_HPP
+
+#include <tnt/math/arithmetic_ops.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <algorithm>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType>
+struct OptimizedClamp<DataType>
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static void eval(Tensor<DataType>& tensor, const DataType& low, const DataType& high) noexcept
+    {
+        if (tensor.shape.total() == 0)
+            return;
+
+        DataType* ptr = tensor.data.data;
+
+        auto low_vec  = simdpp::load_splat<VecType>(&low);
+        auto high_vec = simdpp::load_splat<VecType>(&high);
+
+        int offset = 0, num_blocks = AlignSIMDType<DataType>::num_aligned_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType block = simdpp::load<VecType>(ptr + offset);
+            simdpp::store(ptr + offset, VecType(simdpp::min(simdpp::max(block, low_vec), high_vec)));
+        }
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("clamp(Tensor<T>&, Scalar, Scalar)", T, test_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> tensor(shape);
+        for (int i = 0; i < shape.total(); ++i)
+            tensor.data[i] = (T) (i % 11);
+
+        Tensor<T> result = tensor;
+        clamp(result, 3, 8);
+
+        for (int i = 0; i < shape.total(); ++i)
+            REQUIRE(result.data[i] == std::min(std::max(tensor.data[i], (T) 3), (T) 8));
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    Tensor<T> tensor(Shape{2, 2});
+    REQUIRE_THROWS(clamp(tensor, 5, 4));
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_CLAMP_IMPL_HPP
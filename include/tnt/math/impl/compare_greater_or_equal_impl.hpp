@@ -44,6 +44,64 @@ struct OptimizedCompareGreaterOrEqual<LeftType, RightType>
 
         return mask;
     }
+
+    static Tensor<uint8_t> eval(const Tensor<LeftType>& left, const Tensor<RightType>& right)
+    {
+        static_assert(std::is_same<LeftType, RightType>::value, "Tensors must have the same type");
+
+        using Bytes        = StoreMaskBytes<LeftType>;
+        using BytesVecType = typename Bytes::VecType;
+
+        Tensor<uint8_t> mask(left.shape);
+
+        const LeftType* l_ptr = left.data.data;
+        const LeftType* r_ptr = right.data.data;
+        uint8_t*        m_ptr = mask.data.data;
+
+        const int total      = left.shape.total();
+        const int num_groups = total / Bytes::Size;
+
+        for (int g = 0; g < num_groups; ++g) {
+            BytesVecType l_block = simdpp::load<BytesVecType>(l_ptr + g * Bytes::Size);
+            BytesVecType r_block = simdpp::load<BytesVecType>(r_ptr + g * Bytes::Size);
+            Bytes::store(m_ptr + g * Bytes::Size, simdpp::cmp_ge(l_block, r_block));
+        }
+
+        for (int i = num_groups * Bytes::Size; i < total; ++i)
+            m_ptr[i] = l_ptr[i] >= r_ptr[i] ? 255 : 0;
+
+        return mask;
+    }
+
+    /// Compare 16 elements at a time and pack the lane masks straight into
+    /// bits, so no byte mask is ever materialized
+    static BitMask eval_bits(const Tensor<LeftType>& tensor, const RightType& _scalar)
+    {
+        using Pack        = PackMaskBits<LeftType>;
+        using PackVecType = typename Pack::VecType;
+
+        BitMask mask(tensor.shape);
+
+        const LeftType*    l_ptr = tensor.data.data;
+        BitMask::WordType* w_ptr = mask.data.data;
+
+        LeftType scalar = static_cast<LeftType>(_scalar);
+        auto scalar_vec = simdpp::load_splat<PackVecType>(&scalar);
+
+        const int total      = tensor.shape.total();
+        const int num_groups = total / Pack::Size;
+
+        for (int g = 0; g < num_groups; ++g) {
+            PackVecType block = simdpp::load<PackVecType>(l_ptr + g * Pack::Size);
+            w_ptr[g / 4] |= BitMask::WordType(Pack::pack(simdpp::cmp_ge(block, scalar_vec))) << (Pack::Size * (g % 4));
+        }
+
+        for (int i = num_groups * Pack::Size; i < total; ++i)
+            if (l_ptr[i] >= scalar)
+                w_ptr[i / BitMask::WordBits] |= BitMask::WordType(1) << (i % BitMask::WordBits);
+
+        return mask;
+    }
 };
 
 } // namespace detail
@@ -86,6 +144,46 @@ TEST_CASE_TEMPLATE("compare_greater_or_equal(Tensor<T>&, Scalar)", T, test_data_
     }
 }
 
+TEST_CASE_TEMPLATE("compare_greater_or_equal_bits(Tensor<T>&, Scalar)", T, test_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> tensor(shape);
+        for (int i = 0; i < shape.total(); ++i)
+            tensor.data[i] = (T) (i % 5);
+
+        for (int scalar = 0; scalar < 6; ++scalar) {
+            BitMask bits = compare_greater_or_equal_bits(tensor, scalar);
+            REQUIRE((bits.to_bytes() == compare_greater_or_equal(tensor, scalar)));
+        }
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{16, 4});
+    test_shape(Shape{17, 67});
+}
+
+TEST_CASE_TEMPLATE("compare_greater_or_equal(Tensor<T>&, Tensor<T>&)", T, test_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> left(shape), right(shape);
+        for (int i = 0; i < shape.total(); ++i) {
+            left.data[i]  = (T) (i % 7);
+            right.data[i] = (T) (i % 5);
+        }
+
+        Tensor<uint8_t> mask = compare_greater_or_equal(left, right);
+        for (int i = 0; i < shape.total(); ++i)
+            REQUIRE(mask.data[i] == (left.data[i] >= right.data[i] ? 255 : 0));
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    REQUIRE_THROWS(compare_greater_or_equal(Tensor<T>(Shape{2, 2}), Tensor<T>(Shape{4})));
+}
+
 } // namespace tnt
 
 #endif // TNT_MATH_COMPARE_GREATER_OR_EQUAL_IMPL_HPP
@@ -0,0 +1,66 @@
+#ifndef TNT_MATH_COMPARE_PREDICATE_IMPL_HPP
+#define TNT_MATH_COMPARE_PREDICATE_IMPL_HPP
+
+#include <tnt/math/compare_ops.hpp>
+#include <tnt/utils/simd.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// SIMD and scalar forms of a [Comparison]()
+template <Comparison Op>
+struct ComparePredicate {};
+
+#define COMPARE_PREDICATE(OP, SIMD_FUNC, SCALAR_OP)                            \
+template <>                                                                    \
+struct ComparePredicate<Comparison::OP>                                        \
+{                                                                              \
+    template <typename VecType>                                                \
+    static TNT_INL auto simd(const VecType& left, const VecType& right)        \
+        -> decltype(simdpp::SIMD_FUNC(left, right))                            \
+    {                                                                          \
+        return simdpp::SIMD_FUNC(left, right);                                 \
+    }                                                                          \
+                                                                               \
+    template <typename T>                                                      \
+    static TNT_INL bool scalar(const T& left, const T& right)                  \
+    {                                                                          \
+        return left SCALAR_OP right;                                           \
+    }                                                                          \
+};
+
+COMPARE_PREDICATE(Equal,          cmp_eq,  ==)
+COMPARE_PREDICATE(NotEqual,       cmp_neq, !=)
+COMPARE_PREDICATE(LessThan,       cmp_lt,  <)
+COMPARE_PREDICATE(GreaterThan,    cmp_gt,  >)
+COMPARE_PREDICATE(LessOrEqual,    cmp_le,  <=)
+COMPARE_PREDICATE(GreaterOrEqual, cmp_ge,  >=)
+
+#undef COMPARE_PREDICATE
+
+/// Select the instantiation of `Kernel` for a runtime [Comparison]() so a
+/// kernel is written once and compiled with its predicate inlined
+template <template <Comparison> class Kernel, typename Result, typename... Args>
+inline Result dispatch_comparison(Comparison op, const Args&... args)
+{
+    switch (op) {
+        case Comparison::Equal:          return Kernel<Comparison::Equal>::run(args...);
+        case Comparison::NotEqual:       return Kernel<Comparison::NotEqual>::run(args...);
+        case Comparison::LessThan:       return Kernel<Comparison::LessThan>::run(args...);
+        case Comparison::GreaterThan:    return Kernel<Comparison::GreaterThan>::run(args...);
+        case Comparison::LessOrEqual:    return Kernel<Comparison::LessOrEqual>::run(args...);
+        case Comparison::GreaterOrEqual: return Kernel<Comparison::GreaterOrEqual>::run(args...);
+    }
+
+    throw InvalidParameterException("tnt::detail::dispatch_comparison()", __FILE__, __LINE__,
+                                    "Unknown comparison");
+}
+
+} // namespace detail
+
+} // namespace tnt
+
+#endif // TNT_MATH_COMPARE_PREDICATE_IMPL_HPP
@@ -0,0 +1,561 @@
+#ifndef TNT_MATH_COMPLEX_IMPL_HPP
+#define TNT_MATH_COMPLEX_IMPL_HPP
+
+#include <tnt/math/complex_ops.hpp>
+#include <tnt/math/arithmetic_ops.hpp>
+#include <tnt/math/simd_math.hpp>
+
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Vectors over interleaved complex arrays. Elementwise operations that
+/// treat the parts alike run over the padded array of parts a vector at a
+/// time. Operations that mix the parts load two vectors at once, split into
+/// a vector of real parts and a vector of imaginary parts, and finish the
+/// elements left over with scalar code.
+template <typename T>
+struct ComplexSIMD
+{
+    using VecType = typename SIMDType<T>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<T>::value;
+
+    /// The number of vectors of parts in a padded array of `total` complex
+    /// values
+    static TNT_INL int num_blocks(int total)
+    {
+        return total == 0 ? 0 : AlignSIMDType<T>::num_aligned_blocks(2 * total);
+    }
+
+    static TNT_INL VecType splat(T value)
+    {
+        return simdpp::load_splat<VecType>(&value);
+    }
+
+    /// A vector of `value` repeated as `{real, imag, real, imag, ...}`
+    static TNT_INL VecType pattern(const std::complex<T>& value)
+    {
+        T parts[Size];
+        for (int i = 0; i < Size; ++i)
+            parts[i] = (i & 1) ? value.imag() : value.real();
+
+        return simdpp::load_u<VecType>(parts);
+    }
+
+    static TNT_INL void multiply(VecType& re, VecType& im, const VecType& b_re, const VecType& b_im)
+    {
+        VecType r = simdpp::sub(simdpp::mul(re, b_re), simdpp::mul(im, b_im));
+        im = simdpp::add(simdpp::mul(re, b_im), simdpp::mul(im, b_re));
+        re = r;
+    }
+
+    static TNT_INL void divide(VecType& re, VecType& im, const VecType& b_re, const VecType& b_im)
+    {
+        VecType norm = simdpp::add(simdpp::mul(b_re, b_re), simdpp::mul(b_im, b_im));
+        VecType r = simdpp::add(simdpp::mul(re, b_re), simdpp::mul(im, b_im));
+        im = simdpp::div(simdpp::sub(simdpp::mul(im, b_re), simdpp::mul(re, b_im)), norm);
+        re = simdpp::div(r, norm);
+    }
+
+    // The scalar tails use the same formulas as the vectors, so an element
+    // does not change with its position in the array
+    static TNT_INL std::complex<T> multiply(const std::complex<T>& a, const std::complex<T>& b)
+    {
+        return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(),
+                               a.real() * b.imag() + a.imag() * b.real());
+    }
+
+    static TNT_INL std::complex<T> divide(const std::complex<T>& a, const std::complex<T>& b)
+    {
+        const T norm = b.real() * b.real() + b.imag() * b.imag();
+        return std::complex<T>((a.real() * b.real() + a.imag() * b.imag()) / norm,
+                               (a.imag() * b.real() - a.real() * b.imag()) / norm);
+    }
+};
+
+template <typename LeftType, typename RightType>
+struct OptimizedAdd<LeftType, RightType, typename std::enable_if<IsComplex<LeftType>::value>::type>
+{
+    using Scalar  = typename ScalarType<LeftType>::type;
+    using Lanes   = ComplexSIMD<Scalar>;
+    using VecType = typename Lanes::VecType;
+
+    static void eval(Tensor<LeftType>& tensor, const RightType& scalar)
+    {
+        Scalar* ptr = reinterpret_cast<Scalar*>(tensor.data.data);
+        const VecType value = Lanes::pattern(static_cast<LeftType>(scalar));
+
+        int offset = 0, num_blocks = Lanes::num_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Lanes::Size)
+            simdpp::store(ptr + offset, VecType(simdpp::add(simdpp::load<VecType>(ptr + offset), value)));
+    }
+
+    static void eval(Tensor<LeftType>& left, const Tensor<RightType>& right)
+    {
+        static_assert(std::is_same<LeftType, RightType>::value, "Complex tensors can only be added to complex tensors of the same type");
+
+        Scalar*       l_ptr = reinterpret_cast<Scalar*>(left.data.data);
+        const Scalar* r_ptr = reinterpret_cast<const Scalar*>(right.data.data);
+
+        int offset = 0, num_blocks = Lanes::num_blocks(left.shape.total());
+        for ( ; num_blocks--; offset += Lanes::Size)
+            simdpp::store(l_ptr + offset, VecType(simdpp::add(simdpp::load<VecType>(l_ptr + offset),
+                                                              simdpp::load<VecType>(r_ptr + offset))));
+    }
+};
+
+template <typename LeftType, typename RightType>
+struct OptimizedSubtract<LeftType, RightType, typename std::enable_if<IsComplex<LeftType>::value>::type>
+{
+    using Scalar  = typename ScalarType<LeftType>::type;
+    using Lanes   = ComplexSIMD<Scalar>;
+    using VecType = typename Lanes::VecType;
+
+    static void eval(Tensor<LeftType>& tensor, const RightType& scalar)
+    {
+        Scalar* ptr = reinterpret_cast<Scalar*>(tensor.data.data);
+        const VecType value = Lanes::pattern(static_cast<LeftType>(scalar));
+
+        int offset = 0, num_blocks = Lanes::num_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Lanes::Size)
+            simdpp::store(ptr + offset, VecType(simdpp::sub(simdpp::load<VecType>(ptr + offset), value)));
+    }
+
+    static void eval(Tensor<LeftType>& left, const Tensor<RightType>& right)
+    {
+        static_assert(std::is_same<LeftType, RightType>::value, "Complex tensors can only be subtracted from complex tensors of the same type");
+
+        Scalar*       l_ptr = reinterpret_cast<Scalar*>(left.data.data);
+        const Scalar* r_ptr = reinterpret_cast<const Scalar*>(right.data.data);
+
+        int offset = 0, num_blocks = Lanes::num_blocks(left.shape.total());
+        for ( ; num_blocks--; offset += Lanes::Size)
+            simdpp::store(l_ptr + offset, VecType(simdpp::sub(simdpp::load<VecType>(l_ptr + offset),
+                                                              simdpp::load<VecType>(r_ptr + offset))));
+    }
+};
+
+template <typename LeftType, typename RightType>
+struct OptimizedMultiply<LeftType, RightType, typename std::enable_if<IsComplex<LeftType>::value>::type>
+{
+    using Scalar  = typename ScalarType<LeftType>::type;
+    using Lanes   = ComplexSIMD<Scalar>;
+    using VecType = typename Lanes::VecType;
+
+    static void eval(Tensor<LeftType>& tensor, const RightType& scalar)
+    {
+        scale(tensor, scalar, IsComplex<RightType>());
+    }
+
+    static void eval(Tensor<LeftType>& left, const Tensor<RightType>& right)
+    {
+        static_assert(std::is_same<LeftType, RightType>::value, "Complex tensors can only be multiplied by complex tensors of the same type");
+
+        Scalar*       l_ptr = reinterpret_cast<Scalar*>(left.data.data);
+        const Scalar* r_ptr = reinterpret_cast<const Scalar*>(right.data.data);
+
+        const int total = left.shape.total();
+
+        int i = 0;
+        for ( ; i + Lanes::Size <= total; i += Lanes::Size) {
+            VecType re, im, b_re, b_im;
+            simdpp::load_packed2(re, im, l_ptr + 2 * i);
+            simdpp::load_packed2(b_re, b_im, r_ptr + 2 * i);
+
+            Lanes::multiply(re, im, b_re, b_im);
+            simdpp::store_packed2(l_ptr + 2 * i, re, im);
+        }
+
+        for ( ; i < total; ++i)
+            left.data[i] = Lanes::multiply(left.data[i], right.data[i]);
+    }
+
+private:
+    // A real factor scales both parts alike
+    static void scale(Tensor<LeftType>& tensor, const RightType& scalar, std::false_type)
+    {
+        Scalar* ptr = reinterpret_cast<Scalar*>(tensor.data.data);
+        const VecType value = Lanes::splat(static_cast<Scalar>(scalar));
+
+        int offset = 0, num_blocks = Lanes::num_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Lanes::Size)
+            simdpp::store(ptr + offset, VecType(simdpp::mul(simdpp::load<VecType>(ptr + offset), value)));
+    }
+
+    static void scale(Tensor<LeftType>& tensor, const RightType& scalar, std::true_type)
+    {
+        Scalar* ptr = reinterpret_cast<Scalar*>(tensor.data.data);
+
+        const LeftType value = static_cast<LeftType>(scalar);
+        const VecType b_re = Lanes::splat(value.real());
+        const VecType b_im = Lanes::splat(value.imag());
+
+        const int total = tensor.shape.total();
+
+        int i = 0;
+        for ( ; i + Lanes::Size <= total; i += Lanes::Size) {
+            VecType re, im;
+            simdpp::load_packed2(re, im, ptr + 2 * i);
+
+            Lanes::multiply(re, im, b_re, b_im);
+            simdpp::store_packed2(ptr + 2 * i, re, im);
+        }
+
+        for ( ; i < total; ++i)
+            tensor.data[i] = Lanes::multiply(tensor.data[i], value);
+    }
+};
+
+template <typename LeftType, typename RightType>
+struct OptimizedDivide<LeftType, RightType, typename std::enable_if<IsComplex<LeftType>::value>::type>
+{
+    using Scalar  = typename ScalarType<LeftType>::type;
+    using Lanes   = ComplexSIMD<Scalar>;
+    using VecType = typename Lanes::VecType;
+
+    static void eval(Tensor<LeftType>& tensor, const RightType& scalar)
+    {
+        divide(tensor, scalar, IsComplex<RightType>());
+    }
+
+    static void eval(Tensor<LeftType>& left, const Tensor<RightType>& right)
+    {
+        static_assert(std::is_same<LeftType, RightType>::value, "Complex tensors can only be divided by complex tensors of the same type");
+
+        Scalar*       l_ptr = reinterpret_cast<Scalar*>(left.data.data);
+        const Scalar* r_ptr = reinterpret_cast<const Scalar*>(right.data.data);
+
+        const int total = left.shape.total();
+
+        int i = 0;
+        for ( ; i + Lanes::Size <= total; i += Lanes::Size) {
+            VecType re, im, b_re, b_im;
+            simdpp::load_packed2(re, im, l_ptr + 2 * i);
+            simdpp::load_packed2(b_re, b_im, r_ptr + 2 * i);
+
+            Lanes::divide(re, im, b_re, b_im);
+            simdpp::store_packed2(l_ptr + 2 * i, re, im);
+        }
+
+        for ( ; i < total; ++i)
+            left.data[i] = Lanes::divide(left.data[i], right.data[i]);
+    }
+
+private:
+    static void divide(Tensor<LeftType>& tensor, const RightType& scalar, std::false_type)
+    {
+        Scalar* ptr = reinterpret_cast<Scalar*>(tensor.data.data);
+        const VecType value = Lanes::splat(static_cast<Scalar>(scalar));
+
+        int offset = 0, num_blocks = Lanes::num_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Lanes::Size)
+            simdpp::store(ptr + offset, VecType(simdpp::div(simdpp::load<VecType>(ptr + offset), value)));
+    }
+
+    // Dividing by a complex scalar multiplies by its reciprocal
+    static void divide(Tensor<LeftType>& tensor, const RightType& scalar, std::true_type)
+    {
+        OptimizedMultiply<LeftType, LeftType>::eval(tensor, LeftType(1) / static_cast<LeftType>(scalar));
+    }
+};
+
+template <typename DataType>
+struct OptimizedNegate<DataType, typename std::enable_if<IsComplex<DataType>::value>::type>
+{
+    using Scalar  = typename ScalarType<DataType>::type;
+    using Lanes   = ComplexSIMD<Scalar>;
+    using VecType = typename Lanes::VecType;
+
+    static void eval(Tensor<DataType>& tensor) noexcept
+    {
+        Scalar* ptr = reinterpret_cast<Scalar*>(tensor.data.data);
+
+        int offset = 0, num_blocks = Lanes::num_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Lanes::Size)
+            simdpp::store(ptr + offset, VecType(simdpp::neg(simdpp::load<VecType>(ptr + offset))));
+    }
+};
+
+template <typename DataType>
+struct OptimizedConjugate<DataType, typename std::enable_if<IsComplex<DataType>::value>::type>
+{
+    using Scalar  = typename ScalarType<DataType>::type;
+    using Lanes   = ComplexSIMD<Scalar>;
+    using VecType = typename Lanes::VecType;
+
+    static void eval(Tensor<DataType>& tensor) noexcept
+    {
+        Scalar* ptr = reinterpret_cast<Scalar*>(tensor.data.data);
+
+        // Flip the sign bit of every imaginary part
+        const VecType sign = Lanes::pattern(DataType(Scalar(0), -Scalar(0)));
+
+        int offset = 0, num_blocks = Lanes::num_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Lanes::Size)
+            simdpp::store(ptr + offset, VecType(simdpp::bit_xor(simdpp::load<VecType>(ptr + offset), sign)));
+    }
+};
+
+template <typename DataType>
+struct OptimizedComplexParts<DataType, typename std::enable_if<IsComplex<DataType>::value>::type>
+{
+    using Scalar  = typename ScalarType<DataType>::type;
+    using Lanes   = ComplexSIMD<Scalar>;
+    using VecType = typename Lanes::VecType;
+
+    static Tensor<Scalar> magnitude(const Tensor<DataType>& tensor) noexcept
+    {
+        return apply(tensor, HypotSIMD<Scalar>(), &hypot);
+    }
+
+    static Tensor<Scalar> phase(const Tensor<DataType>& tensor) noexcept
+    {
+        return apply(tensor, Atan2Parts(), &atan2);
+    }
+
+    static Tensor<DataType> combine(const Tensor<Scalar>& real, const Tensor<Scalar>& imag) noexcept
+    {
+        Tensor<DataType> result(real.shape);
+
+        Scalar*       dst = reinterpret_cast<Scalar*>(result.data.data);
+        const Scalar* re  = real.data.data;
+        const Scalar* im  = imag.data.data;
+
+        const int total = real.shape.total();
+
+        int i = 0;
+        for ( ; i + Lanes::Size <= total; i += Lanes::Size)
+            simdpp::store_packed2(dst + 2 * i, simdpp::load<VecType>(re + i), simdpp::load<VecType>(im + i));
+
+        for ( ; i < total; ++i)
+            result.data[i] = DataType(re[i], im[i]);
+
+        return result;
+    }
+
+private:
+    // [Atan2SIMD]() takes the imaginary part first
+    struct Atan2Parts
+    {
+        TNT_INL VecType run(const VecType& re, const VecType& im) const
+        {
+            return Atan2SIMD<Scalar>().run(im, re);
+        }
+    };
+
+    static Scalar hypot(const DataType& value) { return std::hypot(value.real(), value.imag()); }
+    static Scalar atan2(const DataType& value) { return std::atan2(value.imag(), value.real()); }
+
+    template <typename Function>
+    static Tensor<Scalar> apply(const Tensor<DataType>& tensor, const Function& function, Scalar (*tail)(const DataType&))
+    {
+        Tensor<Scalar> result(tensor.shape);
+
+        const Scalar* src = reinterpret_cast<const Scalar*>(tensor.data.data);
+        Scalar*       dst = result.data.data;
+
+        const int total = tensor.shape.total();
+
+        int i = 0;
+        for ( ; i + Lanes::Size <= total; i += Lanes::Size) {
+            VecType re, im;
+            simdpp::load_packed2(re, im, src + 2 * i);
+            simdpp::store(dst + i, function.run(re, im));
+        }
+
+        for ( ; i < total; ++i)
+            dst[i] = tail(tensor.data[i]);
+
+        return result;
+    }
+};
+
+} // namespace detail
+
+namespace
+{
+
+template <typename T>
+Tensor<std::complex<T>> random_complex(const Shape& shape, int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<T> distribution(-2, 2);
+
+    Tensor<std::complex<T>> tensor(shape);
+    for (int i = 0; i < shape.total(); ++i)
+        tensor.data[i] = std::complex<T>(distribution(generator), distribution(generator));
+
+    return tensor;
+}
+
+template <typename T>
+bool near(const std::complex<T>& value, const std::complex<T>& expected)
+{
+    return std::abs(value - expected) <= 8 * std::numeric_limits<T>::epsilon() * std::max(T(1), std::abs(expected));
+}
+
+} // namespace
+
+TEST_CASE_TEMPLATE("real(const Tensor<std::complex<T>>&) / imag(const Tensor<std::complex<T>>&)", T, test_float_data_types)
+{
+    Tensor<std::complex<T>> tensor(Shape{3, 5});
+    for (int i = 0; i < 15; ++i)
+        tensor.data[i] = std::complex<T>(T(i), T(-i));
+
+    TensorView<T> re = real(tensor);
+    TensorView<T> im = imag(tensor);
+
+    REQUIRE(re.shape == tensor.shape);
+    REQUIRE(im.shape == tensor.shape);
+
+    int i = 0;
+    for (auto it = re.begin(); it != re.end(); it++, ++i)
+        REQUIRE(*it == T(i));
+    REQUIRE(i == 15);
+
+    i = 0;
+    for (auto it = im.begin(); it != im.end(); it++, ++i)
+        REQUIRE(*it == T(-i));
+    REQUIRE(i == 15);
+
+    // Views alias the tensor
+    REQUIRE((T) re(1, 2) == T(7));
+    im(2) = T(100);
+    for (int j = 0; j < 5; ++j) {
+        REQUIRE(tensor.data[10 + j] == std::complex<T>(T(10 + j), T(100)));
+        REQUIRE(tensor.data[j] == std::complex<T>(T(j), T(-j)));
+    }
+}
+
+TEST_CASE_TEMPLATE("make_complex(const Tensor<T>&, const Tensor<T>&)", T, test_float_data_types)
+{
+    for (int size : {1, 3, 8, 17, 64}) {
+        Tensor<T> re(Shape{size}), im(Shape{size});
+        for (int i = 0; i < size; ++i) {
+            re.data[i] = T(i) / 2;
+            im.data[i] = T(1) - T(i);
+        }
+
+        Tensor<std::complex<T>> tensor = make_complex(re, im);
+        REQUIRE(tensor.shape == Shape{size});
+        for (int i = 0; i < size; ++i)
+            REQUIRE(tensor.data[i] == std::complex<T>(re.data[i], im.data[i]));
+    }
+
+    REQUIRE_THROWS(make_complex(Tensor<T>(Shape{2, 3}), Tensor<T>(Shape{3, 2})));
+}
+
+TEST_CASE_TEMPLATE("Tensor<std::complex<T>> arithmetic", T, test_float_data_types)
+{
+    using Complex = std::complex<T>;
+
+    for (int size : {1, 5, 16, 37, 130}) {
+        const Tensor<Complex> a = random_complex<T>(Shape{size}, size);
+        const Tensor<Complex> b = random_complex<T>(Shape{size}, size + 1000);
+        const Complex z(T(0.5), T(-1.25));
+
+        const Tensor<Complex> sum        = a + b;
+        const Tensor<Complex> difference = a - b;
+        const Tensor<Complex> product    = a * b;
+        const Tensor<Complex> quotient   = a / b;
+
+        const Tensor<Complex> shifted    = a + z;
+        const Tensor<Complex> lowered    = a - z;
+        const Tensor<Complex> rotated    = a * z;
+        const Tensor<Complex> divided    = a / z;
+        const Tensor<Complex> scaled     = a * T(3);
+        const Tensor<Complex> halved     = a / 2;
+
+        Tensor<Complex> negated = a;
+        negate(negated);
+
+        for (int i = 0; i < size; ++i) {
+            REQUIRE(near(sum.data[i],        a.data[i] + b.data[i]));
+            REQUIRE(near(difference.data[i], a.data[i] - b.data[i]));
+            REQUIRE(near(product.data[i],    a.data[i] * b.data[i]));
+            REQUIRE(near(quotient.data[i],   a.data[i] / b.data[i]));
+
+            REQUIRE(near(shifted.data[i], a.data[i] + z));
+            REQUIRE(near(lowered.data[i], a.data[i] - z));
+            REQUIRE(near(rotated.data[i], a.data[i] * z));
+            REQUIRE(near(divided.data[i], a.data[i] / z));
+            REQUIRE(scaled.data[i] == a.data[i] * T(3));
+            REQUIRE(halved.data[i] == a.data[i] / T(2));
+            REQUIRE(negated.data[i] == -a.data[i]);
+        }
+    }
+
+    Tensor<Complex> tensor(Shape{4}, Complex(1, 1));
+    REQUIRE_THROWS(tensor / Complex(0));
+    REQUIRE_THROWS(tensor * Tensor<Complex>(Shape{5}));
+}
+
+TEST_CASE_TEMPLATE("conjugate(Tensor<std::complex<T>>&)", T, test_float_data_types)
+{
+    for (int size : {1, 7, 32, 45}) {
+        const Tensor<std::complex<T>> tensor = random_complex<T>(Shape{size}, size);
+
+        Tensor<std::complex<T>> result = tensor;
+        conjugate(result);
+
+        for (int i = 0; i < size; ++i)
+            REQUIRE(result.data[i] == std::conj(tensor.data[i]));
+    }
+}
+
+TEST_CASE_TEMPLATE("magnitude(const Tensor<std::complex<T>>&) / phase(const Tensor<std::complex<T>>&)", T, test_float_data_types)
+{
+    using Complex = std::complex<T>;
+
+    const T zero = 0, big = std::numeric_limits<T>::max() / 4, tiny = std::numeric_limits<T>::min() * 4;
+    const T infinity = std::numeric_limits<T>::infinity();
+
+    std::vector<Complex> values = {
+        Complex(zero, zero), Complex(-zero, zero), Complex(zero, -zero), Complex(-zero, -zero),
+        Complex(1, 0), Complex(-1, 0), Complex(0, 1), Complex(0, -1),
+        Complex(1, 1), Complex(-1, 1), Complex(-1, -1), Complex(1, -1),
+        Complex(3, 4), Complex(-4, 3), Complex(big, big), Complex(tiny, -tiny),
+        Complex(infinity, 1), Complex(-2, infinity), Complex(T(1e-3), T(-1e3)), Complex(T(-1e3), T(-1e-3))
+    };
+
+    const Tensor<Complex> random = random_complex<T>(Shape{203}, 7);
+    values.insert(values.end(), random.data.data, random.data.data + 203);
+
+    Tensor<Complex> tensor(Shape{(int) values.size()});
+    for (int i = 0; i < (int) values.size(); ++i)
+        tensor.data[i] = values[i];
+
+    const Tensor<T> magnitudes = magnitude(tensor);
+    const Tensor<T> phases = phase(tensor);
+
+    REQUIRE(magnitudes.shape == tensor.shape);
+    REQUIRE(phases.shape == tensor.shape);
+
+    const T tolerance = 4 * std::numeric_limits<T>::epsilon();
+    for (int i = 0; i < (int) values.size(); ++i) {
+        const T expected_magnitude = std::abs(values[i]);
+        const T expected_phase     = std::arg(values[i]);
+
+        if (std::isinf(expected_magnitude))
+            REQUIRE(magnitudes.data[i] == expected_magnitude);
+        else
+            REQUIRE(std::fabs(magnitudes.data[i] - expected_magnitude) <= tolerance * expected_magnitude);
+
+        REQUIRE(std::fabs(phases.data[i] - expected_phase) <= tolerance * std::max(T(1), std::fabs(expected_phase)));
+        REQUIRE(std::signbit(phases.data[i]) == std::signbit(expected_phase));
+    }
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_COMPLEX_IMPL_HPP
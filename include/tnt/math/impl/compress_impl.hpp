@@ -0,0 +1,116 @@
+#ifndef TNT_MATH_COMPRESS_IMPL_HPP
+#define TNT_MATH_COMPRESS_IMPL_HPP
+
+#include <tnt/math/select_ops.hpp>
+#include <tnt/core/impl/bit_mask_impl.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType, typename MaskType>
+struct OptimizedCompress<DataType, MaskType>
+{
+    /// Compaction runs over the packed mask 64 elements at a time. Empty
+    /// words are skipped, full words are copied as a block and mixed words
+    /// visit only their set bits. Byte masks are packed first with SIMD, which
+    /// also yields the output length with a popcount.
+    static Tensor<DataType> eval(const Tensor<DataType>& tensor, const MaskType& mask)
+    {
+        return run(tensor, pack(mask));
+    }
+
+private:
+    static const BitMask& pack(const BitMask& mask)
+    {
+        return mask;
+    }
+
+    static BitMask pack(const Tensor<uint8_t>& mask)
+    {
+        return BitMask(mask);
+    }
+
+    static Tensor<DataType> run(const Tensor<DataType>& tensor, const BitMask& mask)
+    {
+        Tensor<DataType> result(Shape{mask.count()});
+
+        const DataType*          t_ptr = tensor.data.data;
+        const BitMask::WordType* w_ptr = mask.data.data;
+        DataType*                r_ptr = result.data.data;
+
+        int count = 0;
+        for (int w = 0; w < mask.num_words(); ++w) {
+            BitMask::WordType word = w_ptr[w];
+            const DataType*   base = t_ptr + w * BitMask::WordBits;
+
+            if (word == ~BitMask::WordType(0)) {
+                memcpy(r_ptr + count, base, sizeof(DataType) * BitMask::WordBits);
+                count += BitMask::WordBits;
+                continue;
+            }
+
+            for ( ; word; word &= word - 1)
+                r_ptr[count++] = base[count_trailing_zeros(word)];
+        }
+
+        return result;
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("compress(Tensor<T>&, MaskType&)", T, test_data_types)
+{
+    { // 2x3
+        T data[6]     = {4, 1, 5, 9, 2, 6};
+        T expected[3] = {5, 9, 6};
+
+        Tensor<T> tensor(Shape{2, 3}, AlignedPtr<T>(data, 6));
+
+        REQUIRE((compress(tensor, tensor > 4) == Tensor<T>(Shape{3}, AlignedPtr<T>(expected, 3))));
+        REQUIRE((compress(tensor, BitMask(tensor > 4)) == Tensor<T>(Shape{3}, AlignedPtr<T>(expected, 3))));
+        REQUIRE(compress(tensor, tensor > 9).shape.total() == 0);
+    }
+
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> tensor(shape);
+        Tensor<uint8_t> mask(shape);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            tensor.data[i] = (T) (i % 100);
+            mask.data[i]   = (i % 7 == 2 || (i >= 64 && i < 192)) ? 255 : 0;
+        }
+
+        std::vector<T> expected;
+        for (int i = 0; i < shape.total(); ++i)
+            if (mask.data[i])
+                expected.push_back(tensor.data[i]);
+
+        Tensor<T> expected_tensor(Shape{(int) expected.size()}, AlignedPtr<T>(expected.data(), expected.size()));
+
+        REQUIRE((compress(tensor, mask) == expected_tensor));
+        REQUIRE((compress(tensor, BitMask(mask)) == expected_tensor));
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    REQUIRE_THROWS(compress(Tensor<T>(Shape{2, 2}), Tensor<uint8_t>(Shape{2, 3})));
+    REQUIRE_THROWS(compress(Tensor<T>(Shape{2, 2}), BitMask(Shape{4})));
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_COMPRESS_IMPL_HPP
@@ -0,0 +1,106 @@
+#ifndef TNT_MATH_COUNT_IF_IMPL_HPP
+#define TNT_MATH_COUNT_IF_IMPL_HPP
+
+#include <tnt/math/reduce_ops.hpp>
+#include <tnt/math/impl/compare_predicate_impl.hpp>
+#include <tnt/core/impl/bit_mask_impl.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType>
+struct OptimizedCountIf<DataType>
+{
+    static int eval(const Tensor<DataType>& tensor, Comparison op, const DataType& scalar)
+    {
+        return dispatch_comparison<Kernel, int>(op, tensor, scalar);
+    }
+
+private:
+    /// Each 16 element compare is collapsed to a bitfield with a movemask and
+    /// counted with a popcount
+    template <Comparison Op>
+    struct Kernel
+    {
+        using Pack    = PackMaskBits<DataType>;
+        using VecType = typename Pack::VecType;
+
+        static int run(const Tensor<DataType>& tensor, const DataType& scalar)
+        {
+            const DataType* t_ptr = tensor.data.data;
+            auto scalar_vec = simdpp::load_splat<VecType>(&scalar);
+
+            const int total      = tensor.shape.total();
+            const int num_groups = total / Pack::Size;
+
+            int count = 0;
+            for (int g = 0; g < num_groups; ++g) {
+                VecType block = simdpp::load<VecType>(t_ptr + g * Pack::Size);
+                count += popcount(Pack::pack(ComparePredicate<Op>::simd(block, scalar_vec)));
+            }
+
+            for (int i = num_groups * Pack::Size; i < total; ++i)
+                count += ComparePredicate<Op>::scalar(t_ptr[i], scalar);
+
+            return count;
+        }
+    };
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("count_if(Tensor<T>&, Comparison, Scalar)", T, test_data_types)
+{
+    { // 2x3
+        T data[6] = {1, 4, 2, 4, 7, 0};
+        Tensor<T> tensor(Shape{2, 3}, AlignedPtr<T>(data, 6));
+
+        REQUIRE(count_if(tensor, Comparison::Equal,          4) == 2);
+        REQUIRE(count_if(tensor, Comparison::NotEqual,       4) == 4);
+        REQUIRE(count_if(tensor, Comparison::LessThan,       4) == 3);
+        REQUIRE(count_if(tensor, Comparison::GreaterThan,    4) == 1);
+        REQUIRE(count_if(tensor, Comparison::LessOrEqual,    4) == 5);
+        REQUIRE(count_if(tensor, Comparison::GreaterOrEqual, 4) == 3);
+    }
+
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> tensor(shape);
+        for (int i = 0; i < shape.total(); ++i)
+            tensor.data[i] = (T) ((i * 37) % 101);
+
+        int counts[6] = {0, 0, 0, 0, 0, 0};
+        for (int i = 0; i < shape.total(); ++i) {
+            counts[0] += tensor.data[i] == 50;
+            counts[1] += tensor.data[i] != 50;
+            counts[2] += tensor.data[i] <  50;
+            counts[3] += tensor.data[i] >  50;
+            counts[4] += tensor.data[i] <= 50;
+            counts[5] += tensor.data[i] >= 50;
+        }
+
+        REQUIRE(count_if(tensor, Comparison::Equal,          50) == counts[0]);
+        REQUIRE(count_if(tensor, Comparison::NotEqual,       50) == counts[1]);
+        REQUIRE(count_if(tensor, Comparison::LessThan,       50) == counts[2]);
+        REQUIRE(count_if(tensor, Comparison::GreaterThan,    50) == counts[3]);
+        REQUIRE(count_if(tensor, Comparison::LessOrEqual,    50) == counts[4]);
+        REQUIRE(count_if(tensor, Comparison::GreaterOrEqual, 50) == counts[5]);
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    REQUIRE(count_if(Tensor<T>(), Comparison::Equal, 0) == 0);
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_COUNT_IF_IMPL_HPP
@@ -5,28 +5,239 @@
 #include <tnt/utils/simd.hpp>
 #include <tnt/utils/testing.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <random>
+
 namespace tnt
 {
 
 namespace detail
 {
 
+/// Unsigned integer wide enough to hold `2^(2N)` for `N` bit division magic
+/// numbers. Without a 128 bit type 64 bit division stays scalar.
+template <int Bytes> struct DivisionWideType { using Type = uint64_t; };
+
+#if defined(__SIZEOF_INT128__)
+template <> struct DivisionWideType<8> { using Type = unsigned __int128; };
+#else
+template <> struct DivisionWideType<8> { using Type = void; };
+#endif
+
+template <typename T>
+struct HasDivisionMagic
+{
+    constexpr static bool value = !std::is_void<typename DivisionWideType<sizeof(T)>::Type>::value;
+};
+
+/// Division by an invariant integer as a multiply and shifts, following
+/// Granlund and Montgomery, "Division by Invariant Integers using
+/// Multiplication" (1994). The magic number is computed once per divisor
+/// and applied with a SIMD high multiply. Results match C++ integer
+/// division exactly, including truncation towards zero for signed types.
+template <typename T, typename Enable = void>
+struct IntegerDivisor;
+
+template <typename T>
+struct IntegerDivisor<T, typename std::enable_if<std::is_unsigned<T>::value>::type>
+{
+    using Multiply = MultiplyHighSIMD<T>;
+    using VecType  = typename Multiply::VecType;
+    using WideType = typename DivisionWideType<sizeof(T)>::Type;
+
+    constexpr static int Bits = 8 * sizeof(T);
+
+    explicit IntegerDivisor(T divisor)
+    {
+        int log = 0;
+        while (log < Bits && (WideType(1) << log) < divisor)
+            ++log;
+
+        const T magic = (T) ((WideType(1) << Bits) * ((WideType(1) << log) - divisor) / divisor + 1);
+
+        magic_vec = simdpp::load_splat<VecType>(&magic);
+        shift1    = log > 0 ? 1 : 0;
+        shift2    = log > 0 ? log - 1 : 0;
+    }
+
+    TNT_INL VecType run(const VecType& value) const
+    {
+        VecType high = Multiply::run(magic_vec, value);
+        return simdpp::shift_r(simdpp::add(high, simdpp::shift_r(simdpp::sub(value, high), shift1)), shift2);
+    }
+
+    VecType  magic_vec;
+    unsigned shift1, shift2;
+};
+
+template <typename T>
+struct IntegerDivisor<T, typename std::enable_if<std::is_signed<T>::value>::type>
+{
+    using Multiply     = MultiplyHighSIMD<T>;
+    using VecType      = typename Multiply::VecType;
+    using UnsignedType = typename std::make_unsigned<T>::type;
+    using WideType     = typename DivisionWideType<sizeof(T)>::Type;
+
+    constexpr static int Bits = 8 * sizeof(T);
+
+    explicit IntegerDivisor(T divisor)
+    {
+        const UnsignedType abs_divisor = divisor < 0 ? UnsignedType(0) - UnsignedType(divisor) : UnsignedType(divisor);
+
+        int log = 0;
+        while ((WideType(1) << log) < abs_divisor)
+            ++log;
+        log = std::max(log, 1);
+
+        // 2^(N + l - 1) / |d| + 1 - 2^N, reduced modulo 2^N
+        const T magic = (T) (UnsignedType) ((WideType(1) << (Bits + log - 1)) / abs_divisor + 1);
+        const T sign  = divisor < 0 ? T(-1) : T(0);
+
+        magic_vec = simdpp::load_splat<VecType>(&magic);
+        sign_vec  = simdpp::load_splat<VecType>(&sign);
+        shift     = log - 1;
+    }
+
+    TNT_INL VecType run(const VecType& value) const
+    {
+        VecType quotient = simdpp::add(value, Multiply::run(magic_vec, value));
+        quotient = simdpp::sub(simdpp::shift_r(quotient, shift), simdpp::shift_r<Bits - 1>(value));
+
+        return simdpp::sub(simdpp::bit_xor(quotient, sign_vec), sign_vec);
+    }
+
+    VecType  magic_vec, sign_vec;
+    unsigned shift;
+};
+
+/// Exact elementwise integer division through floating point. A correctly
+/// rounded quotient of integers below `2^24` (`2^53` for double) is never
+/// close enough to the next integer to round across it, so truncating it
+/// gives the exact integer quotient without a refinement step. 8 and 16 bit
+/// types divide in float, 32 bit types in double.
+template <typename T, typename Enable = void>
+struct FloatDivision;
+
+template <typename T>
+struct FloatDivision<T, typename std::enable_if<sizeof(T) <= 2>::type>
+{
+    constexpr static int Size = OptimalSIMDSize<T>::value;
+
+    using VecType = typename SIMDType<T>::VecType;
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right)
+    {
+        simdpp::float32<Size> quotient = simdpp::div(simdpp::to_float32(simdpp::to_int32(left)),
+                                                     simdpp::to_float32(simdpp::to_int32(right)));
+
+        return ConvertSIMDType<T>::convert(simdpp::to_int32(quotient));
+    }
+};
+
+template <>
+struct FloatDivision<int32_t>
+{
+    constexpr static int Size = OptimalSIMDSize<int32_t>::value;
+
+    using VecType = typename SIMDType<int32_t>::VecType;
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right)
+    {
+        return simdpp::to_int32(simdpp::div(simdpp::to_float64(left), simdpp::to_float64(right)));
+    }
+};
+
+// Unsigned 32 bit values are biased into the signed range to convert them
+template <>
+struct FloatDivision<uint32_t>
+{
+    constexpr static int Size = OptimalSIMDSize<uint32_t>::value;
+
+    using VecType = typename SIMDType<uint32_t>::VecType;
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right)
+    {
+        const uint32_t sign = 0x80000000u;
+        const double   bias = 2147483648.0;
+
+        auto sign_vec = simdpp::load_splat<VecType>(&sign);
+        auto bias_vec = simdpp::load_splat<simdpp::float64<Size>>(&bias);
+
+        simdpp::float64<Size> l_float = simdpp::add(simdpp::to_float64(simdpp::bit_cast<simdpp::int32<Size>>(simdpp::bit_xor(left, sign_vec))), bias_vec);
+        simdpp::float64<Size> r_float = simdpp::add(simdpp::to_float64(simdpp::bit_cast<simdpp::int32<Size>>(simdpp::bit_xor(right, sign_vec))), bias_vec);
+
+        simdpp::float64<Size> quotient = simdpp::sub(simdpp::trunc(simdpp::div(l_float, r_float)), bias_vec);
+        return simdpp::bit_xor(simdpp::bit_cast<VecType>(simdpp::to_int32(quotient)), sign_vec);
+    }
+};
+
 template <typename LeftType, typename RightType>
 struct OptimizedDivide<LeftType, RightType,
             typename std::enable_if<std::is_integral<LeftType>::value>::type>
 {
     static void eval(Tensor<LeftType>& tensor, const RightType& _scalar)
     {
+        eval_scalar(tensor, static_cast<LeftType>(_scalar), std::integral_constant<bool, HasDivisionMagic<LeftType>::value>());
+    }
+
+    static void eval(Tensor<LeftType>& left, const Tensor<RightType>& right)
+    {
+        eval_tensor(left, right, std::integral_constant<bool, sizeof(LeftType) <= 4>());
+    }
+
+private:
+    static void eval_scalar(Tensor<LeftType>& tensor, const LeftType scalar, std::true_type)
+    {
+        using Divisor = IntegerDivisor<LeftType>;
+        using VecType = typename Divisor::VecType;
+
+        constexpr int Size = Divisor::Multiply::Size;
+
         LeftType* ptr = tensor.data.data;
+        const Divisor divisor(scalar);
+
+        const int total = tensor.shape.total();
 
-        const LeftType scalar = static_cast<LeftType>(_scalar);
+        int offset = 0;
+        for ( ; offset + Size <= total; offset += Size)
+            simdpp::store(ptr + offset, divisor.run(simdpp::load<VecType>(ptr + offset)));
+
+        for ( ; offset < total; ++offset)
+            ptr[offset] /= scalar;
+    }
+
+    static void eval_scalar(Tensor<LeftType>& tensor, const LeftType scalar, std::false_type)
+    {
+        LeftType* ptr = tensor.data.data;
 
         int i = 0, total = tensor.shape.total();
         for ( ; total--; ++i)
             ptr[i] /= scalar;
     }
 
-    static void eval(Tensor<LeftType>& left, const Tensor<RightType>& right)
+    static void eval_tensor(Tensor<LeftType>& left, const Tensor<RightType>& right, std::true_type)
+    {
+        using Division = FloatDivision<LeftType>;
+        using VecType  = typename Division::VecType;
+
+        constexpr int Size = Division::Size;
+
+        LeftType*        l_ptr = left.data.data;
+        const RightType* r_ptr = right.data.data;
+
+        const int total = left.shape.total();
+
+        int offset = 0;
+        for ( ; offset + Size <= total; offset += Size)
+            simdpp::store(l_ptr + offset, Division::run(simdpp::load<VecType>(l_ptr + offset),
+                                                        LoadSIMDType<LeftType, RightType>::load(r_ptr + offset)));
+
+        for ( ; offset < total; ++offset)
+            l_ptr[offset] /= static_cast<LeftType>(r_ptr[offset]);
+    }
+
+    static void eval_tensor(Tensor<LeftType>& left, const Tensor<RightType>& right, std::false_type)
     {
         LeftType* l_ptr        = left.data.data;
         const RightType* r_ptr = right.data.data;
@@ -250,6 +461,85 @@ TEST_CASE_TEMPLATE("divide(Tensor<floating>&, const Tensor<float>&)", T, test_fl
     test_shape(Shape{4, 4, 4, 5});
 }
 
+TEST_CASE_TEMPLATE("divide(Tensor<integer>&, Scalar) matches integer division", T, test_integer_data_types)
+{
+    using TensorType = Tensor<T>;
+    using Limits     = std::numeric_limits<T>;
+
+    auto check = [](const TensorType& numerators, T divisor) {
+        TensorType result = numerators / divisor;
+        for (int i = 0; i < numerators.shape.total(); ++i)
+            REQUIRE(result.data[i] == (T) (numerators.data[i] / divisor));
+    };
+
+    if (sizeof(T) <= 2) {
+        // Every numerator, against every divisor for 8 bit types and a set of
+        // edge case divisors for 16 bit types
+        const int count = 1 << (8 * std::min<int>(sizeof(T), 2));
+
+        TensorType numerators(Shape{count});
+        for (int i = 0; i < count; ++i)
+            numerators.data[i] = (T) (Limits::min() + i);
+
+        if (sizeof(T) == 1) {
+            for (int d = Limits::min(); d <= (int) Limits::max(); ++d)
+                if (d != 0 && !(Limits::is_signed && d == -1))
+                    check(numerators, (T) d);
+        } else {
+            const long long divisors[] = {1, 2, 3, 7, 10, 100, 255, 256, 641, 32767,
+                                          32768, 65535, -3, -256, -32767};
+            for (long long d : divisors)
+                check(numerators, (T) d);
+        }
+    } else {
+        std::mt19937_64 generator(12345);
+
+        TensorType numerators(Shape{1001});
+        for (int i = 0; i < numerators.shape.total(); ++i)
+            numerators.data[i] = (T) generator();
+
+        numerators.data[0] = Limits::max();
+        numerators.data[1] = Limits::min() + (Limits::is_signed ? 1 : 0);
+        numerators.data[2] = 0;
+
+        const T divisors[] = {1, 2, 3, 7, 10, (T) 641, (T) 1000000007, Limits::max(), (T) (Limits::max() / 2 + 1),
+                              (T) -7, (T) -1000000007, (T) (Limits::min() + 1)};
+        for (T d : divisors)
+            check(numerators, d);
+
+        for (int i = 0; i < 100; ++i) {
+            const T d = (T) (generator() >> (generator() % (8 * sizeof(T))));
+            if (d != 0 && !(Limits::is_signed && d == (T) -1))
+                check(numerators, d);
+        }
+    }
+}
+
+TEST_CASE_TEMPLATE("divide(Tensor<integer>&, const Tensor<integer>&) matches integer division", T, test_integer_data_types)
+{
+    using TensorType = Tensor<T>;
+    using Limits     = std::numeric_limits<T>;
+
+    std::mt19937_64 generator(54321);
+
+    TensorType numerators(Shape{4, 257}), divisors(Shape{4, 257});
+    for (int i = 0; i < numerators.shape.total(); ++i) {
+        numerators.data[i] = (T) generator();
+        divisors.data[i]   = (T) (generator() >> (generator() % (8 * sizeof(T))));
+
+        if (divisors.data[i] == 0 || (Limits::is_signed && divisors.data[i] == (T) -1))
+            divisors.data[i] = 3;
+    }
+
+    numerators.data[0] = Limits::max(); divisors.data[0] = 1;
+    numerators.data[1] = Limits::max(); divisors.data[1] = Limits::max();
+    numerators.data[2] = Limits::min(); divisors.data[2] = 1;
+
+    TensorType result = numerators / divisors;
+    for (int i = 0; i < numerators.shape.total(); ++i)
+        REQUIRE(result.data[i] == (T) (numerators.data[i] / divisors.data[i]));
+}
+
 } // namespace tnt
 
 #endif // TNT_MATH_DIVIDE_IMPL_HPP
@@ -0,0 +1,106 @@
+#ifndef TNT_MATH_MASKED_ASSIGN_IMPL_HPP
+#define TNT_MATH_MASKED_ASSIGN_IMPL_HPP
+
+#include <tnt/math/select_ops.hpp>
+#include <tnt/core/impl/bit_mask_impl.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType, typename MaskType>
+struct OptimizedMaskedAssign<DataType, MaskType>
+{
+    using Expand  = ExpandMaskBytes<DataType>;
+    using VecType = typename Expand::VecType;
+
+    constexpr static int Size = Expand::Size;
+
+    /// Groups with no selected elements are skipped without a load or store,
+    /// which keeps sparse masks cheap.
+    static void eval(Tensor<DataType>& tensor, const MaskType& mask, const DataType& value)
+    {
+        DataType* t_ptr = tensor.data.data;
+
+        MaskGroups<MaskType> groups(mask);
+        auto value_vec = simdpp::load_splat<VecType>(&value);
+
+        const int total      = tensor.shape.total();
+        const int num_groups = total / Size;
+
+        for (int g = 0; g < num_groups; ++g) {
+            const int offset = g * Size;
+
+            simdpp::int8<Size> bytes;
+            const uint16_t bits = groups.load(g, bytes);
+
+            if (bits == 0)
+                continue;
+            else if (bits == 0xFFFF)
+                simdpp::store(t_ptr + offset, value_vec);
+            else
+                simdpp::store(t_ptr + offset, VecType(simdpp::blend(value_vec,
+                                                                    simdpp::load<VecType>(t_ptr + offset),
+                                                                    Expand::expand(bytes))));
+        }
+
+        for (int i = num_groups * Size; i < total; ++i)
+            if (groups.test(i))
+                t_ptr[i] = value;
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("masked_assign(Tensor<T>&, MaskType&, Scalar)", T, test_data_types)
+{
+    { // 2x2
+        T data[4]     = {1, 5, 2, 7};
+        T expected[4] = {1, 0, 2, 0};
+
+        Tensor<T> tensor(Shape{2, 2}, AlignedPtr<T>(data, 4));
+        masked_assign(tensor, tensor > 4, 0);
+
+        REQUIRE((tensor == Tensor<T>(Shape{2, 2}, AlignedPtr<T>(expected, 4))));
+    }
+
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> original(shape);
+        Tensor<uint8_t> mask(shape);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            original.data[i] = (T) (i % 50);
+            mask.data[i]     = (i % 5 == 1 || (i >= 48 && i < 80)) ? 255 : 0;
+        }
+
+        Tensor<T> from_bytes = original;
+        masked_assign(from_bytes, mask, 99);
+
+        Tensor<T> from_bits = original;
+        masked_assign(from_bits, BitMask(mask), 99);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            REQUIRE(from_bytes.data[i] == (mask.data[i] ? (T) 99 : original.data[i]));
+            REQUIRE(from_bits.data[i]  == (mask.data[i] ? (T) 99 : original.data[i]));
+        }
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    Tensor<T> tensor(Shape{2, 2});
+    REQUIRE_THROWS(masked_assign(tensor, Tensor<uint8_t>(Shape{4}), 1));
+    REQUIRE_THROWS(masked_assign(tensor, BitMask(Shape{2, 3}), 1));
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_MASKED_ASSIGN_IMPL_HPP
@@ -0,0 +1,99 @@
+#ifndef TNT_MATH_MINIMUM_IMPL_HPP
+#define TNT_MATH_MINIMUM_IMPL_HPP
+
+#include <tnt/math/arithmetic_ops.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <algorithm>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename LeftType, typename RightType>
+struct OptimizedMinimum<LeftType, RightType>
+{
+    using VecType = typename SIMDType<LeftType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<LeftType>::value;
+
+    static void eval(Tensor<LeftType>& tensor, const RightType& _scalar) noexcept
+    {
+        if (tensor.shape.total() == 0)
+            return;
+
+        LeftType* ptr = tensor.data.data;
+
+        LeftType scalar = static_cast<LeftType>(_scalar);
+        auto scalar_vec = simdpp::load_splat<VecType>(&scalar);
+
+        int offset = 0, num_blocks = AlignSIMDType<LeftType>::num_aligned_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType block = simdpp::load<VecType>(ptr + offset);
+            simdpp::store(ptr + offset, VecType(simdpp::min(block, scalar_vec)));
+        }
+    }
+
+    static void eval(Tensor<LeftType>& left, const Tensor<RightType>& right) noexcept
+    {
+        if (left.shape.total() == 0)
+            return;
+
+        LeftType*       l_ptr = left.data.data;
+        const LeftType* r_ptr = right.data.data;
+
+        int offset = 0, num_blocks = AlignSIMDType<LeftType>::num_aligned_blocks(left.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType l_block = simdpp::load<VecType>(l_ptr + offset);
+            VecType r_block = simdpp::load<VecType>(r_ptr + offset);
+            simdpp::store(l_ptr + offset, VecType(simdpp::min(l_block, r_block)));
+        }
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("minimum(Tensor<T>&, Scalar)", T, test_data_types)
+{
+    T data[6]     = {1, 9, 4, 7, 0, 5};
+    T expected[6] = {1, 5, 4, 5, 0, 5};
+
+    Tensor<T> tensor(Shape{2, 3}, AlignedPtr<T>(data, 6));
+    minimum(tensor, 5);
+
+    REQUIRE((tensor == Tensor<T>(Shape{2, 3}, AlignedPtr<T>(expected, 6))));
+}
+
+TEST_CASE_TEMPLATE("minimum(Tensor<T>&, Tensor<T>&)", T, test_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> left(shape), right(shape);
+        for (int i = 0; i < shape.total(); ++i) {
+            left.data[i]  = (T) (i % 7);
+            right.data[i] = (T) (i % 5);
+        }
+
+        Tensor<T> result = left;
+        minimum(result, right);
+
+        for (int i = 0; i < shape.total(); ++i)
+            REQUIRE(result.data[i] == std::min(left.data[i], right.data[i]));
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    Tensor<T> tensor(Shape{2, 2});
+    REQUIRE_THROWS(minimum(tensor, Tensor<T>(Shape{4})));
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_MINIMUM_IMPL_HPP
@@ -15,29 +15,94 @@ namespace detail
 template <typename LeftType, typename RightType>
 struct OptimizedMultiply<LeftType, RightType,
             typename std::enable_if<std::is_same<LeftType, uint8_t>::value
-                                    || std::is_same<LeftType, int8_t>::value
-                                    || std::is_same<LeftType, uint64_t>::value
+                                    || std::is_same<LeftType, int8_t>::value>::type>
+{
+    static void eval(Tensor<LeftType>& tensor, const RightType& _scalar)
+    {
+        LeftType* ptr = tensor.data.data;
+
+        LeftType scalar = static_cast<LeftType>(_scalar);
+        auto scalar_vec = simdpp::load_splat<typename SIMDType<LeftType>::VecType>(&scalar);
+
+        int offset = 0, num_blocks = AlignSIMDType<LeftType>::num_aligned_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += OptimalSIMDSize<LeftType>::value) {
+            auto block = LoadSIMDType<LeftType, LeftType>::load(ptr + offset);
+            auto result = MultiplySIMD<LeftType>::run(block, scalar_vec);
+            simdpp::store(ptr + offset, result);
+        }
+    }
+
+    static void eval(Tensor<LeftType>& left, const Tensor<RightType>& right)
+    {
+        LeftType*  l_ptr = left.data.data;
+        RightType* r_ptr = right.data.data;
+
+        int offset = 0, num_blocks = AlignSIMDType<LeftType>::num_aligned_blocks(left.shape.total());
+        for ( ; num_blocks--; offset += OptimalSIMDSize<LeftType>::value) {
+            auto l_block = LoadSIMDType<LeftType, LeftType>::load(l_ptr + offset);
+            auto r_block = LoadSIMDType<LeftType, RightType>::load(r_ptr + offset);
+            auto result = MultiplySIMD<LeftType>::run(l_block, r_block);
+            simdpp::store(l_ptr + offset, result);
+        }
+    }
+};
+
+template <typename LeftType, typename RightType>
+struct OptimizedMultiply<LeftType, RightType,
+            typename std::enable_if<std::is_same<LeftType, uint64_t>::value
                                     || std::is_same<LeftType, int64_t>::value>::type>
 {
+    using Multiply = MultiplyLow64<LeftType>;
+    using VecType  = typename Multiply::VecType;
+
+    constexpr static int Size = Multiply::Size;
+
     static void eval(Tensor<LeftType>& tensor, const RightType& _scalar)
     {
         LeftType* ptr = tensor.data.data;
 
         const LeftType scalar = static_cast<LeftType>(_scalar);
+        auto scalar_vec = simdpp::load_splat<VecType>(&scalar);
+
+        const int total = tensor.shape.total();
 
-        int i = 0, total = tensor.shape.total();
-        for ( ; total--; ++i)
-            ptr[i] *= scalar;
+        int offset = 0;
+        for ( ; offset + Size <= total; offset += Size)
+            simdpp::store(ptr + offset, Multiply::run(simdpp::load<VecType>(ptr + offset), scalar_vec));
+
+        for ( ; offset < total; ++offset)
+            ptr[offset] *= scalar;
     }
 
     static void eval(Tensor<LeftType>& left, const Tensor<RightType>& right)
     {
-        LeftType* l_ptr        = left.data.data;
+        LeftType*        l_ptr = left.data.data;
         const RightType* r_ptr = right.data.data;
 
-        int i = 0, total = left.shape.total();
-        for ( ; total--; ++i)
-            l_ptr[i] *= static_cast<LeftType>(r_ptr[i]);
+        const int total = left.shape.total();
+
+        int offset = 0;
+        for ( ; offset + Size <= total; offset += Size)
+            simdpp::store(l_ptr + offset, Multiply::run(simdpp::load<VecType>(l_ptr + offset), load(r_ptr + offset)));
+
+        for ( ; offset < total; ++offset)
+            l_ptr[offset] *= static_cast<LeftType>(r_ptr[offset]);
+    }
+
+private:
+    static TNT_INL VecType load(const LeftType* ptr)
+    {
+        return simdpp::load<VecType>(ptr);
+    }
+
+    template <typename OtherType>
+    static TNT_INL VecType load(const OtherType* ptr)
+    {
+        LeftType buffer[Size];
+        for (int i = 0; i < Size; ++i)
+            buffer[i] = static_cast<LeftType>(ptr[i]);
+
+        return simdpp::load_u<VecType>(buffer);
     }
 };
 
@@ -275,6 +340,39 @@ TEST_CASE_TEMPLATE("multiply(Tensor<floating>&, const Tensor<floating>&)", T, te
     test_shape(Shape{4, 4, 4, 5});
 }
 
+TEST_CASE_TEMPLATE("multiply(Tensor<integer>&, ...) wraps on overflow", T, test_integer_data_types)
+{
+    using UnsignedType = typename std::make_unsigned<T>::type;
+
+    auto wrapped = [](T left, T right) {
+        return (T) (UnsignedType) ((uint64_t) (UnsignedType) left * (uint64_t) (UnsignedType) right);
+    };
+
+    auto test_shape = [&](const Shape& shape) {
+        Tensor<T> left(shape), right(shape);
+        for (int i = 0; i < shape.total(); ++i) {
+            left.data[i]  = (T) (UnsignedType) (i * 2654435761ull + 12345);
+            right.data[i] = (T) (UnsignedType) (i * 40503ull * 40503ull + 7);
+        }
+
+        Tensor<T> product = left;
+        multiply(product, right);
+
+        Tensor<T> scaled = left;
+        const T scalar = (T) (UnsignedType) 0x9E3779B97F4A7C15ull;
+        multiply(scaled, scalar);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            REQUIRE(product.data[i] == wrapped(left.data[i], right.data[i]));
+            REQUIRE(scaled.data[i]  == wrapped(left.data[i], scalar));
+        }
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+}
+
 } // namespace tnt
 
 #endif // TNT_MATH_MULTIPLY_IMPL_HPP
@@ -0,0 +1,153 @@
+#ifndef TNT_MATH_MULTIPLY_SATURATE_IMPL_HPP
+#define TNT_MATH_MULTIPLY_SATURATE_IMPL_HPP
+
+#include <tnt/math/arithmetic_ops.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <limits>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType>
+struct OptimizedMultiplySaturate<DataType,
+            typename std::enable_if<std::is_integral<DataType>::value && sizeof(DataType) <= 2>::type>
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static void eval(Tensor<DataType>& tensor, const DataType& scalar) noexcept
+    {
+        if (tensor.shape.total() == 0)
+            return;
+
+        DataType* ptr = tensor.data.data;
+        auto scalar_vec = simdpp::load_splat<VecType>(&scalar);
+
+        int offset = 0, num_blocks = AlignSIMDType<DataType>::num_aligned_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType block = simdpp::load<VecType>(ptr + offset);
+            simdpp::store(ptr + offset, MultiplySaturateSIMD<DataType>::run(block, scalar_vec));
+        }
+    }
+
+    static void eval(Tensor<DataType>& left, const Tensor<DataType>& right) noexcept
+    {
+        if (left.shape.total() == 0)
+            return;
+
+        DataType*       l_ptr = left.data.data;
+        const DataType* r_ptr = right.data.data;
+
+        int offset = 0, num_blocks = AlignSIMDType<DataType>::num_aligned_blocks(left.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType l_block = simdpp::load<VecType>(l_ptr + offset);
+            VecType r_block = simdpp::load<VecType>(r_ptr + offset);
+            simdpp::store(l_ptr + offset, MultiplySaturateSIMD<DataType>::run(l_block, r_block));
+        }
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE("multiply_saturate(Tensor<8 bit>&, ...)")
+{
+    { // uint8
+        uint8_t data[6]     = {0, 1, 15, 16, 100, 255};
+        uint8_t expected[6] = {0, 16, 240, 255, 255, 255};
+
+        Tensor<uint8_t> tensor(Shape{2, 3}, AlignedPtr<uint8_t>(data, 6));
+        multiply_saturate(tensor, 16);
+        REQUIRE((tensor == Tensor<uint8_t>(Shape{2, 3}, AlignedPtr<uint8_t>(expected, 6))));
+
+        Tensor<uint8_t> large(Shape{2, 3}, 200);
+        multiply_saturate(large, 1000);
+        REQUIRE((large == Tensor<uint8_t>(Shape{2, 3}, 255)));
+    }
+
+    { // int8
+        int8_t data[6]     = {0, -1, 10, -10, 100, -128};
+        int8_t expected[6] = {0, 12, 120, -120, 127, -128};
+
+        Tensor<int8_t> tensor(Shape{2, 3}, AlignedPtr<int8_t>(data, 6));
+        Tensor<int8_t> scale(Shape{2, 3}, 12);
+        scale.data[1] = -12;
+        scale.data[3] = 12;
+        scale.data[5] = 12;
+
+        multiply_saturate(tensor, scale);
+        REQUIRE((tensor == Tensor<int8_t>(Shape{2, 3}, AlignedPtr<int8_t>(expected, 6))));
+    }
+
+    auto test_shape = [](const Shape& shape) {
+        Tensor<uint8_t> u_left(shape), u_right(shape);
+        Tensor<int8_t>  s_left(shape), s_right(shape);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            u_left.data[i]  = (uint8_t) (i * 7);
+            u_right.data[i] = (uint8_t) (i % 13);
+            s_left.data[i]  = (int8_t) (i * 7);
+            s_right.data[i] = (int8_t) (i % 13 - 6);
+        }
+
+        Tensor<uint8_t> u_result = u_left;
+        Tensor<int8_t>  s_result = s_left;
+        multiply_saturate(u_result, u_right);
+        multiply_saturate(s_result, s_right);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            REQUIRE(u_result.data[i] == saturate_cast<uint8_t>(u_left.data[i] * u_right.data[i]));
+            REQUIRE(s_result.data[i] == saturate_cast<int8_t>(s_left.data[i] * s_right.data[i]));
+        }
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    Tensor<uint8_t> tensor(Shape{2, 2});
+    REQUIRE_THROWS(multiply_saturate(tensor, Tensor<uint8_t>(Shape{4})));
+}
+
+TEST_CASE_TEMPLATE("multiply_saturate(Tensor<T>&, ...) matches widened multiplication", T, test_saturate_data_types)
+{
+    using Limits = std::numeric_limits<T>;
+
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> left(shape), right(shape);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            left.data[i]  = (T) (Limits::min() + i * 997);
+            right.data[i] = (T) (i % 2 ? i * 31 : -(i % 300));
+        }
+        left.data[0] = Limits::min(); right.data[0] = Limits::is_signed ? (T) -1 : Limits::max();
+        left.data[1] = Limits::max(); right.data[1] = Limits::max();
+
+        Tensor<T> result = left;
+        multiply_saturate(result, right);
+
+        Tensor<T> scaled = left;
+        multiply_saturate(scaled, 3);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            REQUIRE(result.data[i] == saturate_cast<T>((int64_t) left.data[i] * right.data[i]));
+            REQUIRE(scaled.data[i] == saturate_cast<T>((int64_t) left.data[i] * 3));
+        }
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_MULTIPLY_SATURATE_IMPL_HPP
@@ -0,0 +1,91 @@
+#ifndef TNT_MATH_NEGATE_IMPL_HPP
+#define TNT_MATH_NEGATE_IMPL_HPP
+
+#include <tnt/math/arithmetic_ops.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType>
+struct OptimizedNegate<DataType, typename std::enable_if<std::is_signed<DataType>::value>::type>
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static void eval(Tensor<DataType>& tensor) noexcept
+    {
+        if (tensor.shape.total() == 0)
+            return;
+
+        DataType* ptr = tensor.data.data;
+
+        int offset = 0, num_blocks = AlignSIMDType<DataType>::num_aligned_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType block = simdpp::load<VecType>(ptr + offset);
+            simdpp::store(ptr + offset, VecType(simdpp::neg(block)));
+        }
+    }
+};
+
+// simdpp only negates signed vectors, unsigned values wrap as `0 - x`
+template <typename DataType>
+struct OptimizedNegate<DataType, typename std::enable_if<std::is_unsigned<DataType>::value>::type>
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static void eval(Tensor<DataType>& tensor) noexcept
+    {
+        if (tensor.shape.total() == 0)
+            return;
+
+        DataType* ptr = tensor.data.data;
+
+        const DataType zero = 0;
+        auto zero_vec = simdpp::load_splat<VecType>(&zero);
+
+        int offset = 0, num_blocks = AlignSIMDType<DataType>::num_aligned_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType block = simdpp::load<VecType>(ptr + offset);
+            simdpp::store(ptr + offset, VecType(simdpp::sub(zero_vec, block)));
+        }
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("negate(Tensor<T>&)", T, test_data_types)
+{
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> tensor(shape);
+        for (int i = 0; i < shape.total(); ++i)
+            tensor.data[i] = (T) (i % 11);
+
+        Tensor<T> result = tensor;
+        negate(result);
+
+        for (int i = 0; i < shape.total(); ++i)
+            REQUIRE(result.data[i] == (T) ((T) 0 - tensor.data[i]));
+
+        negate(result);
+        REQUIRE((result == tensor));
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_NEGATE_IMPL_HPP
@@ -11,7 +11,7 @@ namespace detail
 {
 
 template <typename LeftType, typename RightType>
-struct OptimizedSubtract<LeftType, RightType>
+struct OptimizedSubtract<LeftType, RightType, typename std::enable_if<std::is_arithmetic<LeftType>::value>::type>
 {
     static void eval(Tensor<LeftType>& tensor, const RightType& _scalar)
     {
@@ -0,0 +1,115 @@
+#ifndef TNT_MATH_SUM_WHERE_IMPL_HPP
+#define TNT_MATH_SUM_WHERE_IMPL_HPP
+
+#include <tnt/math/reduce_ops.hpp>
+#include <tnt/math/impl/compare_predicate_impl.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType>
+struct OptimizedSumWhere<DataType>
+{
+    static DataType eval(const Tensor<DataType>& tensor, Comparison op, const DataType& scalar)
+    {
+        return dispatch_comparison<Kernel, DataType>(op, tensor, scalar);
+    }
+
+private:
+    /// Unselected lanes are blended to zero and every block is added into a
+    /// vector accumulator, which is reduced once at the end
+    template <Comparison Op>
+    struct Kernel
+    {
+        using VecType         = typename SIMDType<DataType>::VecType;
+        using UnsignedVecType = typename VecType::uint_vector_type;
+
+        constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+        static DataType run(const Tensor<DataType>& tensor, const DataType& scalar)
+        {
+            const DataType* t_ptr = tensor.data.data;
+
+            const DataType zero = 0;
+            auto zero_vec   = simdpp::load_splat<VecType>(&zero);
+            auto scalar_vec = simdpp::load_splat<VecType>(&scalar);
+
+            const int total      = tensor.shape.total();
+            const int num_blocks = total / Size;
+
+            VecType sum_vec = zero_vec;
+            for (int offset = 0; offset < num_blocks * Size; offset += Size) {
+                VecType block = simdpp::load<VecType>(t_ptr + offset);
+                UnsignedVecType mask = simdpp::bit_cast<UnsignedVecType>(ComparePredicate<Op>::simd(block, scalar_vec));
+
+                sum_vec = simdpp::add(sum_vec, VecType(simdpp::blend(block, zero_vec, mask)));
+            }
+
+            DataType sum = num_blocks > 0 ? static_cast<DataType>(simdpp::reduce_add(sum_vec)) : zero;
+            for (int i = num_blocks * Size; i < total; ++i)
+                if (ComparePredicate<Op>::scalar(t_ptr[i], scalar))
+                    sum += t_ptr[i];
+
+            return sum;
+        }
+    };
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("sum_where(Tensor<T>&, Comparison, Scalar)", T, test_data_types)
+{
+    { // 2x3
+        T data[6] = {1, 4, 2, 4, 7, 0};
+        Tensor<T> tensor(Shape{2, 3}, AlignedPtr<T>(data, 6));
+
+        REQUIRE(sum_where(tensor, Comparison::Equal,          4) == (T) 8);
+        REQUIRE(sum_where(tensor, Comparison::NotEqual,       4) == (T) 10);
+        REQUIRE(sum_where(tensor, Comparison::LessThan,       4) == (T) 3);
+        REQUIRE(sum_where(tensor, Comparison::GreaterThan,    4) == (T) 7);
+        REQUIRE(sum_where(tensor, Comparison::LessOrEqual,    4) == (T) 11);
+        REQUIRE(sum_where(tensor, Comparison::GreaterOrEqual, 4) == (T) 15);
+    }
+
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> tensor(shape);
+        for (int i = 0; i < shape.total(); ++i)
+            tensor.data[i] = (T) ((i * 37) % 11);
+
+        T sums[6] = {0, 0, 0, 0, 0, 0};
+        for (int i = 0; i < shape.total(); ++i) {
+            const T value = tensor.data[i];
+            if (value == 5) sums[0] += value;
+            if (value != 5) sums[1] += value;
+            if (value <  5) sums[2] += value;
+            if (value >  5) sums[3] += value;
+            if (value <= 5) sums[4] += value;
+            if (value >= 5) sums[5] += value;
+        }
+
+        REQUIRE(sum_where(tensor, Comparison::Equal,          5) == sums[0]);
+        REQUIRE(sum_where(tensor, Comparison::NotEqual,       5) == sums[1]);
+        REQUIRE(sum_where(tensor, Comparison::LessThan,       5) == sums[2]);
+        REQUIRE(sum_where(tensor, Comparison::GreaterThan,    5) == sums[3]);
+        REQUIRE(sum_where(tensor, Comparison::LessOrEqual,    5) == sums[4]);
+        REQUIRE(sum_where(tensor, Comparison::GreaterOrEqual, 5) == sums[5]);
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    REQUIRE(sum_where(Tensor<T>(), Comparison::Equal, 0) == (T) 0);
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_SUM_WHERE_IMPL_HPP
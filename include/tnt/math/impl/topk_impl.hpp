@@ -0,0 +1,216 @@
+#ifndef TNT_MATH_TOPK_IMPL_HPP
+#define TNT_MATH_TOPK_IMPL_HPP
+
+#include <tnt/math/search_ops.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType>
+struct OptimizedTopK<DataType>
+{
+    using VecType         = typename SIMDType<DataType>::VecType;
+    using UnsignedVecType = typename VecType::uint_vector_type;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    struct Candidate
+    {
+        DataType value;
+        int32_t  index;
+    };
+
+    static TopK<DataType> eval(const Tensor<DataType>& tensor, int k, int axis)
+    {
+        const int outer  = tensor.shape.total(0, axis);
+        const int length = tensor.shape[axis];
+        const int inner  = tensor.shape.total(axis) / length;
+
+        Shape shape = tensor.shape;
+        shape[axis] = k;
+
+        TopK<DataType> result{Tensor<DataType>(shape), Tensor<int32_t>(shape)};
+
+        const DataType* t_ptr = tensor.data.data;
+        DataType*       v_ptr = result.values.data.data;
+        int32_t*        i_ptr = result.indices.data.data;
+
+        std::vector<Candidate> heap;
+        heap.reserve(k);
+
+        // Strided axes are gathered into a contiguous row so every search
+        // runs over unit stride memory
+        AlignedPtr<DataType> row(inner == 1 ? 0 : length);
+
+        for (int o = 0; o < outer; ++o) {
+            for (int l = 0; l < inner; ++l) {
+                const DataType* base = t_ptr + o * length * inner + l;
+
+                const DataType* r_ptr = base;
+                if (inner != 1) {
+                    for (int j = 0; j < length; ++j)
+                        row.data[j] = base[j * inner];
+                    r_ptr = row.data;
+                }
+
+                select(r_ptr, length, k, heap);
+
+                for (int i = 0; i < k; ++i) {
+                    v_ptr[(o * k + i) * inner + l] = heap[i].value;
+                    i_ptr[(o * k + i) * inner + l] = heap[i].index;
+                }
+            }
+        }
+
+        return result;
+    }
+
+private:
+    /// Strict ordering of candidates. Larger values win and equal values are
+    /// ordered by position. Used as the heap comparator the heap top is the
+    /// worst candidate kept so far.
+    static bool better(const Candidate& left, const Candidate& right)
+    {
+        return left.value > right.value
+                || (left.value == right.value && left.index < right.index);
+    }
+
+    static TNT_INL void push(std::vector<Candidate>& heap, DataType value, int32_t index)
+    {
+        if (!(value > heap.front().value))
+            return;
+
+        std::pop_heap(heap.begin(), heap.end(), better);
+        heap.back() = Candidate{value, index};
+        std::push_heap(heap.begin(), heap.end(), better);
+    }
+
+    /// Keep a heap of the `k` best candidates. Once it is full only elements
+    /// strictly larger than the worst kept value can enter, so whole SIMD
+    /// blocks are rejected with a single compare and the heap is touched only
+    /// for the rare blocks that contain a candidate.
+    static void select(const DataType* ptr, int length, int k, std::vector<Candidate>& heap)
+    {
+        heap.clear();
+        for (int j = 0; j < k; ++j)
+            heap.push_back(Candidate{ptr[j], j});
+
+        std::make_heap(heap.begin(), heap.end(), better);
+
+        int j = k;
+        for ( ; j + Size <= length; j += Size) {
+            const DataType threshold = heap.front().value;
+
+            auto threshold_vec = simdpp::load_splat<VecType>(&threshold);
+            auto block = simdpp::load_u<VecType>(ptr + j);
+
+            if (!simdpp::test_bits_any(simdpp::bit_cast<UnsignedVecType>(simdpp::cmp_gt(block, threshold_vec))))
+                continue;
+
+            for (int i = j; i < j + Size; ++i)
+                push(heap, ptr[i], i);
+        }
+
+        for ( ; j < length; ++j)
+            push(heap, ptr[j], j);
+
+        std::sort_heap(heap.begin(), heap.end(), better);
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("topk(const Tensor<T>&, int, int)", T, test_data_types)
+{
+    { // 1D
+        T data[8] = {3, 1, 4, 1, 5, 9, 2, 6};
+        Tensor<T> tensor(Shape{8}, AlignedPtr<T>(data, 8));
+
+        T       values[3]  = {9, 6, 5};
+        int32_t indices[3] = {5, 7, 4};
+
+        TopK<T> result = topk(tensor, 3, 0);
+        REQUIRE((result.values  == Tensor<T>(Shape{3}, AlignedPtr<T>(values, 3))));
+        REQUIRE((result.indices == Tensor<int32_t>(Shape{3}, AlignedPtr<int32_t>(indices, 3))));
+    }
+
+    { // 2D along both axes with ties
+        T data[6] = {1, 7, 7,
+                     9, 2, 7};
+        Tensor<T> tensor(Shape{2, 3}, AlignedPtr<T>(data, 6));
+
+        T       row_values[4]  = {7, 7,
+                                  9, 7};
+        int32_t row_indices[4] = {1, 2,
+                                  0, 2};
+
+        TopK<T> rows = topk(tensor, 2, 1);
+        REQUIRE((rows.values  == Tensor<T>(Shape{2, 2}, AlignedPtr<T>(row_values, 4))));
+        REQUIRE((rows.indices == Tensor<int32_t>(Shape{2, 2}, AlignedPtr<int32_t>(row_indices, 4))));
+
+        T       col_values[3]  = {9, 7, 7};
+        int32_t col_indices[3] = {1, 0, 0};
+
+        TopK<T> cols = topk(tensor, 1, 0);
+        REQUIRE((cols.values  == Tensor<T>(Shape{1, 3}, AlignedPtr<T>(col_values, 3))));
+        REQUIRE((cols.indices == Tensor<int32_t>(Shape{1, 3}, AlignedPtr<int32_t>(col_indices, 3))));
+    }
+
+    auto test_shape = [](const Shape& shape, int k) {
+        Tensor<T> tensor(shape);
+        for (int i = 0; i < shape.total(); ++i)
+            tensor.data[i] = (T) ((i * 37) % 101);
+
+        for (int axis = 0; axis < shape.num_axes(); ++axis) {
+            const int length = shape[axis];
+            const int inner  = shape.total(axis) / length;
+            const int outer  = shape.total(0, axis);
+            const int count  = std::min(k, length);
+
+            TopK<T> result = topk(tensor, count, axis);
+            REQUIRE(result.values.shape[axis] == count);
+
+            for (int o = 0; o < outer; ++o) {
+                for (int l = 0; l < inner; ++l) {
+                    const T* base = tensor.data.data + o * length * inner + l;
+
+                    std::vector<int> order(length);
+                    std::iota(order.begin(), order.end(), 0);
+                    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+                        return base[a * inner] > base[b * inner];
+                    });
+
+                    for (int i = 0; i < count; ++i) {
+                        REQUIRE(result.indices.data[(o * count + i) * inner + l] == order[i]);
+                        REQUIRE(result.values.data[(o * count + i) * inner + l] == base[order[i] * inner]);
+                    }
+                }
+            }
+        }
+    };
+
+    test_shape(Shape{3, 1, 3}, 2);
+    test_shape(Shape{4, 4, 4, 5}, 3);
+    test_shape(Shape{5, 257}, 5);
+    test_shape(Shape{7, 9, 33}, 4);
+
+    REQUIRE_THROWS(topk(Tensor<T>(Shape{2, 2}), 3, 0));
+    REQUIRE_THROWS(topk(Tensor<T>(Shape{2, 2}), 0, 0));
+    REQUIRE_THROWS(topk(Tensor<T>(Shape{2, 2}), 1, 2));
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_TOPK_IMPL_HPP
@@ -0,0 +1,283 @@
+#ifndef TNT_MATH_TRANSCENDENTAL_IMPL_HPP
+#define TNT_MATH_TRANSCENDENTAL_IMPL_HPP
+
+#include <tnt/math/transcendental_ops.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType, typename Function>
+struct OptimizedTranscendental<DataType, Function,
+            typename std::enable_if<std::is_floating_point<DataType>::value>::type>
+{
+    using VecType = typename SIMDType<DataType>::VecType;
+
+    constexpr static int Size = OptimalSIMDSize<DataType>::value;
+
+    static void eval(Tensor<DataType>& tensor, const Function& function) noexcept
+    {
+        if (tensor.shape.total() == 0)
+            return;
+
+        DataType* ptr = tensor.data.data;
+
+        int offset = 0, num_blocks = AlignSIMDType<DataType>::num_aligned_blocks(tensor.shape.total());
+        for ( ; num_blocks--; offset += Size) {
+            VecType block = simdpp::load<VecType>(ptr + offset);
+            simdpp::store(ptr + offset, function.run(block));
+        }
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+namespace
+{
+
+// Distance from a reference in units in the last place of the reference.
+// `floor` raises the unit for references close to zero.
+template <typename T>
+double ulp_error(T value, long double reference, long double floor = 0)
+{
+    if (std::isnan(reference))
+        return std::isnan(value) ? 0 : std::numeric_limits<double>::infinity();
+    if (std::isinf(reference) || std::isinf(value))
+        return value == reference ? 0 : std::numeric_limits<double>::infinity();
+
+    const long double magnitude = std::max(std::fabs(reference), std::max(floor, (long double) std::numeric_limits<T>::min()));
+    const long double unit      = std::ldexp((long double) 1, std::ilogb(magnitude) - std::numeric_limits<T>::digits + 1);
+
+    return (double) (std::fabs((long double) value - reference) / unit);
+}
+
+template <typename T, typename Apply, typename Reference>
+double max_ulp_error(Tensor<T> input, Apply apply, Reference reference, long double floor = 0)
+{
+    Tensor<T> result = input;
+    apply(result);
+
+    double error = 0;
+    for (int i = 0; i < input.shape.total(); ++i)
+        error = std::max(error, ulp_error(result.data[i], reference((long double) input.data[i]), floor));
+
+    return error;
+}
+
+template <typename T>
+Tensor<T> uniform_tensor(T low, T high, int count = 20000)
+{
+    std::mt19937 generator(2718);
+    std::uniform_real_distribution<T> distribution(low, high);
+
+    Tensor<T> tensor(Shape{count});
+    for (int i = 0; i < count; ++i)
+        tensor.data[i] = distribution(generator);
+
+    return tensor;
+}
+
+template <typename T> struct ExponentRange;
+template <> struct ExponentRange<float>  { static float  low() { return -103.f;  } static float  high() { return 88.7f;   } };
+template <> struct ExponentRange<double> { static double low() { return -745.;   } static double high() { return 709.7;   } };
+
+} // namespace
+
+TEST_CASE_TEMPLATE("exp(Tensor<floating>&)", T, test_float_data_types)
+{
+    using Limits = std::numeric_limits<T>;
+
+    REQUIRE(max_ulp_error(uniform_tensor<T>(-1, 1), [](Tensor<T>& t) { exp(t); },
+                          [](long double x) { return std::exp(x); }) <= 1);
+    REQUIRE(max_ulp_error(uniform_tensor<T>(ExponentRange<T>::low(), ExponentRange<T>::high()), [](Tensor<T>& t) { exp(t); },
+                          [](long double x) { return std::exp(x); }, Limits::min()) <= 1);
+
+    T special[6]  = {0, -0.f, Limits::infinity(), -Limits::infinity(), 1000, -1000};
+    T expected[6] = {1, 1, Limits::infinity(), 0, Limits::infinity(), 0};
+
+    Tensor<T> tensor(Shape{6}, AlignedPtr<T>(special, 6));
+    exp(tensor);
+    REQUIRE((tensor == Tensor<T>(Shape{6}, AlignedPtr<T>(expected, 6))));
+
+    Tensor<T> nan(Shape{3}, Limits::quiet_NaN());
+    exp(nan);
+    REQUIRE(std::isnan(nan.data[2]));
+}
+
+TEST_CASE_TEMPLATE("log(Tensor<floating>&)", T, test_float_data_types)
+{
+    using Limits       = std::numeric_limits<T>;
+    using UnsignedType = typename detail::SIMDMathConstants<T>::UnsignedType;
+
+    REQUIRE(max_ulp_error(uniform_tensor<T>(0.5, 2), [](Tensor<T>& t) { log(t); },
+                          [](long double x) { return std::log(x); }) <= 1);
+
+    // Every binade, including subnormals
+    std::mt19937_64 generator(1618);
+    Tensor<T> tensor(Shape{20000});
+    for (int i = 0; i < tensor.shape.total(); ++i) {
+        UnsignedType bits = (UnsignedType) generator() & (~UnsignedType(0) >> 1);
+        memcpy(&tensor.data[i], &bits, sizeof(T));
+        if (!std::isfinite(tensor.data[i]) || tensor.data[i] == 0)
+            tensor.data[i] = 1;
+    }
+
+    REQUIRE(max_ulp_error(tensor, [](Tensor<T>& t) { log(t); },
+                          [](long double x) { return std::log(x); }) <= 1);
+
+    T special[5] = {0, -1, Limits::infinity(), 1, Limits::denorm_min()};
+
+    Tensor<T> specials(Shape{5}, AlignedPtr<T>(special, 5));
+    log(specials);
+
+    REQUIRE(specials.data[0] == -Limits::infinity());
+    REQUIRE(std::isnan(specials.data[1]));
+    REQUIRE(specials.data[2] == Limits::infinity());
+    REQUIRE(specials.data[3] == 0);
+    REQUIRE(ulp_error(specials.data[4], std::log((long double) Limits::denorm_min())) <= 1);
+}
+
+TEST_CASE_TEMPLATE("sqrt(Tensor<floating>&)", T, test_float_data_types)
+{
+    REQUIRE(max_ulp_error(uniform_tensor<T>(0, 1000), [](Tensor<T>& t) { sqrt(t); },
+                          [](long double x) { return std::sqrt(x); }) <= 0.5);
+
+    Tensor<T> tensor(Shape{3, 1, 3}, 16);
+    sqrt(tensor);
+    REQUIRE((tensor == Tensor<T>(Shape{3, 1, 3}, 4)));
+}
+
+TEST_CASE_TEMPLATE("pow(Tensor<floating>&, Scalar)", T, test_float_data_types)
+{
+    const T exponents[] = {0.5, 2.5, -1.5, 2, 3, 4, -3, 1.0 / 3, 7.3, -17.5};
+
+    for (T y : exponents) {
+        Tensor<T> tensor = uniform_tensor<T>(0.01, 100);
+
+        Tensor<T> result = tensor;
+        pow(result, y);
+
+        for (int i = 0; i < tensor.shape.total(); ++i) {
+            const long double x = tensor.data[i];
+            REQUIRE(ulp_error(result.data[i], std::pow(x, (long double) y)) <= 2);
+        }
+    }
+
+    T data[6] = {-2, -1.5, 0, 2, 3, 0};
+
+    Tensor<T> cubed(Shape{6}, AlignedPtr<T>(data, 6));
+    pow(cubed, 3);
+    REQUIRE(cubed.data[0] == -8);
+    REQUIRE(cubed.data[1] == T(-3.375));
+    REQUIRE(cubed.data[2] == 0);
+    REQUIRE(cubed.data[3] == 8);
+    REQUIRE(cubed.data[4] == 27);
+
+    Tensor<T> root(Shape{6}, AlignedPtr<T>(data, 6));
+    pow(root, 0.5);
+    REQUIRE(std::isnan(root.data[0]));
+    REQUIRE(root.data[2] == 0);
+
+    Tensor<T> inverse(Shape{6}, AlignedPtr<T>(data, 6));
+    pow(inverse, -1);
+    REQUIRE(inverse.data[2] == std::numeric_limits<T>::infinity());
+
+    Tensor<T> one(Shape{6}, AlignedPtr<T>(data, 6));
+    pow(one, 0);
+    REQUIRE((one == Tensor<T>(Shape{6}, 1)));
+}
+
+TEST_CASE_TEMPLATE("sin(Tensor<floating>&), cos(Tensor<floating>&)", T, test_float_data_types)
+{
+    const T floor = std::ldexp(T(1), -16);
+
+    for (T range : {T(1), T(10), T(4096)}) {
+        Tensor<T> tensor = uniform_tensor<T>(-range, range);
+
+        REQUIRE(max_ulp_error(tensor, [](Tensor<T>& t) { sin(t); },
+                              [](long double x) { return std::sin(x); }, floor) <= 3);
+        REQUIRE(max_ulp_error(tensor, [](Tensor<T>& t) { cos(t); },
+                              [](long double x) { return std::cos(x); }, floor) <= 3);
+    }
+
+    T data[4] = {0, -0.f, 1e-10f, -1e-10f};
+
+    Tensor<T> sines(Shape{4}, AlignedPtr<T>(data, 4));
+    sin(sines);
+    REQUIRE((sines == Tensor<T>(Shape{4}, AlignedPtr<T>(data, 4))));
+    REQUIRE(std::signbit(sines.data[1]));
+
+    Tensor<T> cosines(Shape{4}, AlignedPtr<T>(data, 4));
+    cos(cosines);
+    REQUIRE((cosines == Tensor<T>(Shape{4}, 1)));
+}
+
+TEST_CASE_TEMPLATE("tanh(Tensor<floating>&)", T, test_float_data_types)
+{
+    for (T range : {T(0.7), T(5), T(50)})
+        REQUIRE(max_ulp_error(uniform_tensor<T>(-range, range), [](Tensor<T>& t) { tanh(t); },
+                              [](long double x) { return std::tanh(x); }) <= 3);
+
+    Tensor<T> tensor(Shape{2, 3}, std::numeric_limits<T>::infinity());
+    tanh(tensor);
+    REQUIRE((tensor == Tensor<T>(Shape{2, 3}, 1)));
+}
+
+TEST_CASE_TEMPLATE("sigmoid(Tensor<floating>&)", T, test_float_data_types)
+{
+    for (T range : {T(1), T(20), T(200)})
+        REQUIRE(max_ulp_error(uniform_tensor<T>(-range, range), [](Tensor<T>& t) { sigmoid(t); },
+                              [](long double x) { return 1 / (1 + std::exp(-x)); }) <= 3);
+
+    T data[3]     = {0, std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity()};
+    T expected[3] = {0.5, 1, 0};
+
+    Tensor<T> tensor(Shape{3}, AlignedPtr<T>(data, 3));
+    sigmoid(tensor);
+    REQUIRE((tensor == Tensor<T>(Shape{3}, AlignedPtr<T>(expected, 3))));
+}
+
+namespace
+{
+
+// A fused kernel composed from the SIMD functions, exp(-x^2)
+template <typename T>
+struct GaussianSIMD
+{
+    using VecType = typename SIMDType<T>::VecType;
+
+    TNT_INL VecType run(const VecType& x) const
+    {
+        return detail::ExpSIMD<T>().run(simdpp::neg(simdpp::mul(x, x)));
+    }
+};
+
+} // namespace
+
+TEST_CASE_TEMPLATE("OptimizedTranscendental with a fused function", T, test_float_data_types)
+{
+    Tensor<T> tensor = uniform_tensor<T>(-3, 3, 1001);
+
+    Tensor<T> result = tensor;
+    detail::OptimizedTranscendental<T, GaussianSIMD<T>>::eval(result, GaussianSIMD<T>());
+
+    for (int i = 0; i < tensor.shape.total(); ++i) {
+        const T square = tensor.data[i] * tensor.data[i];
+        REQUIRE(ulp_error(result.data[i], std::exp(-(long double) square)) <= 1);
+    }
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_TRANSCENDENTAL_IMPL_HPP
@@ -0,0 +1,140 @@
+#ifndef TNT_MATH_WHERE_IMPL_HPP
+#define TNT_MATH_WHERE_IMPL_HPP
+
+#include <tnt/math/select_ops.hpp>
+#include <tnt/core/impl/bit_mask_impl.hpp>
+#include <tnt/utils/testing.hpp>
+#include <tnt/utils/simd.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType, typename MaskType>
+struct OptimizedWhere<DataType, MaskType>
+{
+    using Expand  = ExpandMaskBytes<DataType>;
+    using VecType = typename Expand::VecType;
+
+    constexpr static int Size = Expand::Size;
+
+    static Tensor<DataType> eval(const MaskType& mask, const Tensor<DataType>& left, const Tensor<DataType>& right)
+    {
+        return run(mask, left, TensorSource{right.data.data});
+    }
+
+    static Tensor<DataType> eval(const MaskType& mask, const Tensor<DataType>& left, const DataType& scalar)
+    {
+        return run(mask, left, ScalarSource{scalar, simdpp::load_splat<VecType>(&scalar)});
+    }
+
+private:
+    struct TensorSource
+    {
+        TNT_INL VecType block(int offset) const { return simdpp::load<VecType>(ptr + offset); }
+        TNT_INL DataType at(int index) const { return ptr[index]; }
+
+        const DataType* ptr;
+    };
+
+    struct ScalarSource
+    {
+        TNT_INL VecType block(int) const { return vec; }
+        TNT_INL DataType at(int) const { return value; }
+
+        DataType value;
+        VecType  vec;
+    };
+
+    /// Blend 16 elements at a time. Groups where the mask is all clear or
+    /// all set are copied from one side without touching the other.
+    template <typename Source>
+    static Tensor<DataType> run(const MaskType& mask, const Tensor<DataType>& left, const Source& right)
+    {
+        Tensor<DataType> result(left.shape);
+
+        const DataType* l_ptr = left.data.data;
+        DataType*       r_ptr = result.data.data;
+
+        MaskGroups<MaskType> groups(mask);
+
+        const int total      = left.shape.total();
+        const int num_groups = total / Size;
+
+        for (int g = 0; g < num_groups; ++g) {
+            const int offset = g * Size;
+
+            simdpp::int8<Size> bytes;
+            const uint16_t bits = groups.load(g, bytes);
+
+            if (bits == 0)
+                simdpp::store(r_ptr + offset, right.block(offset));
+            else if (bits == 0xFFFF)
+                simdpp::store(r_ptr + offset, simdpp::load<VecType>(l_ptr + offset));
+            else
+                simdpp::store(r_ptr + offset, VecType(simdpp::blend(simdpp::load<VecType>(l_ptr + offset),
+                                                                    right.block(offset),
+                                                                    Expand::expand(bytes))));
+        }
+
+        for (int i = num_groups * Size; i < total; ++i)
+            r_ptr[i] = groups.test(i) ? l_ptr[i] : right.at(i);
+
+        return result;
+    }
+};
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// Unit tests
+
+TEST_CASE_TEMPLATE("where(MaskType&, Tensor<T>&, Tensor<T>&)", T, test_data_types)
+{
+    { // 2x3
+        T left_data[6]  = {1, 2, 3, 4, 5, 6};
+        T right_data[6] = {6, 5, 4, 3, 2, 1};
+        T expected[6]   = {6, 5, 4, 4, 5, 6};
+
+        Tensor<T> left(Shape{2, 3}, AlignedPtr<T>(left_data, 6));
+        Tensor<T> right(Shape{2, 3}, AlignedPtr<T>(right_data, 6));
+
+        REQUIRE((where(left > 3, left, right) == Tensor<T>(Shape{2, 3}, AlignedPtr<T>(expected, 6))));
+        REQUIRE((where(BitMask(left > 3), left, right) == Tensor<T>(Shape{2, 3}, AlignedPtr<T>(expected, 6))));
+    }
+
+    auto test_shape = [](const Shape& shape) {
+        Tensor<T> left(shape), right(shape);
+        Tensor<uint8_t> mask(shape);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            left.data[i]  = (T) (i % 50);
+            right.data[i] = (T) (100 - i % 50);
+            // Mixed groups, a run of set elements and a run of clear ones
+            mask.data[i]  = (i % 3 == 0 || (i >= 32 && i < 64)) && !(i >= 80 && i < 112) ? 1 : 0;
+        }
+
+        Tensor<T> bytes_result  = where(mask, left, right);
+        Tensor<T> bits_result   = where(BitMask(mask), left, right);
+        Tensor<T> scalar_result = where(mask, left, 7);
+
+        for (int i = 0; i < shape.total(); ++i) {
+            REQUIRE(bytes_result.data[i]  == (mask.data[i] ? left.data[i] : right.data[i]));
+            REQUIRE(bits_result.data[i]   == (mask.data[i] ? left.data[i] : right.data[i]));
+            REQUIRE(scalar_result.data[i] == (mask.data[i] ? left.data[i] : (T) 7));
+        }
+    };
+
+    test_shape(Shape{3, 1, 3});
+    test_shape(Shape{4, 4, 4, 5});
+    test_shape(Shape{17, 67});
+
+    REQUIRE_THROWS(where(Tensor<uint8_t>(Shape{2, 2}), Tensor<T>(Shape{2, 2}), Tensor<T>(Shape{2, 3})));
+    REQUIRE_THROWS(where(BitMask(Shape{2, 3}), Tensor<T>(Shape{2, 2}), 0));
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_WHERE_IMPL_HPP
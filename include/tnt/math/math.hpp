@@ -17,5 +17,29 @@
 #include <tnt/math/impl/subtract_impl.hpp>
 #include <tnt/math/impl/multiply_impl.hpp>
 #include <tnt/math/impl/divide_impl.hpp>
+#include <tnt/math/impl/add_saturate_impl.hpp>
+#include <tnt/math/impl/subtract_saturate_impl.hpp>
+#include <tnt/math/impl/multiply_saturate_impl.hpp>
+#include <tnt/math/impl/minimum_impl.hpp>
+#include <tnt/math/impl/maximum_impl.hpp>
+#include <tnt/math/impl/clamp_impl.hpp>
+#include <tnt/math/impl/abs_impl.hpp>
+#include <tnt/math/impl/negate_impl.hpp>
+#include <tnt/math/impl/complex_impl.hpp>
+
+#include <tnt/math/impl/transcendental_impl.hpp>
+
+#include <tnt/math/impl/argmax_impl.hpp>
+#include <tnt/math/impl/argmin_impl.hpp>
+#include <tnt/math/impl/topk_impl.hpp>
+
+#include <tnt/math/impl/where_impl.hpp>
+#include <tnt/math/impl/masked_assign_impl.hpp>
+#include <tnt/math/impl/compress_impl.hpp>
+
+#include <tnt/math/impl/count_if_impl.hpp>
+#include <tnt/math/impl/any_of_impl.hpp>
+#include <tnt/math/impl/all_of_impl.hpp>
+#include <tnt/math/impl/sum_where_impl.hpp>
 
 #endif // TNT_MATH_HPP
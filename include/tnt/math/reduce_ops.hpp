@@ -0,0 +1,100 @@
+#ifndef TNT_MATH_REDUCE_OPS_HPP
+#define TNT_MATH_REDUCE_OPS_HPP
+
+#include <tnt/core/tensor.hpp>
+#include <tnt/math/compare_ops.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType, typename Enable = void>
+struct OptimizedCountIf
+{
+    static int eval(const Tensor<DataType>&, Comparison, const DataType&);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedAnyOf
+{
+    static bool eval(const Tensor<DataType>&, Comparison, const DataType&);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedAllOf
+{
+    static bool eval(const Tensor<DataType>&, Comparison, const DataType&);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedSumWhere
+{
+    static DataType eval(const Tensor<DataType>&, Comparison, const DataType&);
+};
+
+} // namespace detail
+
+/// \brief Count the elements of a tensor that satisfy a comparison with a
+/// scalar
+///
+/// \param tensor A immutable tensor
+/// \param op The [Comparison](tnt::Comparison) applied as `element op scalar`
+/// \param scalar A scalar
+/// \returns The number of elements for which the comparison is true
+/// \notes The comparison is reduced directly from SIMD compare results, no
+/// mask tensor is allocated.
+template <typename DataType, typename ScalarType>
+inline int count_if(const Tensor<DataType>& tensor, Comparison op, const ScalarType& scalar)
+{
+    return detail::OptimizedCountIf<DataType>::eval(tensor, op, static_cast<DataType>(scalar));
+}
+
+/// \brief Check if any element of a tensor satisfies a comparison with a
+/// scalar
+///
+/// \param tensor A immutable tensor
+/// \param op The [Comparison](tnt::Comparison) applied as `element op scalar`
+/// \param scalar A scalar
+/// \returns True if the comparison is true for at least one element. False
+/// for an empty tensor.
+/// \notes The search stops at the first block containing a match.
+template <typename DataType, typename ScalarType>
+inline bool any_of(const Tensor<DataType>& tensor, Comparison op, const ScalarType& scalar)
+{
+    return detail::OptimizedAnyOf<DataType>::eval(tensor, op, static_cast<DataType>(scalar));
+}
+
+/// \brief Check if every element of a tensor satisfies a comparison with a
+/// scalar
+///
+/// \param tensor A immutable tensor
+/// \param op The [Comparison](tnt::Comparison) applied as `element op scalar`
+/// \param scalar A scalar
+/// \returns True if the comparison is true for every element. True for an
+/// empty tensor.
+/// \notes The search stops at the first block containing a mismatch.
+template <typename DataType, typename ScalarType>
+inline bool all_of(const Tensor<DataType>& tensor, Comparison op, const ScalarType& scalar)
+{
+    return detail::OptimizedAllOf<DataType>::eval(tensor, op, static_cast<DataType>(scalar));
+}
+
+/// \brief Sum the elements of a tensor that satisfy a comparison with a
+/// scalar
+///
+/// \param tensor A immutable tensor
+/// \param op The [Comparison](tnt::Comparison) applied as `element op scalar`
+/// \param scalar A scalar
+/// \returns The sum of the selected elements, accumulated in `DataType`.
+/// Integer sums wrap on overflow like any other `DataType` arithmetic.
+template <typename DataType, typename ScalarType>
+inline DataType sum_where(const Tensor<DataType>& tensor, Comparison op, const ScalarType& scalar)
+{
+    return detail::OptimizedSumWhere<DataType>::eval(tensor, op, static_cast<DataType>(scalar));
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_REDUCE_OPS_HPP
@@ -0,0 +1,156 @@
+#ifndef TNT_MATH_SEARCH_OPS_HPP
+#define TNT_MATH_SEARCH_OPS_HPP
+
+#include <tnt/core/tensor.hpp>
+
+namespace tnt
+{
+
+/// \brief The result of a [topk](tnt::topk) search
+///
+/// [values](*::values) and [indices](*::indices) have the same shape. Along
+/// the searched axis they are sorted from largest to smallest value.
+template <typename DataType>
+struct TNT_EXPORT TopK
+{
+    Tensor<DataType> values;
+    Tensor<int32_t>  indices;
+};
+
+namespace detail
+{
+
+template <typename DataType, typename Enable = void>
+struct OptimizedArgMax
+{
+    static int eval(const Tensor<DataType>&);
+    static Tensor<int32_t> eval(const Tensor<DataType>&, int);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedArgMin
+{
+    static int eval(const Tensor<DataType>&);
+    static Tensor<int32_t> eval(const Tensor<DataType>&, int);
+};
+
+template <typename DataType, typename Enable = void>
+struct OptimizedTopK
+{
+    static TopK<DataType> eval(const Tensor<DataType>&, int, int);
+};
+
+} // namespace detail
+
+/// \brief Find the position of the largest element of a tensor
+///
+/// \param tensor A non-empty tensor
+/// \returns The flat (row-major) index of the largest element. If the largest
+/// value occurs more than once the first occurrence is returned. A NaN takes
+/// precedence over every number, so the index of the first NaN is returned
+/// when there is one, as in NumPy.
+/// \notes This function asserts that [tensor](*::tensor) is not empty and
+/// will throw an exception if it is. This check can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline int argmax(const Tensor<DataType>& tensor)
+{
+    TNT_ASSERT(tensor.shape.total() > 0,
+               InvalidParameterException("tnt::argmax()", __FILE__, __LINE__,
+                   "Cannot compute the argmax of an empty tensor"))
+
+    return detail::OptimizedArgMax<DataType>::eval(tensor);
+}
+
+/// \brief Find the position of the largest element along an axis
+///
+/// \param tensor A non-empty tensor
+/// \param axis The axis to search along
+/// \returns A tensor with the same shape as [tensor](*::tensor) except that
+/// [axis](*::axis) has length 1. Each element holds the index along
+/// [axis](*::axis) of the first occurrence of the largest value, or of the
+/// first NaN if there is one.
+/// \notes This function asserts that [axis](*::axis) is valid and will throw
+/// an exception if it is not. This check can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<int32_t> argmax(const Tensor<DataType>& tensor, int axis)
+{
+    TNT_ASSERT(axis >= 0 && axis < tensor.shape.num_axes() && tensor.shape[axis] > 0,
+               InvalidParameterException("tnt::argmax()", __FILE__, __LINE__,
+                   "Invalid axis " + std::to_string(axis) + " for argmax"))
+
+    return detail::OptimizedArgMax<DataType>::eval(tensor, axis);
+}
+
+/// \brief Find the position of the smallest element of a tensor
+///
+/// \param tensor A non-empty tensor
+/// \returns The flat (row-major) index of the smallest element. If the
+/// smallest value occurs more than once the first occurrence is returned. A
+/// NaN takes precedence over every number, so the index of the first NaN is
+/// returned when there is one, as in NumPy.
+/// \notes This function asserts that [tensor](*::tensor) is not empty and
+/// will throw an exception if it is. This check can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline int argmin(const Tensor<DataType>& tensor)
+{
+    TNT_ASSERT(tensor.shape.total() > 0,
+               InvalidParameterException("tnt::argmin()", __FILE__, __LINE__,
+                   "Cannot compute the argmin of an empty tensor"))
+
+    return detail::OptimizedArgMin<DataType>::eval(tensor);
+}
+
+/// \brief Find the position of the smallest element along an axis
+///
+/// \param tensor A non-empty tensor
+/// \param axis The axis to search along
+/// \returns A tensor with the same shape as [tensor](*::tensor) except that
+/// [axis](*::axis) has length 1. Each element holds the index along
+/// [axis](*::axis) of the first occurrence of the smallest value, or of the
+/// first NaN if there is one.
+/// \notes This function asserts that [axis](*::axis) is valid and will throw
+/// an exception if it is not. This check can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline Tensor<int32_t> argmin(const Tensor<DataType>& tensor, int axis)
+{
+    TNT_ASSERT(axis >= 0 && axis < tensor.shape.num_axes() && tensor.shape[axis] > 0,
+               InvalidParameterException("tnt::argmin()", __FILE__, __LINE__,
+                   "Invalid axis " + std::to_string(axis) + " for argmin"))
+
+    return detail::OptimizedArgMin<DataType>::eval(tensor, axis);
+}
+
+/// \brief Find the `k` largest elements along an axis
+///
+/// \param tensor A non-empty tensor
+/// \param k The number of elements to keep. It is tuned for small values
+/// (`k` much smaller than the length of [axis](*::axis)).
+/// \param axis The axis to search along
+/// \returns The values and their indices along [axis](*::axis). Both have the
+/// same shape as [tensor](*::tensor) except that [axis](*::axis) has length
+/// [k](*::k). Results are sorted from largest to smallest, equal values are
+/// ordered by their position.
+/// \notes This function asserts that [axis](*::axis) is valid and that
+/// `0 < k <= tensor.shape[axis]`. These checks can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType>
+inline TopK<DataType> topk(const Tensor<DataType>& tensor, int k, int axis)
+{
+    TNT_ASSERT(axis >= 0 && axis < tensor.shape.num_axes(),
+               InvalidParameterException("tnt::topk()", __FILE__, __LINE__,
+                   "Invalid axis " + std::to_string(axis) + " for topk"))
+
+    TNT_ASSERT(k > 0 && k <= tensor.shape[axis],
+               InvalidParameterException("tnt::topk()", __FILE__, __LINE__,
+                   "topk requires 0 < k <= the length of the searched axis"))
+
+    return detail::OptimizedTopK<DataType>::eval(tensor, k, axis);
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_SEARCH_OPS_HPP
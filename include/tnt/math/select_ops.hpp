@@ -0,0 +1,114 @@
+#ifndef TNT_MATH_SELECT_OPS_HPP
+#define TNT_MATH_SELECT_OPS_HPP
+
+#include <tnt/core/tensor.hpp>
+#include <tnt/core/bit_mask.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType, typename MaskType, typename Enable = void>
+struct OptimizedWhere
+{
+    static Tensor<DataType> eval(const MaskType&, const Tensor<DataType>&, const Tensor<DataType>&);
+    static Tensor<DataType> eval(const MaskType&, const Tensor<DataType>&, const DataType&);
+};
+
+template <typename DataType, typename MaskType, typename Enable = void>
+struct OptimizedMaskedAssign
+{
+    static void eval(Tensor<DataType>&, const MaskType&, const DataType&);
+};
+
+template <typename DataType, typename MaskType, typename Enable = void>
+struct OptimizedCompress
+{
+    static Tensor<DataType> eval(const Tensor<DataType>&, const MaskType&);
+};
+
+} // namespace detail
+
+/// \brief Select elementwise between two tensors
+///
+/// \param mask A byte mask (`Tensor<uint8_t>`) or [BitMask](tnt::BitMask).
+/// Any non-zero byte selects [left](*::left).
+/// \param left Elements taken where [mask](*::mask) is set
+/// \param right Elements taken where [mask](*::mask) is clear
+/// \returns A new tensor with the same shape as the inputs
+/// \notes This function asserts that all inputs have the same shape and will
+/// throw an exception if they do not. This check can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType, typename MaskType>
+inline Tensor<DataType> where(const MaskType& mask, const Tensor<DataType>& left, const Tensor<DataType>& right)
+{
+    TNT_ASSERT(mask.shape == left.shape && left.shape == right.shape,
+               InvalidParameterException("tnt::where()", __FILE__, __LINE__,
+                   "where() requires the mask and both tensors to have the same shape"))
+
+    return detail::OptimizedWhere<DataType, MaskType>::eval(mask, left, right);
+}
+
+/// \brief Select elementwise between a tensor and a scalar
+///
+/// \param mask A byte mask (`Tensor<uint8_t>`) or [BitMask](tnt::BitMask)
+/// \param left Elements taken where [mask](*::mask) is set
+/// \param scalar The value used where [mask](*::mask) is clear
+/// \returns A new tensor with the same shape as the inputs
+/// \notes This function asserts that [mask](*::mask) and [left](*::left) have
+/// the same shape. This check can be disabled by `#define DISABLE_CHECKS`
+/// before calling the function.
+template <typename DataType, typename MaskType, typename ScalarType>
+inline Tensor<DataType> where(const MaskType& mask, const Tensor<DataType>& left, const ScalarType& scalar)
+{
+    TNT_ASSERT(mask.shape == left.shape,
+               InvalidParameterException("tnt::where()", __FILE__, __LINE__,
+                   "where() requires the mask and tensor to have the same shape"))
+
+    return detail::OptimizedWhere<DataType, MaskType>::eval(mask, left, static_cast<DataType>(scalar));
+}
+
+/// \brief Set every element of a tensor selected by a mask to a value in
+/// place. Equivalent to `tensor[mask] = value` in NumPy.
+///
+/// \param tensor The tensor to modify
+/// \param mask A byte mask (`Tensor<uint8_t>`) or [BitMask](tnt::BitMask)
+/// \param value The value to assign
+/// \notes This function asserts that [mask](*::mask) and
+/// [tensor](*::tensor) have the same shape. This check can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType, typename MaskType, typename ScalarType>
+inline Tensor<DataType>& masked_assign(Tensor<DataType>& tensor, const MaskType& mask, const ScalarType& value)
+{
+    TNT_ASSERT(mask.shape == tensor.shape,
+               InvalidParameterException("tnt::masked_assign()", __FILE__, __LINE__,
+                   "masked_assign() requires the mask and tensor to have the same shape"))
+
+    detail::OptimizedMaskedAssign<DataType, MaskType>::eval(tensor, mask, static_cast<DataType>(value));
+    return tensor;
+}
+
+/// \brief Pack the elements selected by a mask into a 1D tensor
+///
+/// \param tensor The tensor to select from
+/// \param mask A byte mask (`Tensor<uint8_t>`) or [BitMask](tnt::BitMask)
+/// \returns A 1D tensor holding the selected elements in row-major order.
+/// Its length is the number of set elements in [mask](*::mask).
+/// \notes This function asserts that [mask](*::mask) and
+/// [tensor](*::tensor) have the same shape. This check can be disabled by
+/// `#define DISABLE_CHECKS` before calling the function.
+template <typename DataType, typename MaskType>
+inline Tensor<DataType> compress(const Tensor<DataType>& tensor, const MaskType& mask)
+{
+    TNT_ASSERT(mask.shape == tensor.shape,
+               InvalidParameterException("tnt::compress()", __FILE__, __LINE__,
+                   "compress() requires the mask and tensor to have the same shape"))
+
+    return detail::OptimizedCompress<DataType, MaskType>::eval(tensor, mask);
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_SELECT_OPS_HPP
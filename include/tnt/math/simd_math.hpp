@@ -0,0 +1,801 @@
+#ifndef TNT_MATH_SIMD_MATH_HPP
+#define TNT_MATH_SIMD_MATH_HPP
+
+#include <tnt/utils/simd.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+// Vectorized elementary functions for float and double. Each function is a
+// small functor with a `run` method on a full SIMD vector, so it can be
+// applied in place by [OptimizedTranscendental]() or composed inside a fused
+// kernel. The algorithms follow fdlibm (exp, log) and Cephes (sin, cos, tanh)
+// with branches replaced by blends, so every lane does the same work.
+//
+// Errors are measured against a correctly rounded result over the normal
+// range of each type. Subnormal results are produced but may carry an
+// extra ulp.
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// Bit layout and polynomial coefficients shared by the functions below.
+/// Coefficients are stored from the highest degree down.
+/// `Dummy` keeps the specializations templates so the coefficient arrays can
+/// be defined in this header.
+template <typename T, typename Dummy = void>
+struct SIMDMathConstants;
+
+template <typename Dummy>
+struct SIMDMathConstants<float, Dummy>
+{
+    using UnsignedType = uint32_t;
+
+    constexpr static int MantissaBits = 23;
+    constexpr static int ExponentBias = 127;
+
+    // 2^23, every integer below it is exactly representable
+    constexpr static float IntegerMagic = 8388608.f;
+
+    constexpr static float ExpHigh = 88.7228390f;
+    constexpr static float ExpLow  = -103.972084f;
+
+    constexpr static float Ln2High = 6.9314575195e-01f;
+    constexpr static float Ln2Low  = 1.4286067653e-06f;
+    constexpr static float LogLn2High = 6.9313812256e-01f;
+    constexpr static float LogLn2Low  = 9.0580006145e-06f;
+
+    // 2^12 + 1, splits a float into two halves whose products are exact
+    constexpr static float Split = 4097.f;
+
+    constexpr static float Exp[5] = {4.1381369442e-08f, -1.6533901999e-06f, 6.6137559770e-05f,
+                                     -2.7777778450e-03f, 1.6666667163e-01f};
+
+    constexpr static float Log[7] = {1.4798198640e-01f, 1.5313838422e-01f, 1.8183572590e-01f, 2.2222198546e-01f,
+                                     2.8571429849e-01f, 4.0000000596e-01f, 6.6666668653e-01f};
+
+    // Subnormal inputs to log are scaled by 2^LogScale first
+    constexpr static float MinNormal = 1.17549435e-38f;
+    constexpr static float LogScale  = 33554432.f;
+    constexpr static int   LogScaleBits = 25;
+
+    // pi / 4 split into three parts with 8, 16 and 24 significant bits
+    constexpr static float QuarterPi[3] = {0.78515625f, 2.4187564849853515625e-4f, 3.77489497744594108e-8f};
+    constexpr static float FourOverPi   = 1.27323954473516f;
+
+    constexpr static float Sin[3] = {-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f};
+    constexpr static float Cos[3] = {2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f};
+
+    // tanh(x) = x + x^3 P(x^2) for |x| < 0.625
+    constexpr static float TanhSmall = 0.625f;
+    constexpr static float TanhNumerator[5] = {-5.70498872745e-3f, 2.06390887954e-2f, -5.37397155531e-2f,
+                                               1.33314422036e-1f, -3.33332819422e-1f};
+
+    // atan(x) = x + x^3 P(x^2) for |x| < tan(pi / 8)
+    constexpr static float AtanReduce = 0.414213562373095f;
+    constexpr static float Atan[4] = {8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f, -3.33329491539e-1f};
+};
+
+template <typename Dummy>
+struct SIMDMathConstants<double, Dummy>
+{
+    using UnsignedType = uint64_t;
+
+    constexpr static int MantissaBits = 52;
+    constexpr static int ExponentBias = 1023;
+
+    constexpr static double IntegerMagic = 4503599627370496.0;
+
+    constexpr static double ExpHigh = 709.782712893383973096;
+    constexpr static double ExpLow  = -745.13321910194110842;
+
+    constexpr static double Ln2High = 6.93147180369123816490e-01;
+    constexpr static double Ln2Low  = 1.90821492927058770002e-10;
+    constexpr static double LogLn2High = 6.93147180369123816490e-01;
+    constexpr static double LogLn2Low  = 1.90821492927058770002e-10;
+
+    constexpr static double Split = 134217729.0;
+
+    constexpr static double Exp[5] = {4.13813679705723846039e-08, -1.65339022054652515390e-06, 6.61375632143793436117e-05,
+                                      -2.77777777770155933842e-03, 1.66666666666666019037e-01};
+
+    constexpr static double Log[7] = {1.479819860511658591e-01, 1.531383769920937332e-01, 1.818357216161805012e-01,
+                                      2.222219843214978396e-01, 2.857142874366239149e-01, 3.999999999940941908e-01,
+                                      6.666666666666735130e-01};
+
+    constexpr static double MinNormal = 2.2250738585072014e-308;
+    constexpr static double LogScale  = 18014398509481984.0;
+    constexpr static int    LogScaleBits = 54;
+
+    constexpr static double QuarterPi[3] = {7.85398125648498535156e-1, 3.77489470793079817668e-8,
+                                            2.69515142907905952645e-15};
+    constexpr static double FourOverPi   = 1.27323954473516268615;
+
+    constexpr static double Sin[6] = {1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+                                      -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1};
+    constexpr static double Cos[6] = {-1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7,
+                                      2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2};
+
+    // tanh(x) = x + x^3 P(x^2) / Q(x^2) for |x| < 0.625, Q has a leading 1
+    constexpr static double TanhSmall = 0.625;
+    constexpr static double TanhNumerator[3]   = {-9.64399179425052238628e-1, -9.92877231001918586564e1,
+                                                  -1.61468768441708447952e3};
+    constexpr static double TanhDenominator[3] = {1.12811678491632931402e2, 2.23548839060100448583e3,
+                                                  4.84406305325125486048e3};
+
+    // atan(x) = x + x^3 P(x^2) / Q(x^2) for |x| < 0.66, Q has a leading 1.
+    // AtanLow is the part of pi / 4 below double precision.
+    constexpr static double AtanReduce = 0.66;
+    constexpr static double AtanLow    = 3.061616997868382943065e-17;
+    constexpr static double AtanNumerator[5]   = {-8.750608600031904122785e-1, -1.615753718733365076637e1,
+                                                  -7.500855792314704667340e1, -1.228866684490136173410e2,
+                                                  -6.485021904942025371773e1};
+    constexpr static double AtanDenominator[5] = {2.485846490142306297962e1, 1.650270098316988542046e2,
+                                                  4.328810604912902668951e2, 4.853903996359136964868e2,
+                                                  1.945506571482613964425e2};
+};
+
+template <typename Dummy> constexpr float SIMDMathConstants<float, Dummy>::Exp[5];
+template <typename Dummy> constexpr float SIMDMathConstants<float, Dummy>::Log[7];
+template <typename Dummy> constexpr float SIMDMathConstants<float, Dummy>::QuarterPi[3];
+template <typename Dummy> constexpr float SIMDMathConstants<float, Dummy>::Sin[3];
+template <typename Dummy> constexpr float SIMDMathConstants<float, Dummy>::Cos[3];
+template <typename Dummy> constexpr float SIMDMathConstants<float, Dummy>::TanhNumerator[5];
+template <typename Dummy> constexpr float SIMDMathConstants<float, Dummy>::Atan[4];
+
+template <typename Dummy> constexpr double SIMDMathConstants<double, Dummy>::Exp[5];
+template <typename Dummy> constexpr double SIMDMathConstants<double, Dummy>::Log[7];
+template <typename Dummy> constexpr double SIMDMathConstants<double, Dummy>::QuarterPi[3];
+template <typename Dummy> constexpr double SIMDMathConstants<double, Dummy>::Sin[6];
+template <typename Dummy> constexpr double SIMDMathConstants<double, Dummy>::Cos[6];
+template <typename Dummy> constexpr double SIMDMathConstants<double, Dummy>::TanhNumerator[3];
+template <typename Dummy> constexpr double SIMDMathConstants<double, Dummy>::TanhDenominator[3];
+template <typename Dummy> constexpr double SIMDMathConstants<double, Dummy>::AtanNumerator[5];
+template <typename Dummy> constexpr double SIMDMathConstants<double, Dummy>::AtanDenominator[5];
+
+/// Vector and bit manipulation helpers for the functions below
+template <typename T>
+struct SIMDMathBase
+{
+    static_assert(std::is_floating_point<T>::value, "SIMD math functions require a floating point type");
+
+    using Constants       = SIMDMathConstants<T>;
+    using VecType         = typename SIMDType<T>::VecType;
+    using UnsignedVecType = typename VecType::uint_vector_type;
+
+    static TNT_INL VecType splat(T value)
+    {
+        return simdpp::load_splat<VecType>(&value);
+    }
+
+    /// Evaluate the polynomial `c[0] x^(N-1) + ... + c[N-1]` with Horner's
+    /// method
+    template <int N>
+    static TNT_INL VecType polynomial(const VecType& x, const T (&c)[N])
+    {
+        VecType result = splat(c[0]);
+        for (int i = 1; i < N; ++i)
+            result = simdpp::add(simdpp::mul(result, x), splat(c[i]));
+
+        return result;
+    }
+
+    /// `2^n` for integral values `n` in the normal exponent range. Adding
+    /// 2^mantissa places `n + bias` in the low mantissa bits, which are then
+    /// shifted into the exponent field.
+    static TNT_INL VecType exp2i(const VecType& n)
+    {
+        VecType biased = simdpp::add(n, splat(T(Constants::ExponentBias) + Constants::IntegerMagic));
+        return simdpp::bit_cast<VecType>(simdpp::shift_l<Constants::MantissaBits>(simdpp::bit_cast<UnsignedVecType>(biased)));
+    }
+
+    static TNT_INL VecType sign_bit()
+    {
+        const typename Constants::UnsignedType bit = typename Constants::UnsignedType(1) << (8 * sizeof(T) - 1);
+        return simdpp::bit_cast<VecType>(simdpp::load_splat<UnsignedVecType>(&bit));
+    }
+
+    /// Lanes of `x` where `mask` is set, negative zero elsewhere, ready to
+    /// be `xor`ed into a result as a sign
+    template <typename MaskType>
+    static TNT_INL VecType sign_where(const MaskType& mask)
+    {
+        return simdpp::bit_and(sign_bit(), mask);
+    }
+};
+
+/// \brief Natural exponential
+///
+/// \notes Error is within 1 ulp. Results overflow to infinity above
+/// `log(max)` and underflow to zero below the smallest subnormal.
+template <typename T>
+struct ExpSIMD : SIMDMathBase<T>
+{
+    using Base      = SIMDMathBase<T>;
+    using Constants = typename Base::Constants;
+    using VecType   = typename Base::VecType;
+
+    TNT_INL VecType run(const VecType& x) const
+    {
+        return run(x, Base::splat(T(0)));
+    }
+
+    /// `exp(x + tail)` for a `tail` below the rounding error of `x`, which
+    /// is folded into the reduced argument
+    TNT_INL VecType run(const VecType& x, const VecType& tail) const
+    {
+        const VecType high = Base::splat(Constants::ExpHigh);
+        const VecType low  = Base::splat(Constants::ExpLow);
+
+        VecType clamped = simdpp::min(simdpp::max(x, low), high);
+
+        // x = k ln2 + r, |r| <= ln2 / 2
+        VecType k = simdpp::floor(simdpp::add(simdpp::mul(clamped, Base::splat(T(1.4426950408889634))), Base::splat(T(0.5))));
+
+        VecType hi = simdpp::sub(clamped, simdpp::mul(k, Base::splat(Constants::Ln2High)));
+        VecType lo = simdpp::sub(simdpp::mul(k, Base::splat(Constants::Ln2Low)), tail);
+        VecType r  = simdpp::sub(hi, lo);
+
+        // exp(r) = 1 + r + r c / (2 - c) with c = r - r^2 P(r^2)
+        VecType t = simdpp::mul(r, r);
+        VecType c = simdpp::sub(r, simdpp::mul(t, Base::polynomial(t, Constants::Exp)));
+        VecType y = simdpp::sub(Base::splat(T(1)),
+                                simdpp::sub(simdpp::sub(lo, simdpp::div(simdpp::mul(r, c), simdpp::sub(Base::splat(T(2)), c))), hi));
+
+        // 2^k is applied in two halves so results near either end of the
+        // range do not overflow the exponent of the scale itself
+        VecType k1 = simdpp::floor(simdpp::mul(k, Base::splat(T(0.5))));
+        VecType k2 = simdpp::sub(k, k1);
+        VecType result = simdpp::mul(simdpp::mul(y, Base::exp2i(k1)), Base::exp2i(k2));
+
+        result = simdpp::blend(Base::splat(std::numeric_limits<T>::infinity()), result, simdpp::cmp_gt(x, high));
+        result = simdpp::blend(Base::splat(T(0)), result, simdpp::cmp_lt(x, low));
+        return simdpp::blend(x, result, simdpp::cmp_neq(x, x));
+    }
+};
+
+/// \brief Natural logarithm
+///
+/// \notes Error is within 1 ulp. `log(0)` is `-inf`, negative inputs give
+/// NaN.
+template <typename T>
+struct LogSIMD : SIMDMathBase<T>
+{
+    using Base            = SIMDMathBase<T>;
+    using Constants       = typename Base::Constants;
+    using VecType         = typename Base::VecType;
+    using UnsignedVecType = typename Base::UnsignedVecType;
+    using UnsignedType    = typename Constants::UnsignedType;
+
+    TNT_INL VecType run(const VecType& x) const
+    {
+        VecType f, e;
+        reduce(x, f, e);
+
+        // log(1 + f) = f - hfsq + s (hfsq + R(z)) with s = f / (2 + f)
+        VecType s    = simdpp::div(f, simdpp::add(Base::splat(T(2)), f));
+        VecType z    = simdpp::mul(s, s);
+        VecType R    = simdpp::mul(z, Base::polynomial(z, Constants::Log));
+        VecType hfsq = simdpp::mul(Base::splat(T(0.5)), simdpp::mul(f, f));
+
+        VecType result = simdpp::add(simdpp::mul(s, simdpp::add(hfsq, R)), simdpp::mul(e, Base::splat(Constants::LogLn2Low)));
+        result = simdpp::sub(simdpp::sub(hfsq, result), f);
+        result = simdpp::sub(simdpp::mul(e, Base::splat(Constants::LogLn2High)), result);
+
+        result = simdpp::blend(Base::splat(std::numeric_limits<T>::quiet_NaN()), result, simdpp::cmp_lt(x, Base::splat(T(0))));
+        result = simdpp::blend(Base::splat(-std::numeric_limits<T>::infinity()), result, simdpp::cmp_eq(x, Base::splat(T(0))));
+        result = simdpp::blend(x, result, simdpp::cmp_eq(x, Base::splat(std::numeric_limits<T>::infinity())));
+        return simdpp::blend(x, result, simdpp::cmp_neq(x, x));
+    }
+
+    /// Split `x = 2^e (1 + f)` with `1 + f` in `[sqrt(2) / 2, sqrt(2))`, so
+    /// `f` is exact
+    static TNT_INL void reduce(const VecType& x, VecType& f, VecType& e)
+    {
+        constexpr int MantissaBits = Constants::MantissaBits;
+
+        const UnsignedType mantissa_mask = (UnsignedType(1) << MantissaBits) - 1;
+        const UnsignedType one_bits      = UnsignedType(Constants::ExponentBias) << MantissaBits;
+        const UnsignedType magic_bits    = UnsignedType(Constants::ExponentBias + MantissaBits) << MantissaBits;
+
+        // Scale subnormals into the normal range
+        auto subnormal = simdpp::cmp_lt(x, Base::splat(Constants::MinNormal));
+        VecType scaled = simdpp::blend(simdpp::mul(x, Base::splat(Constants::LogScale)), x, subnormal);
+        VecType adjust = simdpp::blend(Base::splat(T(Constants::LogScaleBits)), Base::splat(T(0)), subnormal);
+
+        // x = m 2^e with m in [1, 2). The biased exponent is converted to
+        // floating point by placing it in the mantissa of 2^mantissa.
+        UnsignedVecType bits = simdpp::bit_cast<UnsignedVecType>(scaled);
+        UnsignedVecType exponent_bits = simdpp::bit_or(simdpp::shift_r<MantissaBits>(bits),
+                                                       simdpp::load_splat<UnsignedVecType>(&magic_bits));
+
+        e = simdpp::sub(simdpp::bit_cast<VecType>(exponent_bits),
+                        Base::splat(Constants::IntegerMagic + T(Constants::ExponentBias)));
+        e = simdpp::sub(e, adjust);
+
+        VecType m = simdpp::bit_cast<VecType>(simdpp::bit_or(simdpp::bit_and(bits, simdpp::load_splat<UnsignedVecType>(&mantissa_mask)),
+                                                             simdpp::load_splat<UnsignedVecType>(&one_bits)));
+
+        // Move m into [sqrt(2) / 2, sqrt(2))
+        auto large = simdpp::cmp_gt(m, Base::splat(T(1.41421356237309504880)));
+        m = simdpp::blend(simdpp::mul(m, Base::splat(T(0.5))), m, large);
+        e = simdpp::blend(simdpp::add(e, Base::splat(T(1))), e, large);
+
+        f = simdpp::sub(m, Base::splat(T(1)));
+    }
+};
+
+/// \brief Square root
+///
+/// \notes Correctly rounded, the error is within 0.5 ulp
+template <typename T>
+struct SqrtSIMD : SIMDMathBase<T>
+{
+    using VecType = typename SIMDMathBase<T>::VecType;
+
+    TNT_INL VecType run(const VecType& x) const
+    {
+        return simdpp::sqrt(x);
+    }
+};
+
+/// \brief Raise to a fixed power
+///
+/// \notes Exponents 1, 2 and 3 are computed by multiplication, so exactly
+/// representable results such as `pow(2, 3)` are exact. Other exponents use
+/// `exp(y log|x|)` with `log|x|` and its product with `y` carried to twice
+/// the working precision, so the rounding of `y log|x|` is not magnified by
+/// `exp`. The error is within 2 ulp for normal results. Negative bases give
+/// NaN unless `y` is an integer, `pow(x, 0)` is `1`.
+template <typename T>
+struct PowSIMD : SIMDMathBase<T>
+{
+    using Base      = SIMDMathBase<T>;
+    using Constants = typename Base::Constants;
+    using VecType   = typename Base::VecType;
+
+    /// The largest integral exponent computed by multiplication. Beyond it
+    /// the rounding errors of the products exceed those of `exp`.
+    constexpr static int MaxMultiply = 3;
+
+    explicit PowSIMD(T exponent)
+        : exponent(exponent),
+          exponent_vec(Base::splat(exponent)),
+          integer(std::floor(exponent) == exponent),
+          odd(integer && std::fmod(exponent, T(2)) != 0)
+    {
+#if !(SIMDPP_USE_FMA3 || SIMDPP_USE_FMA4)
+        // Split y once so y log|x| can be formed exactly. Exponents too large
+        // to split saturate exp anyway.
+        T high = exponent;
+        if (std::abs(exponent) < std::numeric_limits<T>::max() / Constants::Split)
+            high = exponent * Constants::Split - (exponent * Constants::Split - exponent);
+
+        exponent_high = Base::splat(high);
+        exponent_low  = Base::splat(exponent - high);
+#endif
+    }
+
+    TNT_INL VecType run(const VecType& x) const
+    {
+        if (exponent == T(0))
+            return Base::splat(T(1));
+
+        if (integer && exponent > 0 && exponent <= T(MaxMultiply))
+            return multiply(x);
+
+        VecType magnitude = simdpp::abs(x);
+
+        VecType log_high, log_low;
+        extended_log(magnitude, log_high, log_low);
+
+        // y log|x| = p + tail, with the rounding error of y log_high in tail,
+        // renormalized so p is the rounded sum
+        VecType p, tail;
+        product(log_high, p, tail);
+        tail = simdpp::add(tail, simdpp::mul(exponent_vec, log_low));
+
+        VecType sum = simdpp::add(p, tail);
+        tail = simdpp::sub(tail, simdpp::sub(sum, p));
+        p    = sum;
+
+        // Past the range of exp the tail does not matter and may be NaN
+        tail = simdpp::blend(Base::splat(T(0)), tail, simdpp::cmp_gt(simdpp::abs(p), Base::splat(-2 * Constants::ExpLow)));
+
+        VecType result = ExpSIMD<T>().run(p, tail);
+
+        // 0^y is 0 for positive y and infinity for negative y, and the other
+        // way around for infinite x
+        const T zero_power = exponent > 0 ? T(0) : std::numeric_limits<T>::infinity();
+        result = simdpp::blend(Base::splat(zero_power), result, simdpp::cmp_eq(magnitude, Base::splat(T(0))));
+        result = simdpp::blend(Base::splat(exponent > 0 ? std::numeric_limits<T>::infinity() : T(0)), result,
+                               simdpp::cmp_eq(magnitude, Base::splat(std::numeric_limits<T>::infinity())));
+        result = simdpp::blend(x, result, simdpp::cmp_neq(x, x));
+
+        auto negative = simdpp::cmp_lt(x, Base::splat(T(0)));
+        if (!integer)
+            return simdpp::blend(Base::splat(std::numeric_limits<T>::quiet_NaN()), result, negative);
+        else if (odd)
+            return simdpp::bit_xor(result, Base::sign_where(negative));
+
+        return result;
+    }
+
+    T       exponent;
+    VecType exponent_vec;
+#if !(SIMDPP_USE_FMA3 || SIMDPP_USE_FMA4)
+    VecType exponent_high, exponent_low;
+#endif
+    bool    integer, odd;
+
+private:
+    /// `x^y` for integral `y` from 1 to `MaxMultiply`
+    TNT_INL VecType multiply(const VecType& x) const
+    {
+        if (exponent == T(1))
+            return x;
+
+        VecType square = simdpp::mul(x, x);
+        return exponent == T(2) ? square : VecType(simdpp::mul(square, x));
+    }
+
+    /// `high + low = log(x)` to about twice the working precision. With
+    /// `x = 2^e (1 + f)` and `s = f / (2 + f)`, `log(x) = e ln2 + 2 s + s R(s^2)`.
+    /// `s` is carried as `s_high + s_low` and the leading sum is exact, so
+    /// only the small `s R(s^2)` term is rounded.
+    static TNT_INL void extended_log(const VecType& x, VecType& high, VecType& low)
+    {
+        VecType f, e;
+        LogSIMD<T>::reduce(x, f, e);
+
+        // 2 + f = d_high + d_low exactly
+        VecType d_high = simdpp::add(Base::splat(T(2)), f);
+        VecType d_low  = simdpp::sub(f, simdpp::sub(d_high, Base::splat(T(2))));
+
+        // s_low = (f - s_high (d_high + d_low)) / d_high, where f and the
+        // exact s_high d_high are close enough to subtract without error
+        VecType s_high = simdpp::div(f, d_high);
+
+        VecType q, q_error;
+        two_product(s_high, d_high, q, q_error);
+
+        VecType s_low = simdpp::sub(simdpp::sub(simdpp::sub(f, q), q_error), simdpp::mul(s_high, d_low));
+        s_low = simdpp::div(s_low, d_high);
+
+        VecType z = simdpp::mul(s_high, s_high);
+        VecType R = simdpp::mul(z, Base::polynomial(z, Constants::Log));
+
+        // e ln2_high is exact, and its sum with 2 s_high is split into the
+        // rounded sum and its error
+        VecType a = simdpp::mul(e, Base::splat(Constants::LogLn2High));
+        VecType b = simdpp::add(s_high, s_high);
+
+        high = simdpp::add(a, b);
+        VecType b_virtual = simdpp::sub(high, a);
+        VecType error = simdpp::add(simdpp::sub(a, simdpp::sub(high, b_virtual)), simdpp::sub(b, b_virtual));
+
+        low = simdpp::add(simdpp::mul(s_high, R), simdpp::mul(e, Base::splat(Constants::LogLn2Low)));
+        low = simdpp::add(error, simdpp::add(simdpp::add(s_low, s_low), low));
+
+        // Fold the small terms into high, so low is below its rounding error
+        VecType sum = simdpp::add(high, low);
+        low  = simdpp::sub(low, simdpp::sub(sum, high));
+        high = sum;
+    }
+
+#if SIMDPP_USE_FMA3 || SIMDPP_USE_FMA4
+
+    /// `p + error = y x` exactly
+    TNT_INL void product(const VecType& x, VecType& p, VecType& error) const
+    {
+        two_product(exponent_vec, x, p, error);
+    }
+
+    /// `p + error = a b` exactly. The fused `a b - p` rounds only once, and
+    /// the error of a product is representable.
+    static TNT_INL void two_product(const VecType& a, const VecType& b, VecType& p, VecType& error)
+    {
+        p = simdpp::mul(a, b);
+        error = simdpp::fmsub(a, b, p);
+    }
+
+#else
+
+    /// `p + error = y x` exactly, with the halves of `y` from the constructor
+    TNT_INL void product(const VecType& x, VecType& p, VecType& error) const
+    {
+        VecType x_high, x_low;
+        split(x, x_high, x_low);
+
+        p = simdpp::mul(exponent_vec, x);
+        error = simdpp::sub(simdpp::mul(exponent_high, x_high), p);
+        error = simdpp::add(error, simdpp::mul(exponent_high, x_low));
+        error = simdpp::add(error, simdpp::mul(exponent_low, x_high));
+        error = simdpp::add(error, simdpp::mul(exponent_low, x_low));
+    }
+
+    /// `p + error = a b` exactly (Dekker)
+    static TNT_INL void two_product(const VecType& a, const VecType& b, VecType& p, VecType& error)
+    {
+        VecType a_high, a_low, b_high, b_low;
+        split(a, a_high, a_low);
+        split(b, b_high, b_low);
+
+        p = simdpp::mul(a, b);
+        error = simdpp::sub(simdpp::mul(a_high, b_high), p);
+        error = simdpp::add(error, simdpp::mul(a_high, b_low));
+        error = simdpp::add(error, simdpp::mul(a_low, b_high));
+        error = simdpp::add(error, simdpp::mul(a_low, b_low));
+    }
+
+    /// Veltkamp split of `x` into halves whose products are exact. Only used
+    /// without FMA, where the compiler has no fused multiply-add to contract
+    /// the steps into, which would break the split.
+    static TNT_INL void split(const VecType& x, VecType& high, VecType& low)
+    {
+        VecType scaled = simdpp::mul(x, Base::splat(Constants::Split));
+        high = simdpp::sub(scaled, simdpp::sub(scaled, x));
+        low  = simdpp::sub(x, high);
+    }
+
+#endif
+};
+
+/// Shared range reduction for [SinSIMD]() and [CosSIMD](). `x` is reduced
+/// to `r` in [-pi/4, pi/4] with `|x| = j pi/4 + r` and `j` even.
+template <typename T>
+struct TrigonometricReduction : SIMDMathBase<T>
+{
+    using Base      = SIMDMathBase<T>;
+    using Constants = typename Base::Constants;
+    using VecType   = typename Base::VecType;
+    using MaskType  = decltype(simdpp::cmp_eq(VecType(), VecType()));
+
+    explicit TNT_INL TrigonometricReduction(const VecType& x)
+    {
+        VecType magnitude = simdpp::abs(x);
+
+        // j = (floor(|x| 4 / pi) + 1) & ~1, kept in floating point
+        VecType j = simdpp::floor(simdpp::mul(magnitude, Base::splat(Constants::FourOverPi)));
+        j = simdpp::mul(simdpp::floor(simdpp::mul(simdpp::add(j, Base::splat(T(1))), Base::splat(T(0.5)))), Base::splat(T(2)));
+
+        r = simdpp::sub(magnitude, simdpp::mul(j, Base::splat(Constants::QuarterPi[0])));
+        r = simdpp::sub(r, simdpp::mul(j, Base::splat(Constants::QuarterPi[1])));
+        r = simdpp::sub(r, simdpp::mul(j, Base::splat(Constants::QuarterPi[2])));
+
+        // Quadrant q = j / 2 mod 4, split into its two bits
+        VecType q     = simdpp::mul(j, Base::splat(T(0.5)));
+        VecType q_mod = simdpp::sub(q, simdpp::mul(simdpp::floor(simdpp::mul(q, Base::splat(T(0.25)))), Base::splat(T(4))));
+
+        odd_quadrant  = simdpp::cmp_neq(simdpp::sub(q_mod, simdpp::mul(simdpp::floor(simdpp::mul(q_mod, Base::splat(T(0.5)))),
+                                                                    Base::splat(T(2)))),
+                                        Base::splat(T(0)));
+        upper_half    = simdpp::cmp_ge(q_mod, Base::splat(T(2)));
+    }
+
+    /// sin(r) for r in [-pi/4, pi/4]
+    TNT_INL VecType sin() const
+    {
+        VecType z = simdpp::mul(r, r);
+        return simdpp::add(r, simdpp::mul(simdpp::mul(r, z), Base::polynomial(z, Constants::Sin)));
+    }
+
+    /// cos(r) for r in [-pi/4, pi/4]
+    TNT_INL VecType cos() const
+    {
+        VecType z = simdpp::mul(r, r);
+        VecType result = simdpp::mul(simdpp::mul(z, z), Base::polynomial(z, Constants::Cos));
+        return simdpp::add(simdpp::sub(Base::splat(T(1)), simdpp::mul(Base::splat(T(0.5)), z)), result);
+    }
+
+    VecType  r;
+    MaskType odd_quadrant, upper_half;
+};
+
+/// \brief Sine
+///
+/// \notes Error is within 3 ulp for `|x| < 4096` (float) and within 2 ulp
+/// for `|x| < 2^30` (double), measured relative to `max(|sin x|, 2^-16)`.
+/// Larger arguments lose precision in the range reduction.
+template <typename T>
+struct SinSIMD : SIMDMathBase<T>
+{
+    using Base    = SIMDMathBase<T>;
+    using VecType = typename Base::VecType;
+
+    TNT_INL VecType run(const VecType& x) const
+    {
+        TrigonometricReduction<T> reduced(x);
+
+        VecType result = simdpp::blend(reduced.cos(), reduced.sin(), reduced.odd_quadrant);
+
+        // sin is odd, so the sign of x is applied on top of the quadrant sign
+        VecType sign = simdpp::bit_xor(Base::sign_where(reduced.upper_half), simdpp::bit_and(x, Base::sign_bit()));
+        return simdpp::bit_xor(result, sign);
+    }
+};
+
+/// \brief Cosine
+///
+/// \notes Error bounds match [SinSIMD]()
+template <typename T>
+struct CosSIMD : SIMDMathBase<T>
+{
+    using Base    = SIMDMathBase<T>;
+    using VecType = typename Base::VecType;
+
+    TNT_INL VecType run(const VecType& x) const
+    {
+        TrigonometricReduction<T> reduced(x);
+
+        VecType result = simdpp::blend(reduced.sin(), reduced.cos(), reduced.odd_quadrant);
+
+        // Quadrants 1 and 2 are negative
+        return simdpp::bit_xor(result, Base::sign_where(simdpp::bit_xor(reduced.upper_half, reduced.odd_quadrant)));
+    }
+};
+
+/// \brief Hyperbolic tangent
+///
+/// \notes Error is within 3 ulp. Small arguments use a rational
+/// approximation, larger ones `1 - 2 / (exp(2|x|) + 1)`.
+template <typename T>
+struct TanhSIMD : SIMDMathBase<T>
+{
+    using Base      = SIMDMathBase<T>;
+    using Constants = typename Base::Constants;
+    using VecType   = typename Base::VecType;
+
+    TNT_INL VecType run(const VecType& x) const
+    {
+        VecType magnitude = simdpp::abs(x);
+
+        VecType e     = ExpSIMD<T>().run(simdpp::add(magnitude, magnitude));
+        VecType large = simdpp::sub(Base::splat(T(1)), simdpp::div(Base::splat(T(2)), simdpp::add(e, Base::splat(T(1)))));
+        large = simdpp::bit_xor(large, simdpp::bit_and(x, Base::sign_bit()));
+
+        VecType z     = simdpp::mul(x, x);
+        VecType small = simdpp::add(x, simdpp::mul(simdpp::mul(x, z), small_ratio(z, std::is_same<T, float>())));
+
+        return simdpp::blend(small, large, simdpp::cmp_lt(magnitude, Base::splat(Constants::TanhSmall)));
+    }
+
+private:
+    static TNT_INL VecType small_ratio(const VecType& z, std::true_type)
+    {
+        return Base::polynomial(z, Constants::TanhNumerator);
+    }
+
+    static TNT_INL VecType small_ratio(const VecType& z, std::false_type)
+    {
+        VecType denominator = simdpp::add(z, Base::splat(Constants::TanhDenominator[0]));
+        denominator = simdpp::add(simdpp::mul(denominator, z), Base::splat(Constants::TanhDenominator[1]));
+        denominator = simdpp::add(simdpp::mul(denominator, z), Base::splat(Constants::TanhDenominator[2]));
+
+        return simdpp::div(Base::polynomial(z, Constants::TanhNumerator), denominator);
+    }
+};
+
+/// \brief Logistic sigmoid `1 / (1 + exp(-x))`
+///
+/// \notes Error is within 3 ulp. Negative arguments are evaluated as
+/// `exp(x) / (1 + exp(x))` so small results do not flush to zero early.
+template <typename T>
+struct SigmoidSIMD : SIMDMathBase<T>
+{
+    using Base    = SIMDMathBase<T>;
+    using VecType = typename Base::VecType;
+
+    TNT_INL VecType run(const VecType& x) const
+    {
+        const VecType one = Base::splat(T(1));
+
+        VecType e = ExpSIMD<T>().run(simdpp::neg(simdpp::abs(x)));
+        VecType ratio = simdpp::div(one, simdpp::add(one, e));
+
+        return simdpp::blend(simdpp::mul(e, ratio), ratio, simdpp::cmp_lt(x, Base::splat(T(0))));
+    }
+};
+
+/// \brief Angle of the point `(x, y)`, `atan2(y, x)`
+///
+/// \notes Error is within 2 ulp. Signed zeros follow the C library, so
+/// `atan2(+-0, -0)` is `+-pi`. Two infinite arguments give NaN.
+template <typename T>
+struct Atan2SIMD : SIMDMathBase<T>
+{
+    using Base      = SIMDMathBase<T>;
+    using Constants = typename Base::Constants;
+    using VecType   = typename Base::VecType;
+
+    TNT_INL VecType run(const VecType& y, const VecType& x) const
+    {
+        const VecType zero = Base::splat(T(0));
+
+        VecType ax = simdpp::abs(x);
+        VecType ay = simdpp::abs(y);
+        VecType low  = simdpp::min(ax, ay);
+        VecType high = simdpp::max(ax, ay);
+
+        // atan of the ratio in [0, 1], reduced around 1 with
+        // atan(t) = pi / 4 + atan((t - 1) / (t + 1))
+        VecType t = simdpp::blend(zero, simdpp::div(low, high), simdpp::cmp_eq(high, zero));
+
+        auto reduce = simdpp::cmp_gt(t, Base::splat(Constants::AtanReduce));
+        VecType u = simdpp::blend(simdpp::div(simdpp::sub(t, Base::splat(T(1))), simdpp::add(t, Base::splat(T(1)))), t, reduce);
+
+        VecType result = simdpp::add(atan(u, std::is_same<T, float>()),
+                                     simdpp::bit_and(Base::splat(T(0.78539816339744830962)), reduce));
+
+        // Undo the octant folding: swap the axes, reflect across the y axis
+        // and apply the sign of y
+        const VecType half_pi = Base::splat(T(1.57079632679489661923));
+        result = simdpp::blend(simdpp::sub(half_pi, result), result, simdpp::cmp_gt(ay, ax));
+
+        VecType x_sign = simdpp::bit_or(simdpp::bit_and(x, Base::sign_bit()), Base::splat(T(1)));
+        result = simdpp::blend(simdpp::sub(simdpp::add(half_pi, half_pi), result), result, simdpp::cmp_lt(x_sign, zero));
+
+        result = simdpp::bit_xor(result, simdpp::bit_and(y, Base::sign_bit()));
+
+        auto invalid = simdpp::bit_or(simdpp::cmp_neq(x, x), simdpp::cmp_neq(y, y));
+        return simdpp::blend(simdpp::add(x, y), result, invalid);
+    }
+
+private:
+    static TNT_INL VecType atan(const VecType& u, std::true_type)
+    {
+        VecType z = simdpp::mul(u, u);
+        return simdpp::add(u, simdpp::mul(simdpp::mul(u, z), Base::polynomial(z, Constants::Atan)));
+    }
+
+    static TNT_INL VecType atan(const VecType& u, std::false_type)
+    {
+        VecType z = simdpp::mul(u, u);
+
+        VecType denominator = simdpp::add(z, Base::splat(Constants::AtanDenominator[0]));
+        for (int i = 1; i < 5; ++i)
+            denominator = simdpp::add(simdpp::mul(denominator, z), Base::splat(Constants::AtanDenominator[i]));
+
+        VecType ratio = simdpp::div(simdpp::mul(z, Base::polynomial(z, Constants::AtanNumerator)), denominator);
+
+        // The low part of pi / 4 is only added to reduced lanes, where u <= 0
+        VecType low = simdpp::bit_and(Base::splat(Constants::AtanLow), simdpp::cmp_lt(u, Base::splat(T(0))));
+        return simdpp::add(simdpp::add(u, simdpp::mul(u, ratio)), low);
+    }
+};
+
+/// \brief Length of the vector `(x, y)`, `hypot(x, y)`
+///
+/// \notes Error is within 2 ulp. The larger part is factored out, so the
+/// result does not overflow or underflow unless the length itself does.
+template <typename T>
+struct HypotSIMD : SIMDMathBase<T>
+{
+    using Base    = SIMDMathBase<T>;
+    using VecType = typename Base::VecType;
+
+    TNT_INL VecType run(const VecType& x, const VecType& y) const
+    {
+        const VecType zero = Base::splat(T(0));
+
+        VecType ax = simdpp::abs(x);
+        VecType ay = simdpp::abs(y);
+        VecType low  = simdpp::min(ax, ay);
+        VecType high = simdpp::max(ax, ay);
+
+        VecType t = simdpp::blend(zero, simdpp::div(low, high), simdpp::cmp_eq(high, zero));
+        VecType result = simdpp::mul(high, simdpp::sqrt(simdpp::add(Base::splat(T(1)), simdpp::mul(t, t))));
+
+        return simdpp::blend(high, result, simdpp::cmp_eq(high, Base::splat(std::numeric_limits<T>::infinity())));
+    }
+};
+
+} // namespace detail
+
+} // namespace tnt
+
+#endif // TNT_MATH_SIMD_MATH_HPP
@@ -0,0 +1,126 @@
+#ifndef TNT_MATH_TRANSCENDENTAL_OPS_HPP
+#define TNT_MATH_TRANSCENDENTAL_OPS_HPP
+
+#include <tnt/core/tensor.hpp>
+#include <tnt/math/simd_math.hpp>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+template <typename DataType, typename Function, typename Enable = void>
+struct OptimizedTranscendental
+{
+    static void eval(Tensor<DataType>&, const Function&) noexcept;
+};
+
+} // namespace detail
+
+/// \brief Apply the exponential function to a tensor elementwise
+///
+/// The function is computed in place on the tensor
+/// \param tensor A mutable tensor. The function is applied in-place
+/// \requires Type `DataType` is `float` or `double`
+/// \notes Error is within 1 ulp
+template <typename DataType>
+inline void exp(Tensor<DataType>& tensor) noexcept
+{
+    detail::OptimizedTranscendental<DataType, detail::ExpSIMD<DataType>>::eval(tensor, detail::ExpSIMD<DataType>());
+}
+
+/// \brief Apply the natural logarithm to a tensor elementwise
+///
+/// The function is computed in place on the tensor
+/// \param tensor A mutable tensor. The function is applied in-place
+/// \requires Type `DataType` is `float` or `double`
+/// \notes Error is within 1 ulp. Zero maps to `-inf`, negative values to NaN.
+template <typename DataType>
+inline void log(Tensor<DataType>& tensor) noexcept
+{
+    detail::OptimizedTranscendental<DataType, detail::LogSIMD<DataType>>::eval(tensor, detail::LogSIMD<DataType>());
+}
+
+/// \brief Apply the square root to a tensor elementwise
+///
+/// The function is computed in place on the tensor
+/// \param tensor A mutable tensor. The function is applied in-place
+/// \requires Type `DataType` is `float` or `double`
+/// \notes Results are correctly rounded
+template <typename DataType>
+inline void sqrt(Tensor<DataType>& tensor) noexcept
+{
+    detail::OptimizedTranscendental<DataType, detail::SqrtSIMD<DataType>>::eval(tensor, detail::SqrtSIMD<DataType>());
+}
+
+/// \brief Raise each element of a tensor to a fixed power
+///
+/// The function is computed in place on the tensor
+/// \param tensor A mutable tensor. The function is applied in-place
+/// \param exponent A scalar exponent
+/// \requires Type `DataType` is `float` or `double`
+/// \notes The error is within 2 ulp for normal results, and exponents 1, 2
+/// and 3 are computed by multiplication so exactly representable powers are
+/// exact. Negative elements give NaN unless the exponent is an integer.
+template <typename DataType, typename ScalarType>
+inline void pow(Tensor<DataType>& tensor, const ScalarType& exponent) noexcept
+{
+    detail::PowSIMD<DataType> function(static_cast<DataType>(exponent));
+    detail::OptimizedTranscendental<DataType, detail::PowSIMD<DataType>>::eval(tensor, function);
+}
+
+/// \brief Apply the sine function to a tensor elementwise
+///
+/// The function is computed in place on the tensor
+/// \param tensor A mutable tensor. The function is applied in-place
+/// \requires Type `DataType` is `float` or `double`
+/// \notes Error is within 3 ulp for `|x| < 4096` (float) and within 2 ulp
+/// for `|x| < 2^30` (double). Larger arguments lose precision in the range
+/// reduction.
+template <typename DataType>
+inline void sin(Tensor<DataType>& tensor) noexcept
+{
+    detail::OptimizedTranscendental<DataType, detail::SinSIMD<DataType>>::eval(tensor, detail::SinSIMD<DataType>());
+}
+
+/// \brief Apply the cosine function to a tensor elementwise
+///
+/// The function is computed in place on the tensor
+/// \param tensor A mutable tensor. The function is applied in-place
+/// \requires Type `DataType` is `float` or `double`
+/// \notes Error bounds match [sin](tnt::sin)
+template <typename DataType>
+inline void cos(Tensor<DataType>& tensor) noexcept
+{
+    detail::OptimizedTranscendental<DataType, detail::CosSIMD<DataType>>::eval(tensor, detail::CosSIMD<DataType>());
+}
+
+/// \brief Apply the hyperbolic tangent to a tensor elementwise
+///
+/// The function is computed in place on the tensor
+/// \param tensor A mutable tensor. The function is applied in-place
+/// \requires Type `DataType` is `float` or `double`
+/// \notes Error is within 3 ulp
+template <typename DataType>
+inline void tanh(Tensor<DataType>& tensor) noexcept
+{
+    detail::OptimizedTranscendental<DataType, detail::TanhSIMD<DataType>>::eval(tensor, detail::TanhSIMD<DataType>());
+}
+
+/// \brief Apply the logistic sigmoid `1 / (1 + exp(-x))` to a tensor
+/// elementwise
+///
+/// The function is computed in place on the tensor
+/// \param tensor A mutable tensor. The function is applied in-place
+/// \requires Type `DataType` is `float` or `double`
+/// \notes Error is within 3 ulp
+template <typename DataType>
+inline void sigmoid(Tensor<DataType>& tensor) noexcept
+{
+    detail::OptimizedTranscendental<DataType, detail::SigmoidSIMD<DataType>>::eval(tensor, detail::SigmoidSIMD<DataType>());
+}
+
+} // namespace tnt
+
+#endif // TNT_MATH_TRANSCENDENTAL_OPS_HPP
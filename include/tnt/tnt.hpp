@@ -8,6 +8,7 @@
 #include <tnt/core/core.hpp>
 #include <tnt/math/math.hpp>
 #include <tnt/linear/linear.hpp>
+#include <tnt/image/image.hpp>
 
 #endif // TNT_HPP
 
@@ -0,0 +1,242 @@
+#ifndef TNT_PARALLEL_HPP
+#define TNT_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tnt
+{
+
+namespace detail
+{
+
+/// \brief The number of threads used when a caller asks for 0
+inline int default_num_threads() noexcept
+{
+    const unsigned count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : static_cast<int>(count);
+}
+
+/// \brief Worker threads shared by every parallel loop
+///
+/// Workers are started the first time a loop asks for them and then wait
+/// for work until the program exits, so a loop costs a wake up instead of a
+/// thread creation. One loop runs at a time, loops started from other
+/// threads wait for the pool.
+class ThreadPool
+{
+public:
+    static ThreadPool& instance()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    /// True on a thread that is running a task, where a nested loop cannot
+    /// use the pool
+    static bool& in_task() noexcept
+    {
+        thread_local bool inside = false;
+        return inside;
+    }
+
+    /// Call `function(i)` for every `i` in `[0, count)` on the calling
+    /// thread and `num_threads - 1` workers
+    template <typename Function>
+    void run(int count, int num_threads, const Function& function)
+    {
+        std::lock_guard<std::mutex> busy(running);
+
+        while (static_cast<int>(workers.size()) < num_threads - 1) {
+            const int index = static_cast<int>(workers.size()) + 1;
+            workers.emplace_back([this, index]() { work(index); });
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task         = &function;
+            invoke       = &call<Function>;
+            total        = count;
+            participants = num_threads;
+            remaining    = num_threads - 1;
+            next         = 0;
+            ++generation;
+        }
+        wake.notify_all();
+
+        execute();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this]() { return remaining == 0; });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+private:
+    ThreadPool() = default;
+
+    template <typename Function>
+    static void call(const void* function, int i)
+    {
+        (*static_cast<const Function*>(function))(i);
+    }
+
+    /// Take indices from the shared counter until they run out, so uneven
+    /// work balances itself
+    void execute()
+    {
+        in_task() = true;
+        for (int i = next++; i < total; i = next++)
+            invoke(task, i);
+        in_task() = false;
+    }
+
+    void work(int index)
+    {
+        uint64_t seen = 0;
+
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&]() { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+
+                seen = generation;
+                if (index >= participants)
+                    continue;
+            }
+
+            execute();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--remaining == 0)
+                done.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex running;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    const void* task = nullptr;
+    void (*invoke)(const void*, int) = nullptr;
+    int total = 0;
+    int participants = 0;
+    int remaining = 0;
+    std::atomic<int> next{0};
+    uint64_t generation = 0;
+    bool stopping = false;
+};
+
+/// \brief The number of threads a loop of `count` tasks runs on, 1 inside a
+/// task
+inline int team_size(int count, int num_threads)
+{
+    if (ThreadPool::in_task())
+        return 1;
+
+    return std::min(num_threads <= 0 ? default_num_threads() : num_threads, count);
+}
+
+/// \brief Call `function(i)` for every `i` in `[0, count)` on up to
+/// `num_threads` threads
+///
+/// \notes Indices are handed out one at a time from a shared counter, so
+/// uneven work balances itself. The calling thread is one of the workers and
+/// the others come from a [ThreadPool]() that is started on first use.
+/// `function` must not call `parallel_for` again, the pool is busy with the
+/// outer loop and the inner one runs serially on the calling thread.
+/// `function` must not throw, an exception escaping a worker terminates the
+/// program.
+template <typename Function>
+inline void parallel_for(int count, int num_threads, const Function& function)
+{
+    num_threads = team_size(count, num_threads);
+
+    if (num_threads <= 1) {
+        for (int i = 0; i < count; ++i)
+            function(i);
+        return;
+    }
+
+    ThreadPool::instance().run(count, num_threads, function);
+}
+
+/// \brief Blocks each of `count` threads in [wait](*::wait) until all of
+/// them have arrived
+class Barrier
+{
+public:
+    explicit Barrier(int count) : count(count), waiting(0), generation(0) {}
+
+    int size() const noexcept
+    {
+        return count;
+    }
+
+    void wait()
+    {
+        if (count == 1)
+            return;
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        const uint64_t arrived = generation;
+        if (++waiting == count) {
+            waiting = 0;
+            ++generation;
+            released.notify_all();
+            return;
+        }
+
+        released.wait(lock, [&]() { return generation != arrived; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable released;
+    const int count;
+    int waiting;
+    uint64_t generation;
+};
+
+/// \brief Call `function(thread, barrier)` once on each of
+/// `barrier.size()` threads that run at the same time, so the calls may wait
+/// for each other with `barrier.wait()`
+///
+/// \notes The team has [num_threads](*::num_threads) threads, or 1 when
+/// called from inside a task. The same rules as [parallel_for]() apply to
+/// `function`.
+template <typename Function>
+inline void parallel_team(int num_threads, const Function& function)
+{
+    num_threads = num_threads <= 0 ? default_num_threads() : num_threads;
+
+    Barrier barrier(team_size(num_threads, num_threads));
+    parallel_for(barrier.size(), barrier.size(), [&](int thread) { function(thread, barrier); });
+}
+
+} // namespace detail
+
+} // namespace tnt
+
+#endif // TNT_PARALLEL_HPP
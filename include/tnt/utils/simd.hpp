@@ -5,7 +5,9 @@
 
 #include <simdpp/simd.h>
 
+#include <cmath>
 #include <sstream>
+#include <type_traits>
 
 namespace tnt
 {
@@ -247,10 +249,8 @@ template <typename T>
 struct MultiplySIMD
 {
     static_assert(std::is_arithmetic<T>::value,      "MultiplySIMD requires an arithmetic type");
-    static_assert(!std::is_same<T, uint8_t>::value,  "Unsigned 8 bit multiplication is not supported");
-    static_assert(!std::is_same<T, uint64_t>::value, "Unsigned 64 bit multiplication is not supported (overflow)");
-    static_assert(!std::is_same<T, int8_t>::value,   "Signed 8 bit multiplication is not supported");
-    static_assert(!std::is_same<T, int64_t>::value,  "Signed 64 bit multiplication is not supported (overflow)");
+    static_assert(!std::is_same<T, uint64_t>::value, "Use MultiplyLow64 for unsigned 64 bit multiplication");
+    static_assert(!std::is_same<T, int64_t>::value,  "Use MultiplyLow64 for signed 64 bit multiplication");
 
     using VecType = typename SIMDType<T>::VecType;
 
@@ -263,6 +263,28 @@ struct MultiplySIMD
     }
 };
 
+// simdpp has no 8 bit multiply. Both operands are widened to 16 bits, where
+// the low half of the product is exact, and truncated back.
+template <> struct MultiplySIMD<uint8_t>
+{
+    using VecType = typename SIMDType<uint8_t>::VecType;
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right)
+    {
+        return simdpp::to_uint8(simdpp::mul_lo(simdpp::to_uint16(left), simdpp::to_uint16(right)));
+    }
+};
+
+template <> struct MultiplySIMD<int8_t>
+{
+    using VecType = typename SIMDType<int8_t>::VecType;
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right)
+    {
+        return simdpp::to_int8(simdpp::mul_lo(simdpp::to_int16(left), simdpp::to_int16(right)));
+    }
+};
+
 template <> struct MultiplySIMD<float>
 {
     using VecType = typename SIMDType<float>::VecType;
@@ -283,6 +305,361 @@ template <> struct MultiplySIMD<double>
     }
 };
 
+/// \brief Provide a consistent interface for `a * b + c`
+///
+/// Floating point types use a single rounding fused multiply-add when the
+/// target has FMA3 or FMA4, and a multiply followed by an add otherwise. The
+/// scalar form rounds the same way so SIMD blocks and scalar tails agree.
+/// Integer products wrap like [MultiplySIMD]().
+template <typename T>
+struct MultiplyAddSIMD
+{
+    using VecType = typename SIMDType<T>::VecType;
+
+    static TNT_INL VecType run(const VecType& a, const VecType& b, const VecType& c)
+    {
+        return simdpp::add(MultiplySIMD<T>::run(a, b), c);
+    }
+
+    static TNT_INL T scalar(const T& a, const T& b, const T& c)
+    {
+        return scalar(a, b, c, typename std::is_floating_point<T>::type());
+    }
+
+private:
+    static TNT_INL T scalar(const T& a, const T& b, const T& c, std::true_type)
+    {
+        return a * b + c;
+    }
+
+    // Integer arithmetic is done unsigned, where wrapping is defined
+    static TNT_INL T scalar(const T& a, const T& b, const T& c, std::false_type)
+    {
+        using WideType = unsigned long long;
+        return static_cast<T>(static_cast<WideType>(a) * static_cast<WideType>(b) + static_cast<WideType>(c));
+    }
+};
+
+/// \brief True when [MultiplyAddSIMD]() has a SIMD form for type `T`. 64 bit
+/// integers have none, as [MultiplyLow64]() works on at least 4 lanes and
+/// does not match the `OptimalSIMDSize` vectors of the other types.
+template <typename T>
+struct HasMultiplyAddSIMD
+    : public std::integral_constant<bool, !(std::is_integral<T>::value && sizeof(T) == 8)> {};
+
+#if SIMDPP_USE_FMA3 || SIMDPP_USE_FMA4
+
+#define FUSED_MULTIPLY_ADD_CASE(TYPE)                                          \
+template <> struct MultiplyAddSIMD<TYPE>                                       \
+{                                                                              \
+    using VecType = typename SIMDType<TYPE>::VecType;                          \
+                                                                               \
+    static TNT_INL VecType run(const VecType& a, const VecType& b, const VecType& c) \
+    {                                                                          \
+        return simdpp::fmadd(a, b, c);                                         \
+    }                                                                          \
+                                                                               \
+    static TNT_INL TYPE scalar(const TYPE& a, const TYPE& b, const TYPE& c)    \
+    {                                                                          \
+        return std::fma(a, b, c);                                              \
+    }                                                                          \
+};
+
+FUSED_MULTIPLY_ADD_CASE(float)
+FUSED_MULTIPLY_ADD_CASE(double)
+
+#undef FUSED_MULTIPLY_ADD_CASE
+
+#endif
+
+/// \brief Wrapping 64 bit multiplication built from 32 bit partial products
+///
+/// With `a = ah * 2^32 + al` the low 64 bits of `a * b` are
+/// `al * bl + ((ah * bl + al * bh) << 32)`. The full `al * bl` product comes
+/// from a widening 32 bit multiply, the cross terms only need their low 32
+/// bits. Vectors hold at least 4 lanes so the 32 bit halves fill a full
+/// 128 bit register.
+///
+/// \requires Type `T` is `uint64_t` or `int64_t`
+template <typename T>
+struct MultiplyLow64
+{
+    static_assert(std::is_same<T, uint64_t>::value || std::is_same<T, int64_t>::value,
+                  "MultiplyLow64 requires a 64 bit integer type");
+
+    constexpr static int Size = OptimalSIMDSize<T>::value < 4 ? 4 : OptimalSIMDSize<T>::value;
+
+    using VecType         = typename FullSIMDType<T, Size>::VecType;
+    using UnsignedVecType = simdpp::uint64<Size>;
+
+    static TNT_INL VecType run(const VecType& _left, const VecType& _right)
+    {
+        UnsignedVecType left  = simdpp::bit_cast<UnsignedVecType>(_left);
+        UnsignedVecType right = simdpp::bit_cast<UnsignedVecType>(_right);
+
+        simdpp::uint32<Size> l_lo = simdpp::to_uint32(left);
+        simdpp::uint32<Size> r_lo = simdpp::to_uint32(right);
+        simdpp::uint32<Size> l_hi = simdpp::to_uint32(simdpp::shift_r<32>(left));
+        simdpp::uint32<Size> r_hi = simdpp::to_uint32(simdpp::shift_r<32>(right));
+
+        simdpp::uint32<Size> cross = simdpp::add(simdpp::mul_lo(l_hi, r_lo), simdpp::mul_lo(l_lo, r_hi));
+        UnsignedVecType result = simdpp::add(UnsignedVecType(simdpp::mull(l_lo, r_lo)),
+                                             UnsignedVecType(simdpp::shift_l<32>(simdpp::to_uint64(cross))));
+
+        return simdpp::bit_cast<VecType>(result);
+    }
+};
+
+/// \brief High half of an integer multiplication
+///
+/// Returns the upper `N` bits of the `2N` bit product of two `N` bit
+/// integers. simdpp only provides this for 16 bit lanes, the other widths
+/// are built from widening multiplies. 64 bit lanes combine four 32x32
+/// partial products. Vectors hold at least 4 lanes so every 32 bit half
+/// fills a full 128 bit register.
+///
+/// \requires Type `T` is an integer type
+template <typename T>
+struct MultiplyHighSIMD
+{
+    static_assert(std::is_integral<T>::value, "MultiplyHighSIMD requires an integer type");
+
+    constexpr static int Size = OptimalSIMDSize<T>::value < 4 ? 4 : OptimalSIMDSize<T>::value;
+
+    using VecType = typename FullSIMDType<T, Size>::VecType;
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right)
+    {
+        return run(left, right, std::integral_constant<int, sizeof(T)>(), typename std::is_signed<T>::type());
+    }
+
+private:
+    static TNT_INL VecType run(const VecType& left, const VecType& right, std::integral_constant<int, 1>, std::false_type)
+    {
+        simdpp::uint16<Size> product = simdpp::mul_lo(simdpp::to_uint16(left), simdpp::to_uint16(right));
+        return simdpp::to_uint8(simdpp::shift_r<8>(product));
+    }
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right, std::integral_constant<int, 1>, std::true_type)
+    {
+        simdpp::int16<Size> product = simdpp::mul_lo(simdpp::to_int16(left), simdpp::to_int16(right));
+        return simdpp::to_int8(simdpp::shift_r<8>(product));
+    }
+
+    template <typename IsSigned>
+    static TNT_INL VecType run(const VecType& left, const VecType& right, std::integral_constant<int, 2>, IsSigned)
+    {
+        return simdpp::mul_hi(left, right);
+    }
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right, std::integral_constant<int, 4>, std::false_type)
+    {
+        simdpp::uint64<Size> product = simdpp::mull(left, right);
+        return simdpp::to_uint32(simdpp::shift_r<32>(product));
+    }
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right, std::integral_constant<int, 4>, std::true_type)
+    {
+        simdpp::int64<Size> product = simdpp::mull(left, right);
+        return simdpp::to_int32(simdpp::shift_r<32>(product));
+    }
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right, std::integral_constant<int, 8>, std::false_type)
+    {
+        const uint64_t low_mask = 0xFFFFFFFFull;
+        const auto mask = simdpp::load_splat<simdpp::uint64<Size>>(&low_mask);
+
+        simdpp::uint32<Size> l_lo = simdpp::to_uint32(left);
+        simdpp::uint32<Size> r_lo = simdpp::to_uint32(right);
+        simdpp::uint32<Size> l_hi = simdpp::to_uint32(simdpp::shift_r<32>(left));
+        simdpp::uint32<Size> r_hi = simdpp::to_uint32(simdpp::shift_r<32>(right));
+
+        simdpp::uint64<Size> ll = simdpp::mull(l_lo, r_lo);
+        simdpp::uint64<Size> lh = simdpp::mull(l_lo, r_hi);
+        simdpp::uint64<Size> hl = simdpp::mull(l_hi, r_lo);
+        simdpp::uint64<Size> hh = simdpp::mull(l_hi, r_hi);
+
+        simdpp::uint64<Size> mid = simdpp::add(simdpp::shift_r<32>(ll),
+                                               simdpp::add(simdpp::bit_and(lh, mask), simdpp::bit_and(hl, mask)));
+
+        return simdpp::add(simdpp::add(hh, simdpp::shift_r<32>(mid)),
+                           simdpp::add(simdpp::shift_r<32>(lh), simdpp::shift_r<32>(hl)));
+    }
+
+    // The signed product differs from the unsigned one by the other operand
+    // for each negative operand
+    static TNT_INL VecType run(const VecType& left, const VecType& right, std::integral_constant<int, 8>, std::true_type)
+    {
+        using UnsignedVecType = simdpp::uint64<Size>;
+
+        UnsignedVecType high = MultiplyHighSIMD<uint64_t>::run(simdpp::bit_cast<UnsignedVecType>(left),
+                                                               simdpp::bit_cast<UnsignedVecType>(right));
+
+        UnsignedVecType l_sign = simdpp::bit_cast<UnsignedVecType>(simdpp::shift_r<63>(left));
+        UnsignedVecType r_sign = simdpp::bit_cast<UnsignedVecType>(simdpp::shift_r<63>(right));
+
+        high = simdpp::sub(high, simdpp::bit_and(l_sign, simdpp::bit_cast<UnsignedVecType>(right)));
+        high = simdpp::sub(high, simdpp::bit_and(r_sign, simdpp::bit_cast<UnsignedVecType>(left)));
+
+        return simdpp::bit_cast<VecType>(high);
+    }
+};
+
+/// \brief Saturating 8 and 16 bit multiplication
+///
+/// The product of two `N` bit values always fits in `2N` bits, so the
+/// operands are widened, multiplied exactly and clamped back into the `N` bit
+/// range.
+///
+/// \requires Type `T` is `uint8_t`, `int8_t`, `uint16_t` or `int16_t`
+template <typename T>
+struct MultiplySaturateSIMD
+{
+    static_assert(sizeof(T) == -1, "MultiplySaturateSIMD is valid only for [`uint8_t`, `int8_t`, `uint16_t`, `int16_t`]");
+};
+
+template <> struct MultiplySaturateSIMD<uint8_t>
+{
+    constexpr static int Size = OptimalSIMDSize<uint8_t>::value;
+
+    using VecType = typename SIMDType<uint8_t>::VecType;
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right)
+    {
+        const uint16_t high = 255;
+
+        simdpp::uint16<Size> product = simdpp::mul_lo(simdpp::to_uint16(left), simdpp::to_uint16(right));
+        return simdpp::to_uint8(simdpp::min(product, simdpp::load_splat<simdpp::uint16<Size>>(&high)));
+    }
+};
+
+template <> struct MultiplySaturateSIMD<int8_t>
+{
+    constexpr static int Size = OptimalSIMDSize<int8_t>::value;
+
+    using VecType = typename SIMDType<int8_t>::VecType;
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right)
+    {
+        const int16_t low = -128, high = 127;
+
+        simdpp::int16<Size> product = simdpp::mul_lo(simdpp::to_int16(left), simdpp::to_int16(right));
+        product = simdpp::max(product, simdpp::load_splat<simdpp::int16<Size>>(&low));
+        product = simdpp::min(product, simdpp::load_splat<simdpp::int16<Size>>(&high));
+
+        return simdpp::to_int8(product);
+    }
+};
+
+template <> struct MultiplySaturateSIMD<uint16_t>
+{
+    constexpr static int Size = OptimalSIMDSize<uint16_t>::value;
+
+    using VecType = typename SIMDType<uint16_t>::VecType;
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right)
+    {
+        const uint32_t high = 65535;
+
+        simdpp::uint32<Size> product = simdpp::mull(left, right);
+        return simdpp::to_uint16(simdpp::min(product, simdpp::load_splat<simdpp::uint32<Size>>(&high)));
+    }
+};
+
+template <> struct MultiplySaturateSIMD<int16_t>
+{
+    constexpr static int Size = OptimalSIMDSize<int16_t>::value;
+
+    using VecType = typename SIMDType<int16_t>::VecType;
+
+    static TNT_INL VecType run(const VecType& left, const VecType& right)
+    {
+        const int32_t low = -32768, high = 32767;
+
+        simdpp::int32<Size> product = simdpp::mull(left, right);
+        product = simdpp::max(product, simdpp::load_splat<simdpp::int32<Size>>(&low));
+        product = simdpp::min(product, simdpp::load_splat<simdpp::int32<Size>>(&high));
+
+        return simdpp::to_int16(product);
+    }
+};
+
+/// \brief Pack the lanes of a compare mask into the bits of an integer
+///
+/// Compares are issued on [Size]() element vectors so the mask can always be
+/// narrowed to a full 128 bit `uint8` vector and collected with a single
+/// movemask, independent of the width of type `T`.
+///
+/// \requires Type `T` is arithmetic
+template <typename T>
+struct PackMaskBits
+{
+    constexpr static int Size = 16;
+
+    using VecType         = typename FullSIMDType<T, Size>::VecType;
+    using UnsignedVecType = typename VecType::uint_vector_type;
+
+    /// \brief Convert a mask over `Size` lanes of type `T` to a bitfield
+    /// where bit `i` is set if lane `i` is set
+    template <typename MaskType>
+    static TNT_INL uint16_t pack(const MaskType& mask)
+    {
+        simdpp::uint8<Size> bytes = simdpp::to_uint8(simdpp::bit_cast<UnsignedVecType>(mask));
+        return simdpp::extract_bits_any(bytes);
+    }
+};
+
+/// \brief Narrow a compare mask to bytes of `0` or `255` and store them
+///
+/// Uses the `Size` element groups of [PackMaskBits](), so the narrowing is a
+/// single conversion to a full 128 bit `uint8` vector. The bytes are stored
+/// unaligned straight into the destination.
+///
+/// \requires Type `T` is arithmetic
+template <typename T>
+struct StoreMaskBytes
+{
+    constexpr static int Size = 16;
+
+    using VecType         = typename FullSIMDType<T, Size>::VecType;
+    using UnsignedVecType = typename VecType::uint_vector_type;
+
+    /// \brief Store byte `i` of `out` as `255` if lane `i` of the mask is set
+    /// and `0` otherwise
+    template <typename MaskType>
+    static TNT_INL void store(uint8_t* out, const MaskType& mask)
+    {
+        simdpp::store_u(out, simdpp::to_uint8(simdpp::bit_cast<UnsignedVecType>(mask)));
+    }
+};
+
+/// \brief Widen a mask of `Size` bytes to a lane mask over `Size` elements of
+/// type `T`
+///
+/// The inverse of [PackMaskBits](). Mask bytes must be `0` or `255`. They are
+/// sign extended, so every set byte becomes a lane with all bits set.
+///
+/// \requires Type `T` is arithmetic
+template <typename T>
+struct ExpandMaskBytes
+{
+    constexpr static int Size = 16;
+
+    using VecType         = typename FullSIMDType<T, Size>::VecType;
+    using UnsignedVecType = typename VecType::uint_vector_type;
+
+    static TNT_INL UnsignedVecType expand(const simdpp::int8<Size>& bytes)
+    {
+        return simdpp::bit_cast<UnsignedVecType>(widen(bytes, std::integral_constant<int, sizeof(T)>()));
+    }
+
+private:
+    static TNT_INL simdpp::int8<Size>  widen(const simdpp::int8<Size>& b, std::integral_constant<int, 1>) { return b; }
+    static TNT_INL simdpp::int16<Size> widen(const simdpp::int8<Size>& b, std::integral_constant<int, 2>) { return simdpp::to_int16(b); }
+    static TNT_INL simdpp::int32<Size> widen(const simdpp::int8<Size>& b, std::integral_constant<int, 4>) { return simdpp::to_int32(b); }
+    static TNT_INL simdpp::int64<Size> widen(const simdpp::int8<Size>& b, std::integral_constant<int, 8>) { return simdpp::to_int64(b); }
+};
+
 /// \brief Utility struct to print out type information
 ///
 /// This struct provides a single character for type and an integer for size.
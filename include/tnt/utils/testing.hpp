@@ -28,6 +28,7 @@ typedef doctest::Types<int8_t, int16_t, int32_t, int64_t> test_signed_data_types
 typedef doctest::Types<uint8_t, uint16_t, uint32_t, uint64_t,
                         int8_t,  int16_t,  int32_t,  int64_t> test_integer_data_types;
 typedef doctest::Types<float, double> test_float_data_types;
+typedef doctest::Types<uint8_t, int8_t, uint16_t, int16_t> test_saturate_data_types;
 
 // ----------------------------------------------------------------------------
 // Approximately equal for floating point comparisons